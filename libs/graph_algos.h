@@ -15,13 +15,42 @@
 #define __GRAPH_ALGOS_H__
 
 #include <vector>
+#include <array>
+#include <span>
 #include <queue>
+#include <tuple>
 #include <limits>
+#include <optional>
+#include <algorithm>
+#include <functional>
 #include <concepts>
+#include <bit>
 #include <iostream>
 
 #include "math_algos.h"
 #include "math_conts.h"
+#include "par_helpers.h"
+
+
+// block size for the floyd-warshall algorithm
+#ifndef GRAPH_FLOYD_BLOCK
+	#define GRAPH_FLOYD_BLOCK 64
+#endif
+
+// minimum number of work items for which several threads are used, 0: never
+#ifndef GRAPH_THREAD_THRESHOLD
+	#define GRAPH_THREAD_THRESHOLD 1024
+#endif
+
+// maximum number of cyclic buckets in delta_stepping(), a smaller delta is enlarged
+#ifndef GRAPH_DELTA_MAX_BUCKETS
+	#define GRAPH_DELTA_MAX_BUCKETS (std::size_t(1) << 16)
+#endif
+
+// minimum number of vertices for which the floyd-warshall algorithm uses several threads, 0: never
+#ifndef GRAPH_FLOYD_THREAD_THRESHOLD
+	#define GRAPH_FLOYD_THREAD_THRESHOLD 256
+#endif
 
 
 // ----------------------------------------------------------------------------
@@ -53,9 +82,66 @@ concept is_flux_graph = requires(t_graph& graph, std::size_t vertidx, typename t
 	graph.SetCapacity(vertidx, vertidx, w);
 	{ graph.GetCapacity(vertidx, vertidx) } -> std::convertible_to<typename t_graph::t_weight>;
 };
+
+
+/**
+ * graph containers which can traverse the neighbours of a vertex without allocations, e.g. csr_graph
+ */
+template<class t_graph>
+concept has_neighbour_span = requires(const t_graph& graph, std::size_t vertidx)
+{
+	requires is_graph<t_graph>;
+
+	{ graph.GetNeighbourSpan(vertidx, true) } -> std::convertible_to<std::span<const std::size_t>>;
+	{ graph.GetWeightSpan(vertidx, true) } -> std::convertible_to<std::span<const typename t_graph::t_weight>>;
+};
 // ----------------------------------------------------------------------------
 
 
+
+/**
+ * calls func(neighbouridx, weight) for all neighbours on the outgoing (or incoming) edges of a vertex
+ * the weight is the one of the edge vertidx -> neighbouridx (or neighbouridx -> vertidx)
+ * containers with a neighbour span are traversed directly, the others via GetNeighbours()
+ */
+template<class t_graph, class t_func> requires is_graph<t_graph>
+void for_each_neighbour(const t_graph& graph, std::size_t vertidx, bool outgoing_edges, t_func func)
+{
+	if constexpr(has_neighbour_span<t_graph>)
+	{
+		std::span<const std::size_t> neighbours = graph.GetNeighbourSpan(vertidx, outgoing_edges);
+		std::span<const typename t_graph::t_weight> weights = graph.GetWeightSpan(vertidx, outgoing_edges);
+
+		for(std::size_t i=0; i<neighbours.size(); ++i)
+			func(neighbours[i], weights[i]);
+	}
+	else
+	{
+		std::vector<std::size_t> neighbours = graph.GetNeighbours(vertidx, outgoing_edges);
+
+		for(std::size_t neighbouridx : neighbours)
+		{
+			if(outgoing_edges)
+				func(neighbouridx, graph.GetWeight(vertidx, neighbouridx));
+			else
+				func(neighbouridx, graph.GetWeight(neighbouridx, vertidx));
+		}
+	}
+}
+
+
+/**
+ * distributes the work items [0, num) over the given number of threads, 0: all hardware threads
+ * func(thread, begin, end) is called for each chunk
+ */
+template<class t_func>
+void graph_parallel(std::size_t num, std::size_t num_threads, t_func func,
+	std::size_t thread_threshold = GRAPH_THREAD_THRESHOLD)
+{
+	m::parallel_chunks(num, m::parallel_threads(num, thread_threshold, num_threads), func);
+}
+
+
 /**
  * export graph to dot
  * @see https://graphviz.org/doc/info/lang.html
@@ -125,396 +211,1010 @@ void print_graph(const t_graph& graph, std::ostream& ostr = std::cout)
 }
 
 
-//#define __DIJK_IMPL_SORT__ 1	// use a std::priority_queue
-//#define __DIJK_IMPL_SORT__ 2	// use a heap
-#define __DIJK_IMPL_SORT__ 3	// use a sorted vector
-
+// ----------------------------------------------------------------------------
+// priority queues for the shortest-path searches
+// ----------------------------------------------------------------------------
 /**
- * dijkstra algorithm
- * @see (FUH 2021), Kurseinheit 4, p. 17
- * @see (Erickson 2019), p. 288
+ * indexed d-ary min-heap over the vertex indices [0, N) with a decrease-key operation
+ * @see https://en.wikipedia.org/wiki/D-ary_heap
  */
-template<class t_graph> requires is_graph<t_graph>
-std::vector<std::optional<std::size_t>>
-dijk(const t_graph& graph, const std::string& startvert, bool use_weights = true)
+template<class t_key, std::size_t D = 4>
+class indexed_heap
 {
-	// start index
-	auto _startidx = graph.GetVertexIndex(startvert);
-	if(!_startidx)
-		return {};
-	const std::size_t startidx = *_startidx;
+public:
+	static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
 
 
-	// distances
-	const std::size_t N = graph.GetNumVertices();
-	using t_weight = typename t_graph::t_weight;
+public:
+	explicit indexed_heap(std::size_t N)
+		: m_heap{}, m_pos(N, npos), m_keys(N)
+	{
+		m_heap.reserve(N);
+	}
 
-	std::vector<t_weight> dists;
-	std::vector<std::optional<std::size_t>> predecessors;
-	dists.resize(N);
-	predecessors.resize(N);
 
-	// don't use the full maximum to prevent overflows when we're adding the weight afterwards
-	const t_weight infinity = std::numeric_limits<t_weight>::max() / 2;
-	for(std::size_t vertidx=0; vertidx<N; ++vertidx)
-		dists[vertidx] = (vertidx==startidx ? 0 : infinity);
+	bool empty() const
+	{
+		return m_heap.empty();
+	}
 
 
-	// distance priority queue and comparator
-	auto vert_cmp = [&dists](std::size_t idx1, std::size_t idx2) -> bool
+	std::size_t size() const
 	{
-		// sort by ascending value: !operator<
-		return dists[idx1] >= dists[idx2];
-	};
+		return m_heap.size();
+	}
 
-#if __DIJK_IMPL_SORT__ == 1
-	std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(vert_cmp)>
-		prio{vert_cmp};
-#elif __DIJK_IMPL_SORT__ == 2 || __DIJK_IMPL_SORT__ == 3
-	std::vector<std::size_t> prio;
-	prio.reserve(N);
-#endif
 
-	for(std::size_t vertidx=0; vertidx<N; ++vertidx)
+	bool contains(std::size_t idx) const
 	{
-#if __DIJK_IMPL_SORT__ == 1
-		prio.push(vertidx);
-#elif __DIJK_IMPL_SORT__ == 2 || __DIJK_IMPL_SORT__ == 3
-		prio.push_back(vertidx);
-#endif
+		return m_pos[idx] != npos;
 	}
 
-#if __DIJK_IMPL_SORT__ == 2
-	std::make_heap(prio.begin(), prio.end(), vert_cmp);
-#elif __DIJK_IMPL_SORT__ == 3
-	std::sort(prio.begin(), prio.end(), vert_cmp);
-#endif
+
+	/**
+	 * index with the smallest key
+	 */
+	std::size_t top() const
+	{
+		return m_heap.front();
+	}
 
 
-	while(prio.size())
+	/**
+	 * smallest key
+	 */
+	const t_key& top_key() const
 	{
-#if __DIJK_IMPL_SORT__ == 1
-		std::size_t vertidx = prio.top();
-		prio.pop();
-#elif __DIJK_IMPL_SORT__ == 2
-		std::size_t vertidx = *prio.begin();
-		std::pop_heap(prio.begin(), prio.end(), vert_cmp);
-		prio.pop_back();
-#elif __DIJK_IMPL_SORT__ == 3
-		std::size_t vertidx = *prio.rbegin();
-		prio.pop_back();
-#endif
+		return m_keys[m_heap.front()];
+	}
 
-		std::vector<std::size_t> neighbours = graph.GetNeighbours(vertidx);
-		for(std::size_t neighbouridx : neighbours)
+
+	/**
+	 * insert a new index or change the key of an index which is already in the heap
+	 */
+	void push(std::size_t idx, const t_key& key)
+	{
+		if(!contains(idx))
+		{
+			m_pos[idx] = m_heap.size();
+			m_heap.push_back(idx);
+			m_keys[idx] = key;
+			sift_up(m_pos[idx]);
+		}
+		else if(key < m_keys[idx])
 		{
-			t_weight w = use_weights ? graph.GetWeight(vertidx, neighbouridx) : t_weight{1};
+			// decrease key
+			m_keys[idx] = key;
+			sift_up(m_pos[idx]);
+		}
+		else
+		{
+			m_keys[idx] = key;
+			sift_down(m_pos[idx]);
+		}
+	}
 
-			// is the path from startidx to neighbouridx over vertidx shorter than from startidx to neighbouridx?
-			if(dists[vertidx] + w < dists[neighbouridx])
-			{
-				dists[neighbouridx] = dists[vertidx] + w;
-				predecessors[neighbouridx] = vertidx;
 
-				// change distance of node neighbouridx
-#if __DIJK_IMPL_SORT__ == 1
-				// add another node with the same index but the changed distances
-				prio.push(neighbouridx);
-#elif __DIJK_IMPL_SORT__ == 2
-				// resort the priority queue heap after the distance changes
-				std::make_heap(prio.begin(), prio.end(), vert_cmp);
-#elif __DIJK_IMPL_SORT__ == 3
-				// resort with changed distances
-				std::sort(prio.begin(), prio.end(), vert_cmp);
-#endif
-			}
-		}
+	/**
+	 * remove the index with the smallest key
+	 * @returns [index, key]
+	 */
+	std::pair<std::size_t, t_key> pop()
+	{
+		const std::size_t idx = m_heap.front();
+
+		m_heap.front() = m_heap.back();
+		m_pos[m_heap.front()] = 0;
+		m_heap.pop_back();
+		m_pos[idx] = npos;
+
+		if(!m_heap.empty())
+			sift_down(0);
+
+		return std::make_pair(idx, m_keys[idx]);
 	}
 
 
-	/*for(std::size_t i=0; i<N; ++i)
+protected:
+	void sift_up(std::size_t pos)
 	{
-		const std::string& endvert = graph.GetVertexIdent(i);
-		std::cout << "dist from " << startvert << " to " << endvert << ": " << dists[i] << std::endl;
+		const std::size_t idx = m_heap[pos];
+
+		while(pos > 0)
+		{
+			const std::size_t parent = (pos - 1) / D;
+			if(!(m_keys[idx] < m_keys[m_heap[parent]]))
+				break;
+
+			m_heap[pos] = m_heap[parent];
+			m_pos[m_heap[pos]] = pos;
+			pos = parent;
+		}
+
+		m_heap[pos] = idx;
+		m_pos[idx] = pos;
 	}
 
-	for(std::size_t i=0; i<N; ++i)
+
+	void sift_down(std::size_t pos)
 	{
-		const auto& _predidx = predecessors[i];
-		if(!_predidx)
-			continue;
+		const std::size_t idx = m_heap[pos];
+		const std::size_t N = m_heap.size();
 
-		std::size_t predidx = *_predidx;
-		const std::string& vert = graph.GetVertexIdent(i);
-		const std::string& pred = graph.GetVertexIdent(predidx);
+		while(true)
+		{
+			const std::size_t first_child = pos*D + 1;
+			if(first_child >= N)
+				break;
+
+			// smallest child
+			std::size_t child = first_child;
+			const std::size_t end_child = std::min(first_child + D, N);
+			for(std::size_t other=first_child+1; other<end_child; ++other)
+			{
+				if(m_keys[m_heap[other]] < m_keys[m_heap[child]])
+					child = other;
+			}
 
-		std::cout << "predecessor of " << vert << ": " << pred << "." << std::endl;
-	}*/
+			if(!(m_keys[m_heap[child]] < m_keys[idx]))
+				break;
 
-	return predecessors;
-}
+			m_heap[pos] = m_heap[child];
+			m_pos[m_heap[pos]] = pos;
+			pos = child;
+		}
+
+		m_heap[pos] = idx;
+		m_pos[idx] = pos;
+	}
+
+
+private:
+	// vertex indices in heap order
+	std::vector<std::size_t> m_heap;
+
+	// position of each vertex index in the heap
+	std::vector<std::size_t> m_pos;
+
+	// key of each vertex index
+	std::vector<t_key> m_keys;
+};
 
 
 /**
- * dijkstra algorithm (version which also works for negative weights)
- * @see (Erickson 2019), p. 285
+ * radix heap for unsigned integer keys, where the popped keys are non-decreasing
+ * there is no decrease-key operation, outdated entries remain in the heap
+ * @see https://en.wikipedia.org/wiki/Radix_heap
  */
-template<class t_graph> requires is_graph<t_graph>
-std::vector<std::optional<std::size_t>>
-dijk_mod(const t_graph& graph, const std::string& startvert, bool use_weights = true)
+template<class t_key> requires std::unsigned_integral<t_key>
+class radix_heap
 {
-	// start index
-	auto _startidx = graph.GetVertexIndex(startvert);
-	if(!_startidx)
-		return {};
-	const std::size_t startidx = *_startidx;
+public:
+	static constexpr std::size_t num_buckets = std::numeric_limits<t_key>::digits + 1;
 
-	// distances
-	const std::size_t N = graph.GetNumVertices();
-	using t_weight = typename t_graph::t_weight;
 
-	std::vector<t_weight> dists;
-	std::vector<std::optional<std::size_t>> predecessors;
-	dists.resize(N);
-	predecessors.resize(N);
+public:
+	explicit radix_heap(std::size_t = 0)
+	{}
 
-	// don't use the full maximum to prevent overflows when we're adding the weight afterwards
-	const t_weight infinity = std::numeric_limits<t_weight>::max() / 2;
-	for(std::size_t vertidx=0; vertidx<N; ++vertidx)
-		dists[vertidx] = (vertidx==startidx ? 0 : infinity);
 
-	// distance priority queue and comparator
-	auto vert_cmp = [&dists](std::size_t idx1, std::size_t idx2) -> bool
+	bool empty() const
 	{
-		// sort by ascending value: !operator<
-		return dists[idx1] >= dists[idx2];
-	};
+		return m_size == 0;
+	}
 
-#if __DIJK_IMPL_SORT__ == 1
-	std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(vert_cmp)>
-		prio{vert_cmp};
-#elif __DIJK_IMPL_SORT__ == 2 || __DIJK_IMPL_SORT__ == 3
-	std::vector<std::size_t> prio;
-	prio.reserve(N);
-#endif
 
-	// push only start index, not all indices
-#if __DIJK_IMPL_SORT__ == 1
-	prio.push(startidx);
-#elif __DIJK_IMPL_SORT__ == 2 || __DIJK_IMPL_SORT__ == 3
-	prio.push_back(startidx);
-#endif
+	std::size_t size() const
+	{
+		return m_size;
+	}
 
-/*#if __DIJK_IMPL_SORT__ == 2
-	std::make_heap(prio.begin(), prio.end(), vert_cmp);
-#elif __DIJK_IMPL_SORT__ == 3
-	std::sort(prio.begin(), prio.end(), vert_cmp);
-#endif*/
-
-	while(prio.size())
-	{
-#if __DIJK_IMPL_SORT__ == 1
-		std::size_t vertidx = prio.top();
-		prio.pop();
-#elif __DIJK_IMPL_SORT__ == 2
-		std::size_t vertidx = *prio.begin();
-		std::pop_heap(prio.begin(), prio.end(), vert_cmp);
-		prio.pop_back();
-#elif __DIJK_IMPL_SORT__ == 3
-		std::size_t vertidx = *prio.rbegin();
-		prio.pop_back();
-#endif
 
-		std::vector<std::size_t> neighbours = graph.GetNeighbours(vertidx);
-		for(std::size_t neighbouridx : neighbours)
-		{
-			t_weight w = use_weights ? graph.GetWeight(vertidx, neighbouridx) : t_weight{1};
+	/**
+	 * insert an index, the key must not be smaller than the last popped one
+	 */
+	void push(std::size_t idx, t_key key)
+	{
+		m_buckets[bucket(key)].emplace_back(std::make_pair(key, idx));
+		++m_size;
+	}
 
-			// is the path from startidx to neighbouridx over vertidx shorter than from startidx to neighbouridx?
-			if(dists[vertidx] + w < dists[neighbouridx])
-			{
-				dists[neighbouridx] = dists[vertidx] + w;
-				predecessors[neighbouridx] = vertidx;
 
-				// insert new node or change distance of node neighbouridx
-#if __DIJK_IMPL_SORT__ == 1
-				// add another node with the same index but the changed distances
-				prio.push(neighbouridx);
-#elif __DIJK_IMPL_SORT__ == 2
-				// resort the priority queue heap after the distance changes
-				if(std::find(prio.begin(), prio.end(), neighbouridx) != prio.end())
-				{
-					std::make_heap(prio.begin(), prio.end(), vert_cmp);
-				}
-				// ... or insert the new node index if it's not in the queue yet
-				else
-				{
-					prio.push_back(neighbouridx);
-					std::make_heap(prio.begin(), prio.end(), vert_cmp);
-				}
-#elif __DIJK_IMPL_SORT__ == 3
-				// resort with changed distances
-				if(std::find(prio.begin(), prio.end(), neighbouridx) != prio.end())
-				{
-					std::sort(prio.begin(), prio.end(), vert_cmp);
-				}
-				// ... or insert the new node index if it's not in the queue yet
-				else
-				{
-					prio.push_back(neighbouridx);
-					std::sort(prio.begin(), prio.end(), vert_cmp);
-				}
-#endif
-			}
+	/**
+	 * remove an index with the smallest key
+	 * @returns [index, key]
+	 */
+	std::pair<std::size_t, t_key> pop()
+	{
+		if(m_buckets[0].empty())
+		{
+			// redistribute the first non-empty bucket relative to its smallest key
+			std::size_t i = 1;
+			while(m_buckets[i].empty())
+				++i;
+
+			m_last = m_buckets[i].front().first;
+			for(const auto& [key, idx] : m_buckets[i])
+				m_last = std::min(m_last, key);
+
+			for(const auto& entry : m_buckets[i])
+				m_buckets[bucket(entry.first)].push_back(entry);
+			m_buckets[i].clear();
 		}
+
+		const auto [key, idx] = m_buckets[0].back();
+		m_buckets[0].pop_back();
+		--m_size;
+
+		return std::make_pair(idx, key);
 	}
 
-	return predecessors;
-}
+
+protected:
+	/**
+	 * bucket 0 holds the keys equal to the last one, bucket i the keys differing from it in bit i-1
+	 */
+	std::size_t bucket(t_key key) const
+	{
+		return key == m_last ? 0 : std::bit_width(t_key(key ^ m_last));
+	}
+
+
+private:
+	std::array<std::vector<std::pair<t_key, std::size_t>>, num_buckets> m_buckets{};
+	t_key m_last{};
+	std::size_t m_size{};
+};
 
 
 /**
- * is there a path from start to end?
+ * binary heap from the standard library, outdated entries remain in the heap
  */
-template<class t_edge = std::pair<std::size_t, std::size_t>>
-std::pair<bool, std::vector<t_edge>>
-does_path_exist(std::vector<std::optional<std::size_t>> predecessors,
-	std::size_t startidx, std::size_t endidx)
+template<class t_key>
+class lazy_heap
 {
-	std::vector<t_edge> edges;
-	edges.reserve(predecessors.size());
-	std::size_t curidx = endidx;
+public:
+	explicit lazy_heap(std::size_t = 0)
+	{}
 
-	while(1)
+
+	bool empty() const
 	{
-		if(predecessors.size() <= curidx)
-			return std::make_pair(false, edges);
+		return m_heap.empty();
+	}
 
-		auto predecessor = predecessors[curidx];
-		if(!predecessor)
-			return std::make_pair(false, edges);
 
-		edges.emplace_back(std::make_pair(*predecessor, curidx));
+	std::size_t size() const
+	{
+		return m_heap.size();
+	}
 
-		curidx = *predecessor;
-		if(curidx == startidx)
-		{
-			std::reverse(edges.begin(), edges.end());
-			return std::make_pair(true, edges);
-		}
+
+	void push(std::size_t idx, const t_key& key)
+	{
+		m_heap.push(std::make_pair(key, idx));
 	}
 
-	return std::make_pair(false, edges);
-}
+
+	std::pair<std::size_t, t_key> pop()
+	{
+		const auto [key, idx] = m_heap.top();
+		m_heap.pop();
+
+		return std::make_pair(idx, key);
+	}
+
+
+private:
+	std::priority_queue<std::pair<t_key, std::size_t>,
+		std::vector<std::pair<t_key, std::size_t>>,
+		std::greater<std::pair<t_key, std::size_t>>> m_heap{};
+};
 
 
 /**
- * bellman-ford algorithm for distance vectors
- * @see (FUH 2021), Kurseinheit 4, p. 13
+ * priority queue used by the dijkstra algorithm
  */
-template<class t_graph, class t_mat=m::mat<typename t_graph::t_weight, std::vector>>
-requires is_graph<t_graph> && m::is_mat<t_mat>
-t_mat bellman(const t_graph& graph, const std::string& startvert)
+enum class DijkQueue
 {
-	// start index
-	auto _startidx = graph.GetVertexIndex(startvert);
-	if(!_startidx)
-		return t_mat{};
-	const std::size_t startidx = *_startidx;
-
+	PRIORITY_QUEUE,   // std::priority_queue with outdated entries
+	DARY_HEAP,        // indexed 4-ary heap with decrease-key
+	RADIX_HEAP,       // radix heap, only for unsigned integer weights
+};
+// ----------------------------------------------------------------------------
 
-	// distances
-	const std::size_t N = graph.GetNumVertices();
-	using t_weight = typename t_graph::t_weight;
-	t_mat dists = m::zero<t_mat>(N, N);
 
-	// don't use the full maximum to prevent overflows when we're adding the weight afterwards
-	const t_weight infinity = std::numeric_limits<t_weight>::max() / 2;
 
-	for(std::size_t vertidx=0; vertidx<N; ++vertidx)
-		dists(0, vertidx) = (vertidx==startidx ? 0 : infinity);
+// ----------------------------------------------------------------------------
+// shortest paths
+// ----------------------------------------------------------------------------
+/**
+ * label-setting search from startidx using the given priority queue
+ * stops as soon as endidx is reached, if given
+ * outdated queue entries are skipped by comparing with the current distance
+ * @see (FUH 2021), Kurseinheit 4, p. 17
+ * @see (Erickson 2019), pp. 285-288
+ */
+template<class t_graph, class t_queue> requires is_graph<t_graph>
+void dijk_search(const t_graph& graph, std::size_t startidx, std::optional<std::size_t> endidx,
+	bool use_weights, std::vector<typename t_graph::t_weight>& dists,
+	std::vector<std::optional<std::size_t>>& predecessors)
+{
+	using t_weight = typename t_graph::t_weight;
 
+	t_queue prio(graph.GetNumVertices());
+	dists[startidx] = t_weight{};
+	prio.push(startidx, dists[startidx]);
 
-	// iterate vertices
-	for(std::size_t i=1; i<N; ++i)
+	while(!prio.empty())
 	{
-		for(std::size_t vertidx=0; vertidx<N; ++vertidx)
+		const auto [vertidx, dist] = prio.pop();
+		if(dists[vertidx] < dist)
+			continue;
+		if(endidx && vertidx == *endidx)
+			break;
+
+		for_each_neighbour(graph, vertidx, true, [&](std::size_t neighbouridx, t_weight w)
 		{
-			dists(i, vertidx) = dists(i-1, vertidx);
+			if(!use_weights)
+				w = t_weight{1};
 
-			std::vector<std::size_t> neighbours = graph.GetNeighbours(vertidx, false);
-			for(std::size_t neighbouridx : neighbours)
+			// is the path from startidx to neighbouridx over vertidx shorter than from startidx to neighbouridx?
+			if(dists[vertidx] + w < dists[neighbouridx])
 			{
-				t_weight w = graph.GetWeight(neighbouridx, vertidx);
-				//std::cout << "Weight from " << neighbouridx << " to " << vertidx << ": " << w << std::endl;
+				dists[neighbouridx] = dists[vertidx] + w;
+				predecessors[neighbouridx] = vertidx;
 
-				if(dists(i-1, neighbouridx) + w < dists(i, vertidx))
-				{
-					dists(i, vertidx) = dists(i-1, neighbouridx) + w;
-				}
+				// insert the node or decrease its distance
+				prio.push(neighbouridx, dists[neighbouridx]);
 			}
-		}
+		});
 	}
-
-	return dists;
 }
 
 
 /**
- * floyd-warshall algorithm for distance vectors
- * @see (FUH 2021), Kurseinheit 4, p. 23
+ * dijkstra search with the priority queue selected at runtime
+ * @returns [distances, predecessors]
+ */
+template<class t_graph> requires is_graph<t_graph>
+std::tuple<std::vector<typename t_graph::t_weight>, std::vector<std::optional<std::size_t>>>
+dijk_dists(const t_graph& graph, std::size_t startidx, std::optional<std::size_t> endidx = std::nullopt,
+	bool use_weights = true, DijkQueue queue = DijkQueue::DARY_HEAP)
+{
+	using t_weight = typename t_graph::t_weight;
+	const std::size_t N = graph.GetNumVertices();
+
+	// don't use the full maximum to prevent overflows when we're adding the weight afterwards
+	const t_weight infinity = std::numeric_limits<t_weight>::max() / 2;
+
+	std::vector<t_weight> dists(N, infinity);
+	std::vector<std::optional<std::size_t>> predecessors(N);
+
+	if(queue == DijkQueue::RADIX_HEAP)
+	{
+		if constexpr(std::unsigned_integral<t_weight>)
+		{
+			dijk_search<t_graph, radix_heap<t_weight>>(
+				graph, startidx, endidx, use_weights, dists, predecessors);
+			return std::make_tuple(dists, predecessors);
+		}
+
+		// not available for the weight type
+		queue = DijkQueue::DARY_HEAP;
+	}
+
+	if(queue == DijkQueue::PRIORITY_QUEUE)
+	{
+		dijk_search<t_graph, lazy_heap<t_weight>>(
+			graph, startidx, endidx, use_weights, dists, predecessors);
+	}
+	else
+	{
+		dijk_search<t_graph, indexed_heap<t_weight>>(
+			graph, startidx, endidx, use_weights, dists, predecessors);
+	}
+
+	return std::make_tuple(dists, predecessors);
+}
+
+
+/**
+ * dijkstra algorithm
+ * @see (FUH 2021), Kurseinheit 4, p. 17
+ * @see (Erickson 2019), p. 288
+ */
+template<class t_graph> requires is_graph<t_graph>
+std::vector<std::optional<std::size_t>>
+dijk(const t_graph& graph, const std::string& startvert, bool use_weights = true,
+	DijkQueue queue = DijkQueue::DARY_HEAP)
+{
+	// start index
+	auto _startidx = graph.GetVertexIndex(startvert);
+	if(!_startidx)
+		return {};
+
+	auto [dists, predecessors] = dijk_dists<t_graph>(
+		graph, *_startidx, std::nullopt, use_weights, queue);
+	return predecessors;
+}
+
+
+/**
+ * dijkstra algorithm (version which also works for negative weights)
+ * vertices whose distance decreases after they have been taken from the queue are inserted again,
+ * the radix heap is not available here, because it needs non-decreasing keys
+ * @see (Erickson 2019), p. 285
+ */
+template<class t_graph> requires is_graph<t_graph>
+std::vector<std::optional<std::size_t>>
+dijk_mod(const t_graph& graph, const std::string& startvert, bool use_weights = true,
+	DijkQueue queue = DijkQueue::DARY_HEAP)
+{
+	// start index
+	auto _startidx = graph.GetVertexIndex(startvert);
+	if(!_startidx)
+		return {};
+
+	if(queue == DijkQueue::RADIX_HEAP)
+		queue = DijkQueue::DARY_HEAP;
+
+	auto [dists, predecessors] = dijk_dists<t_graph>(
+		graph, *_startidx, std::nullopt, use_weights, queue);
+	return predecessors;
+}
+
+
+/**
+ * shortest path between two vertices, the search stops when the end vertex is reached
+ * @returns [path found?, distance, vertex indices on the path]
+ */
+template<class t_graph> requires is_graph<t_graph>
+std::tuple<bool, typename t_graph::t_weight, std::vector<std::size_t>>
+dijk_path(const t_graph& graph, const std::string& startvert, const std::string& endvert,
+	bool use_weights = true, DijkQueue queue = DijkQueue::DARY_HEAP)
+{
+	using t_weight = typename t_graph::t_weight;
+
+	auto startidx = graph.GetVertexIndex(startvert);
+	auto endidx = graph.GetVertexIndex(endvert);
+	if(!startidx || !endidx)
+		return std::make_tuple(false, t_weight{}, std::vector<std::size_t>{});
+
+	auto [dists, predecessors] = dijk_dists<t_graph>(
+		graph, *startidx, *endidx, use_weights, queue);
+
+	if(*startidx != *endidx && !predecessors[*endidx])
+		return std::make_tuple(false, t_weight{}, std::vector<std::size_t>{});
+
+	std::vector<std::size_t> path{ *endidx };
+	while(path.back() != *startidx)
+		path.push_back(*predecessors[path.back()]);
+	std::reverse(path.begin(), path.end());
+
+	return std::make_tuple(true, dists[*endidx], path);
+}
+
+
+/**
+ * bidirectional dijkstra search for the shortest path between two vertices
+ * alternately expands the forward search along outgoing edges and the backward search along incoming ones,
+ * always continuing the one with the smaller frontier, and stops when the sum of both queue minima exceeds the best path found so far
+ * @returns [path found?, distance, vertex indices on the path]
+ * @see https://en.wikipedia.org/wiki/Bidirectional_search
+ */
+template<class t_graph> requires is_graph<t_graph>
+std::tuple<bool, typename t_graph::t_weight, std::vector<std::size_t>>
+dijk_bidir(const t_graph& graph, const std::string& startvert, const std::string& endvert,
+	bool use_weights = true)
+{
+	using t_weight = typename t_graph::t_weight;
+
+	auto _startidx = graph.GetVertexIndex(startvert);
+	auto _endidx = graph.GetVertexIndex(endvert);
+	if(!_startidx || !_endidx)
+		return std::make_tuple(false, t_weight{}, std::vector<std::size_t>{});
+
+	const std::size_t startidx = *_startidx;
+	const std::size_t endidx = *_endidx;
+	const std::size_t N = graph.GetNumVertices();
+
+	// don't use the full maximum to prevent overflows when we're adding the weight afterwards
+	const t_weight infinity = std::numeric_limits<t_weight>::max() / 2;
+
+	// forward and backward distances, predecessors and queues
+	std::vector<t_weight> dists[2] = { std::vector<t_weight>(N, infinity), std::vector<t_weight>(N, infinity) };
+	std::vector<std::optional<std::size_t>> predecessors[2] = { std::vector<std::optional<std::size_t>>(N),
+		std::vector<std::optional<std::size_t>>(N) };
+	indexed_heap<t_weight> prio[2] = { indexed_heap<t_weight>(N), indexed_heap<t_weight>(N) };
+
+	dists[0][startidx] = t_weight{};
+	dists[1][endidx] = t_weight{};
+	prio[0].push(startidx, t_weight{});
+	prio[1].push(endidx, t_weight{});
+
+	// best path found so far and the vertex where both searches meet
+	t_weight best = startidx == endidx ? t_weight{} : infinity;
+	std::size_t meetidx = startidx;
+
+	while(!prio[0].empty() && !prio[1].empty())
+	{
+		if(!(prio[0].top_key() + prio[1].top_key() < best))
+			break;
+
+		// expand the direction with the smaller frontier
+		const std::size_t dir = prio[1].size() < prio[0].size() ? 1 : 0;
+		std::vector<t_weight>& dists_dir = dists[dir];
+		const std::vector<t_weight>& dists_other = dists[1 - dir];
+		const auto [vertidx, dist] = prio[dir].pop();
+
+		for_each_neighbour(graph, vertidx, dir == 0, [&](std::size_t neighbouridx, t_weight w)
+		{
+			if(!use_weights)
+				w = t_weight{1};
+
+			if(!(dist + w < dists_dir[neighbouridx]))
+				return;
+
+			dists_dir[neighbouridx] = dist + w;
+			predecessors[dir][neighbouridx] = vertidx;
+			prio[dir].push(neighbouridx, dists_dir[neighbouridx]);
+
+			// does this connect the two searches with a shorter path?
+			if(dists_dir[neighbouridx] + dists_other[neighbouridx] < best)
+			{
+				best = dists_dir[neighbouridx] + dists_other[neighbouridx];
+				meetidx = neighbouridx;
+			}
+		});
+	}
+
+	if(!(best < infinity))
+		return std::make_tuple(false, t_weight{}, std::vector<std::size_t>{});
+
+	// path from the start to the meeting vertex ...
+	std::vector<std::size_t> path{ meetidx };
+	while(path.back() != startidx)
+		path.push_back(*predecessors[0][path.back()]);
+	std::reverse(path.begin(), path.end());
+
+	// ... and from there to the end
+	while(path.back() != endidx)
+		path.push_back(*predecessors[1][path.back()]);
+
+	return std::make_tuple(true, best, path);
+}
+// ----------------------------------------------------------------------------
+
+
+/**
+ * is there a path from start to end?
+ */
+template<class t_edge = std::pair<std::size_t, std::size_t>>
+std::pair<bool, std::vector<t_edge>>
+does_path_exist(std::vector<std::optional<std::size_t>> predecessors,
+	std::size_t startidx, std::size_t endidx)
+{
+	std::vector<t_edge> edges;
+	edges.reserve(predecessors.size());
+	std::size_t curidx = endidx;
+
+	while(1)
+	{
+		if(predecessors.size() <= curidx)
+			return std::make_pair(false, edges);
+
+		auto predecessor = predecessors[curidx];
+		if(!predecessor)
+			return std::make_pair(false, edges);
+
+		edges.emplace_back(std::make_pair(*predecessor, curidx));
+
+		curidx = *predecessor;
+		if(curidx == startidx)
+		{
+			std::reverse(edges.begin(), edges.end());
+			return std::make_pair(true, edges);
+		}
+	}
+
+	return std::make_pair(false, edges);
+}
+
+
+/**
+ * bellman-ford algorithm for distance vectors
+ * @see (FUH 2021), Kurseinheit 4, p. 13
  */
 template<class t_graph, class t_mat=m::mat<typename t_graph::t_weight, std::vector>>
 requires is_graph<t_graph> && m::is_mat<t_mat>
-t_mat floyd(const t_graph& graph)
+t_mat bellman(const t_graph& graph, const std::string& startvert)
 {
+	// start index
+	auto _startidx = graph.GetVertexIndex(startvert);
+	if(!_startidx)
+		return t_mat{};
+	const std::size_t startidx = *_startidx;
+
+
 	// distances
 	const std::size_t N = graph.GetNumVertices();
 	using t_weight = typename t_graph::t_weight;
 	t_mat dists = m::zero<t_mat>(N, N);
-	t_mat next_dists = m::zero<t_mat>(N, N);
 
+	// don't use the full maximum to prevent overflows when we're adding the weight afterwards
+	const t_weight infinity = std::numeric_limits<t_weight>::max() / 2;
+
+	for(std::size_t vertidx=0; vertidx<N; ++vertidx)
+		dists(0, vertidx) = (vertidx==startidx ? 0 : infinity);
+
+
+	// iterate vertices
+	for(std::size_t i=1; i<N; ++i)
+	{
+		for(std::size_t vertidx=0; vertidx<N; ++vertidx)
+		{
+			dists(i, vertidx) = dists(i-1, vertidx);
+
+			for_each_neighbour(graph, vertidx, false, [&](std::size_t neighbouridx, t_weight w)
+			{
+				//std::cout << "Weight from " << neighbouridx << " to " << vertidx << ": " << w << std::endl;
+
+				if(dists(i-1, neighbouridx) + w < dists(i, vertidx))
+				{
+					dists(i, vertidx) = dists(i-1, neighbouridx) + w;
+				}
+			});
+		}
+	}
+
+	return dists;
+}
+
+
+/**
+ * bellman-ford algorithm only keeping the current distances
+ * stops as soon as a pass over all edges doesn't change any distance
+ * @returns [distances, predecessors, false if there's a negative cycle]
+ * @see (FUH 2021), Kurseinheit 4, p. 13
+ * @see https://en.wikipedia.org/wiki/Bellman%E2%80%93Ford_algorithm
+ */
+template<class t_graph> requires is_graph<t_graph>
+std::tuple<std::vector<typename t_graph::t_weight>, std::vector<std::optional<std::size_t>>, bool>
+bellman_dists(const t_graph& graph, std::size_t startidx)
+{
+	using t_weight = typename t_graph::t_weight;
+	const std::size_t N = graph.GetNumVertices();
+
+	// don't use the full maximum to prevent overflows when we're adding the weight afterwards
+	const t_weight infinity = std::numeric_limits<t_weight>::max() / 2;
+
+	std::vector<t_weight> dists(N, infinity);
+	std::vector<std::optional<std::size_t>> predecessors(N);
+	dists[startidx] = t_weight{};
+
+	// the distances are final after N-1 passes, a change in the N-th one means a negative cycle
+	for(std::size_t pass=0; pass<N; ++pass)
+	{
+		bool changed = false;
+
+		for(std::size_t vertidx=0; vertidx<N; ++vertidx)
+		{
+			if(dists[vertidx] == infinity)
+				continue;
+
+			for_each_neighbour(graph, vertidx, true, [&](std::size_t neighbouridx, t_weight w)
+			{
+				if(dists[vertidx] + w < dists[neighbouridx])
+				{
+					dists[neighbouridx] = dists[vertidx] + w;
+					predecessors[neighbouridx] = vertidx;
+					changed = true;
+				}
+			});
+		}
+
+		if(!changed)
+			return std::make_tuple(dists, predecessors, true);
+	}
+
+	return std::make_tuple(dists, predecessors, false);
+}
+
+
+/**
+ * relaxes the distances over the intermediate vertices [k0, k1) for the rows [i0, i1) and columns [j0, j1)
+ * of the row-major N x N distance matrix
+ */
+template<class t_weight>
+void floyd_block(t_weight* dists, std::size_t N,
+	std::size_t i0, std::size_t i1, std::size_t j0, std::size_t j1,
+	std::size_t k0, std::size_t k1)
+{
+	const std::size_t cols = j1 - j0;
+
+	for(std::size_t k=k0; k<k1; ++k)
+	{
+		const t_weight* row_k = dists + k*N + j0;
+
+		for(std::size_t i=i0; i<i1; ++i)
+		{
+			// without negative cycles, row k doesn't change over the intermediate vertex k
+			if(i == k)
+				continue;
+
+			t_weight* row_i = dists + i*N + j0;
+			const t_weight dist_ik = dists[i*N + k];
+
+			// the compiler vectorises this loop with -O3 or -ftree-vectorize
+			for(std::size_t j=0; j<cols; ++j)
+			{
+				const t_weight dist = dist_ik + row_k[j];
+				row_i[j] = dist < row_i[j] ? dist : row_i[j];
+			}
+		}
+	}
+}
+
+
+/**
+ * cache-blocked floyd-warshall algorithm on a row-major N x N distance matrix
+ * for each block of intermediate vertices, first the diagonal block is calculated,
+ * then the blocks in its row and column, and finally all remaining blocks in parallel
+ * @see (FUH 2021), Kurseinheit 4, p. 23
+ * @see https://doi.org/10.1145/1064092.1064117 for the blocking
+ */
+template<class t_weight>
+void floyd_flat(std::vector<t_weight>& dists, std::size_t N, std::size_t num_threads = 0,
+	std::size_t block = GRAPH_FLOYD_BLOCK)
+{
+	t_weight* data = dists.data();
+	const std::size_t num_blocks = (N + block - 1) / block;
+
+	// the threads work on whole blocks, so the threshold refers to the number of vertices
+	const std::size_t thread_threshold =
+		(GRAPH_FLOYD_THREAD_THRESHOLD && N >= GRAPH_FLOYD_THREAD_THRESHOLD) ? 1 : 0;
+
+	for(std::size_t kb=0; kb<num_blocks; ++kb)
+	{
+		const std::size_t k0 = kb*block, k1 = std::min(k0 + block, N);
+
+		// diagonal block
+		floyd_block(data, N, k0, k1, k0, k1, k0, k1);
+
+		// blocks in the same row and column as the diagonal one
+		graph_parallel(2*num_blocks, num_threads,
+			[data, N, block, kb, k0, k1](std::size_t, std::size_t begin, std::size_t end)
+		{
+			for(std::size_t task=begin; task<end; ++task)
+			{
+				const std::size_t b = task / 2;
+				if(b == kb)
+					continue;
+
+				const std::size_t b0 = b*block, b1 = std::min(b0 + block, N);
+				if(task % 2 == 0)
+					floyd_block(data, N, k0, k1, b0, b1, k0, k1);
+				else
+					floyd_block(data, N, b0, b1, k0, k1, k0, k1);
+			}
+		}, thread_threshold);
+
+		// remaining blocks, parallel over the block rows
+		graph_parallel(num_blocks, num_threads,
+			[data, N, block, num_blocks, kb, k0, k1](std::size_t, std::size_t begin, std::size_t end)
+		{
+			for(std::size_t ib=begin; ib<end; ++ib)
+			{
+				if(ib == kb)
+					continue;
+
+				const std::size_t i0 = ib*block, i1 = std::min(i0 + block, N);
+				for(std::size_t jb=0; jb<num_blocks; ++jb)
+				{
+					if(jb == kb)
+						continue;
+
+					const std::size_t j0 = jb*block, j1 = std::min(j0 + block, N);
+					floyd_block(data, N, i0, i1, j0, j1, k0, k1);
+				}
+			}
+		}, thread_threshold);
+	}
+}
+
+
+/**
+ * floyd-warshall algorithm for distance vectors
+ * @see (FUH 2021), Kurseinheit 4, p. 23
+ */
+template<class t_graph, class t_mat=m::mat<typename t_graph::t_weight, std::vector>>
+requires is_graph<t_graph> && m::is_mat<t_mat>
+t_mat floyd(const t_graph& graph, std::size_t num_threads = 0)
+{
+	// distances
+	const std::size_t N = graph.GetNumVertices();
+	using t_weight = typename t_graph::t_weight;
 
 	// don't use the full maximum to prevent overflows when we're adding the weight afterwards
 	const t_weight infinity = std::numeric_limits<t_weight>::max() / 2;
 
 	// initial weights
+	std::vector<t_weight> dists(N*N, infinity);
 	for(std::size_t vertidx1=0; vertidx1<N; ++vertidx1)
 	{
-		std::vector<std::size_t> neighbours = graph.GetNeighbours(vertidx1);
+		dists[vertidx1*N + vertidx1] = t_weight{};
+
+		// direct neighbours of vertidx1, using the smallest weight of parallel edges
+		for_each_neighbour(graph, vertidx1, true, [&](std::size_t vertidx2, t_weight w)
+		{
+			if(vertidx2 != vertidx1)
+				dists[vertidx1*N + vertidx2] = std::min(dists[vertidx1*N + vertidx2], w);
+		});
+	}
 
+	floyd_flat(dists, N, num_threads);
+
+	t_mat mat = m::zero<t_mat>(N, N);
+	for(std::size_t vertidx1=0; vertidx1<N; ++vertidx1)
 		for(std::size_t vertidx2=0; vertidx2<N; ++vertidx2)
+			mat(vertidx1, vertidx2) = dists[vertidx1*N + vertidx2];
+
+	return mat;
+}
+
+
+/**
+ * parallel delta-stepping algorithm for single-source shortest paths with non-negative weights
+ * the vertices are sorted into buckets of distance width delta, the vertices in the current bucket
+ * are relaxed in parallel, first repeatedly along the light edges (w <= delta), then once along the
+ * heavy ones. the threads only generate relaxation requests, which are then applied in order.
+ * the queued distances never span more than max_weight/delta + 2 buckets, so these are used cyclically;
+ * delta is enlarged if this would need more than GRAPH_DELTA_MAX_BUCKETS of them.
+ * @returns [distances, predecessors]
+ * @see https://doi.org/10.1016/S0196-6774(03)00076-2
+ */
+template<class t_graph> requires is_graph<t_graph>
+std::tuple<std::vector<typename t_graph::t_weight>, std::vector<std::optional<std::size_t>>>
+delta_stepping(const t_graph& graph, std::size_t startidx, typename t_graph::t_weight delta,
+	std::size_t num_threads = 0)
+{
+	using t_weight = typename t_graph::t_weight;
+	const std::size_t N = graph.GetNumVertices();
+
+	num_threads = m::hardware_threads(num_threads);
+
+	// the bucket indices are distances divided by delta, so use a width of 1 instead of zero
+	if(!(delta > t_weight{0}))
+		delta = t_weight{1};
+
+	t_weight max_weight{};
+	for(std::size_t vertidx=0; vertidx<N; ++vertidx)
+	{
+		for_each_neighbour(graph, vertidx, true, [&max_weight](std::size_t, t_weight w)
 		{
-			if(vertidx2 == vertidx1)
-				continue;
+			max_weight = std::max(max_weight, w);
+		});
+	}
 
-			// is vertidx2 a direct neighbour of vertidx1?
-			if(std::find(neighbours.begin(), neighbours.end(), vertidx2) != neighbours.end())
-				dists(vertidx1, vertidx2) = graph.GetWeight(vertidx1, vertidx2);
-			else
-				dists(vertidx1, vertidx2) = infinity;
-		}
+	constexpr std::size_t max_buckets = std::max<std::size_t>(GRAPH_DELTA_MAX_BUCKETS, 3);
+	if(max_weight / delta > t_weight(max_buckets - 2))
+	{
+		delta = max_weight / t_weight(max_buckets - 2);
+		if constexpr(std::is_integral_v<t_weight>)
+			++delta;
 	}
 
+	// while a bucket is processed, the queued distances lie between its start
+	// and its end plus the maximum weight, so the buckets can be reused cyclically
+	const std::size_t num_buckets = static_cast<std::size_t>(max_weight / delta) + 2;
 
-	// iterate vertices
-	for(std::size_t i=1; i<N; ++i)
+	// don't use the full maximum to prevent overflows when we're adding the weight afterwards
+	const t_weight infinity = std::numeric_limits<t_weight>::max() / 2;
+
+	std::vector<t_weight> dists(N, infinity);
+	std::vector<std::optional<std::size_t>> predecessors(N);
+	std::vector<std::vector<std::size_t>> buckets(num_buckets);
+
+	auto relax = [&dists, &predecessors, &buckets, delta, num_buckets](
+		std::size_t vertidx, t_weight dist, std::optional<std::size_t> predidx)
+	{
+		if(!(dist < dists[vertidx]))
+			return;
+
+		dists[vertidx] = dist;
+		predecessors[vertidx] = predidx;
+
+		const std::size_t bucket = static_cast<std::size_t>(dist / delta);
+		buckets[bucket % num_buckets].push_back(vertidx);
+	};
+
+	// relaxation requests [vertex, distance, predecessor] per thread
+	using t_request = std::tuple<std::size_t, t_weight, std::size_t>;
+	std::vector<std::vector<t_request>> requests(num_threads);
+
+	auto relax_edges = [&](const std::vector<std::size_t>& verts, bool light)
 	{
-		for(std::size_t vertidx1=0; vertidx1<N; ++vertidx1)
+		graph_parallel(verts.size(), num_threads,
+			[&graph, &verts, &dists, &requests, light, delta](std::size_t thread, std::size_t begin, std::size_t end)
 		{
-			for(std::size_t vertidx2=0; vertidx2<N; ++vertidx2)
+			std::vector<t_request>& thread_requests = requests[thread];
+			thread_requests.clear();
+
+			for(std::size_t i=begin; i<end; ++i)
 			{
-				t_weight dist1 = dists(vertidx1, vertidx2);
-				t_weight dist2 = dists(vertidx1, i) + dists(i, vertidx2);
+				const std::size_t vertidx = verts[i];
+				const t_weight dist = dists[vertidx];
 
-				next_dists(vertidx1, vertidx2) = std::min(dist1, dist2);
+				for_each_neighbour(graph, vertidx, true, [&](std::size_t neighbouridx, t_weight w)
+				{
+					if((w <= delta) == light && dist + w < dists[neighbouridx])
+						thread_requests.emplace_back(std::make_tuple(neighbouridx, dist + w, vertidx));
+				});
 			}
+		});
+
+		for(std::vector<t_request>& thread_requests : requests)
+		{
+			for(const auto& [vertidx, dist, predidx] : thread_requests)
+				relax(vertidx, dist, predidx);
+			thread_requests.clear();
+		}
+	};
+
+	relax(startidx, t_weight{}, std::nullopt);
+
+	// marks the vertices already in the current frontier or in the settled list
+	std::vector<bool> in_frontier(N, false), in_settled(N, false);
+	std::vector<std::size_t> frontier, settled;
+
+	// stop after a full cycle of empty buckets
+	for(std::size_t bucket=0, num_empty=0; num_empty<num_buckets; ++bucket)
+	{
+		std::vector<std::size_t>& bucket_verts = buckets[bucket % num_buckets];
+		if(bucket_verts.empty())
+		{
+			++num_empty;
+			continue;
 		}
 
-		std::swap(dists, next_dists);
+		num_empty = 0;
+		settled.clear();
+
+		while(!bucket_verts.empty())
+		{
+			// take the vertices which are still in this bucket, the others have moved to an earlier one
+			frontier.clear();
+			for(std::size_t vertidx : bucket_verts)
+			{
+				if(in_frontier[vertidx] || static_cast<std::size_t>(dists[vertidx] / delta) != bucket)
+					continue;
+
+				in_frontier[vertidx] = true;
+				frontier.push_back(vertidx);
+
+				if(!in_settled[vertidx])
+				{
+					in_settled[vertidx] = true;
+					settled.push_back(vertidx);
+				}
+			}
+			bucket_verts.clear();
+
+			for(std::size_t vertidx : frontier)
+				in_frontier[vertidx] = false;
+
+			// light edges can lead back into the current bucket
+			relax_edges(frontier, true);
+		}
+
+		// the distances in this bucket are final, heavy edges lead to later buckets
+		relax_edges(settled, false);
+		for(std::size_t vertidx : settled)
+			in_settled[vertidx] = false;
 	}
 
-	return dists;
+	return std::make_tuple(dists, predecessors);
 }
 
 
@@ -614,4 +1314,462 @@ t_graph flux_max(const t_graph& _graph, const std::string& startvert, const std:
 	return graph;
 }
 
+// ----------------------------------------------------------------------------
+// maximum flow on a flat edge array
+// ----------------------------------------------------------------------------
+/**
+ * residual network of a flux graph, stored as a flat edge array
+ * each edge is stored together with its reverse edge, and the edges of each vertex are contiguous,
+ * the residual capacities are updated in place by the max-flow algorithms
+ */
+template<class _t_weight = unsigned int>
+class flow_network
+{
+public:
+	using t_weight = _t_weight;
+	static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+
+public:
+	/**
+	 * build the network from the capacities of a flux graph, the current fluxes are ignored
+	 */
+	template<class t_graph> requires is_flux_graph<t_graph>
+	explicit flow_network(const t_graph& graph)
+		: m_num_vertices{graph.GetNumVertices()}
+	{
+		std::vector<std::tuple<std::size_t, std::size_t, t_weight>> edges;
+		for(const auto& [idx1, idx2, data] : graph.GetEdges())
+		{
+			const t_weight cap = std::get<1>(data);
+			if(idx1 != idx2 && cap > t_weight{})
+				edges.emplace_back(std::make_tuple(idx1, idx2, cap));
+		}
+
+		// every edge appears in the rows of both of its vertices
+		m_offs.assign(m_num_vertices + 1, 0);
+		for(const auto& [idx1, idx2, cap] : edges)
+		{
+			++m_offs[idx1 + 1];
+			++m_offs[idx2 + 1];
+		}
+		for(std::size_t idx=0; idx<m_num_vertices; ++idx)
+			m_offs[idx + 1] += m_offs[idx];
+
+		const std::size_t num_edges = m_offs.back();
+		m_to.resize(num_edges);
+		m_rev.resize(num_edges);
+		m_cap.resize(num_edges);
+		m_orig_cap.resize(num_edges);
+
+		std::vector<std::size_t> pos(m_offs.begin(), m_offs.end() - 1);
+		for(const auto& [idx1, idx2, cap] : edges)
+		{
+			const std::size_t edge = pos[idx1]++;
+			const std::size_t edge_rev = pos[idx2]++;
+
+			m_to[edge] = idx2;
+			m_rev[edge] = edge_rev;
+			m_cap[edge] = m_orig_cap[edge] = cap;
+
+			m_to[edge_rev] = idx1;
+			m_rev[edge_rev] = edge;
+			m_cap[edge_rev] = m_orig_cap[edge_rev] = t_weight{};
+		}
+	}
+
+
+	std::size_t GetNumVertices() const
+	{
+		return m_num_vertices;
+	}
+
+
+	/**
+	 * write the fluxes into the weights of the flux graph
+	 */
+	template<class t_graph> requires is_flux_graph<t_graph>
+	void ApplyFluxes(t_graph& graph) const
+	{
+		for(std::size_t idx1=0; idx1<m_num_vertices; ++idx1)
+		{
+			for(std::size_t edge=m_offs[idx1]; edge<m_offs[idx1 + 1]; ++edge)
+			{
+				if(m_orig_cap[edge] > t_weight{})
+					graph.SetWeight(idx1, m_to[edge], t_weight(m_orig_cap[edge] - m_cap[edge]));
+			}
+		}
+	}
+
+
+	/**
+	 * vertices which can be reached from the start vertex in the residual network,
+	 * after a max-flow algorithm, these form the source side of a minimum cut
+	 */
+	std::vector<bool> GetReachable(std::size_t startidx) const
+	{
+		std::vector<bool> reachable(m_num_vertices, false);
+		std::vector<std::size_t> stack{ startidx };
+		reachable[startidx] = true;
+
+		while(!stack.empty())
+		{
+			const std::size_t idx = stack.back();
+			stack.pop_back();
+
+			for(std::size_t edge=m_offs[idx]; edge<m_offs[idx + 1]; ++edge)
+			{
+				if(m_cap[edge] > t_weight{} && !reachable[m_to[edge]])
+				{
+					reachable[m_to[edge]] = true;
+					stack.push_back(m_to[edge]);
+				}
+			}
+		}
+
+		return reachable;
+	}
+
+
+	/**
+	 * dinic's algorithm: augments blocking flows in the level graph of a breadth-first search
+	 * @returns total flow
+	 * @see https://en.wikipedia.org/wiki/Dinic%27s_algorithm
+	 */
+	t_weight Dinic(std::size_t startidx, std::size_t endidx)
+	{
+		t_weight total{};
+		if(startidx == endidx)
+			return total;
+
+		std::vector<std::size_t> level(m_num_vertices), cur(m_num_vertices);
+		std::vector<std::size_t> queue, path;
+		queue.reserve(m_num_vertices);
+
+		while(true)
+		{
+			// level graph
+			std::fill(level.begin(), level.end(), npos);
+			level[startidx] = 0;
+			queue.clear();
+			queue.push_back(startidx);
+
+			for(std::size_t head=0; head<queue.size() && level[endidx]==npos; ++head)
+			{
+				const std::size_t idx = queue[head];
+				for(std::size_t edge=m_offs[idx]; edge<m_offs[idx + 1]; ++edge)
+				{
+					if(m_cap[edge] > t_weight{} && level[m_to[edge]] == npos)
+					{
+						level[m_to[edge]] = level[idx] + 1;
+						queue.push_back(m_to[edge]);
+					}
+				}
+			}
+
+			if(level[endidx] == npos)
+				break;
+
+			// blocking flow using depth-first searches, cur is the next edge to try for each vertex
+			std::copy(m_offs.begin(), m_offs.end() - 1, cur.begin());
+			path.clear();
+			std::size_t idx = startidx;
+
+			while(true)
+			{
+				if(idx == endidx)
+				{
+					t_weight flow = m_cap[path.front()];
+					for(std::size_t edge : path)
+						flow = std::min(flow, m_cap[edge]);
+
+					std::size_t first_saturated = path.size();
+					for(std::size_t i=0; i<path.size(); ++i)
+					{
+						m_cap[path[i]] -= flow;
+						m_cap[m_rev[path[i]]] += flow;
+
+						if(first_saturated == path.size() && m_cap[path[i]] == t_weight{})
+							first_saturated = i;
+					}
+					total += flow;
+
+					// continue from the tail of the first saturated edge
+					path.resize(first_saturated);
+					idx = path.empty() ? startidx : m_to[path.back()];
+					continue;
+				}
+
+				// advance
+				bool advanced = false;
+				for(; cur[idx]<m_offs[idx + 1]; ++cur[idx])
+				{
+					const std::size_t edge = cur[idx];
+					if(m_cap[edge] > t_weight{} && level[m_to[edge]] == level[idx] + 1)
+					{
+						path.push_back(edge);
+						idx = m_to[edge];
+						advanced = true;
+						break;
+					}
+				}
+				if(advanced)
+					continue;
+
+				// retreat from a dead end
+				if(idx == startidx)
+					break;
+
+				level[idx] = npos;
+				path.pop_back();
+				idx = path.empty() ? startidx : m_to[path.back()];
+				++cur[idx];
+			}
+		}
+
+		return total;
+	}
+
+
+	/**
+	 * highest-label push-relabel algorithm with the gap heuristic
+	 * the excess which can't reach the end vertex is pushed back to the start vertex,
+	 * so that the result is a valid flow
+	 * @returns total flow
+	 * @see https://en.wikipedia.org/wiki/Push%E2%80%93relabel_maximum_flow_algorithm
+	 */
+	t_weight PushRelabel(std::size_t startidx, std::size_t endidx)
+	{
+		const std::size_t N = m_num_vertices;
+		if(startidx == endidx)
+			return t_weight{};
+
+		std::vector<std::size_t> height(N, N), cur(m_offs.begin(), m_offs.end() - 1);
+		std::vector<t_weight> excess(N, t_weight{});
+
+		// number of vertices per height below N, for the gap heuristic
+		std::vector<std::size_t> count(N, 0);
+
+		// initial heights: distances to the end vertex in the residual network
+		std::vector<std::size_t> queue{ endidx };
+		height[endidx] = 0;
+		for(std::size_t head=0; head<queue.size(); ++head)
+		{
+			const std::size_t idx = queue[head];
+			for(std::size_t edge=m_offs[idx]; edge<m_offs[idx + 1]; ++edge)
+			{
+				const std::size_t other = m_to[edge];
+				if(other != startidx && height[other] == N && m_cap[m_rev[edge]] > t_weight{})
+				{
+					height[other] = height[idx] + 1;
+					queue.push_back(other);
+				}
+			}
+		}
+		height[startidx] = N;
+		for(std::size_t idx=0; idx<N; ++idx)
+		{
+			if(height[idx] < N)
+				++count[height[idx]];
+		}
+
+		// active vertices by height
+		std::vector<std::vector<std::size_t>> active(2*N + 1);
+		std::size_t highest = 0;
+
+		auto push = [&](std::size_t idx, std::size_t edge, t_weight flow)
+		{
+			const std::size_t other = m_to[edge];
+			m_cap[edge] -= flow;
+			m_cap[m_rev[edge]] += flow;
+			excess[idx] -= flow;
+
+			if(other != startidx && other != endidx && excess[other] == t_weight{})
+			{
+				active[height[other]].push_back(other);
+				highest = std::max(highest, height[other]);
+			}
+			excess[other] += flow;
+		};
+
+		// saturate the edges leaving the start vertex
+		for(std::size_t edge=m_offs[startidx]; edge<m_offs[startidx + 1]; ++edge)
+		{
+			if(m_cap[edge] > t_weight{})
+			{
+				excess[startidx] += m_cap[edge];
+				push(startidx, edge, m_cap[edge]);
+			}
+		}
+
+		auto relabel = [&](std::size_t idx)
+		{
+			const std::size_t old_height = height[idx];
+
+			std::size_t new_height = 2*N;
+			for(std::size_t edge=m_offs[idx]; edge<m_offs[idx + 1]; ++edge)
+			{
+				if(m_cap[edge] > t_weight{})
+					new_height = std::min(new_height, height[m_to[edge]] + 1);
+			}
+
+			if(old_height < N)
+				--count[old_height];
+
+			// gap: the vertices above the empty height can't reach the end vertex anymore
+			if(old_height < N && count[old_height] == 0)
+			{
+				for(std::size_t other=0; other<N; ++other)
+				{
+					if(other != startidx && height[other] > old_height && height[other] < N)
+					{
+						--count[height[other]];
+						height[other] = N + 1;
+						cur[other] = m_offs[other];
+					}
+				}
+
+				new_height = std::max(new_height, N + 1);
+			}
+
+			height[idx] = new_height;
+			cur[idx] = m_offs[idx];
+			if(new_height < N)
+				++count[new_height];
+		};
+
+		while(true)
+		{
+			while(highest > 0 && active[highest].empty())
+				--highest;
+			if(active[highest].empty())
+				break;
+
+			const std::size_t idx = active[highest].back();
+			active[highest].pop_back();
+
+			// the height has been raised by a gap in the meantime
+			if(height[idx] != highest)
+			{
+				active[height[idx]].push_back(idx);
+				highest = std::max(highest, height[idx]);
+				continue;
+			}
+
+			// discharge
+			while(excess[idx] > t_weight{})
+			{
+				if(cur[idx] == m_offs[idx + 1])
+				{
+					relabel(idx);
+					continue;
+				}
+
+				const std::size_t edge = cur[idx];
+				if(m_cap[edge] > t_weight{} && height[idx] == height[m_to[edge]] + 1)
+					push(idx, edge, std::min(excess[idx], m_cap[edge]));
+				else
+					++cur[idx];
+			}
+		}
+
+		return excess[endidx];
+	}
+
+
+private:
+	std::size_t m_num_vertices{};
+
+	// edges: offsets per vertex, end vertex, index of the reverse edge, residual and original capacities
+	std::vector<std::size_t> m_offs{};
+	std::vector<std::size_t> m_to{};
+	std::vector<std::size_t> m_rev{};
+	std::vector<t_weight> m_cap{};
+	std::vector<t_weight> m_orig_cap{};
+};
+
+
+/**
+ * max-flow algorithm working on the flat residual network
+ */
+enum class FluxAlgo
+{
+	DINIC,
+	PUSH_RELABEL,
+};
+
+
+/**
+ * flux maximum, updating the residual capacities in place
+ * @returns flux graph with the fluxes as weights
+ */
+template<class t_graph> requires is_flux_graph<t_graph>
+t_graph flux_max(const t_graph& _graph, const std::string& startvert, const std::string& endvert,
+	FluxAlgo algo)
+{
+	using t_weight = typename t_graph::t_weight;
+	t_graph graph = _graph;
+
+	auto startidx = graph.GetVertexIndex(startvert);
+	auto endidx = graph.GetVertexIndex(endvert);
+	if(!startidx || !endidx)
+		return graph;
+
+	for(const auto& edge : graph.GetEdges())
+		graph.SetWeight(std::get<0>(edge), std::get<1>(edge), t_weight{});
+
+	flow_network<t_weight> net(graph);
+	if(algo == FluxAlgo::PUSH_RELABEL)
+		net.PushRelabel(*startidx, *endidx);
+	else
+		net.Dinic(*startidx, *endidx);
+
+	net.ApplyFluxes(graph);
+	return graph;
+}
+
+
+/**
+ * minimum cut between two vertices, its capacity equals the maximum flux
+ * @returns [cut capacity, vertices on the start side, cut edges]
+ * @see https://en.wikipedia.org/wiki/Max-flow_min-cut_theorem
+ */
+template<class t_graph> requires is_flux_graph<t_graph>
+std::tuple<typename t_graph::t_weight, std::vector<std::size_t>, std::vector<std::pair<std::size_t, std::size_t>>>
+min_cut(const t_graph& graph, const std::string& startvert, const std::string& endvert,
+	FluxAlgo algo = FluxAlgo::DINIC)
+{
+	using t_weight = typename t_graph::t_weight;
+
+	auto startidx = graph.GetVertexIndex(startvert);
+	auto endidx = graph.GetVertexIndex(endvert);
+	if(!startidx || !endidx)
+		return std::make_tuple(t_weight{}, std::vector<std::size_t>{}, std::vector<std::pair<std::size_t, std::size_t>>{});
+
+	flow_network<t_weight> net(graph);
+	const t_weight flow = algo == FluxAlgo::PUSH_RELABEL
+		? net.PushRelabel(*startidx, *endidx)
+		: net.Dinic(*startidx, *endidx);
+
+	const std::vector<bool> reachable = net.GetReachable(*startidx);
+
+	std::vector<std::size_t> start_side;
+	for(std::size_t idx=0; idx<reachable.size(); ++idx)
+	{
+		if(reachable[idx])
+			start_side.push_back(idx);
+	}
+
+	std::vector<std::pair<std::size_t, std::size_t>> cut_edges;
+	for(const auto& [idx1, idx2, data] : graph.GetEdges())
+	{
+		if(reachable[idx1] && !reachable[idx2] && std::get<1>(data) > t_weight{})
+			cut_edges.emplace_back(std::make_pair(idx1, idx2));
+	}
+
+	return std::make_tuple(flow, start_side, cut_edges);
+}
+// ----------------------------------------------------------------------------
+
+
 #endif
@@ -124,6 +124,14 @@ int main()
 
 	std::cout << "\n--------------------------------------------------------------------------------" << std::endl;
 
+	{
+		std::cout << "\nusing csr graph" << std::endl;
+		using t_graph = csr_graph<unsigned int>;
+		tst<t_graph>();
+	}
+
+	std::cout << "\n--------------------------------------------------------------------------------" << std::endl;
+
 	{
 		std::cout << "\nflux graph" << std::endl;
 		using t_flux_graph = adjacency_matrix<std::pair<unsigned int, unsigned int>, unsigned int>;
@@ -13,9 +13,14 @@
 #define __GRAPH_CONTS_H__
 
 #include <string>
+#include <stdexcept>
 #include <vector>
+#include <span>
+#include <tuple>
 #include <memory>
 #include <optional>
+#include <algorithm>
+#include <unordered_map>
 #include <type_traits>
 
 #include "math_algos.h"
@@ -28,6 +33,90 @@ constexpr bool is_pair =
 	std::is_same_v<T, std::tuple<t_val, t_val>>;
 
 
+/**
+ * vertex identifiers with a hash index for the lookup of a vertex index by its name
+ * if several vertices have the same name, the first one is found
+ */
+class vertex_idents
+{
+public:
+	vertex_idents() = default;
+	~vertex_idents() = default;
+
+
+	std::size_t GetSize() const
+	{
+		return m_idents.size();
+	}
+
+
+	const std::string& GetIdent(std::size_t idx) const
+	{
+		return m_idents[idx];
+	}
+
+
+	std::optional<std::size_t> GetIndex(const std::string& id) const
+	{
+		auto iter = m_index.find(id);
+		if(iter == m_index.end())
+			return std::nullopt;
+
+		return iter->second;
+	}
+
+
+	void Reserve(std::size_t N)
+	{
+		m_idents.reserve(N);
+		m_index.reserve(N);
+	}
+
+
+	void Add(const std::string& id)
+	{
+		m_index.emplace(id, m_idents.size());
+		m_idents.push_back(id);
+	}
+
+
+	/**
+	 * remove a vertex and shift the indices of the following ones
+	 */
+	void Remove(std::size_t idx)
+	{
+		const std::string id = std::move(m_idents[idx]);
+		m_idents.erase(m_idents.begin() + idx);
+
+		auto iter = m_index.find(id);
+		const bool removed_indexed = iter != m_index.end() && iter->second == idx;
+		if(removed_indexed)
+			m_index.erase(iter);
+
+		for(std::size_t idxOther=idx; idxOther<m_idents.size(); ++idxOther)
+		{
+			auto iterOther = m_index.find(m_idents[idxOther]);
+			if(iterOther != m_index.end() && iterOther->second == idxOther + 1)
+				iterOther->second = idxOther;
+		}
+
+		// another vertex with the same name is now the first one
+		if(removed_indexed)
+		{
+			auto iterSame = std::find(m_idents.begin() + idx, m_idents.end(), id);
+			if(iterSame != m_idents.end())
+				m_index.emplace(id, iterSame - m_idents.begin());
+		}
+	}
+
+
+private:
+	std::vector<std::string> m_idents{};
+	std::unordered_map<std::string, std::size_t> m_index{};
+};
+
+
+
 /**
  * adjacency matrix
  * @see (FUH 2021), Kurseinheit 4, pp. 3-5
@@ -49,50 +138,78 @@ public:
 
 	std::size_t GetNumVertices() const
 	{
-		return m_mat.size1();
+		return m_vertexidents.GetSize();
 	}
 
 
 	const std::string& GetVertexIdent(std::size_t i) const
 	{
-		return m_vertexidents[i];
+		return m_vertexidents.GetIdent(i);
 	}
 
 
 	std::optional<std::size_t> GetVertexIndex(const std::string& vert) const
 	{
-		auto iter = std::find(m_vertexidents.begin(), m_vertexidents.end(), vert);
-		if(iter == m_vertexidents.end())
-			return std::nullopt;
-
-		return iter - m_vertexidents.begin();
+		return m_vertexidents.GetIndex(vert);
 	}
 
 
-	void AddVertex(const std::string& id)
+	/**
+	 * the matrix has room for more vertices than are in use, its capacity is doubled when it is full
+	 */
+	void Reserve(std::size_t N)
 	{
-		t_mat matNew = m::zero<t_mat>(m_mat.size1()+1, m_mat.size2()+1);
+		if(N <= m_mat.size1())
+			return;
+
+		t_mat matNew = m::zero<t_mat>(N, N);
 
-		for(std::size_t i=0; i<m_mat.size1(); ++i)
-			for(std::size_t j=0; j<m_mat.size2(); ++j)
+		const std::size_t num_verts = GetNumVertices();
+		for(std::size_t i=0; i<num_verts; ++i)
+			for(std::size_t j=0; j<num_verts; ++j)
 				matNew(i,j) = m_mat(i,j);
 
 		m_mat = std::move(matNew);
-		m_vertexidents.push_back(id);
+		m_vertexidents.Reserve(N);
+	}
+
+
+	void AddVertex(const std::string& id)
+	{
+		const std::size_t num_verts = GetNumVertices();
+		if(num_verts >= m_mat.size1())
+			Reserve(std::max<std::size_t>(2*num_verts, 4));
+
+		m_vertexidents.Add(id);
 	}
 
 
 	void RemoveVertex(std::size_t idx)
 	{
-		m_mat = m::submat<t_mat>(m_mat, idx, idx);
-		m_vertexidents.erase(m_vertexidents.begin() + idx);
+		const std::size_t num_verts = GetNumVertices();
+
+		// move the following rows and columns, the unused part of the matrix stays zero
+		for(std::size_t i=0; i<num_verts; ++i)
+		{
+			for(std::size_t j=0; j<num_verts; ++j)
+			{
+				if(i < idx && j < idx)
+					continue;
+
+				const std::size_t iOld = i < idx ? i : i+1;
+				const std::size_t jOld = j < idx ? j : j+1;
+				m_mat(i,j) = (iOld < num_verts && jOld < num_verts) ? m_mat(iOld, jOld) : t_data{};
+			}
+		}
+
+		m_vertexidents.Remove(idx);
 	}
 
 
 	void RemoveVertex(const std::string& id)
 	{
-		std::size_t idx = GetVertexIndex(id);
-		RemoveVertex(idx);
+		if(auto idx = GetVertexIndex(id))
+			RemoveVertex(*idx);
 	}
 
 
@@ -215,11 +332,11 @@ public:
 	std::vector<std::tuple<std::size_t, std::size_t, t_data>> GetEdges() const
 	{
 		std::vector<std::tuple<std::size_t, std::size_t, t_data>> edges;
-		edges.reserve(m_mat.size1() * m_mat.size2());
+		edges.reserve(GetNumVertices());
 
-		for(std::size_t i=0; i<m_mat.size1(); ++i)
+		for(std::size_t i=0; i<GetNumVertices(); ++i)
 		{
-			for(std::size_t j=0; j<m_mat.size2(); ++j)
+			for(std::size_t j=0; j<GetNumVertices(); ++j)
 			{
 				// include edges which have a capacity
 				if constexpr(is_pair<t_data, t_weight>)
@@ -269,7 +386,7 @@ public:
 		// neighbour vertices on outgoing edges
 		if(outgoing_edges)
 		{
-			for(std::size_t idxOther=0; idxOther<m_mat.size2(); ++idxOther)
+			for(std::size_t idxOther=0; idxOther<GetNumVertices(); ++idxOther)
 			{
 				// TODO: weight == 0 should not be the same as having no edge
 				if(GetWeight(idx, idxOther))
@@ -280,7 +397,7 @@ public:
 		// neighbour vertices on incoming edges
 		else
 		{
-			for(std::size_t idxOther=0; idxOther<m_mat.size1(); ++idxOther)
+			for(std::size_t idxOther=0; idxOther<GetNumVertices(); ++idxOther)
 			{
 				// TODO: weight == 0 should not be the same as having no edge
 				if(GetWeight(idxOther, idx))
@@ -294,32 +411,32 @@ public:
 
 	std::vector<std::string> GetNeighbours(const std::string& vert, bool outgoing_edges=true) const
 	{
-		auto iter = std::find(m_vertexidents.begin(), m_vertexidents.end(), vert);
-		if(iter == m_vertexidents.end())
+		auto _idx = GetVertexIndex(vert);
+		if(!_idx)
 			return {};
-		std::size_t idx = iter - m_vertexidents.begin();
+		const std::size_t idx = *_idx;
 
 		std::vector<std::string> neighbours;
 
 		// neighbour vertices on outgoing edges
 		if(outgoing_edges)
 		{
-			for(std::size_t idxOther=0; idxOther<m_mat.size2(); ++idxOther)
+			for(std::size_t idxOther=0; idxOther<GetNumVertices(); ++idxOther)
 			{
 				// TODO: weight == 0 should not be the same as having no edge
 				if(GetWeight(idx, idxOther))
-					neighbours.push_back(m_vertexidents[idxOther]);
+					neighbours.push_back(GetVertexIdent(idxOther));
 			}
 		}
 
 		// neighbour vertices on incoming edges
 		else
 		{
-			for(std::size_t idxOther=0; idxOther<m_mat.size1(); ++idxOther)
+			for(std::size_t idxOther=0; idxOther<GetNumVertices(); ++idxOther)
 			{
 				// TODO: weight == 0 should not be the same as having no edge
 				if(GetWeight(idxOther, idx))
-					neighbours.push_back(m_vertexidents[idxOther]);
+					neighbours.push_back(GetVertexIdent(idxOther));
 			}
 		}
 
@@ -328,7 +445,9 @@ public:
 
 
 private:
-	std::vector<std::string> m_vertexidents{};
+	vertex_idents m_vertexidents{};
+
+	// weights, only the upper left GetNumVertices() x GetNumVertices() part is used
 	t_mat m_mat{};
 };
 
@@ -353,36 +472,32 @@ public:
 
 	std::size_t GetNumVertices() const
 	{
-		return m_vertexidents.size();
+		return m_vertexidents.GetSize();
 	}
 
 
 	const std::string& GetVertexIdent(std::size_t i) const
 	{
-		return m_vertexidents[i];
+		return m_vertexidents.GetIdent(i);
 	}
 
 
 	std::optional<std::size_t> GetVertexIndex(const std::string& vert) const
 	{
-		auto iter = std::find(m_vertexidents.begin(), m_vertexidents.end(), vert);
-		if(iter == m_vertexidents.end())
-			return std::nullopt;
-
-		return iter - m_vertexidents.begin();
+		return m_vertexidents.GetIndex(vert);
 	}
 
 
 	void AddVertex(const std::string& id)
 	{
-		m_vertexidents.push_back(id);
+		m_vertexidents.Add(id);
 		m_nodes.push_back(nullptr);
 	}
 
 
 	void RemoveVertex(std::size_t idx)
 	{
-		m_vertexidents.erase(m_vertexidents.begin() + idx);
+		m_vertexidents.Remove(idx);
 		m_nodes.erase(m_nodes.begin() + idx);
 
 		for(std::size_t idx1=0; idx1<m_nodes.size(); ++idx1)
@@ -392,15 +507,22 @@ public:
 
 			while(node)
 			{
+				// remove the edges to the vertex
 				if(node->idx == idx)
 				{
 					if(node_prev)
 						node_prev->next = node->next;
 					else
 						m_nodes[idx1] = node->next;
-					break;
+
+					node = node->next;
+					continue;
 				}
 
+				// shift the indices of the following vertices
+				if(node->idx > idx)
+					--node->idx;
+
 				node_prev = node;
 				node = node->next;
 			}
@@ -410,8 +532,8 @@ public:
 
 	void RemoveVertex(const std::string& id)
 	{
-		std::size_t idx = GetVertexIndex(id);
-		RemoveVertex(idx);
+		if(auto idx = GetVertexIndex(id))
+			RemoveVertex(*idx);
 	}
 
 
@@ -605,9 +727,424 @@ private:
 		std::shared_ptr<AdjNode> next{};
 	};
 
-	std::vector<std::string> m_vertexidents{};
+	vertex_idents m_vertexidents{};
 	std::vector<std::shared_ptr<AdjNode>> m_nodes{};
 };
 
 
+
+/**
+ * immutable graph in compressed sparse row (CSR) format
+ * the outgoing and the incoming edges of each vertex are stored contiguously in
+ * offset, vertex index and weight arrays, which allows traversing the neighbours
+ * via spans without allocations and looking up weights by binary search
+ *
+ * the graph is meant to be built once from an edge list or from another container,
+ * AddVertex() is cheap, but AddEdge() and RemoveEdge() have to move the following edges
+ *
+ * @see https://en.wikipedia.org/wiki/Sparse_matrix#Compressed_sparse_row_(CSR,_CRS_or_Yale_format)
+ */
+template<class _t_weight = unsigned int>
+class csr_graph
+{
+public:
+	using t_weight = _t_weight;
+	using t_edge = std::tuple<std::size_t, std::size_t, t_weight>;
+
+
+public:
+	csr_graph() = default;
+	~csr_graph() = default;
+
+	csr_graph(const csr_graph<t_weight>& other) = default;
+	csr_graph(csr_graph<t_weight>&& other) noexcept = default;
+	csr_graph<t_weight>& operator=(const csr_graph<t_weight>& other) = default;
+	csr_graph<t_weight>& operator=(csr_graph<t_weight>&& other) noexcept = default;
+
+
+	/**
+	 * build the graph from a list of [start index, end index, weight] edges
+	 * @throws std::out_of_range if an edge refers to a non-existing vertex
+	 */
+	csr_graph(const std::vector<std::string>& vertexidents, const std::vector<t_edge>& edges)
+	{
+		m_vertexidents.Reserve(vertexidents.size());
+		for(const std::string& id : vertexidents)
+			m_vertexidents.Add(id);
+
+		Build(edges);
+	}
+
+
+	/**
+	 * build the graph from a list of [start index, end index, weight] edges,
+	 * the vertices are named by their indices
+	 * @throws std::out_of_range if an edge refers to a non-existing vertex
+	 */
+	csr_graph(std::size_t num_vertices, const std::vector<t_edge>& edges)
+	{
+		m_vertexidents.Reserve(num_vertices);
+		for(std::size_t idx=0; idx<num_vertices; ++idx)
+			m_vertexidents.Add(std::to_string(idx));
+
+		Build(edges);
+	}
+
+
+	/**
+	 * build the graph from another graph container, e.g. adjacency_matrix or adjacency_list
+	 */
+	template<class t_graph>
+	explicit csr_graph(const t_graph& graph)
+	requires requires(const t_graph& g) { g.GetNeighbours(std::size_t{}, true); g.GetWeight(std::size_t{}, std::size_t{}); }
+	{
+		const std::size_t N = graph.GetNumVertices();
+		m_vertexidents.Reserve(N);
+
+		std::vector<t_edge> edges;
+		for(std::size_t idx1=0; idx1<N; ++idx1)
+		{
+			m_vertexidents.Add(graph.GetVertexIdent(idx1));
+
+			std::vector<std::size_t> neighbours = graph.GetNeighbours(idx1, true);
+			std::sort(neighbours.begin(), neighbours.end());
+			neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+
+			for(std::size_t idx2 : neighbours)
+				edges.emplace_back(std::make_tuple(idx1, idx2, t_weight(graph.GetWeight(idx1, idx2))));
+		}
+
+		Build(edges);
+	}
+
+
+	std::size_t GetNumVertices() const
+	{
+		return m_vertexidents.GetSize();
+	}
+
+
+	std::size_t GetNumEdges() const
+	{
+		return m_out_idx.size();
+	}
+
+
+	const std::string& GetVertexIdent(std::size_t i) const
+	{
+		return m_vertexidents.GetIdent(i);
+	}
+
+
+	std::optional<std::size_t> GetVertexIndex(const std::string& vert) const
+	{
+		return m_vertexidents.GetIndex(vert);
+	}
+
+
+	/**
+	 * add a new vertex without edges
+	 */
+	void AddVertex(const std::string& id)
+	{
+		m_vertexidents.Add(id);
+		m_out_offs.push_back(m_out_offs.back());
+		m_in_offs.push_back(m_in_offs.back());
+	}
+
+
+	/**
+	 * set the weight of an existing edge
+	 */
+	void SetWeight(std::size_t idx1, std::size_t idx2, t_weight w)
+	{
+		if(auto edge = FindEdge(m_out_offs, m_out_idx, idx1, idx2))
+			m_out_weights[*edge] = w;
+		if(auto edge = FindEdge(m_in_offs, m_in_idx, idx2, idx1))
+			m_in_weights[*edge] = w;
+	}
+
+
+	void SetWeight(const std::string& vert1, const std::string& vert2, t_weight w)
+	{
+		auto idx1 = GetVertexIndex(vert1);
+		auto idx2 = GetVertexIndex(vert2);
+
+		if(idx1 && idx2)
+			SetWeight(*idx1, *idx2, w);
+	}
+
+
+	t_weight GetWeight(std::size_t idx1, std::size_t idx2) const
+	{
+		if(auto edge = FindEdge(m_out_offs, m_out_idx, idx1, idx2))
+			return m_out_weights[*edge];
+
+		return t_weight{};
+	}
+
+
+	t_weight GetWeight(const std::string& vert1, const std::string& vert2) const
+	{
+		auto idx1 = GetVertexIndex(vert1);
+		auto idx2 = GetVertexIndex(vert2);
+
+		if(idx1 && idx2)
+			return GetWeight(*idx1, *idx2);
+
+		return t_weight{};
+	}
+
+
+	/**
+	 * insert an edge, this has to move all following edges
+	 */
+	void AddEdge(std::size_t idx1, std::size_t idx2, t_weight w = t_weight{})
+	{
+		InsertEdge(m_out_offs, m_out_idx, m_out_weights, idx1, idx2, w);
+		InsertEdge(m_in_offs, m_in_idx, m_in_weights, idx2, idx1, w);
+	}
+
+
+	void AddEdge(const std::string& vert1, const std::string& vert2, t_weight w = t_weight{})
+	{
+		auto idx1 = GetVertexIndex(vert1);
+		auto idx2 = GetVertexIndex(vert2);
+		if(!idx1 || !idx2)
+			return;
+
+		AddEdge(*idx1, *idx2, w);
+	}
+
+
+	/**
+	 * remove an edge, this has to move all following edges
+	 */
+	void RemoveEdge(std::size_t idx1, std::size_t idx2)
+	{
+		EraseEdge(m_out_offs, m_out_idx, m_out_weights, idx1, idx2);
+		EraseEdge(m_in_offs, m_in_idx, m_in_weights, idx2, idx1);
+	}
+
+
+	void RemoveEdge(const std::string& vert1, const std::string& vert2)
+	{
+		auto idx1 = GetVertexIndex(vert1);
+		auto idx2 = GetVertexIndex(vert2);
+		if(!idx1 || !idx2)
+			return;
+
+		RemoveEdge(*idx1, *idx2);
+	}
+
+
+	std::vector<t_edge> GetEdges() const
+	{
+		std::vector<t_edge> edges;
+		edges.reserve(GetNumEdges());
+
+		for(std::size_t idx1=0; idx1<GetNumVertices(); ++idx1)
+			for(std::size_t edge=m_out_offs[idx1]; edge<m_out_offs[idx1+1]; ++edge)
+				edges.emplace_back(std::make_tuple(idx1, m_out_idx[edge], m_out_weights[edge]));
+
+		return edges;
+	}
+
+
+	bool IsAdjacent(std::size_t idx1, std::size_t idx2) const
+	{
+		return FindEdge(m_out_offs, m_out_idx, idx1, idx2).has_value();
+	}
+
+
+	bool IsAdjacent(const std::string& vert1, const std::string& vert2) const
+	{
+		auto idx1 = GetVertexIndex(vert1);
+		auto idx2 = GetVertexIndex(vert2);
+		if(!idx1 || !idx2)
+			return false;
+
+		return IsAdjacent(*idx1, *idx2);
+	}
+
+
+	/**
+	 * indices of the neighbour vertices on outgoing (or incoming) edges, sorted by index
+	 */
+	std::span<const std::size_t> GetNeighbourSpan(std::size_t idx, bool outgoing_edges=true) const
+	{
+		if(outgoing_edges)
+			return std::span<const std::size_t>(m_out_idx.data() + m_out_offs[idx], m_out_offs[idx+1] - m_out_offs[idx]);
+		else
+			return std::span<const std::size_t>(m_in_idx.data() + m_in_offs[idx], m_in_offs[idx+1] - m_in_offs[idx]);
+	}
+
+
+	/**
+	 * weights of the outgoing (or incoming) edges, in the order of GetNeighbourSpan()
+	 */
+	std::span<const t_weight> GetWeightSpan(std::size_t idx, bool outgoing_edges=true) const
+	{
+		if(outgoing_edges)
+			return std::span<const t_weight>(m_out_weights.data() + m_out_offs[idx], m_out_offs[idx+1] - m_out_offs[idx]);
+		else
+			return std::span<const t_weight>(m_in_weights.data() + m_in_offs[idx], m_in_offs[idx+1] - m_in_offs[idx]);
+	}
+
+
+	std::vector<std::size_t> GetNeighbours(std::size_t idx, bool outgoing_edges=true) const
+	{
+		std::span<const std::size_t> neighbours = GetNeighbourSpan(idx, outgoing_edges);
+		return std::vector<std::size_t>(neighbours.begin(), neighbours.end());
+	}
+
+
+	std::vector<std::string> GetNeighbours(const std::string& vert, bool outgoing_edges=true) const
+	{
+		auto idx = GetVertexIndex(vert);
+		if(!idx)
+			return {};
+
+		std::vector<std::string> neighbours;
+		for(std::size_t neighbour_index : GetNeighbourSpan(*idx, outgoing_edges))
+			neighbours.push_back(GetVertexIdent(neighbour_index));
+
+		return neighbours;
+	}
+
+
+protected:
+	/**
+	 * build the outgoing and the incoming arrays using a counting sort of the edges
+	 * @throws std::out_of_range if an edge refers to a non-existing vertex
+	 */
+	void Build(const std::vector<t_edge>& edges)
+	{
+		const std::size_t N = GetNumVertices();
+		const std::size_t E = edges.size();
+
+		for(const auto& [idx1, idx2, w] : edges)
+		{
+			if(idx1 >= N || idx2 >= N)
+				throw std::out_of_range("csr_graph: edge vertex index out of range.");
+		}
+
+		m_out_offs.assign(N + 1, 0);
+		m_in_offs.assign(N + 1, 0);
+		for(const auto& [idx1, idx2, w] : edges)
+		{
+			++m_out_offs[idx1 + 1];
+			++m_in_offs[idx2 + 1];
+		}
+		for(std::size_t idx=0; idx<N; ++idx)
+		{
+			m_out_offs[idx + 1] += m_out_offs[idx];
+			m_in_offs[idx + 1] += m_in_offs[idx];
+		}
+
+		// outgoing edges, sorted by end vertex within each row
+		m_out_idx.resize(E);
+		m_out_weights.resize(E);
+		std::vector<std::size_t> pos(m_out_offs.begin(), m_out_offs.end() - 1);
+		for(const auto& [idx1, idx2, w] : edges)
+		{
+			const std::size_t edge = pos[idx1]++;
+			m_out_idx[edge] = idx2;
+			m_out_weights[edge] = w;
+		}
+
+		std::vector<std::pair<std::size_t, t_weight>> row;
+		for(std::size_t idx=0; idx<N; ++idx)
+		{
+			const std::size_t begin = m_out_offs[idx], end = m_out_offs[idx + 1];
+			if(std::is_sorted(m_out_idx.begin() + begin, m_out_idx.begin() + end))
+				continue;
+
+			row.clear();
+			for(std::size_t edge=begin; edge<end; ++edge)
+				row.emplace_back(std::make_pair(m_out_idx[edge], m_out_weights[edge]));
+			std::stable_sort(row.begin(), row.end(), [](const auto& a, const auto& b) -> bool
+			{
+				return a.first < b.first;
+			});
+			for(std::size_t edge=begin; edge<end; ++edge)
+				std::tie(m_out_idx[edge], m_out_weights[edge]) = row[edge - begin];
+		}
+
+		// incoming edges, traversing the sorted outgoing edges keeps the start vertices sorted
+		m_in_idx.resize(E);
+		m_in_weights.resize(E);
+		pos.assign(m_in_offs.begin(), m_in_offs.end() - 1);
+		for(std::size_t idx1=0; idx1<N; ++idx1)
+		{
+			for(std::size_t edge=m_out_offs[idx1]; edge<m_out_offs[idx1 + 1]; ++edge)
+			{
+				const std::size_t edge_in = pos[m_out_idx[edge]]++;
+				m_in_idx[edge_in] = idx1;
+				m_in_weights[edge_in] = m_out_weights[edge];
+			}
+		}
+	}
+
+
+	/**
+	 * binary search for the edge idx1 -> idx2 in the row of idx1
+	 */
+	static std::optional<std::size_t> FindEdge(
+		const std::vector<std::size_t>& offs, const std::vector<std::size_t>& indices,
+		std::size_t idx1, std::size_t idx2)
+	{
+		auto begin = indices.begin() + offs[idx1];
+		auto end = indices.begin() + offs[idx1 + 1];
+
+		auto iter = std::lower_bound(begin, end, idx2);
+		if(iter == end || *iter != idx2)
+			return std::nullopt;
+
+		return iter - indices.begin();
+	}
+
+
+	static void InsertEdge(std::vector<std::size_t>& offs, std::vector<std::size_t>& indices,
+		std::vector<t_weight>& weights, std::size_t idx1, std::size_t idx2, t_weight w)
+	{
+		auto iter = std::upper_bound(indices.begin() + offs[idx1], indices.begin() + offs[idx1 + 1], idx2);
+		const std::size_t edge = iter - indices.begin();
+
+		indices.insert(iter, idx2);
+		weights.insert(weights.begin() + edge, w);
+		for(std::size_t idx=idx1+1; idx<offs.size(); ++idx)
+			++offs[idx];
+	}
+
+
+	static void EraseEdge(std::vector<std::size_t>& offs, std::vector<std::size_t>& indices,
+		std::vector<t_weight>& weights, std::size_t idx1, std::size_t idx2)
+	{
+		auto edge = FindEdge(offs, indices, idx1, idx2);
+		if(!edge)
+			return;
+
+		indices.erase(indices.begin() + *edge);
+		weights.erase(weights.begin() + *edge);
+		for(std::size_t idx=idx1+1; idx<offs.size(); ++idx)
+			--offs[idx];
+	}
+
+
+private:
+	vertex_idents m_vertexidents{};
+
+	// outgoing edges: offsets per vertex, end vertex indices and weights
+	std::vector<std::size_t> m_out_offs{0};
+	std::vector<std::size_t> m_out_idx{};
+	std::vector<t_weight> m_out_weights{};
+
+	// incoming edges: offsets per vertex, start vertex indices and weights
+	std::vector<std::size_t> m_in_offs{0};
+	std::vector<std::size_t> m_in_idx{};
+	std::vector<t_weight> m_in_weights{};
+};
+
+
 #endif
@@ -0,0 +1,116 @@
+/**
+ * tests the vertex name index of the graph containers and benchmarks building graphs by vertex names
+ * @author Tobias Weber
+ * @date oct-2026
+ * @license see 'LICENSE.EUPL' file
+ *
+ * g++ -std=c++20 -Wall -Wextra -Weffc++ -O2 -o graph_conts_tst graph_conts_tst.cpp
+ */
+
+#include "graph_conts.h"
+#include "tst_helpers.h"
+
+#include <iostream>
+#include <random>
+#include <chrono>
+
+
+using t_weight = unsigned int;
+
+
+/**
+ * adds and removes vertices and checks the names, indices and edges
+ */
+template<class t_graph>
+bool check_vertices()
+{
+	t_graph graph;
+	for(const char* id : { "A", "B", "C", "D", "E" })
+		graph.AddVertex(id);
+
+	graph.AddEdge("A", "B", 1);
+	graph.AddEdge("B", "D", 2);
+	graph.AddEdge("D", "E", 3);
+	graph.AddEdge("E", "C", 4);
+	graph.AddEdge("C", "A", 5);
+
+	bool ok = graph.GetNumVertices() == 5 && *graph.GetVertexIndex("D") == 3
+		&& !graph.GetVertexIndex("X") && graph.GetWeight("D", "E") == 3;
+
+	graph.RemoveVertex("B");
+	ok = ok && graph.GetNumVertices() == 4 && !graph.GetVertexIndex("B");
+	ok = ok && *graph.GetVertexIndex("A") == 0 && *graph.GetVertexIndex("C") == 1
+		&& *graph.GetVertexIndex("D") == 2 && *graph.GetVertexIndex("E") == 3;
+	ok = ok && graph.GetWeight("D", "E") == 3 && graph.GetWeight("E", "C") == 4
+		&& graph.GetWeight("C", "A") == 5 && !graph.IsAdjacent("A", "D");
+	ok = ok && graph.GetNeighbours("E") == std::vector<std::string>{ "C" };
+
+	// a new vertex must not have any edges
+	graph.AddVertex("F");
+	ok = ok && *graph.GetVertexIndex("F") == 4 && graph.GetNeighbours("F").empty()
+		&& graph.GetNeighbours("F", false).empty();
+
+	// with duplicate names the first vertex is found
+	graph.AddVertex("A");
+	ok = ok && *graph.GetVertexIndex("A") == 0;
+	graph.RemoveVertex(0);
+	ok = ok && *graph.GetVertexIndex("A") == 4 && *graph.GetVertexIndex("F") == 3;
+
+	return ok;
+}
+
+
+/**
+ * builds a graph with the given number of vertices by names
+ */
+template<class t_graph>
+double build_graph(std::size_t num_verts, std::size_t num_edges, std::mt19937& rnd, bool& ok)
+{
+	std::uniform_int_distribution<std::size_t> dist_vert(0, num_verts - 1);
+	std::vector<std::string> names;
+	for(std::size_t i=0; i<num_verts; ++i)
+		names.emplace_back("vert_" + std::to_string(i));
+
+	auto start = std::chrono::steady_clock::now();
+
+	t_graph graph;
+	for(const std::string& name : names)
+		graph.AddVertex(name);
+	for(std::size_t i=0; i<num_edges; ++i)
+		graph.AddEdge(names[dist_vert(rnd)], names[dist_vert(rnd)], t_weight(i + 1));
+
+	double time = seconds_since(start);
+
+	ok = graph.GetNumVertices() == num_verts;
+	for(std::size_t i=0; i<num_verts; i+=97)
+		ok = ok && *graph.GetVertexIndex(names[i]) == i && graph.GetVertexIdent(i) == names[i];
+
+	return time;
+}
+
+
+int main()
+{
+	std::mt19937 rnd{1234};
+	std::cout << std::boolalpha;
+
+	std::cout << "adjacency matrix: ok = " << check_vertices<adjacency_matrix<t_weight>>() << std::endl;
+	std::cout << "adjacency list: ok = " << check_vertices<adjacency_list<t_weight>>() << std::endl;
+
+	// benchmark
+	{
+		bool ok_list = false, ok_mat = false;
+
+		const std::size_t num_verts_list = 200000;
+		double time_list = build_graph<adjacency_list<t_weight>>(num_verts_list, 4*num_verts_list, rnd, ok_list);
+		std::cout << "adjacency list, " << num_verts_list << " vertices: "
+			<< time_list << " s, ok = " << ok_list << std::endl;
+
+		const std::size_t num_verts_mat = 4000;
+		double time_mat = build_graph<adjacency_matrix<t_weight>>(num_verts_mat, 4*num_verts_mat, rnd, ok_mat);
+		std::cout << "adjacency matrix, " << num_verts_mat << " vertices: "
+			<< time_mat << " s, ok = " << ok_mat << std::endl;
+	}
+
+	return 0;
+}
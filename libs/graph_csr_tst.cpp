@@ -0,0 +1,182 @@
+/**
+ * compares the csr graph with the adjacency list on random graphs
+ * @author Tobias Weber
+ * @date oct-2026
+ * @license see 'LICENSE.EUPL' file
+ *
+ * g++ -std=c++20 -Wall -Wextra -Weffc++ -O2 -o graph_csr_tst graph_csr_tst.cpp
+ */
+
+#include "graph_conts.h"
+#include "graph_algos.h"
+#include "tst_helpers.h"
+
+#include <random>
+#include <stdexcept>
+#include <chrono>
+
+
+using t_weight = unsigned int;
+using t_edges = std::vector<std::tuple<std::size_t, std::size_t, t_weight>>;
+
+
+/**
+ * the adjacency list only keeps the weight of the most recently added one of duplicate edges
+ */
+adjacency_list<t_weight> make_adjacency_list(std::size_t num_verts, const t_edges& edges)
+{
+	adjacency_list<t_weight> graph;
+	for(std::size_t i=0; i<num_verts; ++i)
+		graph.AddVertex(std::to_string(i));
+	for(const auto& [idx1, idx2, w] : edges)
+		graph.AddEdge(idx1, idx2, w);
+
+	return graph;
+}
+
+
+/**
+ * sum of all edge weights via the outgoing neighbours
+ */
+template<class t_graph>
+std::size_t sum_weights(const t_graph& graph)
+{
+	std::size_t sum = 0;
+	for(std::size_t vertidx=0; vertidx<graph.GetNumVertices(); ++vertidx)
+		for_each_neighbour(graph, vertidx, true, [&sum](std::size_t, t_weight w) { sum += w; });
+
+	return sum;
+}
+
+
+/**
+ * are the two distance matrices equal?
+ */
+template<class t_mat>
+bool same_dists(const t_mat& mat1, const t_mat& mat2)
+{
+	if(mat1.size1() != mat2.size1() || mat1.size2() != mat2.size2())
+		return false;
+
+	for(std::size_t i=0; i<mat1.size1(); ++i)
+		for(std::size_t j=0; j<mat1.size2(); ++j)
+			if(mat1(i, j) != mat2(i, j))
+				return false;
+
+	return true;
+}
+
+
+int main()
+{
+	std::mt19937 rnd{1234};
+	std::cout << std::boolalpha;
+
+	// compare the algorithm results on a small graph
+	{
+		const std::size_t num_verts = 400;
+		t_edges edges = random_edges(num_verts, 1600, rnd);
+		adjacency_list<t_weight> graph_list = make_adjacency_list(num_verts, edges);
+		csr_graph<t_weight> graph_csr(graph_list);
+
+		bool ok_struct = graph_csr.GetNumVertices() == num_verts;
+		for(std::size_t idx1=0; idx1<num_verts; ++idx1)
+		{
+			for(std::size_t idx2=0; idx2<num_verts; ++idx2)
+			{
+				ok_struct = ok_struct && graph_csr.IsAdjacent(idx1, idx2) == graph_list.IsAdjacent(idx1, idx2);
+				ok_struct = ok_struct && graph_csr.GetWeight(idx1, idx2) == graph_list.GetWeight(idx1, idx2);
+			}
+		}
+		std::cout << "structure: ok = " << ok_struct << std::endl;
+
+		auto start_list = std::chrono::steady_clock::now();
+		auto pred_list = dijk(graph_list, "0");
+		auto bellman_list = bellman(graph_list, "0");
+		auto floyd_list = floyd(graph_list);
+		double time_list = seconds_since(start_list);
+
+		auto start_csr = std::chrono::steady_clock::now();
+		auto pred_csr = dijk(graph_csr, "0");
+		auto bellman_csr = bellman(graph_csr, "0");
+		auto floyd_csr = floyd(graph_csr);
+		double time_csr = seconds_since(start_csr);
+
+		std::cout << "dijk, bellman, floyd: ok = " << (pred_list == pred_csr
+			&& same_dists(bellman_list, bellman_csr) && same_dists(floyd_list, floyd_csr)) << std::endl;
+		std::cout << num_verts << " vertices, " << edges.size() << " edges: adjacency list: "
+			<< time_list << " s, csr: " << time_csr << " s" << std::endl;
+	}
+
+	// adding and removing edges
+	{
+		csr_graph<t_weight> graph(4, t_edges{ { 0, 1, 5 }, { 2, 1, 3 } });
+		graph.AddVertex("4");
+		graph.AddEdge("4", "0", 7);
+		graph.AddEdge(0, 3, 2);
+		graph.SetWeight(2, 1, 4);
+		graph.RemoveEdge(0, 1);
+
+		bool ok = graph.GetNumEdges() == 3 && graph.GetWeight(4, 0) == 7
+			&& graph.GetWeight(0, 3) == 2 && graph.GetWeight(2, 1) == 4 && !graph.IsAdjacent(0, 1)
+			&& graph.GetNeighbours(1, false) == std::vector<std::size_t>{ 2 }
+			&& graph.GetNeighbours(0, false) == std::vector<std::size_t>{ 4 }
+			&& graph.GetWeightSpan(1, false)[0] == 4;
+		std::cout << "modification: ok = " << ok << std::endl;
+	}
+
+	// edges referring to non-existing vertices
+	{
+		bool ok = false;
+		try
+		{
+			csr_graph<t_weight> graph(3, t_edges{ { 0, 1, 5 }, { 1, 3, 2 } });
+		}
+		catch(const std::out_of_range&)
+		{
+			ok = true;
+		}
+		std::cout << "invalid edge: ok = " << ok << std::endl;
+	}
+
+	// traversal of a large graph
+	{
+		const std::size_t num_verts = 1000000;
+		const std::size_t num_edges = 4000000;
+		t_edges edges = random_edges(num_verts, num_edges, rnd);
+
+		auto start_build_list = std::chrono::steady_clock::now();
+		adjacency_list<t_weight> graph_list = make_adjacency_list(num_verts, edges);
+		double time_build_list = seconds_since(start_build_list);
+
+		auto start_build_csr = std::chrono::steady_clock::now();
+		csr_graph<t_weight> graph_csr(num_verts, edges);
+		double time_build_csr = seconds_since(start_build_csr);
+
+		auto start_list = std::chrono::steady_clock::now();
+		std::size_t sum_list = sum_weights(graph_list);
+		double time_list = seconds_since(start_list);
+
+		auto start_csr = std::chrono::steady_clock::now();
+		std::size_t sum_csr = sum_weights(graph_csr);
+		double time_csr = seconds_since(start_csr);
+
+		std::size_t sum_edges = 0;
+		for(const auto& edge : edges)
+			sum_edges += std::get<2>(edge);
+
+		// the adjacency list returns the weight of the last duplicate edge for all of its copies
+		std::size_t sum_ref = 0;
+		csr_graph<t_weight> graph_csr2(graph_list);
+		for(std::size_t vertidx=0; vertidx<num_verts; ++vertidx)
+			for(std::size_t neighbouridx : graph_list.GetNeighbours(vertidx))
+				sum_ref += graph_csr2.GetWeight(vertidx, neighbouridx);
+
+		std::cout << num_verts << " vertices, " << num_edges << " edges:" << std::endl;
+		std::cout << "\tbuild: adjacency list: " << time_build_list << " s, csr: " << time_build_csr << " s" << std::endl;
+		std::cout << "\tedge traversal: adjacency list: " << time_list << " s, csr: " << time_csr << " s" << std::endl;
+		std::cout << "\tok = " << (sum_list == sum_ref && sum_csr == sum_edges) << std::endl;
+	}
+
+	return 0;
+}
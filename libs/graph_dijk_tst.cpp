@@ -0,0 +1,214 @@
+/**
+ * compares the priority queues and the single-target variants of the dijkstra search
+ * @author Tobias Weber
+ * @date oct-2026
+ * @license see 'LICENSE.EUPL' file
+ *
+ * g++ -std=c++20 -Wall -Wextra -Weffc++ -O2 -o graph_dijk_tst graph_dijk_tst.cpp
+ */
+
+#include "graph_conts.h"
+#include "graph_algos.h"
+#include "tst_helpers.h"
+
+#include <random>
+#include <chrono>
+
+
+using t_weight = unsigned int;
+using t_edges = std::vector<std::tuple<std::size_t, std::size_t, t_weight>>;
+
+
+/**
+ * grid with random weights in both directions, similar to a road network
+ */
+t_edges grid_edges(std::size_t width, std::mt19937& rnd)
+{
+	std::uniform_int_distribution<t_weight> dist_weight(1, 100);
+
+	t_edges edges;
+	for(std::size_t y=0; y<width; ++y)
+	{
+		for(std::size_t x=0; x<width; ++x)
+		{
+			const std::size_t idx = y*width + x;
+			if(x+1 < width)
+			{
+				edges.emplace_back(std::make_tuple(idx, idx + 1, dist_weight(rnd)));
+				edges.emplace_back(std::make_tuple(idx + 1, idx, dist_weight(rnd)));
+			}
+			if(y+1 < width)
+			{
+				edges.emplace_back(std::make_tuple(idx, idx + width, dist_weight(rnd)));
+				edges.emplace_back(std::make_tuple(idx + width, idx, dist_weight(rnd)));
+			}
+		}
+	}
+
+	return edges;
+}
+
+
+/**
+ * is the path connected and does it have the given length?
+ */
+template<class t_graph>
+bool check_path(const t_graph& graph, const std::vector<std::size_t>& path, t_weight dist)
+{
+	t_weight len = 0;
+	for(std::size_t i=1; i<path.size(); ++i)
+	{
+		if(!graph.IsAdjacent(path[i-1], path[i]))
+			return false;
+		len += graph.GetWeight(path[i-1], path[i]);
+	}
+
+	return len == dist;
+}
+
+
+int main()
+{
+	std::mt19937 rnd{1234};
+	std::cout << std::boolalpha;
+
+	// compare the queues and the single-target searches on small graphs
+	{
+		bool ok_queues = true, ok_path = true, ok_bidir = true;
+
+		for(std::size_t iter=0; iter<20; ++iter)
+		{
+			const std::size_t num_verts = 200;
+			adjacency_list<t_weight> graph_list;
+			for(std::size_t i=0; i<num_verts; ++i)
+				graph_list.AddVertex(std::to_string(i));
+			for(const auto& [idx1, idx2, w] : random_edges(num_verts, 600, rnd))
+				graph_list.AddEdge(idx1, idx2, w);
+
+			// without duplicate edges
+			csr_graph<t_weight> graph(graph_list);
+
+			auto [dists_pq, preds_pq] = dijk_dists(graph, 0, std::nullopt, true, DijkQueue::PRIORITY_QUEUE);
+			auto [dists_dary, preds_dary] = dijk_dists(graph, 0, std::nullopt, true, DijkQueue::DARY_HEAP);
+			auto [dists_radix, preds_radix] = dijk_dists(graph, 0, std::nullopt, true, DijkQueue::RADIX_HEAP);
+			auto [dists_list, preds_list] = dijk_dists(graph_list, 0, std::nullopt, true, DijkQueue::DARY_HEAP);
+			ok_queues = ok_queues && dists_pq == dists_dary && dists_pq == dists_radix && dists_pq == dists_list;
+
+			for(std::size_t endidx=0; endidx<num_verts; endidx+=7)
+			{
+				const std::string start = "0", end = std::to_string(endidx);
+				const bool reachable = endidx == 0 || preds_pq[endidx];
+
+				for(DijkQueue queue : { DijkQueue::PRIORITY_QUEUE, DijkQueue::DARY_HEAP, DijkQueue::RADIX_HEAP })
+				{
+					auto [found, dist, path] = dijk_path(graph, start, end, true, queue);
+					ok_path = ok_path && found == reachable;
+					if(found)
+						ok_path = ok_path && dist == dists_pq[endidx] && check_path(graph, path, dist);
+				}
+
+				auto [found, dist, path] = dijk_bidir(graph, start, end);
+				ok_bidir = ok_bidir && found == reachable;
+				if(found)
+				{
+					ok_bidir = ok_bidir && dist == dists_pq[endidx] && check_path(graph, path, dist)
+						&& path.front() == 0 && path.back() == endidx;
+				}
+
+				// unweighted
+				auto [found_unw, dist_unw, path_unw] = dijk_bidir(graph_list, start, end, false);
+				auto [found_unw2, dist_unw2, path_unw2] = dijk_path(graph_list, start, end, false);
+				ok_bidir = ok_bidir && found_unw == found_unw2 && dist_unw == dist_unw2
+					&& path_unw.size() == path_unw2.size();
+			}
+		}
+
+		std::cout << "priority queues: ok = " << ok_queues << std::endl;
+		std::cout << "single target: ok = " << ok_path << std::endl;
+		std::cout << "bidirectional: ok = " << ok_bidir << std::endl;
+	}
+
+	// indexed heap
+	{
+		indexed_heap<int, 3> heap(10);
+		for(std::size_t i=0; i<10; ++i)
+			heap.push(i, int(100 - i*3));
+		heap.push(5, -1);
+		heap.push(2, 200);
+
+		std::vector<std::size_t> order;
+		while(!heap.empty())
+			order.push_back(heap.pop().first);
+		std::cout << "indexed heap: ok = "
+			<< (order == std::vector<std::size_t>{ 5, 9, 8, 7, 6, 4, 3, 1, 0, 2 }) << std::endl;
+	}
+
+	// benchmark on a large grid
+	{
+		const std::size_t width = 1000;
+		csr_graph<t_weight> graph(width*width, grid_edges(width, rnd));
+		const std::size_t startidx = width/4*width + width/4;
+
+		std::cout << graph.GetNumVertices() << " vertices, " << graph.GetNumEdges()
+			<< " edges, search from one to all vertices:" << std::endl;
+
+		std::vector<t_weight> dists_ref;
+		for(DijkQueue queue : { DijkQueue::PRIORITY_QUEUE, DijkQueue::DARY_HEAP, DijkQueue::RADIX_HEAP })
+		{
+			const char* name = queue == DijkQueue::PRIORITY_QUEUE ? "priority queue"
+				: queue == DijkQueue::DARY_HEAP ? "d-ary heap" : "radix heap";
+
+			auto start = std::chrono::steady_clock::now();
+			auto [dists, preds] = dijk_dists(graph, startidx, std::nullopt, true, queue);
+			double time = seconds_since(start);
+
+			if(dists_ref.empty())
+				dists_ref = dists;
+			std::cout << "	" << name << ": " << time << " s, ok = " << (dists == dists_ref) << std::endl;
+		}
+	}
+
+	// benchmark of single-target queries on a large random graph
+	{
+		const std::size_t num_verts = 1000000;
+		const std::size_t num_queries = 10;
+		csr_graph<t_weight> graph(num_verts, random_edges(num_verts, 4*num_verts, rnd));
+		std::uniform_int_distribution<std::size_t> dist_vert(0, num_verts - 1);
+
+		std::cout << num_verts << " vertices, " << graph.GetNumEdges() << " edges, "
+			<< num_queries << " single-target queries:" << std::endl;
+
+		double time_full = 0, time_path = 0, time_bidir = 0;
+		bool ok = true;
+		for(std::size_t query=0; query<num_queries; ++query)
+		{
+			const std::size_t startidx = dist_vert(rnd), endidx = dist_vert(rnd);
+			const std::string start = std::to_string(startidx), end = std::to_string(endidx);
+
+			auto start_full = std::chrono::steady_clock::now();
+			auto [dists, preds] = dijk_dists(graph, startidx);
+			time_full += seconds_since(start_full);
+
+			auto start_path = std::chrono::steady_clock::now();
+			auto [found, dist, path] = dijk_path(graph, start, end);
+			time_path += seconds_since(start_path);
+
+			auto start_bidir = std::chrono::steady_clock::now();
+			auto [found_bidir, dist_bidir, path_bidir] = dijk_bidir(graph, start, end);
+			time_bidir += seconds_since(start_bidir);
+
+			const bool reachable = startidx == endidx || preds[endidx];
+			ok = ok && found == reachable && found_bidir == reachable;
+			if(reachable)
+			{
+				ok = ok && dist == dists[endidx] && dist_bidir == dists[endidx]
+					&& check_path(graph, path_bidir, dist_bidir);
+			}
+		}
+
+		std::cout << "	all vertices: " << time_full << " s, early exit: " << time_path
+			<< " s, bidirectional: " << time_bidir << " s, ok = " << ok << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,500 @@
+/**
+ * distance-vector routing simulation
+ * @author Tobias Weber
+ * @date oct-2026
+ * @license see 'LICENSE.EUPL' file
+ *
+ * the routers are identified by their index and every router keeps a dense
+ * distance and next-hop table with one entry per destination.
+ * the routers exchange their distance vectors in synchronous rounds:
+ * in each round all routers whose links or neighbours' vectors changed in the
+ * previous round recompute their table from their neighbours' previous tables,
+ * i.e. one round is one step of a parallel bellman-ford iteration.
+ *
+ * as in real distance-vector protocols, removing links can lead to count-to-infinity,
+ * which ends when the distances reach the configurable infinity value (e.g. 16 in RIP).
+ *
+ * @see https://de.wikipedia.org/wiki/Distanzvektoralgorithmus
+ * @see https://en.wikipedia.org/wiki/Distance-vector_routing_protocol
+ */
+
+#ifndef __GRAPH_DISTVEC_H__
+#define __GRAPH_DISTVEC_H__
+
+#include <vector>
+#include <tuple>
+#include <limits>
+#include <optional>
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+
+#include "graph_conts.h"
+#include "graph_algos.h"
+
+
+template<class t_weight = unsigned int>
+class distvec_sim
+{
+public:
+	using t_hop = std::uint32_t;
+	static constexpr t_hop no_hop = std::numeric_limits<t_hop>::max();
+
+
+public:
+	distvec_sim() = default;
+	~distvec_sim() = default;
+
+
+	/**
+	 * routers without links, by default all routers are destinations
+	 */
+	explicit distvec_sim(std::size_t num_routers,
+		const std::optional<std::vector<std::size_t>>& dests = std::nullopt)
+		: m_links(num_routers), m_num_incoming(num_routers, 0),
+		  m_dirty(num_routers, 1)
+	{
+		if(dests)
+			SetDestinations(*dests);
+		else
+			SetDestinations();
+	}
+
+
+	/**
+	 * one router per vertex and one link per outgoing edge, parallel edges give the cheapest link
+	 */
+	template<class t_graph> requires is_graph<t_graph>
+	explicit distvec_sim(const t_graph& graph,
+		const std::optional<std::vector<std::size_t>>& dests = std::nullopt)
+		: distvec_sim(graph.GetNumVertices(), dests)
+	{
+		for(std::size_t vertidx=0; vertidx<graph.GetNumVertices(); ++vertidx)
+		{
+			for_each_neighbour(graph, vertidx, true,
+				[this, vertidx](std::size_t neighbouridx, typename t_graph::t_weight w)
+			{
+				if(std::optional<t_weight> link = GetLink(vertidx, neighbouridx); !link || w < *link)
+					SetLink(vertidx, neighbouridx, static_cast<t_weight>(w));
+			});
+		}
+	}
+
+
+	std::size_t GetNumRouters() const
+	{
+		return m_links.size();
+	}
+
+
+	/**
+	 * adds a router without links, the destinations are not changed
+	 */
+	std::size_t AddRouter()
+	{
+		m_links.emplace_back();
+		m_num_incoming.push_back(0);
+		m_dirty.push_back(1);
+		m_destcols.push_back(no_hop);
+
+		m_dists_new.resize(m_dists_new.size() + m_dests.size(), m_infinity);
+		m_dists.resize(m_dists.size() + m_dests.size(), m_infinity);
+		m_hops.resize(m_hops.size() + m_dests.size(), no_hop);
+		m_changed.push_back(0);
+		m_changed_new.push_back(0);
+
+		return m_links.size() - 1;
+	}
+
+
+	/**
+	 * sets the cost of the link from router idx1 to its neighbour idx2
+	 * idx2 then sends its distance vector to idx1
+	 */
+	void SetLink(std::size_t idx1, std::size_t idx2, t_weight w)
+	{
+		for(auto& [neighbouridx, neighbourw] : m_links[idx1])
+		{
+			if(neighbouridx == idx2)
+			{
+				neighbourw = w;
+				m_dirty[idx1] = 1;
+				return;
+			}
+		}
+
+		m_links[idx1].emplace_back(std::make_pair(static_cast<t_hop>(idx2), w));
+		++m_num_incoming[idx2];
+		m_dirty[idx1] = 1;
+	}
+
+
+	/**
+	 * sets the links in both directions
+	 */
+	void SetBidirLink(std::size_t idx1, std::size_t idx2, t_weight w)
+	{
+		SetLink(idx1, idx2, w);
+		SetLink(idx2, idx1, w);
+	}
+
+
+	void RemoveLink(std::size_t idx1, std::size_t idx2)
+	{
+		auto iter = std::find_if(m_links[idx1].begin(), m_links[idx1].end(),
+			[idx2](const auto& link) { return link.first == idx2; });
+		if(iter == m_links[idx1].end())
+			return;
+
+		m_links[idx1].erase(iter);
+		--m_num_incoming[idx2];
+		m_dirty[idx1] = 1;
+	}
+
+
+	std::optional<t_weight> GetLink(std::size_t idx1, std::size_t idx2) const
+	{
+		for(const auto& [neighbouridx, w] : m_links[idx1])
+			if(neighbouridx == idx2)
+				return w;
+
+		return std::nullopt;
+	}
+
+
+	/**
+	 * restricts the routing tables to the given destinations to save memory for large topologies,
+	 * this resets the tables
+	 */
+	void SetDestinations(const std::vector<std::size_t>& dests)
+	{
+		m_dests.clear();
+		m_destcols.assign(GetNumRouters(), no_hop);
+
+		for(std::size_t dest : dests)
+		{
+			if(m_destcols[dest] != no_hop)
+				continue;
+
+			m_destcols[dest] = static_cast<t_hop>(m_dests.size());
+			m_dests.push_back(static_cast<t_hop>(dest));
+		}
+
+		Reset();
+	}
+
+
+	/**
+	 * all routers are destinations
+	 */
+	void SetDestinations()
+	{
+		std::vector<std::size_t> dests(GetNumRouters());
+		for(std::size_t idx=0; idx<dests.size(); ++idx)
+			dests[idx] = idx;
+
+		SetDestinations(dests);
+	}
+
+
+	const std::vector<t_hop>& GetDestinations() const
+	{
+		return m_dests;
+	}
+
+
+	/**
+	 * distances larger or equal to infinity mean that the destination is unreachable
+	 */
+	void SetInfinity(t_weight infinity)
+	{
+		m_infinity = infinity;
+		Reset();
+	}
+
+
+	t_weight GetInfinity() const
+	{
+		return m_infinity;
+	}
+
+
+	/**
+	 * number of threads for the rounds, 0: all hardware threads
+	 */
+	void SetNumThreads(std::size_t num_threads, std::size_t thread_threshold = GRAPH_THREAD_THRESHOLD)
+	{
+		m_num_threads = num_threads;
+		m_thread_threshold = thread_threshold;
+	}
+
+
+	/**
+	 * every router only knows the route to itself, the statistics are cleared
+	 */
+	void Reset()
+	{
+		const std::size_t N = GetNumRouters();
+		const std::size_t D = m_dests.size();
+
+		m_dists.assign(N*D, m_infinity);
+		m_dists_new.assign(N*D, m_infinity);
+		m_hops.assign(N*D, no_hop);
+		for(std::size_t col=0; col<D; ++col)
+		{
+			m_dists[m_dests[col]*D + col] = t_weight{};
+			m_hops[m_dests[col]*D + col] = m_dests[col];
+		}
+
+		m_changed.assign(N, 0);
+		m_changed_new.assign(N, 0);
+		m_dirty.assign(N, 1);
+
+		m_num_rounds = m_num_messages = m_num_updates = 0;
+	}
+
+
+	/**
+	 * one round of the synchronous exchange
+	 * returns false if no router changed its distances, i.e. the tables have converged
+	 */
+	bool Round()
+	{
+		const std::size_t N = GetNumRouters();
+		const std::size_t D = m_dests.size();
+
+		const std::size_t num_threads = m::hardware_threads(m_num_threads);
+
+		// messages and updated table entries per thread
+		std::vector<std::size_t> num_messages(num_threads, 0), num_updates(num_threads, 0);
+
+		graph_parallel(N, num_threads, [this, D, &num_messages, &num_updates](
+			std::size_t thread, std::size_t begin, std::size_t end)
+		{
+			for(std::size_t idx=begin; idx<end; ++idx)
+			{
+				m_changed_new[idx] = 0;
+
+				// only recompute the table if a neighbour has sent a new vector
+				bool active = m_dirty[idx];
+				for(std::size_t link=0; link<m_links[idx].size() && !active; ++link)
+					active = m_changed[m_links[idx][link].first];
+				if(!active)
+					continue;
+
+				t_weight *dists_new = m_dists_new.data() + idx*D;
+				t_hop *hops = m_hops.data() + idx*D;
+				const t_weight *dists = m_dists.data() + idx*D;
+
+				std::fill(dists_new, dists_new + D, m_infinity);
+				std::fill(hops, hops + D, no_hop);
+				if(t_hop col = m_destcols[idx]; col != no_hop)
+				{
+					dists_new[col] = t_weight{};
+					hops[col] = static_cast<t_hop>(idx);
+				}
+
+				// received distance vectors
+				for(const auto& [neighbouridx, w] : m_links[idx])
+				{
+					const t_weight *dists_neighbour = m_dists.data() + neighbouridx*D;
+
+					for(std::size_t col=0; col<D; ++col)
+					{
+						const t_weight dist = std::min<t_weight>(w + dists_neighbour[col], m_infinity);
+						if(dist < dists_new[col])
+						{
+							dists_new[col] = dist;
+							hops[col] = neighbouridx;
+						}
+					}
+				}
+
+				std::size_t updates = 0;
+				for(std::size_t col=0; col<D; ++col)
+					updates += (dists_new[col] != dists[col]);
+
+				if(updates)
+				{
+					m_changed_new[idx] = 1;
+					num_updates[thread] += updates;
+					// the new vector is sent to all routers having a link to this one
+					num_messages[thread] += m_num_incoming[idx];
+				}
+			}
+		}, m_thread_threshold);
+
+		// apply the batch of new vectors
+		bool changed = false;
+		for(std::size_t idx=0; idx<N; ++idx)
+		{
+			m_dirty[idx] = 0;
+			if(!m_changed_new[idx])
+				continue;
+
+			std::copy(m_dists_new.begin() + idx*D, m_dists_new.begin() + (idx+1)*D, m_dists.begin() + idx*D);
+			changed = true;
+		}
+		std::swap(m_changed, m_changed_new);
+
+		for(std::size_t thread=0; thread<num_threads; ++thread)
+		{
+			m_num_messages += num_messages[thread];
+			m_num_updates += num_updates[thread];
+		}
+		if(changed)
+			++m_num_rounds;
+
+		return changed;
+	}
+
+
+	/**
+	 * exchanges the vectors until convergence, 0: no limit on the number of rounds
+	 * returns the number of rounds which changed the tables and if the tables have converged
+	 */
+	std::tuple<std::size_t, bool> Run(std::size_t max_rounds = 0)
+	{
+		std::size_t rounds = 0;
+
+		while(!max_rounds || rounds < max_rounds)
+		{
+			if(!Round())
+				return std::make_tuple(rounds, true);
+			++rounds;
+		}
+
+		return std::make_tuple(rounds, false);
+	}
+
+
+	/**
+	 * distance from the router to the destination, nullopt if it is unreachable or not a destination
+	 */
+	std::optional<t_weight> GetDist(std::size_t idx, std::size_t dest) const
+	{
+		const t_hop col = m_destcols[dest];
+		if(col == no_hop)
+			return std::nullopt;
+
+		const t_weight dist = m_dists[idx*m_dests.size() + col];
+		if(dist >= m_infinity)
+			return std::nullopt;
+
+		return dist;
+	}
+
+
+	/**
+	 * neighbour to which the router forwards the packets for the destination
+	 */
+	std::optional<std::size_t> GetNextHop(std::size_t idx, std::size_t dest) const
+	{
+		const t_hop col = m_destcols[dest];
+		if(col == no_hop || !GetDist(idx, dest))
+			return std::nullopt;
+
+		const t_hop hop = m_hops[idx*m_dests.size() + col];
+		if(hop == no_hop)
+			return std::nullopt;
+
+		return hop;
+	}
+
+
+	/**
+	 * follows the next hops from the router to the destination
+	 * returns an empty path if there is no route or the next hops form a loop
+	 */
+	std::vector<std::size_t> GetRoute(std::size_t idx, std::size_t dest) const
+	{
+		std::vector<std::size_t> route{ idx };
+
+		while(idx != dest)
+		{
+			std::optional<std::size_t> hop = GetNextHop(idx, dest);
+			if(!hop || route.size() > GetNumRouters())
+				return {};
+
+			idx = *hop;
+			route.push_back(idx);
+		}
+
+		return route;
+	}
+
+
+	/**
+	 * number of rounds which changed the tables since the last reset
+	 */
+	std::size_t GetNumRounds() const
+	{
+		return m_num_rounds;
+	}
+
+
+	/**
+	 * number of distance vectors sent to neighbours since the last reset
+	 */
+	std::size_t GetNumMessages() const
+	{
+		return m_num_messages;
+	}
+
+
+	/**
+	 * number of changed table entries since the last reset
+	 */
+	std::size_t GetNumUpdates() const
+	{
+		return m_num_updates;
+	}
+
+
+	/**
+	 * prints the routing table of a router
+	 */
+	void PrintTable(std::ostream& ostr, std::size_t idx) const
+	{
+		ostr << "Routing table for router " << idx << ":\n";
+		for(t_hop dest : m_dests)
+		{
+			ostr << "\tto " << dest << ": ";
+			if(std::optional<t_weight> dist = GetDist(idx, dest); dist)
+				ostr << "distance " << *dist << " via " << *GetNextHop(idx, dest) << "\n";
+			else
+				ostr << "unreachable\n";
+		}
+	}
+
+
+private:
+	// outgoing links [neighbour, cost] per router
+	std::vector<std::vector<std::pair<t_hop, t_weight>>> m_links{};
+	// number of incoming links per router, i.e. the recipients of its vector
+	std::vector<std::size_t> m_num_incoming{};
+
+	// destination routers and their table columns
+	std::vector<t_hop> m_dests{};
+	std::vector<t_hop> m_destcols{};
+
+	// current and next tables of the routers, router-major
+	std::vector<t_weight> m_dists{}, m_dists_new{};
+	std::vector<t_hop> m_hops{};
+
+	// routers whose distance vector changed in the previous and current round
+	std::vector<unsigned char> m_changed{}, m_changed_new{};
+	// routers whose links changed
+	std::vector<unsigned char> m_dirty{};
+
+	// don't use the full maximum to prevent overflows when we're adding the weight afterwards
+	t_weight m_infinity = std::numeric_limits<t_weight>::max() / 2;
+
+	std::size_t m_num_threads = 1;
+	std::size_t m_thread_threshold = GRAPH_THREAD_THRESHOLD;
+
+	std::size_t m_num_rounds = 0, m_num_messages = 0, m_num_updates = 0;
+};
+
+
+#endif
@@ -0,0 +1,188 @@
+/**
+ * compares the distance-vector routing simulation with dijkstra's algorithm
+ * @author Tobias Weber
+ * @date oct-2026
+ * @license see 'LICENSE.EUPL' file
+ *
+ * g++ -std=c++20 -Wall -Wextra -Weffc++ -O2 -o graph_distvec_tst graph_distvec_tst.cpp -lpthread
+ */
+
+#include "graph_conts.h"
+#include "graph_algos.h"
+#include "graph_distvec.h"
+#include "tst_helpers.h"
+
+#include <random>
+#include <chrono>
+
+
+using t_weight = unsigned int;
+using t_edges = std::vector<std::tuple<std::size_t, std::size_t, t_weight>>;
+
+
+/**
+ * random connected topology with bidirectional links: a ring and random shortcuts
+ */
+t_edges random_topology(std::size_t num_verts, std::size_t num_shortcuts, std::mt19937& rnd)
+{
+	std::uniform_int_distribution<std::size_t> dist_vert(0, num_verts - 1);
+	std::uniform_int_distribution<t_weight> dist_weight(1, 20);
+
+	t_edges edges;
+	auto add_edge = [&edges, &rnd, &dist_weight](std::size_t idx1, std::size_t idx2)
+	{
+		const t_weight w = dist_weight(rnd);
+		edges.emplace_back(std::make_tuple(idx1, idx2, w));
+		edges.emplace_back(std::make_tuple(idx2, idx1, w));
+	};
+
+	for(std::size_t i=0; i<num_verts; ++i)
+		add_edge(i, (i + 1) % num_verts);
+	for(std::size_t i=0; i<num_shortcuts; ++i)
+	{
+		std::size_t idx1 = dist_vert(rnd), idx2 = dist_vert(rnd);
+		if(idx1 != idx2)
+			add_edge(idx1, idx2);
+	}
+
+	return edges;
+}
+
+
+/**
+ * are the distances of the routers to the destination the same as the ones found by dijkstra?
+ * the links are symmetric, so the distances from the destination can be used
+ */
+template<class t_graph>
+bool same_dists(const distvec_sim<t_weight>& sim, const t_graph& graph, std::size_t dest)
+{
+	auto [dists, preds] = dijk_dists(graph, dest);
+
+	for(std::size_t idx=0; idx<graph.GetNumVertices(); ++idx)
+	{
+		std::optional<t_weight> dist = sim.GetDist(idx, dest);
+		if(!dist || *dist != dists[idx])
+			return false;
+
+		// the route has to have the same length
+		std::vector<std::size_t> route = sim.GetRoute(idx, dest);
+		t_weight len = 0;
+		for(std::size_t i=1; i<route.size(); ++i)
+			len += *sim.GetLink(route[i-1], route[i]);
+		if(route.empty() || route.back() != dest || len != dists[idx])
+			return false;
+	}
+
+	return true;
+}
+
+
+int main()
+{
+	std::mt19937 rnd{1234};
+	std::cout << std::boolalpha;
+
+	// example from tests/graphs/distvec.cpp
+	{
+		distvec_sim<t_weight> sim(3);
+		sim.SetBidirLink(0, 1, 1);
+		sim.SetBidirLink(1, 2, 2);
+		auto [rounds, converged] = sim.Run();
+
+		bool ok = converged && rounds == 2
+			&& *sim.GetDist(0, 2) == 3 && *sim.GetNextHop(0, 2) == 1
+			&& *sim.GetDist(2, 0) == 3 && *sim.GetNextHop(2, 0) == 1
+			&& sim.GetRoute(0, 2) == std::vector<std::size_t>{ 0, 1, 2 };
+		std::cout << "small example: ok = " << ok << std::endl;
+
+		// a direct link becomes the better route
+		sim.SetBidirLink(0, 2, 2);
+		sim.Run();
+		ok = *sim.GetDist(0, 2) == 2 && *sim.GetNextHop(0, 2) == 2 && *sim.GetDist(1, 2) == 2;
+
+		// the removed link can't be replaced, the routers count to infinity
+		sim.SetInfinity(16);
+		sim.Run();
+		sim.RemoveLink(0, 1);
+		sim.RemoveLink(1, 0);
+		sim.RemoveLink(1, 2);
+		sim.RemoveLink(2, 1);
+		auto [rounds_inf, converged_inf] = sim.Run(100);
+		ok = ok && converged_inf && !sim.GetDist(1, 0) && !sim.GetDist(0, 1) && *sim.GetDist(0, 2) == 2
+			&& sim.GetRoute(1, 2).empty();
+		std::cout << "link changes: ok = " << ok << std::endl;
+	}
+
+	// compare with dijkstra
+	{
+		const std::size_t num_verts = 1000;
+		t_edges edges = random_topology(num_verts, 2000, rnd);
+		adjacency_list<t_weight> graph;
+		for(std::size_t i=0; i<num_verts; ++i)
+			graph.AddVertex(std::to_string(i));
+		for(const auto& [idx1, idx2, w] : edges)
+			graph.AddEdge(idx1, idx2, w);
+
+		distvec_sim<t_weight> sim(graph);
+		auto [rounds, converged] = sim.Run();
+
+		bool ok = converged && rounds == sim.GetNumRounds();
+		for(std::size_t dest : { std::size_t(0), std::size_t(123), num_verts - 1 })
+			ok = ok && same_dists(sim, graph, dest);
+		std::cout << "all destinations: ok = " << ok << std::endl;
+
+		// a link failure has to be routed around
+		const std::size_t idx1 = 123, idx2 = graph.GetNeighbours(idx1)[0];
+		sim.RemoveLink(idx1, idx2);
+		sim.RemoveLink(idx2, idx1);
+		graph.RemoveEdge(std::to_string(idx1), std::to_string(idx2));
+		graph.RemoveEdge(std::to_string(idx2), std::to_string(idx1));
+		sim.Run();
+		std::cout << "link failure: ok = " << (same_dists(sim, graph, 123) && same_dists(sim, graph, idx2)) << std::endl;
+	}
+
+	// large topology with a subset of destinations
+	{
+		const std::size_t num_verts = 50000;
+		const std::size_t num_dests = 64;
+		t_edges edges = random_topology(num_verts, 2*num_verts, rnd);
+		csr_graph<t_weight> graph(num_verts, edges);
+
+		std::vector<std::size_t> dests(num_dests);
+		for(std::size_t i=0; i<num_dests; ++i)
+			dests[i] = i * (num_verts / num_dests);
+
+		std::cout << "\nhardware threads: " << std::thread::hardware_concurrency() << std::endl;
+		std::cout << num_verts << " routers, " << edges.size() << " links, " << num_dests << " destinations:" << std::endl;
+
+		std::vector<t_weight> dists_ref;
+		for(std::size_t num_threads : { 1, 2, 4 })
+		{
+			distvec_sim<t_weight> sim(graph, dests);
+			sim.SetNumThreads(num_threads);
+
+			auto start = std::chrono::steady_clock::now();
+			auto [rounds, converged] = sim.Run();
+			double time = seconds_since(start);
+
+			std::vector<t_weight> dists;
+			dists.reserve(num_verts * num_dests);
+			for(std::size_t idx=0; idx<num_verts; ++idx)
+				for(std::size_t dest : dests)
+					dists.push_back(*sim.GetDist(idx, dest));
+
+			bool ok = converged;
+			if(dists_ref.empty())
+				ok = ok && same_dists(sim, graph, dests[1]);
+			else
+				ok = ok && dists == dists_ref;
+			dists_ref = std::move(dists);
+
+			std::cout << "\t" << num_threads << " threads: " << rounds << " rounds, "
+				<< sim.GetNumMessages() << " messages, " << sim.GetNumUpdates() << " updates, "
+				<< time << " s, ok = " << ok << std::endl;
+		}
+	}
+
+	return 0;
+}
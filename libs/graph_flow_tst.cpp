@@ -0,0 +1,191 @@
+/**
+ * compares the max-flow algorithms on random flux graphs
+ * @author Tobias Weber
+ * @date oct-2026
+ * @license see 'LICENSE.EUPL' file
+ *
+ * g++ -std=c++20 -Wall -Wextra -Weffc++ -O2 -o graph_flow_tst graph_flow_tst.cpp
+ */
+
+#include "graph_conts.h"
+#include "graph_algos.h"
+#include "tst_helpers.h"
+
+#include <random>
+#include <chrono>
+
+
+using t_weight = unsigned int;
+using t_flux_graph = adjacency_matrix<std::pair<t_weight, t_weight>, t_weight>;
+using t_graph = adjacency_matrix<t_weight>;
+
+
+/**
+ * random flux graph with the given number of vertices and edges
+ */
+t_flux_graph random_flux_graph(std::size_t num_verts, std::size_t num_edges, std::mt19937& rnd)
+{
+	std::uniform_int_distribution<std::size_t> dist_vert(0, num_verts - 1);
+	std::uniform_int_distribution<t_weight> dist_cap(1, 100);
+
+	t_flux_graph graph;
+	graph.Reserve(num_verts);
+	for(std::size_t i=0; i<num_verts; ++i)
+		graph.AddVertex(std::to_string(i));
+
+	for(std::size_t i=0; i<num_edges; ++i)
+	{
+		const std::size_t idx1 = dist_vert(rnd), idx2 = dist_vert(rnd);
+		if(idx1 != idx2)
+			graph.SetCapacity(idx1, idx2, dist_cap(rnd));
+	}
+
+	return graph;
+}
+
+
+/**
+ * checks the capacity constraints and the flux conservation
+ * @returns total flux leaving the start vertex
+ */
+std::pair<bool, long> check_flux(const t_flux_graph& graph, std::size_t startidx, std::size_t endidx)
+{
+	const std::size_t N = graph.GetNumVertices();
+	std::vector<long> balance(N, 0);
+	bool ok = true;
+
+	for(const auto& [idx1, idx2, data] : graph.GetEdges())
+	{
+		const auto [flux, cap] = data;
+		ok = ok && flux <= cap;
+		balance[idx1] -= long(flux);
+		balance[idx2] += long(flux);
+	}
+
+	for(std::size_t idx=0; idx<N; ++idx)
+	{
+		if(idx != startidx && idx != endidx)
+			ok = ok && balance[idx] == 0;
+	}
+	ok = ok && balance[startidx] == -balance[endidx];
+
+	return std::make_pair(ok, -balance[startidx]);
+}
+
+
+/**
+ * connects the start and end vertices with all other ones, so that many augmenting paths are needed
+ */
+void connect_terminals(t_flux_graph& graph, std::mt19937& rnd)
+{
+	const std::size_t N = graph.GetNumVertices();
+	std::uniform_int_distribution<t_weight> dist_cap(1, 100);
+
+	for(std::size_t idx=1; idx<N-1; ++idx)
+	{
+		graph.SetCapacity(0, idx, dist_cap(rnd));
+		graph.SetCapacity(idx, N - 1, dist_cap(rnd));
+	}
+}
+
+
+int main()
+{
+	std::mt19937 rnd{1234};
+	std::cout << std::boolalpha;
+
+	// compare with ford-fulkerson on small graphs
+	{
+		bool ok_flux = true, ok_cut = true;
+
+		for(std::size_t iter=0; iter<30; ++iter)
+		{
+			const std::size_t num_verts = 20 + iter;
+			t_flux_graph graph = random_flux_graph(num_verts, 4*num_verts, rnd);
+			const std::string start = "0", end = std::to_string(num_verts - 1);
+
+			auto [ok_ff, flux_ff] = check_flux(flux_max<t_flux_graph, t_graph>(graph, start, end), 0, num_verts - 1);
+			auto [ok_dinic, flux_dinic] = check_flux(flux_max(graph, start, end, FluxAlgo::DINIC), 0, num_verts - 1);
+			auto [ok_pr, flux_pr] = check_flux(flux_max(graph, start, end, FluxAlgo::PUSH_RELABEL), 0, num_verts - 1);
+			ok_flux = ok_flux && ok_ff && ok_dinic && ok_pr && flux_ff == flux_dinic && flux_ff == flux_pr;
+
+			for(FluxAlgo algo : { FluxAlgo::DINIC, FluxAlgo::PUSH_RELABEL })
+			{
+				auto [cut, start_side, cut_edges] = min_cut(graph, start, end, algo);
+
+				long cut_cap = 0;
+				for(const auto& [idx1, idx2] : cut_edges)
+					cut_cap += graph.GetCapacity(idx1, idx2);
+
+				ok_cut = ok_cut && long(cut) == flux_ff && cut_cap == flux_ff
+					&& std::find(start_side.begin(), start_side.end(), 0) != start_side.end()
+					&& std::find(start_side.begin(), start_side.end(), num_verts - 1) == start_side.end();
+			}
+		}
+
+		std::cout << "flux maximum: ok = " << ok_flux << std::endl;
+		std::cout << "minimum cut: ok = " << ok_cut << std::endl;
+	}
+
+	// example from graph_algos_tst
+	{
+		t_flux_graph graph;
+		for(const char* id : { "A", "B", "C", "D", "E" })
+			graph.AddVertex(id);
+		graph.SetCapacity("A", "B", 3);
+		graph.SetCapacity("A", "C", 4);
+		graph.SetCapacity("B", "C", 15);
+		graph.SetCapacity("B", "D", 5);
+		graph.SetCapacity("C", "D", 2);
+
+		auto [cut, start_side, cut_edges] = min_cut(graph, "A", "D");
+		std::cout << "example: ok = " << (cut == 5 && start_side == std::vector<std::size_t>{ 0, 2 }
+			&& cut_edges == std::vector<std::pair<std::size_t, std::size_t>>{ { 0, 1 }, { 2, 3 } }) << std::endl;
+	}
+
+	// benchmark
+	{
+		const std::size_t num_verts = 300;
+		t_flux_graph graph = random_flux_graph(num_verts, 10*num_verts, rnd);
+		connect_terminals(graph, rnd);
+		const std::string start = "0", end = std::to_string(num_verts - 1);
+
+		auto start_ff = std::chrono::steady_clock::now();
+		auto [ok_ff, flux_ff] = check_flux(flux_max<t_flux_graph, t_graph>(graph, start, end), 0, num_verts - 1);
+		double time_ff = seconds_since(start_ff);
+
+		auto start_dinic = std::chrono::steady_clock::now();
+		auto [ok_dinic, flux_dinic] = check_flux(flux_max(graph, start, end, FluxAlgo::DINIC), 0, num_verts - 1);
+		double time_dinic = seconds_since(start_dinic);
+
+		auto start_pr = std::chrono::steady_clock::now();
+		auto [ok_pr, flux_pr] = check_flux(flux_max(graph, start, end, FluxAlgo::PUSH_RELABEL), 0, num_verts - 1);
+		double time_pr = seconds_since(start_pr);
+
+		std::cout << num_verts << " vertices, flux " << flux_ff << ": ford-fulkerson: " << time_ff
+			<< " s, dinic: " << time_dinic << " s, push-relabel: " << time_pr << " s, ok = "
+			<< (ok_ff && ok_dinic && ok_pr && flux_ff == flux_dinic && flux_ff == flux_pr) << std::endl;
+	}
+
+	// larger network on a flat edge array
+	{
+		const std::size_t num_verts = 3000;
+		t_flux_graph graph = random_flux_graph(num_verts, 10*num_verts, rnd);
+		connect_terminals(graph, rnd);
+
+		flow_network<t_weight> net_dinic(graph), net_pr(graph);
+
+		auto start_dinic = std::chrono::steady_clock::now();
+		t_weight flux_dinic = net_dinic.Dinic(0, num_verts - 1);
+		double time_dinic = seconds_since(start_dinic);
+
+		auto start_pr = std::chrono::steady_clock::now();
+		t_weight flux_pr = net_pr.PushRelabel(0, num_verts - 1);
+		double time_pr = seconds_since(start_pr);
+
+		std::cout << num_verts << " vertices, flux " << flux_dinic << ": dinic: " << time_dinic
+			<< " s, push-relabel: " << time_pr << " s, ok = " << (flux_dinic == flux_pr) << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,243 @@
+/**
+ * compares the all-pairs and single-source shortest path algorithms and benchmarks them with several threads
+ * @author Tobias Weber
+ * @date oct-2026
+ * @license see 'LICENSE.EUPL' file
+ *
+ * g++ -std=c++20 -Wall -Wextra -Weffc++ -O3 -march=native -o graph_paths_tst graph_paths_tst.cpp -lpthread
+ */
+
+#include "graph_conts.h"
+#include "graph_algos.h"
+#include "tst_helpers.h"
+
+#include <random>
+#include <chrono>
+#include <cstdint>
+
+
+using t_weight = unsigned int;
+using t_edges = std::vector<std::tuple<std::size_t, std::size_t, t_weight>>;
+
+
+/**
+ * removes parallel edges, keeping the first one
+ */
+t_edges unique_edges(t_edges edges)
+{
+	std::stable_sort(edges.begin(), edges.end(), [](const auto& edge1, const auto& edge2) -> bool
+	{
+		return std::make_pair(std::get<0>(edge1), std::get<1>(edge1))
+			< std::make_pair(std::get<0>(edge2), std::get<1>(edge2));
+	});
+
+	edges.erase(std::unique(edges.begin(), edges.end(), [](const auto& edge1, const auto& edge2) -> bool
+	{
+		return std::get<0>(edge1) == std::get<0>(edge2) && std::get<1>(edge1) == std::get<1>(edge2);
+	}), edges.end());
+
+	return edges;
+}
+
+
+/**
+ * textbook floyd-warshall triple loop for comparison
+ */
+void floyd_naive(std::vector<t_weight>& dists, std::size_t N)
+{
+	for(std::size_t k=0; k<N; ++k)
+		for(std::size_t i=0; i<N; ++i)
+			for(std::size_t j=0; j<N; ++j)
+				dists[i*N + j] = std::min(dists[i*N + j], dists[i*N + k] + dists[k*N + j]);
+}
+
+
+/**
+ * initial distance matrix of a graph
+ */
+template<class t_graph>
+std::vector<t_weight> initial_dists(const t_graph& graph)
+{
+	const std::size_t N = graph.GetNumVertices();
+	std::vector<t_weight> dists(N*N, std::numeric_limits<t_weight>::max() / 2);
+
+	for(std::size_t vertidx=0; vertidx<N; ++vertidx)
+	{
+		dists[vertidx*N + vertidx] = 0;
+		for_each_neighbour(graph, vertidx, true, [&](std::size_t neighbouridx, t_weight w)
+		{
+			if(neighbouridx != vertidx)
+				dists[vertidx*N + neighbouridx] = std::min(dists[vertidx*N + neighbouridx], w);
+		});
+	}
+
+	return dists;
+}
+
+
+int main()
+{
+	std::mt19937 rnd{1234};
+	std::cout << std::boolalpha;
+
+	// compare with the dijkstra search from every vertex
+	{
+		const std::size_t num_verts = 300;
+		csr_graph<t_weight> graph(num_verts, unique_edges(random_edges(num_verts, 1200, rnd)));
+
+		// block size which doesn't divide the number of vertices
+		std::vector<t_weight> dists_blocked = initial_dists(graph);
+		floyd_flat(dists_blocked, num_verts, 4, 48);
+		auto dists_floyd = floyd(graph);
+
+		bool ok_floyd = true, ok_bellman = true, ok_delta = true;
+		for(std::size_t startidx=0; startidx<num_verts; ++startidx)
+		{
+			auto [dists, preds] = dijk_dists(graph, startidx);
+
+			for(std::size_t idx=0; idx<num_verts; ++idx)
+			{
+				ok_floyd = ok_floyd && dists_floyd(startidx, idx) == dists[idx]
+					&& dists_blocked[startidx*num_verts + idx] == dists[idx];
+			}
+
+			auto [dists_bellman, preds_bellman, no_neg_cycle] = bellman_dists(graph, startidx);
+			ok_bellman = ok_bellman && no_neg_cycle && dists_bellman == dists;
+
+			if(startidx % 10 == 0)
+			{
+				for(t_weight delta : { 0u, 1u, 25u, 1000u })
+				{
+					auto [dists_delta, preds_delta] = delta_stepping(graph, startidx, delta, 3);
+					ok_delta = ok_delta && dists_delta == dists;
+
+					// the predecessors have to be on a shortest path
+					for(std::size_t idx=0; idx<num_verts; ++idx)
+					{
+						if(preds_delta[idx])
+						{
+							ok_delta = ok_delta && dists[*preds_delta[idx]]
+								+ graph.GetWeight(*preds_delta[idx], idx) == dists[idx];
+						}
+					}
+				}
+			}
+		}
+
+		std::cout << "floyd: ok = " << ok_floyd << std::endl;
+		std::cout << "bellman: ok = " << ok_bellman << std::endl;
+		std::cout << "delta-stepping: ok = " << ok_delta << std::endl;
+	}
+
+	// large weights, which would need one bucket per unit of distance with a small delta
+	{
+		using t_weight_large = std::uint64_t;
+		const std::size_t num_verts = 2000;
+		std::uniform_int_distribution<t_weight_large> dist_weight(1, 1'000'000'000);
+
+		std::vector<std::tuple<std::size_t, std::size_t, t_weight_large>> edges;
+		for(const auto& [idx1, idx2, w] : random_edges(num_verts, 8000, rnd))
+			edges.emplace_back(std::make_tuple(idx1, idx2, dist_weight(rnd)));
+		csr_graph<t_weight_large> graph(num_verts, edges);
+
+		auto [dists, preds] = dijk_dists(graph, 0);
+		bool ok = true;
+		for(t_weight_large delta : { 0ull, 1ull, 1000ull, 100'000'000ull })
+		{
+			auto [dists_delta, preds_delta] = delta_stepping(graph, 0, delta, 3);
+			ok = ok && dists_delta == dists;
+		}
+		std::cout << "delta-stepping, large weights: ok = " << ok << std::endl;
+	}
+
+	// negative weights
+	{
+		adjacency_list<int> graph;
+		for(const char* id : { "A", "B", "C", "D" })
+			graph.AddVertex(id);
+		graph.AddEdge("A", "B", 4);
+		graph.AddEdge("A", "C", 2);
+		graph.AddEdge("B", "D", -3);
+		graph.AddEdge("C", "D", 2);
+
+		auto [dists, preds, no_neg_cycle] = bellman_dists(graph, 0);
+		bool ok = no_neg_cycle && dists == std::vector<int>{ 0, 4, 2, 1 } && *preds[3] == 1;
+
+		graph.AddEdge("D", "A", 1);
+		graph.AddEdge("D", "B", -2);
+		auto [dists_cycle, preds_cycle, no_neg_cycle2] = bellman_dists(graph, 0);
+		ok = ok && !no_neg_cycle2;
+		std::cout << "negative weights: ok = " << ok << std::endl;
+	}
+
+	std::cout << "\nhardware threads: " << std::thread::hardware_concurrency() << std::endl;
+
+	// floyd-warshall benchmark
+	{
+		const std::size_t num_verts = 1500;
+		csr_graph<t_weight> graph(num_verts, random_edges(num_verts, 8*num_verts, rnd));
+		const std::vector<t_weight> dists_init = initial_dists(graph);
+
+		std::vector<t_weight> dists_naive = dists_init;
+		auto start_naive = std::chrono::steady_clock::now();
+		floyd_naive(dists_naive, num_verts);
+		double time_naive = seconds_since(start_naive);
+
+		std::cout << "floyd-warshall, " << num_verts << " vertices: triple loop: " << time_naive << " s" << std::endl;
+		for(std::size_t num_threads : { 1, 2, 4 })
+		{
+			std::vector<t_weight> dists = dists_init;
+			auto start = std::chrono::steady_clock::now();
+			floyd_flat(dists, num_verts, num_threads);
+			double time = seconds_since(start);
+
+			std::cout << "\tblocked, " << num_threads << " threads: " << time << " s, ok = "
+				<< (dists == dists_naive) << std::endl;
+		}
+	}
+
+	// bellman-ford benchmark
+	{
+		const std::size_t num_verts = 3000;
+		csr_graph<t_weight> graph(num_verts, random_edges(num_verts, 4*num_verts, rnd));
+
+		auto start_table = std::chrono::steady_clock::now();
+		auto table = bellman(graph, "0");
+		double time_table = seconds_since(start_table);
+
+		auto start_dists = std::chrono::steady_clock::now();
+		auto [dists, preds, no_neg_cycle] = bellman_dists(graph, 0);
+		double time_dists = seconds_since(start_dists);
+
+		bool ok = no_neg_cycle;
+		for(std::size_t idx=0; idx<num_verts; ++idx)
+			ok = ok && table(num_verts - 1, idx) == dists[idx];
+
+		std::cout << "bellman-ford, " << num_verts << " vertices: distance table: " << time_table
+			<< " s, early termination: " << time_dists << " s, ok = " << ok << std::endl;
+	}
+
+	// delta-stepping benchmark
+	{
+		const std::size_t num_verts = 1000000;
+		csr_graph<t_weight> graph(num_verts, random_edges(num_verts, 4*num_verts, rnd));
+
+		auto start_dijk = std::chrono::steady_clock::now();
+		auto [dists_dijk, preds_dijk] = dijk_dists(graph, 0, std::nullopt, true, DijkQueue::RADIX_HEAP);
+		double time_dijk = seconds_since(start_dijk);
+
+		std::cout << "delta-stepping, " << num_verts << " vertices, " << graph.GetNumEdges()
+			<< " edges: dijkstra (radix heap): " << time_dijk << " s" << std::endl;
+		for(std::size_t num_threads : { 1, 2, 4 })
+		{
+			auto start = std::chrono::steady_clock::now();
+			auto [dists, preds] = delta_stepping(graph, 0, t_weight(25), num_threads);
+			double time = seconds_since(start);
+
+			std::cout << "\t" << num_threads << " threads: " << time << " s, ok = "
+				<< (dists == dists_dijk) << std::endl;
+		}
+	}
+
+	return 0;
+}
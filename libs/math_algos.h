@@ -31,8 +31,10 @@
 #include <algorithm>
 #include <numeric>
 #include <numbers>
+#include <utility>
 //#include <iostream>
 
+// 0: determinant and inverse via LU decomposition, 1: via Laplace expansion
 #define MATH_USE_FLAT_DET 0
 
 
@@ -96,6 +98,19 @@ requires is_scalar<t_real>
 }
 
 
+/**
+ * calls func(0), func(1), ..., func(N-1), unrolled at compile time
+ */
+template<std::size_t N, class t_func>
+constexpr void unroll(t_func&& func)
+{
+	[&func]<std::size_t ...I>(std::index_sequence<I...>)
+	{
+		(func(I), ...);
+	}(std::make_index_sequence<N>{});
+}
+
+
 /**
  * are two angles equal within an epsilon range?
  */
@@ -507,12 +522,19 @@ requires is_mat<t_mat>
 
 	for(t_size i=0; i<mat.size1(); ++i)
 	{
+		// the diagonal of a hermitian matrix is real
+		if constexpr(is_complex<t_elem>)
+		{
+			if(!equals<typename t_elem::value_type>(mat(i,i).imag(), 0, eps.real()))
+				return false;
+		}
+
 		for(t_size j=i+1; j<mat.size2(); ++j)
 		{
 			if constexpr(is_complex<t_elem>)
 			{
 				// not hermitian?
-				if(!equals<t_elem>(mat(i,j), std::conj(mat(j,i)), eps))
+				if(!equals<t_elem>(mat(i,j), std::conj(mat(j,i)), eps.real()))
 					return false;
 			}
 			else
@@ -548,6 +570,22 @@ requires is_mat<t_mat>
 }
 
 
+/**
+ * transpose matrix into an existing matrix of size size2 x size1, without allocations
+ * mat_out must not be the same object as mat
+ */
+template<class t_mat_out, class t_mat>
+void trans_into(t_mat_out& mat_out, const t_mat& mat)
+requires is_basic_mat<t_mat_out> && is_basic_mat<t_mat>
+{
+	using t_size = decltype(mat.size1());
+
+	for(t_size i=0; i<mat.size1(); ++i)
+		for(t_size j=0; j<mat.size2(); ++j)
+			mat_out(j,i) = mat(i,j);
+}
+
+
 /**
  * create vector from initializer_list
  */
@@ -741,6 +779,35 @@ requires is_basic_vec<t_vec>
 }
 
 
+/**
+ * inner product <vec1|vec2> of fixed-size vectors, unrolled for small sizes
+ */
+template<class t_vec>
+typename t_vec::value_type inner(const t_vec& vec1, const t_vec& vec2)
+requires is_basic_vec<t_vec> && is_fixed_vec<t_vec>
+{
+	using T = typename t_vec::value_type;
+	constexpr std::size_t N = t_vec::size();
+
+	T val{};
+	auto add_elem = [&val, &vec1, &vec2](std::size_t i)
+	{
+		if constexpr(is_complex<T>)
+			val += std::conj(vec1[i]) * vec2[i];
+		else
+			val += vec1[i] * vec2[i];
+	};
+
+	if constexpr(N <= 4)
+		unroll<N>(add_elem);
+	else
+		for(std::size_t i=0; i<N; ++i)
+			add_elem(i);
+
+	return val;
+}
+
+
 /**
  * inner product between two vectors of different type
  */
@@ -848,6 +915,31 @@ requires is_basic_vec<t_vec> && is_mat<t_mat>
 }
 
 
+/**
+ * outer product |v1><v2| into an existing matrix, without allocations
+ * the product is scaled by the optional factor
+ */
+template<class t_mat, class t_vec>
+void outer_into(t_mat& mat, const t_vec& vec1, const t_vec& vec2,
+	typename t_vec::value_type scale = typename t_vec::value_type(1))
+requires is_basic_vec<t_vec> && is_basic_mat<t_mat>
+{
+	using t_size = decltype(vec1.size());
+
+	for(t_size n1=0; n1<vec1.size(); ++n1)
+	{
+		typename t_vec::value_type val1{};
+		if constexpr(is_complex<typename t_vec::value_type>)
+			val1 = scale * std::conj(vec1[n1]);
+		else
+			val1 = scale * vec1[n1];
+
+		for(t_size n2=0; n2<vec2.size(); ++n2)
+			mat(n1, n2) = val1 * vec2[n2];
+	}
+}
+
+
 /**
  * outer product |v1><v2|, "flattened" to a (state) vector
  */
@@ -1023,6 +1115,28 @@ requires is_basic_mat<t_mat> && is_basic_vec<t_vec>
 
 
 
+/**
+ * matrix to project onto vector: P = |v><v|, written into an existing matrix
+ * a non-normalised vector is normalised via the scale factor instead of a temporary vector
+ * @see (Arens15), p. 814
+ */
+template<class t_mat, class t_vec>
+void projector_into(t_mat& mat, const t_vec& vec, bool is_normalised = true)
+requires is_vec<t_vec> && is_mat<t_mat>
+{
+	using T = typename t_vec::value_type;
+
+	T scale = T(1);
+	if(!is_normalised)
+	{
+		const T len = norm<t_vec>(vec);
+		scale = T(1) / (len*len);
+	}
+
+	outer_into<t_mat, t_vec>(mat, vec, vec, scale);
+}
+
+
 /**
  * matrix to project onto vector: P = |v><v|
  * from: |x'> = <v|x> * |v> = |v><v|x> = |v><v| * |x>
@@ -1032,16 +1146,9 @@ template<class t_mat, class t_vec>
 t_mat projector(const t_vec& vec, bool is_normalised = true)
 requires is_vec<t_vec> && is_mat<t_mat>
 {
-	if(is_normalised)
-	{
-		return outer<t_mat, t_vec>(vec, vec);
-	}
-	else
-	{
-		const auto len = norm<t_vec>(vec);
-		t_vec _vec = vec / len;
-		return outer<t_mat, t_vec>(_vec, _vec);
-	}
+	t_mat mat = create<t_mat>(vec.size(), vec.size());
+	projector_into<t_mat, t_vec>(mat, vec, is_normalised);
+	return mat;
 }
 
 
@@ -1165,11 +1272,29 @@ template<class t_mat, class t_vec>
 t_mat ortho_projector(const t_vec& vec, bool is_normalised = true)
 requires is_vec<t_vec> && is_mat<t_mat>
 {
+	t_mat mat = create<t_mat>(vec.size(), vec.size());
+	ortho_projector_into<t_mat, t_vec>(mat, vec, is_normalised);
+	return mat;
+}
+
+
+/**
+ * matrix to project onto orthogonal complement: P = 1-|v><v|, written into an existing matrix
+ */
+template<class t_mat, class t_vec>
+void ortho_projector_into(t_mat& mat, const t_vec& vec, bool is_normalised = true)
+requires is_vec<t_vec> && is_mat<t_mat>
+{
+	using T = typename t_vec::value_type;
 	using t_size = decltype(vec.size());
 
-	const t_size iSize = vec.size();
-	return unit<t_mat>(iSize) -
-		projector<t_mat, t_vec>(vec, is_normalised);
+	projector_into<t_mat, t_vec>(mat, vec, is_normalised);
+
+	for(t_size i=0; i<vec.size(); ++i)
+	{
+		for(t_size j=0; j<vec.size(); ++j)
+			mat(i, j) = (i==j ? T(1) : T(0)) - mat(i, j);
+	}
 }
 
 
@@ -1185,13 +1310,29 @@ template<class t_mat, class t_vec>
 t_mat ortho_mirror_op(const t_vec& vec, bool is_normalised = true)
 requires is_vec<t_vec> && is_mat<t_mat>
 {
-	using t_size = decltype(vec.size());
+	t_mat mat = create<t_mat>(vec.size(), vec.size());
+	ortho_mirror_op_into<t_mat, t_vec>(mat, vec, is_normalised);
+	return mat;
+}
+
+
+/**
+ * matrix to mirror on plane perpendicular to vector: P = 1 - 2*|v><v|, written into an existing matrix
+ */
+template<class t_mat, class t_vec>
+void ortho_mirror_op_into(t_mat& mat, const t_vec& vec, bool is_normalised = true)
+requires is_vec<t_vec> && is_mat<t_mat>
+{
 	using T = typename t_vec::value_type;
+	using t_size = decltype(vec.size());
 
-	const t_size iSize = vec.size();
+	projector_into<t_mat, t_vec>(mat, vec, is_normalised);
 
-	return unit<t_mat>(iSize) -
-		T(2)*projector<t_mat, t_vec>(vec, is_normalised);
+	for(t_size i=0; i<vec.size(); ++i)
+	{
+		for(t_size j=0; j<vec.size(); ++j)
+			mat(i, j) = (i==j ? T(1) : T(0)) - T(2)*mat(i, j);
+	}
 }
 
 
@@ -1229,37 +1370,117 @@ requires is_vec<t_vec> && is_mat<t_mat>
 
 
 /**
- * QR decomposition of a matrix
- * @returns [Q, R, number of mirror operations]
+ * in-place QR decomposition of a matrix
+ * R: input matrix, overwritten by R
+ * Q: rows x rows output matrix
+ * vecMirror: work vector of size rows
+ *
+ * the mirror operations of ortho_mirror_zero_op are applied directly via
+ * their householder vectors instead of building and multiplying the mirror matrices,
+ * this performs no allocations
+ *
+ * @returns number of mirror operations
  * @see (Scarpino11), pp. 269-272
  */
 template<class t_mat, class t_vec>
-std::tuple<t_mat, t_mat, decltype(t_mat{}.size1())> qr(const t_mat& mat)
+decltype(t_mat{}.size1()) qr_inplace(t_mat& R, t_mat& Q, t_vec& vecMirror)
 requires is_mat<t_mat> && is_vec<t_vec>
 {
-	//using T = typename t_mat::value_type;
-	using size_t = decltype(mat.size1());
+	using T = typename t_mat::value_type;
+	using t_real = decltype(std::abs(T{}));
+	using size_t = decltype(R.size1());
+	constexpr t_real eps = std::numeric_limits<t_real>::epsilon();
 
-	const size_t rows = mat.size1();
-	const size_t cols = mat.size2();
-	const size_t N = std::min(cols, rows);
+	const size_t rows = R.size1();
+	const size_t cols = R.size2();
 
-	t_mat R = mat;
-	t_mat Q = unit<t_mat>(N, N);
+	unit<t_mat>(Q, 0, 0, rows, rows);
 
 	size_t num_mirrors = 0;
-	for(size_t icol=0; icol<N-1; ++icol)
+	for(size_t icol=0; icol+1<rows && icol<cols; ++icol)
 	{
-		t_vec vecCol = col<t_mat, t_vec>(R, icol);
-		const auto [matMirror, reflected] = ortho_mirror_zero_op<t_mat, t_vec>(vecCol, icol);
-		Q = Q * matMirror;
-		R = matMirror * R;
+		// norm of the rest vector
+		T n = T(0);
+		for(size_t i=icol; i<rows; ++i)
+			n += R(i, icol)*R(i, icol);
+
+		// mirror vector, see ortho_mirror_zero_op
+		bool reflected = false;
+		for(size_t i=0; i<rows; ++i)
+		{
+			if(i < icol)
+				vecMirror[i] = T(0);
+			else if(i == icol)
+				vecMirror[i] = R(i, icol) - std::sqrt(n);
+			else
+				vecMirror[i] = R(i, icol);
+
+			if(std::abs(vecMirror[i]) > eps)
+				reflected = true;
+		}
+
+		// nothing to do -> mirror would be the unit matrix
+		if(!reflected)
+			continue;
+
+		T len2 = T(0);
+		for(size_t i=icol; i<rows; ++i)
+			len2 += vecMirror[i]*vecMirror[i];
+		const T scale = T(2) / len2;
+
+		// R = (1 - 2*|v><v|) * R
+		for(size_t j=0; j<cols; ++j)
+		{
+			T dot = T(0);
+			for(size_t i=icol; i<rows; ++i)
+				dot += vecMirror[i]*R(i, j);
+			dot *= scale;
+
+			for(size_t i=icol; i<rows; ++i)
+				R(i, j) -= dot*vecMirror[i];
+		}
+
+		// the mirrored column is exactly [..., |rest|, 0, ..., 0]
+		R(icol, icol) = std::sqrt(n);
+		for(size_t i=icol+1; i<rows; ++i)
+			R(i, icol) = T(0);
+
+		// Q = Q * (1 - 2*|v><v|)
+		for(size_t i=0; i<rows; ++i)
+		{
+			T dot = T(0);
+			for(size_t j=icol; j<rows; ++j)
+				dot += Q(i, j)*vecMirror[j];
+			dot *= scale;
+
+			for(size_t j=icol; j<rows; ++j)
+				Q(i, j) -= dot*vecMirror[j];
+		}
 
-		if(reflected)
-			++num_mirrors;
+		++num_mirrors;
 	}
 
-	return std::make_tuple(Q, R, num_mirrors);
+	return num_mirrors;
+}
+
+
+/**
+ * QR decomposition of a matrix
+ * @returns [Q, R, number of mirror operations]
+ * @see (Scarpino11), pp. 269-272
+ */
+template<class t_mat, class t_vec>
+std::tuple<t_mat, t_mat, decltype(t_mat{}.size1())> qr(const t_mat& mat)
+requires is_mat<t_mat> && is_vec<t_vec>
+{
+	const auto rows = mat.size1();
+
+	t_mat R = mat;
+	t_mat Q = create<t_mat>(rows, rows);
+	t_vec vecMirror = create<t_vec>(rows);
+
+	const auto num_mirrors = qr_inplace<t_mat, t_vec>(R, Q, vecMirror);
+	return std::make_tuple(std::move(Q), std::move(R), num_mirrors);
 }
 
 
@@ -1388,240 +1609,1085 @@ requires is_basic_vec<t_vec>
 	t_vec vec;
 	vec.reserve(iNumRows);
 
-	for(t_size iRow=0; iRow<iNumRows; ++iRow)
+	for(t_size iRow=0; iRow<iNumRows; ++iRow)
+	{
+		if(iRow == iRemRow)
+			continue;
+
+		for(t_size iCol=0; iCol<iNumCols; ++iCol)
+		{
+			if(iCol == iRemCol)
+				continue;
+			vec.push_back(mat[iRow*iNumCols + iCol]);
+		}
+	}
+
+	return vec;
+}
+
+
+/**
+ * submatrix removing a column/row from a matrix, written into an existing matrix
+ */
+template<class t_mat_out, class t_mat>
+void submat_into(t_mat_out& matRet, const t_mat& mat,
+	decltype(mat.size1()) iRemRow, decltype(mat.size2()) iRemCol)
+requires is_basic_mat<t_mat_out> && is_basic_mat<t_mat>
+{
+	using size_t = decltype(mat.size1());
+
+	size_t iResRow = 0;
+	for(size_t iRow=0; iRow<mat.size1(); ++iRow)
+	{
+		if(iRow == iRemRow)
+			continue;
+
+		size_t iResCol = 0;
+		for(size_t iCol=0; iCol<mat.size2(); ++iCol)
+		{
+			if(iCol == iRemCol)
+				continue;
+
+			matRet(iResRow, iResCol) = mat(iRow, iCol);
+			++iResCol;
+		}
+
+		++iResRow;
+	}
+}
+
+
+/**
+ * submatrix removing a column/row from a matrix
+ */
+template<class t_mat>
+t_mat submat(const t_mat& mat, decltype(mat.size1()) iRemRow, decltype(mat.size2()) iRemCol)
+requires is_dyn_mat<t_mat>
+{
+	t_mat matRet = m::create<t_mat>(mat.size1()-1, mat.size2()-1);
+	submat_into<t_mat, t_mat>(matRet, mat, iRemRow, iRemCol);
+
+	return matRet;
+}
+
+
+/**
+ * determinant from a square matrix stored in a vector container
+ * @see (Merziger06), p. 185
+ */
+template<class t_vec>
+typename t_vec::value_type flat_det(const t_vec& mat, std::size_t iN)
+requires is_basic_vec<t_vec>
+{
+	using t_size = decltype(mat.size());
+	using T = typename t_vec::value_type;
+
+	// special cases
+	if(iN == 0)
+		return 0;
+	else if(iN == 1)
+		return mat[0];
+	else if(iN == 2)
+		return mat[0]*mat[3] - mat[1]*mat[2];
+
+
+	T fullDet = T(0);
+	t_size iRow = 0;
+
+	// get row with maximum number of zeros
+	t_size iMaxNumZeros = 0;
+	for(t_size iCurRow=0; iCurRow<iN; ++iCurRow)
+	{
+		t_size iNumZeros = 0;
+		for(t_size iCurCol=0; iCurCol<iN; ++iCurCol)
+		{
+			if(equals<T>(mat[iCurRow*iN + iCurCol], T(0)))
+				++iNumZeros;
+		}
+
+		if(iNumZeros > iMaxNumZeros)
+		{
+			iRow = iCurRow;
+			iMaxNumZeros = iNumZeros;
+		}
+	}
+
+
+	// recursively expand determiant along a row
+	for(t_size iCol=0; iCol<iN; ++iCol)
+	{
+		const T elem = mat[iRow*iN + iCol];
+		if(equals<T>(elem, 0))
+			continue;
+
+		const T sgn = ((iRow+iCol) % 2) == 0 ? T(1) : T(-1);
+		const t_vec subMat = flat_submat<t_vec>(mat, iN, iN, iRow, iCol);
+		const T subDet = flat_det<t_vec>(subMat, iN-1) * sgn;
+
+		fullDet += elem * subDet;
+	}
+
+	return fullDet;
+}
+
+
+/**
+ * LU decomposition of a square matrix with partial pivoting: P*A = L*U
+ * L (having a unit diagonal) and U are stored in the same matrix
+ * @returns [LU, row permutation, number of row swaps, is the matrix regular?]
+ * @see https://en.wikipedia.org/wiki/LU_decomposition
+ */
+template<class t_mat>
+std::tuple<t_mat, std::vector<std::size_t>, std::size_t, bool> lu(const t_mat& mat)
+requires is_mat<t_mat>
+{
+	using T = typename t_mat::value_type;
+	using t_size = decltype(mat.size1());
+
+	const t_size N = mat.size1();
+	t_mat LU = mat;
+
+	std::vector<std::size_t> perm(N);
+	std::iota(perm.begin(), perm.end(), 0);
+
+	std::size_t num_swaps = 0;
+	bool regular = true;
+
+	for(t_size k=0; k<N; ++k)
+	{
+		// find the row with the largest pivot element
+		t_size pivot = k;
+		auto pivot_abs = std::abs(LU(k, k));
+		for(t_size i=k+1; i<N; ++i)
+		{
+			auto elem_abs = std::abs(LU(i, k));
+			if(elem_abs > pivot_abs)
+			{
+				pivot = i;
+				pivot_abs = elem_abs;
+			}
+		}
+
+		if(pivot != k)
+		{
+			for(t_size j=0; j<N; ++j)
+				std::swap(LU(k, j), LU(pivot, j));
+			std::swap(perm[k], perm[pivot]);
+			++num_swaps;
+		}
+
+		// singular matrix
+		if(equals<T>(LU(k, k), T(0)))
+		{
+			regular = false;
+			continue;
+		}
+
+		// eliminate the column below the pivot
+		for(t_size i=k+1; i<N; ++i)
+		{
+			const T factor = LU(i, k) / LU(k, k);
+			LU(i, k) = factor;
+
+			for(t_size j=k+1; j<N; ++j)
+				LU(i, j) -= factor * LU(k, j);
+		}
+	}
+
+	return std::make_tuple(LU, perm, num_swaps, regular);
+}
+
+
+/**
+ * solve L*U*x = P*b using the results of the LU decomposition
+ * @see https://en.wikipedia.org/wiki/LU_decomposition#Solving_linear_equations
+ */
+template<class t_mat, class t_vec>
+t_vec lu_solve(const t_mat& LU, const std::vector<std::size_t>& perm, const t_vec& vec)
+requires is_mat<t_mat> && is_vec<t_vec>
+{
+	using t_size = decltype(LU.size1());
+
+	const t_size N = LU.size1();
+	t_vec x = create<t_vec>(N);
+
+	// forward substitution: L*y = P*b
+	for(t_size i=0; i<N; ++i)
+	{
+		x[i] = vec[perm[i]];
+		for(t_size j=0; j<i; ++j)
+			x[i] -= LU(i, j) * x[j];
+	}
+
+	// back substitution: U*x = y
+	for(t_size i=N; i>0; --i)
+	{
+		const t_size row = i-1;
+		for(t_size j=row+1; j<N; ++j)
+			x[row] -= LU(row, j) * x[j];
+		x[row] /= LU(row, row);
+	}
+
+	return x;
+}
+
+
+/**
+ * Cholesky decomposition of a symmetric (or hermitian) positive-definite matrix: A = L*L^H
+ * @returns [L, is the matrix positive-definite?]
+ * @see https://en.wikipedia.org/wiki/Cholesky_decomposition#The_Cholesky_algorithm
+ */
+template<class t_mat>
+std::tuple<t_mat, bool> cholesky(const t_mat& mat)
+requires is_mat<t_mat>
+{
+	using T = typename t_mat::value_type;
+	using t_size = decltype(mat.size1());
+
+	const t_size N = mat.size1();
+	t_mat L = zero<t_mat>(N, N);
+
+	auto conj = [](const T& val) -> T
+	{
+		if constexpr(is_complex<T>)
+			return std::conj(val);
+		else
+			return val;
+	};
+
+	for(t_size j=0; j<N; ++j)
+	{
+		// diagonal element, has to be real and positive
+		T diag = mat(j, j);
+		for(t_size k=0; k<j; ++k)
+			diag -= L(j, k) * conj(L(j, k));
+
+		auto diag_re = std::real(diag);
+		if(diag_re <= 0)
+			return std::make_tuple(L, false);
+		L(j, j) = T(std::sqrt(diag_re));
+
+		// elements below the diagonal
+		for(t_size i=j+1; i<N; ++i)
+		{
+			T elem = mat(i, j);
+			for(t_size k=0; k<j; ++k)
+				elem -= L(i, k) * conj(L(j, k));
+			L(i, j) = elem / L(j, j);
+		}
+	}
+
+	return std::make_tuple(L, true);
+}
+
+
+/**
+ * solve L*L^H*x = b using the results of the Cholesky decomposition
+ */
+template<class t_mat, class t_vec>
+t_vec cholesky_solve(const t_mat& L, const t_vec& vec)
+requires is_mat<t_mat> && is_vec<t_vec>
+{
+	using T = typename t_mat::value_type;
+	using t_size = decltype(L.size1());
+
+	const t_size N = L.size1();
+	t_vec x = create<t_vec>(N);
+
+	// forward substitution: L*y = b
+	for(t_size i=0; i<N; ++i)
+	{
+		x[i] = vec[i];
+		for(t_size j=0; j<i; ++j)
+			x[i] -= L(i, j) * x[j];
+		x[i] /= L(i, i);
+	}
+
+	// back substitution: L^H*x = y
+	for(t_size i=N; i>0; --i)
+	{
+		const t_size row = i-1;
+		for(t_size j=row+1; j<N; ++j)
+		{
+			if constexpr(is_complex<T>)
+				x[row] -= std::conj(L(j, row)) * x[j];
+			else
+				x[row] -= L(j, row) * x[j];
+		}
+		x[row] /= L(row, row);
+	}
+
+	return x;
+}
+
+
+/**
+ * determinant
+ */
+template<class t_mat, class t_vec>
+typename t_mat::value_type det(const t_mat& mat)
+requires is_mat<t_mat>
+{
+	using T = typename t_mat::value_type;
+	using size_t = decltype(mat.size1());
+
+	if(mat.size1() != mat.size2())
+		return 0;
+
+	size_t N = mat.size1();
+
+	// special cases
+	switch(N)
+	{
+		case 0: return 0;
+		case 1: return mat(0, 0);
+		case 2: return mat(0,0)*mat(1,1) - mat(1,0)*mat(0,1);
+	}
+
+	T res = T{1};
+
+#if MATH_USE_FLAT_DET == 0
+	// symmetric (hermitian) positive-definite matrix: det = prod_i L_ii^2
+	if(is_symm_or_herm<t_mat>(mat))
+	{
+		const auto [L, pos_def] = cholesky<t_mat>(mat);
+		if(pos_def)
+		{
+			for(size_t i=0; i<N; ++i)
+				res *= L(i,i);
+			return res*res;
+		}
+	}
+
+	const auto [LU, perm, num_swaps, regular] = lu<t_mat>(mat);
+
+	for(size_t i=0; i<N; ++i)
+		res *= LU(i,i);
+
+	// odd number of row swaps
+	if((num_swaps % 2) != 0)
+		res = -res;
+
+#else
+	std::vector<T> matFlat = convert<std::vector<T>, t_mat>(mat);
+	res = flat_det<std::vector<T>>(matFlat, mat.size1());
+#endif
+
+	return res;
+}
+
+
+/**
+ * determinant of a fixed-size matrix up to 4x4, using explicit formulas
+ * @see https://www.geometrictools.com/Documentation/LaplaceExpansionTheorem.pdf
+ */
+template<class t_mat, class t_vec>
+typename t_mat::value_type det(const t_mat& mat)
+requires is_mat<t_mat> && is_fixed_mat<t_mat>
+	&& (t_mat::size1() == t_mat::size2()) && (t_mat::size1() <= 4)
+{
+	using T = typename t_mat::value_type;
+	constexpr std::size_t N = t_mat::size1();
+
+	if constexpr(N == 0)
+	{
+		return T(0);
+	}
+	else if constexpr(N == 1)
+	{
+		return mat(0,0);
+	}
+	else if constexpr(N == 2)
+	{
+		return mat(0,0)*mat(1,1) - mat(1,0)*mat(0,1);
+	}
+	else if constexpr(N == 3)
+	{
+		return mat(0,0) * (mat(1,1)*mat(2,2) - mat(1,2)*mat(2,1))
+			- mat(0,1) * (mat(1,0)*mat(2,2) - mat(1,2)*mat(2,0))
+			+ mat(0,2) * (mat(1,0)*mat(2,1) - mat(1,1)*mat(2,0));
+	}
+	else
+	{
+		// 2x2 sub-determinants of the first and last two rows
+		const T a0 = mat(0,0)*mat(1,1) - mat(0,1)*mat(1,0);
+		const T a1 = mat(0,0)*mat(1,2) - mat(0,2)*mat(1,0);
+		const T a2 = mat(0,0)*mat(1,3) - mat(0,3)*mat(1,0);
+		const T a3 = mat(0,1)*mat(1,2) - mat(0,2)*mat(1,1);
+		const T a4 = mat(0,1)*mat(1,3) - mat(0,3)*mat(1,1);
+		const T a5 = mat(0,2)*mat(1,3) - mat(0,3)*mat(1,2);
+		const T b0 = mat(2,0)*mat(3,1) - mat(2,1)*mat(3,0);
+		const T b1 = mat(2,0)*mat(3,2) - mat(2,2)*mat(3,0);
+		const T b2 = mat(2,0)*mat(3,3) - mat(2,3)*mat(3,0);
+		const T b3 = mat(2,1)*mat(3,2) - mat(2,2)*mat(3,1);
+		const T b4 = mat(2,1)*mat(3,3) - mat(2,3)*mat(3,1);
+		const T b5 = mat(2,2)*mat(3,3) - mat(2,3)*mat(3,2);
+
+		return a0*b5 - a1*b4 + a2*b3 + a3*b2 - a4*b1 + a5*b0;
+	}
+}
+
+
+/**
+ * trace
+ */
+template<class t_mat>
+typename t_mat::value_type trace(const t_mat& mat)
+requires is_mat<t_mat>
+{
+	using t_size = decltype(mat.size1());
+	using T = typename t_mat::value_type;
+
+	T _tr = T(0);
+
+	t_size N = std::min(mat.size1(), mat.size2());
+	for(t_size i=0; i<N; ++i)
+		_tr += mat(i,i);
+
+	return _tr;
+}
+
+
+/**
+ * inverted matrix
+ * solves A*x_i = e_i for all unit vectors e_i using the LU (or Cholesky) decomposition,
+ * or, with MATH_USE_FLAT_DET, uses the adjugate matrix
+ * @see https://en.wikipedia.org/wiki/Invertible_matrix#Methods_of_matrix_inversion
+ * @see https://en.wikipedia.org/wiki/Invertible_matrix#In_relation_to_its_adjugate
+ * @see https://en.wikipedia.org/wiki/Adjugate_matrix
+ */
+template<class t_mat, class t_vec>
+std::tuple<t_mat, bool> inv(const t_mat& mat)
+requires is_mat<t_mat> && is_vec<t_vec>
+{
+	using T = typename t_mat::value_type;
+	using t_idx = decltype(mat.size1());
+
+	const t_idx N = mat.size1();
+
+	// fail if matrix is not square
+	if(N != mat.size2())
+		return std::make_tuple(t_mat(), false);
+
+	t_mat matInv = create<t_mat>(N, N);
+
+#if MATH_USE_FLAT_DET == 0
+	t_vec vecUnit = zero<t_vec>(N);
+
+	// symmetric (hermitian) positive-definite matrix
+	if(is_symm_or_herm<t_mat>(mat))
+	{
+		const auto [L, pos_def] = cholesky<t_mat>(mat);
+		if(pos_def)
+		{
+			for(t_idx i=0; i<N; ++i)
+			{
+				vecUnit[i] = T(1);
+				set_col<t_mat, t_vec>(matInv, cholesky_solve<t_mat, t_vec>(L, vecUnit), i);
+				vecUnit[i] = T(0);
+			}
+
+			return std::make_tuple(matInv, true);
+		}
+	}
+
+	const auto [LU, perm, num_swaps, regular] = lu<t_mat>(mat);
+
+	// fail if matrix is singular
+	if(!regular)
+		return std::make_tuple(t_mat(), false);
+
+	for(t_idx i=0; i<N; ++i)
+	{
+		vecUnit[i] = T(1);
+		set_col<t_mat, t_vec>(matInv, lu_solve<t_mat, t_vec>(LU, perm, vecUnit), i);
+		vecUnit[i] = T(0);
+	}
+
+#else
+	using t_matvec = std::vector<T>;
+	const t_matvec matFlat = convert<std::vector<T>, t_mat>(mat);
+	const T fullDet = flat_det<t_matvec>(matFlat, N);
+
+	// fail if determinant is zero
+	if(equals<T>(fullDet, 0))
+		return std::make_tuple(t_mat(), false);
+
+	for(t_idx i=0; i<N; ++i)
+	{
+		for(t_idx j=0; j<N; ++j)
+		{
+			const t_matvec subMat = flat_submat<t_matvec>(matFlat, N, N, i, j);
+			const T subDet = flat_det<t_matvec>(subMat, N-1);
+
+			const T sgn = ((i+j) % 2) == 0 ? T(1) : T(-1);
+			matInv(j,i) = sgn * subDet;
+		}
+	}
+
+	matInv = matInv / fullDet;
+#endif
+
+	return std::make_tuple(matInv, true);
+}
+
+
+/**
+ * inverted fixed-size matrix up to 4x4, using the explicit adjugate matrix
+ * @see https://www.geometrictools.com/Documentation/LaplaceExpansionTheorem.pdf
+ */
+template<class t_mat, class t_vec>
+std::tuple<t_mat, bool> inv(const t_mat& mat)
+requires is_mat<t_mat> && is_vec<t_vec> && is_fixed_mat<t_mat>
+	&& (t_mat::size1() == t_mat::size2()) && (t_mat::size1() <= 4)
+{
+	using T = typename t_mat::value_type;
+	constexpr std::size_t N = t_mat::size1();
+
+	t_mat matInv{};
+	T fullDet{};
+
+	if constexpr(N == 0)
+	{
+		return std::make_tuple(matInv, false);
+	}
+	else if constexpr(N == 1)
+	{
+		fullDet = mat(0,0);
+		matInv(0,0) = T(1);
+	}
+	else if constexpr(N == 2)
+	{
+		fullDet = det<t_mat, t_vec>(mat);
+		matInv(0,0) = mat(1,1);  matInv(0,1) = -mat(0,1);
+		matInv(1,0) = -mat(1,0); matInv(1,1) = mat(0,0);
+	}
+	else if constexpr(N == 3)
+	{
+		matInv(0,0) = mat(1,1)*mat(2,2) - mat(1,2)*mat(2,1);
+		matInv(0,1) = mat(0,2)*mat(2,1) - mat(0,1)*mat(2,2);
+		matInv(0,2) = mat(0,1)*mat(1,2) - mat(0,2)*mat(1,1);
+		matInv(1,0) = mat(1,2)*mat(2,0) - mat(1,0)*mat(2,2);
+		matInv(1,1) = mat(0,0)*mat(2,2) - mat(0,2)*mat(2,0);
+		matInv(1,2) = mat(0,2)*mat(1,0) - mat(0,0)*mat(1,2);
+		matInv(2,0) = mat(1,0)*mat(2,1) - mat(1,1)*mat(2,0);
+		matInv(2,1) = mat(0,1)*mat(2,0) - mat(0,0)*mat(2,1);
+		matInv(2,2) = mat(0,0)*mat(1,1) - mat(0,1)*mat(1,0);
+
+		fullDet = mat(0,0)*matInv(0,0) + mat(0,1)*matInv(1,0) + mat(0,2)*matInv(2,0);
+	}
+	else
+	{
+		// 2x2 sub-determinants of the first and last two rows
+		const T a0 = mat(0,0)*mat(1,1) - mat(0,1)*mat(1,0);
+		const T a1 = mat(0,0)*mat(1,2) - mat(0,2)*mat(1,0);
+		const T a2 = mat(0,0)*mat(1,3) - mat(0,3)*mat(1,0);
+		const T a3 = mat(0,1)*mat(1,2) - mat(0,2)*mat(1,1);
+		const T a4 = mat(0,1)*mat(1,3) - mat(0,3)*mat(1,1);
+		const T a5 = mat(0,2)*mat(1,3) - mat(0,3)*mat(1,2);
+		const T b0 = mat(2,0)*mat(3,1) - mat(2,1)*mat(3,0);
+		const T b1 = mat(2,0)*mat(3,2) - mat(2,2)*mat(3,0);
+		const T b2 = mat(2,0)*mat(3,3) - mat(2,3)*mat(3,0);
+		const T b3 = mat(2,1)*mat(3,2) - mat(2,2)*mat(3,1);
+		const T b4 = mat(2,1)*mat(3,3) - mat(2,3)*mat(3,1);
+		const T b5 = mat(2,2)*mat(3,3) - mat(2,3)*mat(3,2);
+
+		fullDet = a0*b5 - a1*b4 + a2*b3 + a3*b2 - a4*b1 + a5*b0;
+
+		matInv(0,0) = + mat(1,1)*b5 - mat(1,2)*b4 + mat(1,3)*b3;
+		matInv(0,1) = - mat(0,1)*b5 + mat(0,2)*b4 - mat(0,3)*b3;
+		matInv(0,2) = + mat(3,1)*a5 - mat(3,2)*a4 + mat(3,3)*a3;
+		matInv(0,3) = - mat(2,1)*a5 + mat(2,2)*a4 - mat(2,3)*a3;
+		matInv(1,0) = - mat(1,0)*b5 + mat(1,2)*b2 - mat(1,3)*b1;
+		matInv(1,1) = + mat(0,0)*b5 - mat(0,2)*b2 + mat(0,3)*b1;
+		matInv(1,2) = - mat(3,0)*a5 + mat(3,2)*a2 - mat(3,3)*a1;
+		matInv(1,3) = + mat(2,0)*a5 - mat(2,2)*a2 + mat(2,3)*a1;
+		matInv(2,0) = + mat(1,0)*b4 - mat(1,1)*b2 + mat(1,3)*b0;
+		matInv(2,1) = - mat(0,0)*b4 + mat(0,1)*b2 - mat(0,3)*b0;
+		matInv(2,2) = + mat(3,0)*a4 - mat(3,1)*a2 + mat(3,3)*a0;
+		matInv(2,3) = - mat(2,0)*a4 + mat(2,1)*a2 - mat(2,3)*a0;
+		matInv(3,0) = - mat(1,0)*b3 + mat(1,1)*b1 - mat(1,2)*b0;
+		matInv(3,1) = + mat(0,0)*b3 - mat(0,1)*b1 + mat(0,2)*b0;
+		matInv(3,2) = - mat(3,0)*a3 + mat(3,1)*a1 - mat(3,2)*a0;
+		matInv(3,3) = + mat(2,0)*a3 - mat(2,1)*a1 + mat(2,2)*a0;
+	}
+
+	// fail if determinant is zero
+	if(equals<T>(fullDet, 0))
+		return std::make_tuple(t_mat{}, false);
+
+	const T invDet = T(1) / fullDet;
+	for(std::size_t i=0; i<N; ++i)
+		for(std::size_t j=0; j<N; ++j)
+			matInv(i,j) *= invDet;
+
+	return std::make_tuple(matInv, true);
+}
+
+
+/**
+ * solves the linear equation system A*x = b
+ * uses the Cholesky decomposition for symmetric (hermitian) positive-definite matrices
+ * and the LU decomposition otherwise
+ * @returns [x, was a solution found?]
+ */
+template<class t_mat, class t_vec>
+std::tuple<t_vec, bool> solve(const t_mat& mat, const t_vec& vec)
+requires is_mat<t_mat> && is_vec<t_vec>
+{
+	// fail if matrix is not square or the sizes do not match
+	if(mat.size1() != mat.size2() || std::size_t(mat.size1()) != std::size_t(vec.size()))
+		return std::make_tuple(t_vec(), false);
+
+	// symmetric (hermitian) positive-definite matrix
+	if(is_symm_or_herm<t_mat>(mat))
+	{
+		const auto [L, pos_def] = cholesky<t_mat>(mat);
+		if(pos_def)
+			return std::make_tuple(cholesky_solve<t_mat, t_vec>(L, vec), true);
+	}
+
+	const auto [LU, perm, num_swaps, regular] = lu<t_mat>(mat);
+
+	// fail if matrix is singular
+	if(!regular)
+		return std::make_tuple(t_vec(), false);
+
+	return std::make_tuple(lu_solve<t_mat, t_vec>(LU, perm, vec), true);
+}
+
+
+/**
+ * eigenvalues and -vectors of a real symmetric or complex hermitian matrix, in place
+ *
+ * the matrix is first reduced to tridiagonal form using householder reflections,
+ * P = 1 - tau*|v><v| (i.e. ortho_mirror_op with an unnormalised vector), which are
+ * applied implicitly and stored in the lower triangle of the matrix. the phases of the
+ * complex off-diagonal elements are then rotated away and the real tridiagonal matrix
+ * is diagonalised using implicit QL iterations.
+ *
+ * mat: overwritten with the eigenvectors in its columns (undefined if !calc_evecs)
+ * evals: eigenvalues in ascending order
+ * apart from the O(N) work vectors allocated once per call, everything is done in place
+ * @returns did the QL iterations converge?
+ *
+ * @see (Scarpino11), pp. 269-272 for the householder reflections
+ * @see https://en.wikipedia.org/wiki/Householder_transformation#Tridiagonalization
+ * @see W. H. Press et al., "Numerical Recipes in C", 2nd ed. (1992), ch. 11.2-11.3
+ */
+template<class t_mat, class t_vec>
+bool eigenvecs_herm_inplace(t_mat& mat, t_vec& evals, bool calc_evecs = true, std::size_t max_iter = 64)
+requires is_mat<t_mat> && is_vec<t_vec>
+{
+	using T = typename t_mat::value_type;
+	using t_real = decltype(std::abs(T{}));
+	using t_idx = decltype(mat.size1());
+
+	const t_idx N = mat.size1();
+	if(N != mat.size2())
+		return false;
+	if(std::size_t(evals.size()) != std::size_t(N))
+		evals = create<t_vec>(N);
+	if(N == 0)
+		return true;
+
+	auto conj = [](const T& t) -> T
+	{
+		if constexpr(is_complex<T>)
+			return std::conj(t);
+		else
+			return t;
+	};
+
+	// work vectors
+	std::vector<T> p(N), offdiag(N);
+	std::vector<t_real> tau(N), d(N), e(N);
+
+	// ------------------------------------------------------------------------
+	// householder tridiagonalisation
+	for(t_idx k=0; k+2<N; ++k)
 	{
-		if(iRow == iRemRow)
+		// column below the diagonal
+		t_real alpha{};
+		for(t_idx i=k+1; i<N; ++i)
+			alpha += std::norm(mat(i,k));
+		alpha = std::sqrt(alpha);
+
+		const T x0 = mat(k+1,k);
+		const t_real x0_abs = std::abs(x0);
+		if(alpha == t_real(0))
+		{
+			tau[k] = t_real(0);
+			offdiag[k] = T(0);
 			continue;
+		}
 
-		for(t_size iCol=0; iCol<iNumCols; ++iCol)
+		// v = x + phase(x0)*|x|*e_1, stored in the column
+		const T phase = x0_abs > t_real(0) ? x0 / x0_abs : T(1);
+		mat(k+1,k) += phase * alpha;
+		tau[k] = t_real(1) / (alpha * (alpha + x0_abs));
+		offdiag[k] = -phase * alpha;
+
+		// p = tau * B|v>
+		for(t_idx i=k+1; i<N; ++i)
 		{
-			if(iCol == iRemCol)
-				continue;
-			vec.push_back(mat[iRow*iNumCols + iCol]);
+			T sum{};
+			for(t_idx j=k+1; j<N; ++j)
+				sum += mat(i,j) * mat(j,k);
+			p[i] = tau[k] * sum;
 		}
-	}
 
-	return vec;
-}
+		// w = p - tau/2 * <v|p> * v
+		T vp{};
+		for(t_idx i=k+1; i<N; ++i)
+			vp += conj(mat(i,k)) * p[i];
+		const T K = tau[k] * t_real(0.5) * vp;
+		for(t_idx i=k+1; i<N; ++i)
+			p[i] -= K * mat(i,k);
+
+		// B = P B P = B - |v><w| - |w><v|
+		for(t_idx i=k+1; i<N; ++i)
+			for(t_idx j=k+1; j<N; ++j)
+				mat(i,j) -= mat(i,k)*conj(p[j]) + p[i]*conj(mat(j,k));
+	}
 
+	for(t_idx i=0; i<N; ++i)
+		d[i] = std::real(mat(i,i));
+	if(N >= 2)
+		offdiag[N-2] = mat(N-1, N-2);
 
-/**
- * submatrix removing a column/row from a matrix
- */
-template<class t_mat>
-t_mat submat(const t_mat& mat, decltype(mat.size1()) iRemRow, decltype(mat.size2()) iRemCol)
-requires is_dyn_mat<t_mat>
-{
-	using size_t = decltype(mat.size1());
-	t_mat matRet = m::create<t_mat>(mat.size1()-1, mat.size2()-1);
+	// rotate the phases of the off-diagonal elements away: T = D T_real D^H
+	p[0] = T(1);
+	for(t_idx i=0; i+1<N; ++i)
+	{
+		e[i] = std::abs(offdiag[i]);
+		p[i+1] = e[i] > t_real(0) ? p[i] * offdiag[i] / e[i] : p[i];
+	}
+	e[N-1] = t_real(0);
+	// ------------------------------------------------------------------------
 
-	size_t iResRow = 0;
-	for(size_t iRow=0; iRow<mat.size1(); ++iRow)
+	// ------------------------------------------------------------------------
+	// accumulate the householder reflections backwards, Q = P_0 P_1 ... P_(N-3), and Z = Q D
+	if(calc_evecs)
 	{
-		if(iRow == iRemRow)
-			continue;
+		for(t_idx i=(N>=2 ? N-2 : 0); i<N; ++i)
+			for(t_idx j=(N>=2 ? N-2 : 0); j<N; ++j)
+				mat(i,j) = (i==j ? T(1) : T(0));
 
-		size_t iResCol = 0;
-		for(size_t iCol=0; iCol<mat.size2(); ++iCol)
+		for(t_idx k=(N>=2 ? N-2 : 0); k-->0;)
 		{
-			if(iCol == iRemCol)
-				continue;
+			for(t_idx j=k+1; j<N; ++j)
+			{
+				T vq{};
+				for(t_idx i=k+1; i<N; ++i)
+					vq += conj(mat(i,k)) * mat(i,j);
+				vq *= tau[k];
 
-			matRet(iResRow, iResCol) = mat(iRow, iCol);
-			++iResCol;
+				for(t_idx i=k+1; i<N; ++i)
+					mat(i,j) -= mat(i,k) * vq;
+			}
+
+			// the elements left of the diagonal still hold the earlier reflection vectors
+			for(t_idx i=k+1; i<N; ++i)
+				mat(i,k) = mat(k,i) = T(0);
+			mat(k,k) = T(1);
 		}
 
-		++iResRow;
+		for(t_idx i=0; i<N; ++i)
+			for(t_idx j=0; j<N; ++j)
+				mat(i,j) *= p[j];
 	}
+	// ------------------------------------------------------------------------
 
-	return matRet;
-}
+	// ------------------------------------------------------------------------
+	// implicit QL iterations on the real tridiagonal matrix
+	const t_real eps = std::numeric_limits<t_real>::epsilon();
 
+	for(t_idx l=0; l<N; ++l)
+	{
+		for(std::size_t iter=0; ; ++iter)
+		{
+			// find small off-diagonal element to split the matrix
+			t_idx m = l;
+			for(; m+1<N; ++m)
+			{
+				const t_real dd = std::abs(d[m]) + std::abs(d[m+1]);
+				if(std::abs(e[m]) <= eps*dd)
+					break;
+			}
 
-/**
- * determinant from a square matrix stored in a vector container
- * @see (Merziger06), p. 185
- */
-template<class t_vec>
-typename t_vec::value_type flat_det(const t_vec& mat, std::size_t iN)
-requires is_basic_vec<t_vec>
-{
-	using t_size = decltype(mat.size());
-	using T = typename t_vec::value_type;
+			if(m == l)
+				break;
+			if(iter >= max_iter)
+				return false;
 
-	// special cases
-	if(iN == 0)
-		return 0;
-	else if(iN == 1)
-		return mat[0];
-	else if(iN == 2)
-		return mat[0]*mat[3] - mat[1]*mat[2];
+			// shift
+			t_real g = (d[l+1] - d[l]) / (t_real(2) * e[l]);
+			t_real r = std::hypot(g, t_real(1));
+			g = d[m] - d[l] + e[l] / (g + (g >= t_real(0) ? r : -r));
 
+			t_real s = 1, c = 1, p_ql = 0;
+			bool underflow = false;
 
-	T fullDet = T(0);
-	t_size iRow = 0;
+			for(t_idx i=m; i-->l;)
+			{
+				const t_real f = s * e[i];
+				const t_real b = c * e[i];
+				r = std::hypot(f, g);
+				e[i+1] = r;
+
+				if(r == t_real(0))
+				{
+					// recover from underflow
+					d[i+1] -= p_ql;
+					e[m] = t_real(0);
+					underflow = true;
+					break;
+				}
+
+				s = f / r;
+				c = g / r;
+				g = d[i+1] - p_ql;
+				r = (d[i] - g)*s + t_real(2)*c*b;
+				p_ql = s * r;
+				d[i+1] = g + p_ql;
+				g = c*r - b;
+
+				// rotate eigenvectors
+				if(calc_evecs)
+				{
+					for(t_idx k=0; k<N; ++k)
+					{
+						const T z = mat(k,i+1);
+						mat(k,i+1) = s*mat(k,i) + c*z;
+						mat(k,i) = c*mat(k,i) - s*z;
+					}
+				}
+			}
 
-	// get row with maximum number of zeros
-	t_size iMaxNumZeros = 0;
-	for(t_size iCurRow=0; iCurRow<iN; ++iCurRow)
+			if(underflow)
+				continue;
+
+			d[l] -= p_ql;
+			e[l] = g;
+			e[m] = t_real(0);
+		}
+	}
+	// ------------------------------------------------------------------------
+
+	// sort by ascending eigenvalues
+	for(t_idx i=0; i<N; ++i)
 	{
-		t_size iNumZeros = 0;
-		for(t_size iCurCol=0; iCurCol<iN; ++iCurCol)
+		t_idx min_idx = i;
+		for(t_idx j=i+1; j<N; ++j)
 		{
-			if(equals<T>(mat[iCurRow*iN + iCurCol], T(0)))
-				++iNumZeros;
+			if(d[j] < d[min_idx])
+				min_idx = j;
 		}
 
-		if(iNumZeros > iMaxNumZeros)
+		if(min_idx != i)
 		{
-			iRow = iCurRow;
-			iMaxNumZeros = iNumZeros;
+			std::swap(d[i], d[min_idx]);
+			if(calc_evecs)
+			{
+				for(t_idx k=0; k<N; ++k)
+					std::swap(mat(k,i), mat(k,min_idx));
+			}
 		}
-	}
 
+		evals[i] = d[i];
+	}
 
-	// recursively expand determiant along a row
-	for(t_size iCol=0; iCol<iN; ++iCol)
-	{
-		const T elem = mat[iRow*iN + iCol];
-		if(equals<T>(elem, 0))
-			continue;
+	return true;
+}
 
-		const T sgn = ((iRow+iCol) % 2) == 0 ? T(1) : T(-1);
-		const t_vec subMat = flat_submat<t_vec>(mat, iN, iN, iRow, iCol);
-		const T subDet = flat_det<t_vec>(subMat, iN-1) * sgn;
 
-		fullDet += elem * subDet;
-	}
+/**
+ * eigenvalues and -vectors of a real symmetric or complex hermitian matrix
+ * @returns [eigenvalues in ascending order, eigenvectors in the columns, ok?]
+ * @see eigenvecs_herm_inplace
+ */
+template<class t_mat, class t_vec>
+std::tuple<t_vec, t_mat, bool> eigenvecs_herm(const t_mat& mat, bool calc_evecs = true)
+requires is_mat<t_mat> && is_vec<t_vec>
+{
+	t_mat evecs = mat;
+	t_vec evals = create<t_vec>(mat.size1());
 
-	return fullDet;
+	bool ok = eigenvecs_herm_inplace<t_mat, t_vec>(evecs, evals, calc_evecs);
+	return std::make_tuple(evals, evecs, ok);
 }
 
 
 /**
- * determinant
+ * singular value decomposition A = U * diag(sigma) * V^H for rows >= cols, in place
+ * using one-sided jacobi rotations which orthogonalise the columns of A
+ *
+ * mat: the rows x cols matrix A, overwritten with U
+ * sigma: singular values in descending order
+ * V: cols x cols unitary matrix
+ * no memory is allocated if sigma and V already have the correct sizes
+ * @returns did the jacobi sweeps converge?
+ *
+ * @see J. Demmel and K. Veselic, SIAM J. Matrix Anal. Appl. 13(4), pp. 1204-1245 (1992), DOI: 10.1137/0613074
+ * @see https://en.wikipedia.org/wiki/Jacobi_eigenvalue_algorithm
  */
 template<class t_mat, class t_vec>
-typename t_mat::value_type det(const t_mat& mat)
-requires is_mat<t_mat>
+bool svd_inplace(t_mat& mat, t_vec& sigma, t_mat& V, std::size_t max_sweeps = 64)
+requires is_mat<t_mat> && is_vec<t_vec>
 {
 	using T = typename t_mat::value_type;
-	using size_t = decltype(mat.size1());
+	using t_real = decltype(std::abs(T{}));
+	using t_idx = decltype(mat.size1());
 
-	if(mat.size1() != mat.size2())
-		return 0;
+	const t_idx rows = mat.size1();
+	const t_idx cols = mat.size2();
+	if(rows < cols)
+		return false;
 
-	size_t N = mat.size1();
+	if(std::size_t(sigma.size()) != std::size_t(cols))
+		sigma = create<t_vec>(cols);
+	if(V.size1() != cols || V.size2() != cols)
+		V = create<t_mat>(cols, cols);
+	for(t_idx i=0; i<cols; ++i)
+		for(t_idx j=0; j<cols; ++j)
+			V(i,j) = (i==j ? T(1) : T(0));
 
-	// special cases
-	switch(N)
+	auto conj = [](const T& t) -> T
 	{
-		case 0: return 0;
-		case 1: return mat(0, 0);
-		case 2: return mat(0,0)*mat(1,1) - mat(1,0)*mat(0,1);
-	}
-
-	T res = T{1};
-
-#if MATH_USE_FLAT_DET == 0
-	const auto [Q, R, num_mirrors] = qr<t_mat, t_vec>(mat);
-
-	for(size_t i=0; i<N; ++i)
-		res *= R(i,i);
+		if constexpr(is_complex<T>)
+			return std::conj(t);
+		else
+			return t;
+	};
 
-	// odd number of mirror operations for qr
-	if((num_mirrors % 2) != 0)
-		res = -res;
+	// rotates columns p and q of the matrix
+	auto rotate = [&conj](t_mat& M, t_idx num_rows, t_idx p, t_idx q, t_real c, t_real s, const T& phase)
+	{
+		for(t_idx k=0; k<num_rows; ++k)
+		{
+			const T a = M(k,p);
+			const T b = M(k,q) * conj(phase);
+			M(k,p) = c*a - s*b;
+			M(k,q) = s*a + c*b;
+		}
+	};
 
-	// test sign of det(Q)
-	//std::vector<T> matFlatQ = convert<std::vector<T>, t_mat>(Q);
-	//T detQ = flat_det<std::vector<T>>(matFlatQ, Q.size1());
-	//if(detQ < 0.) res = -res;
+	const t_real eps = std::numeric_limits<t_real>::epsilon();
+	bool converged = false;
 
-#else
-	std::vector<T> matFlat = convert<std::vector<T>, t_mat>(mat);
-	res = flat_det<std::vector<T>>(matFlat, mat.size1());
-#endif
+	for(std::size_t sweep=0; sweep<max_sweeps && !converged; ++sweep)
+	{
+		converged = true;
 
-	return res;
-}
+		for(t_idx p=0; p+1<cols; ++p)
+		{
+			for(t_idx q=p+1; q<cols; ++q)
+			{
+				// 2x2 sub-matrix of A^H A
+				t_real alpha{}, beta{};
+				T gamma{};
+				for(t_idx k=0; k<rows; ++k)
+				{
+					alpha += std::norm(mat(k,p));
+					beta += std::norm(mat(k,q));
+					gamma += conj(mat(k,p)) * mat(k,q);
+				}
+
+				const t_real gamma_abs = std::abs(gamma);
+				if(gamma_abs == t_real(0) || gamma_abs <= eps * std::sqrt(alpha*beta))
+					continue;
+				converged = false;
+
+				// rotation which makes the columns orthogonal
+				const t_real zeta = (beta - alpha) / (t_real(2) * gamma_abs);
+				const t_real t = (zeta >= t_real(0) ? t_real(1) : t_real(-1)) /
+					(std::abs(zeta) + std::sqrt(t_real(1) + zeta*zeta));
+				const t_real c = t_real(1) / std::sqrt(t_real(1) + t*t);
+				const t_real s = c * t;
+				const T phase = gamma / gamma_abs;
+
+				rotate(mat, rows, p, q, c, s, phase);
+				rotate(V, cols, p, q, c, s, phase);
+			}
+		}
+	}
 
+	// singular values are the column norms
+	for(t_idx j=0; j<cols; ++j)
+	{
+		t_real n{};
+		for(t_idx k=0; k<rows; ++k)
+			n += std::norm(mat(k,j));
+		n = std::sqrt(n);
 
-/**
- * trace
- */
-template<class t_mat>
-typename t_mat::value_type trace(const t_mat& mat)
-requires is_mat<t_mat>
-{
-	using t_size = decltype(mat.size1());
-	using T = typename t_mat::value_type;
+		sigma[j] = n;
+		if(n > t_real(0))
+		{
+			for(t_idx k=0; k<rows; ++k)
+				mat(k,j) /= n;
+		}
+	}
 
-	T _tr = T(0);
+	// sort by descending singular values
+	for(t_idx i=0; i<cols; ++i)
+	{
+		t_idx max_idx = i;
+		for(t_idx j=i+1; j<cols; ++j)
+		{
+			if(std::real(sigma[j]) > std::real(sigma[max_idx]))
+				max_idx = j;
+		}
 
-	t_size N = std::min(mat.size1(), mat.size2());
-	for(t_size i=0; i<N; ++i)
-		_tr += mat(i,i);
+		if(max_idx != i)
+		{
+			std::swap(sigma[i], sigma[max_idx]);
+			for(t_idx k=0; k<rows; ++k)
+				std::swap(mat(k,i), mat(k,max_idx));
+			for(t_idx k=0; k<cols; ++k)
+				std::swap(V(k,i), V(k,max_idx));
+		}
+	}
 
-	return _tr;
+	return converged;
 }
 
 
 /**
- * inverted matrix
- * @see https://en.wikipedia.org/wiki/Invertible_matrix#In_relation_to_its_adjugate
- * @see https://en.wikipedia.org/wiki/Adjugate_matrix
+ * singular value decomposition A = U * diag(sigma) * V^H
+ * for a rows x cols matrix, U is rows x N and V is cols x N with N = min(rows, cols)
+ * @returns [U, singular values in descending order, V, ok?]
+ * @see svd_inplace
  */
 template<class t_mat, class t_vec>
-std::tuple<t_mat, bool> inv(const t_mat& mat)
+std::tuple<t_mat, t_vec, t_mat, bool> svd(const t_mat& mat)
 requires is_mat<t_mat> && is_vec<t_vec>
 {
-	using T = typename t_mat::value_type;
-	using t_idx = decltype(mat.size1());
-
-	const t_idx N = mat.size1();
-
-	// fail if matrix is not square
-	if(N != mat.size2())
-		return std::make_tuple(t_mat(), false);
+	t_vec sigma = create<t_vec>(std::min(mat.size1(), mat.size2()));
+	t_mat U, V;
 
-#if MATH_USE_FLAT_DET == 0
-	const T fullDet = det<t_mat, t_vec>(mat);
-
-#else
-	using t_matvec = std::vector<T>;
-	const t_matvec matFlat = convert<std::vector<T>, t_mat>(mat);
-	const T fullDet = flat_det<t_matvec>(matFlat, N);
-#endif
-
-	// fail if determinant is zero
-	if(equals<T>(fullDet, 0))
-		return std::make_tuple(t_mat(), false);
-
-	t_mat matInv = create<t_mat>(N, N);
+	if(mat.size1() >= mat.size2())
+	{
+		U = mat;
+		bool ok = svd_inplace<t_mat, t_vec>(U, sigma, V);
+		return std::make_tuple(U, sigma, V, ok);
+	}
 
-	for(t_idx i=0; i<N; ++i)
+	// decompose A^H = V * diag(sigma) * U^H
+	V = create<t_mat>(mat.size2(), mat.size1());
+	for(decltype(mat.size1()) i=0; i<mat.size1(); ++i)
 	{
-		for(t_idx j=0; j<N; ++j)
+		for(decltype(mat.size1()) j=0; j<mat.size2(); ++j)
 		{
-#if MATH_USE_FLAT_DET == 0
-			// careful with size1() and size2() of static matrices (not fulfilling is_dyn_mat!
-			const t_mat subMat = submat<t_mat>(mat, i, j);
-			const T subDet = det<t_mat, t_vec>(subMat);
-
-#else
-			// alternatively, better for static matrices:
-			const t_matvec subMat = flat_submat<t_matvec>(matFlat, N, N, i, j);
-			const T subDet = flat_det<t_matvec>(subMat, N-1);
-#endif
-
-			const T sgn = ((i+j) % 2) == 0 ? T(1) : T(-1);
-			matInv(j,i) = sgn * subDet;
+			if constexpr(is_complex<typename t_mat::value_type>)
+				V(j,i) = std::conj(mat(i,j));
+			else
+				V(j,i) = mat(i,j);
 		}
 	}
 
-	matInv = matInv / fullDet;
-	return std::make_tuple(matInv, true);
+	bool ok = svd_inplace<t_mat, t_vec>(V, sigma, U);
+	return std::make_tuple(U, sigma, V, ok);
 }
 
 
@@ -2226,6 +3292,24 @@ requires is_basic_vec<t_vec>
 }
 
 
+/**
+ * 3-dim cross product of fixed-size vectors
+ * (for larger vectors, e.g. in homogeneous coordinates, the remaining components are zero)
+ */
+template<class t_vec>
+t_vec cross(const t_vec& vec1, const t_vec& vec2)
+requires is_basic_vec<t_vec> && is_fixed_vec<t_vec> && (t_vec::size() >= 3) && (t_vec::size() <= 4)
+{
+	t_vec vec{};
+
+	vec[0] = vec1[1]*vec2[2] - vec1[2]*vec2[1];
+	vec[1] = vec1[2]*vec2[0] - vec1[0]*vec2[2];
+	vec[2] = vec1[0]*vec2[1] - vec1[1]*vec2[0];
+
+	return vec;
+}
+
+
 /**
  * cross product matrix (3x3)
  * @see https://en.wikipedia.org/wiki/Skew-symmetric_matrix
@@ -2257,8 +3341,29 @@ requires is_basic_vec<t_vec> && is_mat<t_mat>
 template<class t_mat, class t_vec>
 t_mat rotation(const t_vec& axis, const typename t_vec::value_type angle, bool is_normalised=1)
 requires is_vec<t_vec> && is_mat<t_mat>
+{
+	t_mat mat = create<t_mat>(3, 3);
+	rotation_into<t_mat, t_vec>(mat, axis, angle, is_normalised);
+	return mat;
+}
+
+
+/**
+ * SO(3) matrix to rotate around an axis, written into an existing matrix of at least 3x3
+ * elements, without allocations; larger matrices (e.g. for homogeneous coordinates)
+ * are filled up with the identity
+ *
+ * the projectors |v><v| and 1-|v><v| and the skew-symmetric matrix of rotation()
+ * are summed directly per element:
+ * R_ij = v_i v_j + cos(angle) * (delta_ij - v_i v_j) + sin(angle) * [v]_x,ij
+ * @see https://en.wikipedia.org/wiki/Rodrigues%27_rotation_formula
+ */
+template<class t_mat, class t_vec>
+void rotation_into(t_mat& mat, const t_vec& axis, const typename t_vec::value_type angle, bool is_normalised=1)
+requires is_vec<t_vec> && is_mat<t_mat>
 {
 	using t_real = typename t_vec::value_type;
+	using t_size = decltype(mat.size1());
 
 	const t_real c = std::cos(angle);
 	const t_real s = std::sin(angle);
@@ -2267,33 +3372,30 @@ requires is_vec<t_vec> && is_mat<t_mat>
 	if(!is_normalised)
 		len = norm<t_vec>(axis);
 
-	// ----------------------------------------------------
-	// special cases: rotations around [100], [010], [001]
-	if(equals(axis, create<t_vec>({len,0,0})))
-		return create<t_mat>({{1,0,0}, {0,c,s}, {0,-s,c}});
-	else if(equals(axis, create<t_vec>({0,len,0})))
-		return create<t_mat>({{c,0,-s}, {0,1,0}, {s,0,c}});
-	else if(equals(axis, create<t_vec>({0,0,len})))
-		return create<t_mat>({{c,s,0}, {-s,c,0}, {0,0,1}});
-
-	// ----------------------------------------------------
-	// general case
-	// project along rotation axis using |v><v|
-	t_mat matProj1 = projector<t_mat, t_vec>(axis/len, 1);
-
-	// project along axis 2 in plane perpendicular to rotation axis using 1-|v><v|
-	t_mat matProj2 = ortho_projector<t_mat, t_vec>(axis/len, 1) * c;
+	const t_real v[3] = { axis[0]/len, axis[1]/len, axis[2]/len };
 
-	// project along axis 3 in plane perpendicular to rotation axis and axis 2 using v_cross matrix
-	t_mat matProj3 = skewsymmetric<t_mat, t_vec>(axis/len) * s;
+	for(t_size i=0; i<3; ++i)
+	{
+		for(t_size j=0; j<3; ++j)
+		{
+			// written such that rotations around [100], [010] and [001] are exact
+			const t_real proj = v[i]*v[j];
+			mat(i, j) = proj + c*((i==j ? t_real(1) : t_real(0)) - proj);
+		}
+	}
 
-	//std::cout << matProj1(3,3) <<  " " << matProj2(3,3) <<  " " << matProj3(3,3) << std::endl;
-	// rotation in the orthogonal plane is done above by axis2*cos + axis3*sin
-	t_mat matProj = matProj1 + matProj2 + matProj3;
+	mat(0,1) -= s*v[2]; mat(0,2) += s*v[1];
+	mat(1,0) += s*v[2]; mat(1,2) -= s*v[0];
+	mat(2,0) -= s*v[1]; mat(2,1) += s*v[0];
 
 	// if matrix is larger than 3x3 (e.g. for homogeneous coordinates), fill up with identity
-	unit<t_mat>(matProj, 3,3, matProj.size1(), matProj.size2());
-	return matProj;
+	unit<t_mat>(mat, 3,3, mat.size1(), mat.size2());
+	for(t_size i=0; i<std::min<t_size>(3, mat.size1()); ++i)
+		for(t_size j=3; j<mat.size2(); ++j)
+			mat(i, j) = 0;
+	for(t_size i=3; i<mat.size1(); ++i)
+		for(t_size j=0; j<std::min<t_size>(3, mat.size2()); ++j)
+			mat(i, j) = 0;
 }
 
 
@@ -3512,10 +4614,8 @@ template<class t_mat, class t_vec>
 t_mat hom_rotation(const t_vec& axis, const typename t_vec::value_type angle, bool is_normalised=1)
 requires is_vec<t_vec> && is_mat<t_mat>
 {
-	t_mat rot = rotation<t_mat, t_vec>(axis, angle, is_normalised);
-
-	t_mat rot_hom = unit<t_mat>(4,4);
-	m::convert<t_mat, t_mat>(rot_hom, rot);
+	t_mat rot_hom = create<t_mat>(4,4);
+	rotation_into<t_mat, t_vec>(rot_hom, axis, angle, is_normalised);
 
 	return rot_hom;
 }
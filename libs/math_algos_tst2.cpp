@@ -34,6 +34,310 @@ void det_tests()
 }
 
 
+template<class t_scalar, class t_vec, class t_mat>
+void inv_tests()
+{
+	// general matrix, using the LU decomposition
+	t_mat mat1 = create<t_mat>({1, 23, 4,  5, -3, 23,  9, -3, -4});
+	auto [inv1, ok1] = inv<t_mat, t_vec>(mat1);
+	std::cout << "inv ok = " << ok1 << ", M*M^(-1) = 1: "
+		<< equals<t_mat>(mat1*inv1, unit<t_mat>(3), 1e-6) << std::endl;
+
+	// metric, using the Cholesky decomposition
+	t_mat mat2 = metric<t_mat, t_vec>({
+		create<t_vec>({1, 0, 0}),
+		create<t_vec>({0.5, 2, 0}),
+		create<t_vec>({0.1, 0.2, 3}) });
+	auto [inv2, ok2] = inv<t_mat, t_vec>(mat2);
+	std::cout << "inv ok = " << ok2 << ", G*G^(-1) = 1: "
+		<< equals<t_mat>(mat2*inv2, unit<t_mat>(3), 1e-6) << std::endl;
+
+	// linear equation systems
+	t_vec vec = create<t_vec>({3, -2, 5});
+	auto [x1, solved1] = solve<t_mat, t_vec>(mat1, vec);
+	auto [x2, solved2] = solve<t_mat, t_vec>(mat2, vec);
+	std::cout << "solve ok = " << solved1 << ", M*x = b: "
+		<< equals<t_vec>(mat1*x1, vec, 1e-6) << std::endl;
+	std::cout << "solve ok = " << solved2 << ", G*x = b: "
+		<< equals<t_vec>(mat2*x2, vec, 1e-6) << std::endl;
+
+	// singular matrix
+	t_mat mat3 = create<t_mat>({1, 2, 3,  2, 4, 6,  1, 0, 1});
+	auto [inv3, ok3] = inv<t_mat, t_vec>(mat3);
+	std::cout << "singular: inv ok = " << ok3 << std::endl;
+
+	// complex diagonal, not hermitian, using the LU decomposition
+	if constexpr(is_complex<t_scalar>)
+	{
+		t_mat mat4 = create<t_mat>({t_scalar(1, 1), 0, 0,  0, 2, 0,  0, 0, 3});
+		t_scalar det4 = det<t_mat, t_vec>(mat4);
+		auto [inv4, ok4] = inv<t_mat, t_vec>(mat4);
+		auto [x4, solved4] = solve<t_mat, t_vec>(mat4, vec);
+		std::cout << "complex diagonal: hermitian = " << is_symm_or_herm<t_mat>(mat4)
+			<< ", det = " << det4 << ", ok = " << equals<t_scalar>(det4, t_scalar(6, 6), 1e-6)
+			<< ", inv ok = " << (ok4 && equals<t_mat>(mat4*inv4, unit<t_mat>(3), 1e-6))
+			<< ", solve ok = " << (solved4 && equals<t_vec>(mat4*x4, vec, 1e-6)) << std::endl;
+	}
+}
+
+
+template<class t_vec>
+auto expr_returned(const t_vec& x)
+{
+	t_vec y = create<t_vec>({1, 1, 1});
+	return x - y;
+}
+
+
+template<class t_scalar, class t_vec, class t_mat>
+void expr_tests()
+{
+	t_vec x = create<t_vec>({1, 2, 3});
+	t_vec y = create<t_vec>({-1, 0.5, 2});
+	t_vec z = create<t_vec>({0, 1, 0});
+
+	// evaluated in one loop on assignment
+	t_vec res = t_scalar(2)*lazy(x) + lazy(y)*t_scalar(3) - z/t_scalar(2);
+	std::cout << "a*x + b*y - z/c = " << res << ", ok = "
+		<< equals<t_vec>(res, create<t_vec>({-1, 5, 12}), 1e-6) << std::endl;
+
+	// the same evaluated directly
+	t_vec res_direct = t_scalar(2)*x + y*t_scalar(3) - z/t_scalar(2);
+	std::cout << "direct: ok = " << equals<t_vec>(res, res_direct, 1e-6) << std::endl;
+
+	// in-place evaluation referencing the result
+	res = lazy(res) - x;
+	std::cout << "res - x = " << res << std::endl;
+
+	// results kept in auto variables or returned are not affected by later changes
+	t_vec a = create<t_vec>({1, 2, 3});
+	t_vec b = create<t_vec>({3, 2, 1});
+	auto d = a - b;
+	a[0] = 100;
+	t_vec e = d;
+	t_vec f = expr_returned(b);
+	std::cout << "auto a - b = " << e << ", returned x - y = " << f << ", ok = "
+		<< (equals<t_vec>(e, create<t_vec>({-2, 0, 2}), 1e-6)
+			&& equals<t_vec>(f, create<t_vec>({2, 1, 0}), 1e-6)) << std::endl;
+
+	t_mat mat = create<t_mat>({1, 2,  3, 4});
+	t_mat mat2 = lazy(mat) + mat*t_scalar(2) - unit<t_mat>(2);
+	t_mat mat3 = mat + mat*t_scalar(2) - unit<t_mat>(2);
+	std::cout << "M + 2M - 1 = " << mat2 << ", ok = "
+		<< equals<t_mat>(mat2, mat3, 1e-6) << std::endl;
+
+	// algorithms combining containers whose results were kept in auto variables
+	if constexpr(is_complex<t_scalar>)
+	{
+		using t_real = typename t_scalar::value_type;
+
+		const auto sigma = su2_matrices<std::vector<t_mat>>(false);
+		t_vec dir = create<t_vec>({1, 0, 0});
+		t_mat proj = proj_su2<t_vec, t_mat>(dir, true);
+		t_mat inner_proj = inner<std::vector<t_mat>, t_vec>(sigma, dir);
+		std::cout << "<sigma|x> = " << proj << ", ok = "
+			<< (equals<t_mat>(proj, sigma[0], t_real(1e-6))
+				&& equals<t_mat>(inner_proj, sigma[0], t_real(1e-6))) << std::endl;
+
+		t_vec P_i = create<t_vec>({0, 0, 1});
+		t_vec Mperp = create<t_vec>({1, t_scalar(0, 0.5), 0});
+		t_scalar N{0.5, 0};
+		auto [I_dir, P_f_dir] = blume_maleev<t_vec>(P_i, Mperp, N);
+		auto [I_indir, P_f_indir] = blume_maleev_indir<t_mat, t_vec>(P_i, Mperp, N);
+		std::cout << "blume-maleev: I = " << I_indir << ", P_f = " << P_f_indir << ", ok = "
+			<< (equals<t_scalar>(I_dir, I_indir, t_real(1e-6))
+				&& equals<t_vec>(P_f_dir, P_f_indir, t_real(1e-6))) << std::endl;
+	}
+}
+
+
+template<class t_scalar, class t_vec, class t_mat>
+void fixed_tests()
+{
+	using t_vec3 = fvec<t_scalar, 3>;
+	using t_vec4 = fvec<t_scalar, 4>;
+	using t_mat3 = fmat<t_scalar, 3, 3>;
+	using t_mat4 = fmat<t_scalar, 4, 4>;
+
+	// compare with the dynamic containers
+	t_mat4 mat1 = create<t_mat4>({1, 23, 4, 3,  5, -3, 23, 4,  9, 3, -4, -10,  -3, 4, 1, -2});
+	t_mat mat1_dyn = convert<t_mat, t_mat4>(mat1);
+	t_scalar det1 = det<t_mat4, t_vec4>(mat1);
+	std::cout << "fixed det = " << det1 << ", ok = "
+		<< equals<t_scalar>(det1, det<t_mat, t_vec>(mat1_dyn), 1e-4) << std::endl;
+
+	auto [inv1, ok1] = inv<t_mat4, t_vec4>(mat1);
+	auto [inv1_dyn, ok1_dyn] = inv<t_mat, t_vec>(mat1_dyn);
+	std::cout << "fixed inv ok = " << ok1 << ", M*M^(-1) = 1: "
+		<< equals<t_mat4>(mat1*inv1, unit<t_mat4>(), 1e-6) << ", same as dynamic: "
+		<< equals<t_mat>(convert<t_mat, t_mat4>(inv1), inv1_dyn, 1e-6) << std::endl;
+
+	t_mat3 mat2 = create<t_mat3>({1, 23, 4,  5, -3, 23,  9, -3, -4});
+	auto [inv2, ok2] = inv<t_mat3, t_vec3>(mat2);
+	std::cout << "fixed det = " << det<t_mat3, t_vec3>(mat2) << ", inv ok = " << ok2
+		<< ", M*M^(-1) = 1: " << equals<t_mat3>(mat2*inv2, unit<t_mat3>(), 1e-6) << std::endl;
+
+	// vector operations
+	t_vec3 x = create<t_vec3>({1, 2, 3});
+	t_vec3 y = create<t_vec3>({-1, 0.5, 2});
+	t_vec3 xy = cross<t_vec3>(x, y);
+	std::cout << "x cross y = " << xy << ", ok = "
+		<< equals<t_vec3>(xy, create<t_vec3>({2.5, -5, 2.5}), 1e-6)
+		<< ", x*y = " << x*y << std::endl;
+
+	// homogeneous transformations
+	t_mat4 trafo = hom_translation<t_mat4>(t_scalar(1), t_scalar(2), t_scalar(3)) *
+		hom_rotation<t_mat4, t_vec3>(create<t_vec3>({0, 0, 1}), t_scalar(0.5));
+	t_vec4 pos = trafo * create<t_vec4>({1, 0, 0, 1});
+	std::cout << "T*R*x = " << pos << ", ok = "
+		<< equals<t_vec4>(pos, create<t_vec4>({1 + std::cos(0.5), 2 + std::sin(0.5), 3, 1}), 1e-6)
+		<< std::endl;
+}
+
+
+template<class t_scalar, class t_vec, class t_mat>
+void eig_tests()
+{
+	// symmetric or hermitian matrix
+	t_mat mat = create<t_mat>({
+		4, 1, -2, 2,
+		1, 2, 0, 1,
+		-2, 0, 3, -2,
+		2, 1, -2, -1 });
+	if constexpr(is_complex<t_scalar>)
+	{
+		mat(0,1) += t_scalar(0, 0.5); mat(1,0) -= t_scalar(0, 0.5);
+		mat(2,3) += t_scalar(0, -1.5); mat(3,2) -= t_scalar(0, -1.5);
+	}
+
+	auto [evals, evecs, ok] = eigenvecs_herm<t_mat, t_vec>(mat);
+	std::cout << "eigenvalues: " << evals << ", ok = " << ok << std::endl;
+
+	bool evecs_ok = equals<t_mat>(herm<t_mat>(evecs) * evecs, unit<t_mat>(4), 1e-8);
+	for(std::size_t i=0; i<evals.size(); ++i)
+	{
+		t_vec evec = col<t_mat, t_vec>(evecs, i);
+		evecs_ok = evecs_ok && equals<t_vec>(mat * evec, evals[i] * evec, 1e-8);
+	}
+	std::cout << "M*v_i = l_i*v_i: " << evecs_ok << ", sum(l_i) = tr(M): "
+		<< equals<t_scalar>(sum(evals), trace<t_mat>(mat), 1e-8) << std::endl;
+
+	// singular value decomposition of non-square matrices
+	const t_scalar elems2[5][3] = {
+		{ 1, 2, 3 },
+		{ -4, 5, 6 },
+		{ 7, 8, -9 },
+		{ 0, 1, 1 },
+		{ 2, 0, 1 } };
+	t_mat mat2 = create<t_mat>(5, 3);
+	for(std::size_t i=0; i<5; ++i)
+		for(std::size_t j=0; j<3; ++j)
+			mat2(i,j) = elems2[i][j];
+	if constexpr(is_complex<t_scalar>)
+		mat2(1,2) += t_scalar(0, 2);
+
+	for(const t_mat& A : { mat2, herm<t_mat>(mat2) })
+	{
+		auto [U, sigma, V, svd_ok] = svd<t_mat, t_vec>(A);
+
+		t_mat S = zero<t_mat>(sigma.size(), sigma.size());
+		for(std::size_t i=0; i<sigma.size(); ++i)
+			S(i,i) = sigma[i];
+
+		std::cout << "singular values: " << sigma << ", ok = " << svd_ok
+			<< ", U*S*V^H = A: " << equals<t_mat>(U * S * herm<t_mat>(V), A, 1e-8)
+			<< ", V^H*V = 1: " << equals<t_mat>(herm<t_mat>(V) * V, unit<t_mat>(3), 1e-8)
+			<< std::endl;
+	}
+}
+
+
+template<class t_scalar, class t_vec, class t_mat>
+void sparse_tests()
+{
+	using t_csr = csr_mat<t_scalar>;
+	using t_csc = csc_mat<t_scalar>;
+
+	// unsorted triplets with a duplicate element
+	t_csr csr(4, 5, std::vector<typename t_csr::triplet_type>{
+		{ 2, 3, 5 }, { 0, 0, 1 }, { 3, 1, -2 }, { 0, 4, 3 },
+		{ 2, 3, 1 }, { 1, 2, 7 }, { 3, 4, 4 } });
+	t_csc csc(csr);
+
+	t_mat dense = zero<t_mat>(4, 5);
+	dense(0,0) = 1; dense(0,4) = 3; dense(1,2) = 7;
+	dense(2,3) = 6; dense(3,1) = -2; dense(3,4) = 4;
+
+	std::cout << "sparse = " << csr << ", nnz = " << csr.nnz() << ", ok = "
+		<< (equals<t_mat>(convert<t_mat, t_csr>(csr), dense) &&
+			equals<t_mat>(convert<t_mat, t_csc>(csc), dense) &&
+			equals<t_mat>(convert<t_mat, t_csr>(t_csr(dense)), dense)) << std::endl;
+
+	// triplets outside the matrix
+	bool rejected_row = false, rejected_col = false;
+	try { t_csr(4, 5, std::vector<typename t_csr::triplet_type>{ { 4, 0, 1 } }); }
+	catch(const std::out_of_range&) { rejected_row = true; }
+	try { t_csc(4, 5, std::vector<typename t_csc::triplet_type>{ { 0, 0, 1 }, { 1, 5, 1 } }); }
+	catch(const std::out_of_range&) { rejected_col = true; }
+	std::cout << "invalid triplets rejected: " << (rejected_row && rejected_col) << std::endl;
+
+	t_csr csr2(4, 5, std::vector<typename t_csr::triplet_type>{ { 0, 0, -1 }, { 1, 1, 2 } });
+	t_mat dense2 = zero<t_mat>(4, 5);
+	dense2(0,0) = -1; dense2(1,1) = 2;
+	std::cout << "A + B - 2B = " << (csr + csr2 - csr2*t_scalar(2)) << ", ok = "
+		<< equals<t_mat>(convert<t_mat, t_csr>(csr + csr2 - csr2*t_scalar(2)), dense - dense2) << std::endl;
+
+	// products
+	t_vec x = create<t_vec>({ 1, 2, 3, 4, 5 });
+	t_mat B = create<t_mat>(5, 2);
+	for(std::size_t i=0; i<B.size1(); ++i)
+	{
+		B(i,0) = t_scalar(i);
+		B(i,1) = t_scalar(1) - t_scalar(i);
+	}
+
+	std::cout << "A*x = " << csr*x << ", ok = "
+		<< (equals<t_vec>(csr*x, dense*x) && equals<t_vec>(csc*x, dense*x)) << std::endl;
+	std::cout << "A*B = " << csr*B << ", ok = "
+		<< (equals<t_mat>(csr*B, dense*B) && equals<t_mat>(csc*B, dense*B)) << std::endl;
+
+	t_vec y = create<t_vec>({ 1, 1, 1, 1 });
+	csc.mult(x, y, t_scalar(2), t_scalar(-1));
+	std::cout << "2*A*x - y = " << y << ", ok = "
+		<< equals<t_vec>(y, t_scalar(2)*(dense*x) - create<t_vec>({ 1, 1, 1, 1 })) << std::endl;
+
+	// operands of the wrong size
+	bool rejected_vec = false, rejected_mat = false;
+	try { t_vec z = csr * create<t_vec>({ 1, 2, 3, 4 }); }
+	catch(const std::invalid_argument&) { rejected_vec = true; }
+	try { t_mat C = csc * create<t_mat>(4, 2); }
+	catch(const std::invalid_argument&) { rejected_mat = true; }
+	std::cout << "mismatching products rejected: " << (rejected_vec && rejected_mat) << std::endl;
+
+	// large tridiagonal matrix, which would need 10^10 elements in dense form
+	const std::size_t N = 100000;
+	std::vector<typename t_csr::triplet_type> triplets;
+	triplets.reserve(3*N);
+	for(std::size_t i=0; i<N; ++i)
+	{
+		triplets.emplace_back(i, i, 2);
+		if(i > 0)
+			triplets.emplace_back(i, i-1, -1);
+		if(i+1 < N)
+			triplets.emplace_back(i, i+1, -1);
+	}
+
+	t_csr laplace(N, N, triplets);
+	t_vec ones = create<t_vec>(N);
+	for(std::size_t i=0; i<N; ++i)
+		ones[i] = 1;
+	t_vec lap_ones = laplace * ones;
+	std::cout << "laplace*1: nnz = " << laplace.nnz() << ", ok = "
+		<< (equals<t_scalar>(sum(lap_ones), 2) && equals<t_scalar>(lap_ones[0], 1)
+			&& equals<t_scalar>(lap_ones[N/2], 0)) << std::endl;
+}
+
+
 template<class t_mat1, class t_mat2>
 void conv_tests()
 {
@@ -72,6 +376,20 @@ int main()
 	det_tests<t_real, t_vec, t_mat>();
 	det_tests<t_cplx, t_vec_cplx, t_mat_cplx>();
 
+	inv_tests<t_real, t_vec, t_mat>();
+	inv_tests<t_cplx, t_vec_cplx, t_mat_cplx>();
+
+	expr_tests<t_real, t_vec, t_mat>();
+	expr_tests<t_cplx, t_vec_cplx, t_mat_cplx>();
+
+	fixed_tests<t_real, t_vec, t_mat>();
+
+	eig_tests<t_real, t_vec, t_mat>();
+	eig_tests<t_cplx, t_vec_cplx, t_mat_cplx>();
+
+	sparse_tests<t_real, t_vec, t_mat>();
+	sparse_tests<t_cplx, t_vec_cplx, t_mat_cplx>();
+
 	conv_tests<t_mat, t_mat_cplx>();
 	qr_tests<t_mat, t_vec>();
 
@@ -0,0 +1,215 @@
+/**
+ * counts the heap allocations of the geometry helpers and compares them with their allocation-free variants
+ * @author Tobias Weber
+ * @date oct-2026
+ * @license: see 'LICENSE.EUPL' file
+ *
+ * g++ -std=c++20 -Wall -Wextra -Weffc++ -O2 -o math_alloc_tst math_alloc_tst.cpp
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+
+#include "math_algos.h"
+#include "math_conts.h"
+
+using namespace m;
+using namespace m_ops;
+
+using t_real = double;
+using t_vec = vec<t_real, std::vector>;
+using t_mat = mat<t_real, std::vector>;
+
+
+// ----------------------------------------------------------------------------
+// allocation counter
+// ----------------------------------------------------------------------------
+static std::size_t g_num_allocs = 0;
+
+
+void* operator new(std::size_t size)
+{
+	++g_num_allocs;
+	if(void* ptr = std::malloc(size ? size : 1))
+		return ptr;
+	throw std::bad_alloc{};
+}
+
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+// ----------------------------------------------------------------------------
+
+
+/**
+ * calls the function several times and prints the allocations and the time per call
+ */
+template<class t_func>
+void bench(const char* name, t_func func)
+{
+	constexpr std::size_t num_calls = 100000;
+
+	const std::size_t allocs_before = g_num_allocs;
+	auto start = std::chrono::steady_clock::now();
+	for(std::size_t i=0; i<num_calls; ++i)
+		func(i);
+	auto stop = std::chrono::steady_clock::now();
+	const std::size_t allocs = g_num_allocs - allocs_before;
+
+	std::cout << std::left << std::setw(32) << name
+		<< std::right << std::setw(8) << t_real(allocs)/t_real(num_calls) << " allocs/call, "
+		<< std::setw(10) << std::chrono::duration<t_real, std::nano>(stop - start).count()/t_real(num_calls)
+		<< " ns/call" << std::endl;
+}
+
+
+int main()
+{
+	std::cout << std::boolalpha;
+
+	const t_vec axis = create<t_vec>({ 1., -2., 0.5 });
+	const t_vec vec1 = create<t_vec>({ 0.3, 1., 2. });
+	const t_mat matA = create<t_mat>({ 1, 23, 4,  5, -3, 23,  9, -3, -4 });
+	t_mat mat8 = create<t_mat>(8, 8);
+	for(std::size_t i=0; i<8; ++i)
+		for(std::size_t j=0; j<8; ++j)
+			mat8(i, j) = std::sin(t_real(i*i + 3*j + 1)) + (i == j ? 2. : 0.);
+
+	// pre-allocated outputs and work vectors
+	t_mat out3 = create<t_mat>(3, 3), out4 = create<t_mat>(4, 4), out2 = create<t_mat>(2, 2);
+	t_mat Q3 = create<t_mat>(3, 3), R3 = create<t_mat>(3, 3);
+	t_mat Q8 = create<t_mat>(8, 8), R8 = create<t_mat>(8, 8);
+	t_vec work3 = create<t_vec>(3), work8 = create<t_vec>(8);
+
+	// check the allocation-free variants against the ones returning a new container
+	{
+		const t_real eps = 1e-12;
+
+		rotation_into<t_mat, t_vec>(out3, axis, 0.7, false);
+		bool ok_rot = equals<t_mat>(out3, rotation<t_mat, t_vec>(axis, 0.7, false), eps);
+		rotation_into<t_mat, t_vec>(out4, axis, 0.7, false);
+		ok_rot = ok_rot && equals<t_mat>(out4, hom_rotation<t_mat, t_vec>(axis, 0.7, false), eps);
+
+		// the general formula has to agree with the explicit rotation around [100]
+		rotation_into<t_mat, t_vec>(out3, create<t_vec>({ 1., 0., 0. }), 0.7);
+		const t_real c = std::cos(0.7), s = std::sin(0.7);
+		ok_rot = ok_rot && equals<t_mat>(out3, create<t_mat>({{1,0,0}, {0,c,s}, {0,-s,c}}), eps);
+		std::cout << "rotation_into: ok = " << ok_rot << std::endl;
+
+		projector_into<t_mat, t_vec>(out3, axis, false);
+		bool ok_proj = equals<t_mat>(out3, projector<t_mat, t_vec>(axis/norm<t_vec>(axis), true), eps);
+		ortho_projector_into<t_mat, t_vec>(out3, axis, false);
+		ok_proj = ok_proj && equals<t_mat>(out3, unit<t_mat>(3) - projector<t_mat, t_vec>(axis, false), eps);
+		ortho_mirror_op_into<t_mat, t_vec>(out3, axis, false);
+		ok_proj = ok_proj && equals<t_mat>(out3, unit<t_mat>(3) - 2.*projector<t_mat, t_vec>(axis, false), eps);
+		std::cout << "projector_into: ok = " << ok_proj << std::endl;
+
+		outer_into<t_mat, t_vec>(out3, axis, vec1);
+		bool ok_misc = equals<t_mat>(out3, outer<t_mat, t_vec>(axis, vec1), eps);
+		trans_into<t_mat, t_mat>(out3, matA);
+		ok_misc = ok_misc && equals<t_mat>(out3, trans<t_mat>(matA), eps);
+		submat_into<t_mat, t_mat>(out2, matA, 1, 2);
+		ok_misc = ok_misc && equals<t_mat>(out2, submat<t_mat>(matA, 1, 2), eps);
+		std::cout << "outer_into, trans_into, submat_into: ok = " << ok_misc << std::endl;
+
+		R8 = mat8;
+		const std::size_t num_mirrors = qr_inplace<t_mat, t_vec>(R8, Q8, work8);
+		bool ok_qr = equals<t_mat>(Q8*R8, mat8, 1e-10);
+		ok_qr = ok_qr && equals<t_mat>(trans<t_mat>(Q8)*Q8, unit<t_mat>(8), 1e-10);
+		for(std::size_t i=0; i<8; ++i)
+			for(std::size_t j=0; j<i; ++j)
+				ok_qr = ok_qr && equals<t_real>(R8(i, j), 0., 1e-12);
+		auto [Q, R, num_mirrors2] = qr<t_mat, t_vec>(mat8);
+		ok_qr = ok_qr && equals<t_mat>(Q, Q8, eps) && equals<t_mat>(R, R8, eps) && num_mirrors == num_mirrors2;
+		std::cout << "qr_inplace: ok = " << ok_qr << std::endl;
+	}
+
+	// benchmark
+	{
+		std::cout << "\nallocations and time per call:" << std::endl;
+		t_real sum = 0;
+
+		bench("rotation", [&](std::size_t i)
+		{
+			sum += rotation<t_mat, t_vec>(axis, t_real(i)*1e-5, false)(0, 1);
+		});
+		bench("rotation_into", [&](std::size_t i)
+		{
+			rotation_into<t_mat, t_vec>(out3, axis, t_real(i)*1e-5, false);
+			sum += out3(0, 1);
+		});
+		bench("hom_rotation", [&](std::size_t i)
+		{
+			sum += hom_rotation<t_mat, t_vec>(axis, t_real(i)*1e-5, false)(0, 1);
+		});
+		bench("rotation_into (4x4)", [&](std::size_t i)
+		{
+			rotation_into<t_mat, t_vec>(out4, axis, t_real(i)*1e-5, false);
+			sum += out4(0, 1);
+		});
+		bench("ortho_projector", [&](std::size_t)
+		{
+			sum += ortho_projector<t_mat, t_vec>(axis, false)(0, 1);
+		});
+		bench("ortho_projector_into", [&](std::size_t)
+		{
+			ortho_projector_into<t_mat, t_vec>(out3, axis, false);
+			sum += out3(0, 1);
+		});
+		bench("outer", [&](std::size_t)
+		{
+			sum += outer<t_mat, t_vec>(axis, vec1)(0, 1);
+		});
+		bench("outer_into", [&](std::size_t)
+		{
+			outer_into<t_mat, t_vec>(out3, axis, vec1);
+			sum += out3(0, 1);
+		});
+		bench("trans", [&](std::size_t)
+		{
+			sum += trans<t_mat>(matA)(0, 1);
+		});
+		bench("trans_into", [&](std::size_t)
+		{
+			trans_into<t_mat, t_mat>(out3, matA);
+			sum += out3(0, 1);
+		});
+		bench("qr (3x3)", [&](std::size_t)
+		{
+			auto [Q, R, num_mirrors] = qr<t_mat, t_vec>(matA);
+			sum += R(0, 1);
+		});
+		bench("qr_inplace (3x3)", [&](std::size_t)
+		{
+			R3 = matA;
+			qr_inplace<t_mat, t_vec>(R3, Q3, work3);
+			sum += R3(0, 1);
+		});
+		bench("qr (8x8)", [&](std::size_t)
+		{
+			auto [Q, R, num_mirrors] = qr<t_mat, t_vec>(mat8);
+			sum += R(0, 1);
+		});
+		bench("qr_inplace (8x8)", [&](std::size_t)
+		{
+			R8 = mat8;
+			qr_inplace<t_mat, t_vec>(R8, Q8, work8);
+			sum += R8(0, 1);
+		});
+
+		std::cout << "checksum: " << sum << std::endl;
+	}
+
+	return 0;
+}
@@ -12,6 +12,7 @@
 #include <iterator>
 #include <complex>
 #include <concepts>
+#include <type_traits>
 //#include <iostream>
 
 
@@ -51,6 +52,16 @@ concept /*bool*/ is_dyn_vec = requires(const T& a)
 };
 
 
+/**
+ * requirements of a vector type with a size known at compile time
+ */
+template<class T>
+concept /*bool*/ is_fixed_vec = requires
+{
+	typename std::integral_constant<std::size_t, T::size()>;	// static constexpr size()
+} && is_basic_vec<T>;
+
+
 /**
  * requirements for a vector container
  */
@@ -127,6 +138,17 @@ concept /*bool*/ is_dyn_mat = requires(const T& a)
 };
 
 
+/**
+ * requirements of a matrix type with sizes known at compile time
+ */
+template<class T>
+concept /*bool*/ is_fixed_mat = requires
+{
+	typename std::integral_constant<std::size_t, T::size1()>;	// static constexpr size1()
+	typename std::integral_constant<std::size_t, T::size2()>;	// static constexpr size2()
+} && is_basic_mat<T>;
+
+
 /**
  * requirements for a matrix container
  */
@@ -141,6 +163,17 @@ concept /*bool*/ is_mat = requires(const T& a)
 } && is_basic_mat<T>;
 
 
+/**
+ * requirements for a matrix with contiguous, row-major storage
+ */
+template<class T>
+concept /*bool*/ is_flat_mat = requires(const T& a)
+{
+	{ a.data() } -> std::convertible_to<const typename T::value_type*>;
+	requires T::is_row_major;	// must declare its storage order
+} && is_basic_mat<T>;
+
+
 /**
  * requirements for a complex number
  */
@@ -19,7 +19,13 @@
 #include <array>
 #include <iostream>
 #include <iomanip>
+#include <functional>
+#include <algorithm>
+#include <tuple>
+#include <type_traits>
+#include <stdexcept>
 #include "math_concepts.h"
+#include "math_gemm.h"
 
 
 // separator tokens
@@ -392,13 +398,25 @@ requires m::is_basic_mat<t_mat> && m::is_dyn_mat<t_mat>
 
 	t_mat matRet = m::create<t_mat>(mat1.size1(), mat2.size2());
 
-	for(t_size row=0; row<matRet.size1(); ++row)
+	// use blocked kernel for contiguous matrices
+	if constexpr(m::is_flat_mat<t_mat>)
 	{
-		for(t_size col=0; col<matRet.size2(); ++col)
+		using T = typename t_mat::value_type;
+
+		std::fill(matRet.data(), matRet.data() + matRet.size1()*matRet.size2(), T(0));
+		m::gemm<T>(mat1.data(), mat2.data(), matRet.data(),
+			mat1.size1(), mat2.size2(), mat1.size2());
+	}
+	else
+	{
+		for(t_size row=0; row<matRet.size1(); ++row)
 		{
-			matRet(row, col) = 0;
-			for(t_size i=0; i<mat1.size2(); ++i)
-				matRet(row, col) += mat1(row, i) * mat2(i, col);
+			for(t_size col=0; col<matRet.size2(); ++col)
+			{
+				matRet(row, col) = 0;
+				for(t_size i=0; i<mat1.size2(); ++i)
+					matRet(row, col) += mat1(row, i) * mat2(i, col);
+			}
 		}
 	}
 
@@ -748,6 +766,153 @@ requires m::is_basic_quat<t_quat> && m::is_basic_vec<t_vec> && m::is_dyn_vec<t_v
 // maths
 namespace m {
 
+/**
+ * ----------------------------------------------------------------------------
+ * expression templates
+ * element-wise operations on expressions started with m::lazy() are only
+ * evaluated when the expression is assigned to a container, using a single
+ * loop and allocation, operations on plain m::vec and m::mat are evaluated directly
+ * ----------------------------------------------------------------------------
+ */
+
+/**
+ * requirements for an operand of a lazily evaluated expression,
+ * expr_type is the container type the expression evaluates to
+ */
+template<class T>
+concept /*bool*/ is_expr = requires(const std::remove_cvref_t<T>& a)
+{
+	typename std::remove_cvref_t<T>::expr_type;
+	a.elem(0);			// flat element access
+};
+
+
+/**
+ * requirements for a vector expression
+ */
+template<class T>
+concept /*bool*/ is_vec_expr = is_expr<T>
+	&& is_basic_vec<typename std::remove_cvref_t<T>::expr_type>;
+
+
+/**
+ * requirements for a matrix expression
+ */
+template<class T>
+concept /*bool*/ is_mat_expr = is_expr<T>
+	&& is_basic_mat<typename std::remove_cvref_t<T>::expr_type>;
+
+
+/**
+ * requirements for an unevaluated expression, i.e. not the container itself
+ */
+template<class T>
+concept /*bool*/ is_expr_node = is_expr<T>
+	&& !std::same_as<std::remove_cvref_t<T>, typename std::remove_cvref_t<T>::expr_type>;
+
+
+/**
+ * the container type an expression evaluates to
+ */
+template<class T>
+using expr_type_t = typename std::remove_cvref_t<T>::expr_type;
+
+
+/**
+ * requirements for two expressions that can be combined element-wise
+ */
+template<class T1, class T2>
+concept /*bool*/ is_expr_compatible =
+	((is_vec_expr<T1> && is_vec_expr<T2>) || (is_mat_expr<T1> && is_mat_expr<T2>))
+	&& std::same_as<expr_type_t<T1>, expr_type_t<T2>>;
+
+
+/**
+ * containers are referenced by an expression if they are lvalues,
+ * temporaries and sub-expressions are stored by value,
+ * so an expression must not outlive or be evaluated after changes to its lvalue operands
+ */
+template<class T>
+using expr_operand_t = std::conditional_t<
+	std::is_lvalue_reference_v<T> && !is_expr_node<T>,
+	const std::remove_reference_t<T>&,
+	std::remove_cvref_t<T>>;
+
+
+/**
+ * element of an expression operand, scalars are used as they are
+ */
+template<class T>
+decltype(auto) expr_elem(const T& operand, std::size_t i)
+{
+	if constexpr(is_expr<T>)
+		return operand.elem(i);
+	else
+		return operand;
+}
+
+
+/**
+ * element-wise operation op(arg, args...)
+ * the first argument is an expression which determines the shape
+ */
+template<class t_op, class t_arg, class... t_args>
+class expr_node
+{
+public:
+	using expr_type = expr_type_t<t_arg>;
+	using value_type = typename expr_type::value_type;
+
+	explicit expr_node(expr_operand_t<t_arg> arg, expr_operand_t<t_args>... args)
+		: m_args{std::forward<expr_operand_t<t_arg>>(arg), std::forward<expr_operand_t<t_args>>(args)...}
+	{}
+
+	std::size_t size() const requires is_vec_expr<t_arg> { return std::get<0>(m_args).size(); }
+	std::size_t size1() const requires is_mat_expr<t_arg> { return std::get<0>(m_args).size1(); }
+	std::size_t size2() const requires is_mat_expr<t_arg> { return std::get<0>(m_args).size2(); }
+
+	value_type elem(std::size_t i) const
+	{
+		return std::apply([i](const auto&... args) -> value_type
+		{
+			return t_op{}(expr_elem(args, i)...);
+		}, m_args);
+	}
+
+	value_type operator[](std::size_t i) const requires is_vec_expr<t_arg> { return elem(i); }
+
+private:
+	std::tuple<expr_operand_t<t_arg>, expr_operand_t<t_args>...> m_args;
+};
+
+
+/**
+ * evaluates an expression node into its container, containers are passed through
+ */
+template<class t_expr>
+decltype(auto) expr_eval(t_expr&& expr)
+requires is_expr<t_expr>
+{
+	if constexpr(is_expr_node<t_expr>)
+		return expr_type_t<t_expr>(expr);
+	else
+		return std::forward<t_expr>(expr);
+}
+
+
+/**
+ * starts a lazily evaluated expression on a container, e.g. m::lazy(a)*x + y - z,
+ * the container is referenced, not copied
+ */
+template<class t_cont>
+auto lazy(const t_cont& cont)
+requires is_expr<t_cont> && (!is_expr_node<t_cont>)
+{
+	return expr_node<std::identity, const t_cont&>(cont);
+}
+// ----------------------------------------------------------------------------
+
+
 /**
  * ----------------------------------------------------------------------------
  * vector container
@@ -760,31 +925,95 @@ class vec : public t_cont<T>
 public:
 	using value_type = T;
 	using container_type = t_cont<T>;
+	using expr_type = vec;
 
 	vec() = default;
 	vec(std::size_t SIZE) : t_cont<T>(SIZE) {}
 	~vec() = default;
 
+	vec(const vec&) = default;
+	vec(vec&&) = default;
+	vec& operator=(const vec&) = default;
+	vec& operator=(vec&&) = default;
+
+	/**
+	 * evaluate an expression
+	 */
+	template<class t_expr> requires is_expr_node<t_expr> && std::same_as<expr_type_t<t_expr>, vec>
+	vec(const t_expr& expr) : t_cont<T>(expr.size())
+	{
+		for(std::size_t i=0; i<this->size(); ++i)
+			(*this)[i] = expr.elem(i);
+	}
+
+	/**
+	 * evaluate an expression, in place if the sizes match
+	 * (all operations are element-wise, so the expression may reference this vector)
+	 */
+	template<class t_expr> requires is_expr_node<t_expr> && std::same_as<expr_type_t<t_expr>, vec>
+	vec& operator=(const t_expr& expr)
+	{
+		if(this->size() != expr.size())
+			return *this = vec(expr);
+
+		for(std::size_t i=0; i<this->size(); ++i)
+			(*this)[i] = expr.elem(i);
+		return *this;
+	}
+
 	const value_type& operator()(std::size_t i) const { return this->operator[](i); }
 	value_type& operator()(std::size_t i) { return this->operator[](i); }
+	const value_type& elem(std::size_t i) const { return this->operator[](i); }
 
 	using t_cont<T>::operator[];
 
-	friend vec operator+(const vec& vec1, const vec& vec2) { return m_ops::operator+(vec1, vec2); }
-	friend vec operator-(const vec& vec1, const vec& vec2) { return m_ops::operator-(vec1, vec2); }
+	// these return evaluated vectors (and take precedence over the m_ops operators),
+	// temporaries passed as first operand are reused for the result
+	friend vec operator+(vec vec1, const vec& vec2) { vec1 += vec2; return vec1; }
+	friend vec operator-(vec vec1, const vec& vec2) { vec1 -= vec2; return vec1; }
 	friend const vec& operator+(const vec& vec1) { return vec1; }
-	friend vec operator-(const vec& vec1) { return m_ops::operator-(vec1); }
+	friend vec operator-(vec vec1) { vec1 *= value_type(-1); return vec1; }
 
 	friend value_type operator*(const vec& vec1, const vec& vec2) { return m_ops::operator*<vec>(vec1, vec2); }
-	friend vec operator*(value_type d, const vec& vec1) { return m_ops::operator*(d, vec1); }
-	friend vec operator*(const vec& vec1, value_type d) { return m_ops::operator*(vec1, d); }
-	friend vec operator/(const vec& vec1, value_type d) { return m_ops::operator/(vec1, d); }
+	friend vec operator*(value_type d, vec vec1) { vec1 *= d; return vec1; }
+	friend vec operator*(vec vec1, value_type d) { vec1 *= d; return vec1; }
+	friend vec operator/(vec vec1, value_type d) { vec1 /= d; return vec1; }
 
 	vec& operator*=(const vec& vec2) { return m_ops::operator*=(*this, vec2); }
-	vec& operator+=(const vec& vec2) { return m_ops::operator+=(*this, vec2); }
-	vec& operator-=(const vec& vec2) { return m_ops::operator-=(*this, vec2); }
-	vec& operator*=(value_type d) { return m_ops::operator*=(*this, d); }
-	vec& operator/=(value_type d) { return m_ops::operator/=(*this, d); }
+	vec& operator+=(const vec& vec2) { return *this += lazy(vec2); }
+	vec& operator-=(const vec& vec2) { return *this -= lazy(vec2); }
+
+	template<class t_expr> requires is_expr_node<t_expr> && std::same_as<expr_type_t<t_expr>, vec>
+	vec& operator+=(const t_expr& expr)
+	{
+		assert(this->size() == expr.size());
+		for(std::size_t i=0; i<this->size(); ++i)
+			(*this)[i] += expr.elem(i);
+		return *this;
+	}
+
+	template<class t_expr> requires is_expr_node<t_expr> && std::same_as<expr_type_t<t_expr>, vec>
+	vec& operator-=(const t_expr& expr)
+	{
+		assert(this->size() == expr.size());
+		for(std::size_t i=0; i<this->size(); ++i)
+			(*this)[i] -= expr.elem(i);
+		return *this;
+	}
+
+	vec& operator*=(value_type d)
+	{
+		for(value_type& elem : *this)
+			elem *= d;
+		return *this;
+	}
+
+	vec& operator/=(value_type d)
+	{
+		for(value_type& elem : *this)
+			elem /= d;
+		return *this;
+	}
 
 private:
 };
@@ -802,34 +1031,104 @@ class mat
 public:
 	using value_type = T;
 	using container_type = t_cont<T>;
+	using expr_type = mat;
+
+	// elements are stored row after row
+	static constexpr bool is_row_major = true;
 
 	mat() = default;
 	mat(std::size_t ROWS, std::size_t COLS) : m_data(ROWS*COLS), m_rowsize{ROWS}, m_colsize{COLS} {}
 	~mat() = default;
 
+	mat(const mat&) = default;
+	mat(mat&&) = default;
+	mat& operator=(const mat&) = default;
+	mat& operator=(mat&&) = default;
+
+	/**
+	 * evaluate an expression
+	 */
+	template<class t_expr> requires is_expr_node<t_expr> && std::same_as<expr_type_t<t_expr>, mat>
+	mat(const t_expr& expr) : m_data(expr.size1()*expr.size2()), m_rowsize{expr.size1()}, m_colsize{expr.size2()}
+	{
+		for(std::size_t i=0; i<m_data.size(); ++i)
+			m_data[i] = expr.elem(i);
+	}
+
+	/**
+	 * evaluate an expression, in place if the sizes match
+	 * (all operations are element-wise, so the expression may reference this matrix)
+	 */
+	template<class t_expr> requires is_expr_node<t_expr> && std::same_as<expr_type_t<t_expr>, mat>
+	mat& operator=(const t_expr& expr)
+	{
+		if(size1() != expr.size1() || size2() != expr.size2())
+			return *this = mat(expr);
+
+		for(std::size_t i=0; i<m_data.size(); ++i)
+			m_data[i] = expr.elem(i);
+		return *this;
+	}
+
 	std::size_t size1() const { return m_rowsize; }
 	std::size_t size2() const { return m_colsize; }
 	const T& operator()(std::size_t row, std::size_t col) const { return m_data[row*m_colsize + col]; }
 	T& operator()(std::size_t row, std::size_t col) { return m_data[row*m_colsize + col]; }
+	const T& elem(std::size_t i) const { return m_data[i]; }
+
+	const T* data() const requires requires(const container_type& cont) { cont.data(); } { return m_data.data(); }
+	T* data() requires requires(container_type& cont) { cont.data(); } { return m_data.data(); }
 
-	friend mat operator+(const mat& mat1, const mat& mat2) { return m_ops::operator+(mat1, mat2); }
-	friend mat operator-(const mat& mat1, const mat& mat2) { return m_ops::operator-(mat1, mat2); }
+	// these return evaluated matrices (and take precedence over the m_ops operators),
+	// temporaries passed as first operand are reused for the result
+	friend mat operator+(mat mat1, const mat& mat2) { mat1 += mat2; return mat1; }
+	friend mat operator-(mat mat1, const mat& mat2) { mat1 -= mat2; return mat1; }
 	friend const mat& operator+(const mat& mat1) { return mat1; }
-	friend mat operator-(const mat& mat1) { return m_ops::operator-(mat1); }
+	friend mat operator-(mat mat1) { mat1 *= value_type(-1); return mat1; }
 
 	friend mat operator*(const mat& mat1, const mat& mat2) { return m_ops::operator*(mat1, mat2); }
-	friend mat operator*(const mat& mat1, value_type d) { return m_ops::operator*(mat1, d); }
-	friend mat operator*(value_type d, const mat& mat1) { return m_ops::operator*(d, mat1); }
-	friend mat operator/(const mat& mat1, value_type d) { return m_ops::operator/(mat1, d); }
+	friend mat operator*(mat mat1, value_type d) { mat1 *= d; return mat1; }
+	friend mat operator*(value_type d, mat mat1) { mat1 *= d; return mat1; }
+	friend mat operator/(mat mat1, value_type d) { mat1 /= d; return mat1; }
 
-	template<class t_vec> requires is_basic_vec<t_cont<T>> && is_dyn_vec<t_cont<T>>
+	template<class t_vec> requires is_basic_vec<t_vec> && is_dyn_vec<t_vec>
 	friend t_vec operator*(const mat& mat1, const t_vec& vec2) { return m_ops::operator*(mat1, vec2); }
 
 	mat& operator*=(const mat& mat2) { return m_ops::operator*=(*this, mat2); }
-	mat& operator+=(const mat& mat2) { return m_ops::operator+=(*this, mat2); }
-	mat& operator-=(const mat& mat2) { return m_ops::operator-=(*this, mat2); }
-	mat& operator*=(value_type d) { return m_ops::operator*=(*this, d); }
-	mat& operator/=(value_type d) { return m_ops::operator/=(*this, d); }
+	mat& operator+=(const mat& mat2) { return *this += lazy(mat2); }
+	mat& operator-=(const mat& mat2) { return *this -= lazy(mat2); }
+
+	template<class t_expr> requires is_expr_node<t_expr> && std::same_as<expr_type_t<t_expr>, mat>
+	mat& operator+=(const t_expr& expr)
+	{
+		assert(size1() == expr.size1() && size2() == expr.size2());
+		for(std::size_t i=0; i<m_data.size(); ++i)
+			m_data[i] += expr.elem(i);
+		return *this;
+	}
+
+	template<class t_expr> requires is_expr_node<t_expr> && std::same_as<expr_type_t<t_expr>, mat>
+	mat& operator-=(const t_expr& expr)
+	{
+		assert(size1() == expr.size1() && size2() == expr.size2());
+		for(std::size_t i=0; i<m_data.size(); ++i)
+			m_data[i] -= expr.elem(i);
+		return *this;
+	}
+
+	mat& operator*=(value_type d)
+	{
+		for(std::size_t i=0; i<m_data.size(); ++i)
+			m_data[i] *= d;
+		return *this;
+	}
+
+	mat& operator/=(value_type d)
+	{
+		for(std::size_t i=0; i<m_data.size(); ++i)
+			m_data[i] /= d;
+		return *this;
+	}
 
 
 private:
@@ -838,6 +1137,787 @@ private:
 };
 
 
+/**
+ * ----------------------------------------------------------------------------
+ * operators on expressions
+ * at least one operand has to be an expression node, the operators
+ * on plain containers are friends of the containers
+ * ----------------------------------------------------------------------------
+ */
+
+/**
+ * unary +
+ */
+template<class t_arg>
+const t_arg& operator+(const t_arg& arg)
+requires is_expr_node<t_arg>
+{
+	return arg;
+}
+
+
+/**
+ * unary -
+ */
+template<class t_arg>
+auto operator-(t_arg&& arg)
+requires is_expr_node<t_arg>
+{
+	return expr_node<std::negate<>, t_arg>(std::forward<t_arg>(arg));
+}
+
+
+/**
+ * binary +
+ */
+template<class t_lhs, class t_rhs>
+auto operator+(t_lhs&& lhs, t_rhs&& rhs)
+requires is_expr_compatible<t_lhs, t_rhs> && (is_expr_node<t_lhs> || is_expr_node<t_rhs>)
+{
+	return expr_node<std::plus<>, t_lhs, t_rhs>(std::forward<t_lhs>(lhs), std::forward<t_rhs>(rhs));
+}
+
+
+/**
+ * binary -
+ */
+template<class t_lhs, class t_rhs>
+auto operator-(t_lhs&& lhs, t_rhs&& rhs)
+requires is_expr_compatible<t_lhs, t_rhs> && (is_expr_node<t_lhs> || is_expr_node<t_rhs>)
+{
+	return expr_node<std::minus<>, t_lhs, t_rhs>(std::forward<t_lhs>(lhs), std::forward<t_rhs>(rhs));
+}
+
+
+/**
+ * expression * scalar
+ */
+template<class t_arg>
+auto operator*(t_arg&& arg, const typename expr_type_t<t_arg>::value_type& d)
+requires is_expr_node<t_arg>
+{
+	using T = typename expr_type_t<t_arg>::value_type;
+	return expr_node<std::multiplies<>, t_arg, T>(std::forward<t_arg>(arg), d);
+}
+
+
+/**
+ * scalar * expression
+ */
+template<class t_arg>
+auto operator*(const typename expr_type_t<t_arg>::value_type& d, t_arg&& arg)
+requires is_expr_node<t_arg>
+{
+	using T = typename expr_type_t<t_arg>::value_type;
+	return expr_node<std::multiplies<>, t_arg, T>(std::forward<t_arg>(arg), d);
+}
+
+
+/**
+ * expression / scalar
+ */
+template<class t_arg>
+auto operator/(t_arg&& arg, const typename expr_type_t<t_arg>::value_type& d)
+requires is_expr_node<t_arg>
+{
+	using T = typename expr_type_t<t_arg>::value_type;
+	return expr_node<std::divides<>, t_arg, T>(std::forward<t_arg>(arg), d);
+}
+
+
+/**
+ * inner product of vector expressions, evaluated directly
+ */
+template<class t_lhs, class t_rhs>
+typename expr_type_t<t_lhs>::value_type operator*(const t_lhs& lhs, const t_rhs& rhs)
+requires is_vec_expr<t_lhs> && is_vec_expr<t_rhs> && is_expr_compatible<t_lhs, t_rhs>
+	&& (is_expr_node<t_lhs> || is_expr_node<t_rhs>)
+{
+	using T = typename expr_type_t<t_lhs>::value_type;
+	assert(lhs.size() == rhs.size());
+
+	T val{};
+	for(std::size_t i=0; i<lhs.size(); ++i)
+	{
+		if constexpr(is_complex<T>)
+			val += std::conj(lhs.elem(i)) * rhs.elem(i);
+		else
+			val += lhs.elem(i) * rhs.elem(i);
+	}
+
+	return val;
+}
+
+
+/**
+ * matrix-matrix and matrix-vector products involving expressions,
+ * the expressions are evaluated first
+ */
+template<class t_lhs, class t_rhs>
+auto operator*(t_lhs&& lhs, t_rhs&& rhs)
+requires is_mat_expr<t_lhs> && (is_mat_expr<t_rhs> || is_vec_expr<t_rhs>)
+	&& (is_expr_node<t_lhs> || is_expr_node<t_rhs>)
+{
+	return expr_eval(std::forward<t_lhs>(lhs)) * expr_eval(std::forward<t_rhs>(rhs));
+}
+
+
+/**
+ * operator <<
+ */
+template<class t_expr>
+std::ostream& operator<<(std::ostream& ostr, const t_expr& expr)
+requires is_expr_node<t_expr>
+{
+	return m_ops::operator<<(ostr, expr_type_t<t_expr>(expr));
+}
+// ----------------------------------------------------------------------------
+
+
+/**
+ * ----------------------------------------------------------------------------
+ * fixed-size vector container, stored on the stack
+ * ----------------------------------------------------------------------------
+ */
+template<class T, std::size_t N>
+class fvec
+{
+public:
+	using value_type = T;
+	using size_type = std::size_t;
+	using container_type = std::array<T, N>;
+
+	constexpr fvec() = default;
+	~fvec() = default;
+
+	static constexpr std::size_t size() { return N; }
+
+	constexpr const T& operator[](std::size_t i) const { return m_data[i]; }
+	constexpr T& operator[](std::size_t i) { return m_data[i]; }
+	constexpr const T& operator()(std::size_t i) const { return m_data[i]; }
+	constexpr T& operator()(std::size_t i) { return m_data[i]; }
+
+	constexpr const T* data() const { return m_data.data(); }
+	constexpr T* data() { return m_data.data(); }
+	constexpr auto begin() const { return m_data.begin(); }
+	constexpr auto end() const { return m_data.end(); }
+	constexpr auto begin() { return m_data.begin(); }
+	constexpr auto end() { return m_data.end(); }
+
+	friend constexpr fvec operator+(const fvec& vec1, const fvec& vec2)
+	{
+		fvec vec;
+		unroll<N>([&](std::size_t i) { vec[i] = vec1[i] + vec2[i]; });
+		return vec;
+	}
+
+	friend constexpr fvec operator-(const fvec& vec1, const fvec& vec2)
+	{
+		fvec vec;
+		unroll<N>([&](std::size_t i) { vec[i] = vec1[i] - vec2[i]; });
+		return vec;
+	}
+
+	friend constexpr const fvec& operator+(const fvec& vec1) { return vec1; }
+
+	friend constexpr fvec operator-(const fvec& vec1)
+	{
+		fvec vec;
+		unroll<N>([&](std::size_t i) { vec[i] = -vec1[i]; });
+		return vec;
+	}
+
+	friend constexpr fvec operator*(const fvec& vec1, value_type d)
+	{
+		fvec vec;
+		unroll<N>([&](std::size_t i) { vec[i] = vec1[i] * d; });
+		return vec;
+	}
+
+	friend constexpr fvec operator/(const fvec& vec1, value_type d)
+	{
+		fvec vec;
+		unroll<N>([&](std::size_t i) { vec[i] = vec1[i] / d; });
+		return vec;
+	}
+
+	friend constexpr fvec operator*(value_type d, const fvec& vec1) { return vec1 * d; }
+	friend value_type operator*(const fvec& vec1, const fvec& vec2) { return inner<fvec>(vec1, vec2); }
+
+	constexpr fvec& operator+=(const fvec& vec2) { return *this = *this + vec2; }
+	constexpr fvec& operator-=(const fvec& vec2) { return *this = *this - vec2; }
+	constexpr fvec& operator*=(value_type d) { return *this = *this * d; }
+	constexpr fvec& operator/=(value_type d) { return *this = *this / d; }
+
+	friend std::ostream& operator<<(std::ostream& ostr, const fvec& vec)
+	{
+		for(std::size_t i=0; i<N; ++i)
+		{
+			ostr << vec[i];
+			if(i < N-1)
+				ostr << COLSEP << " ";
+		}
+		return ostr;
+	}
+
+private:
+	container_type m_data{};
+};
+
+
+/**
+ * ----------------------------------------------------------------------------
+ * fixed-size matrix container, stored on the stack
+ * ----------------------------------------------------------------------------
+ */
+template<class T, std::size_t ROWS, std::size_t COLS>
+class fmat
+{
+public:
+	using value_type = T;
+	using size_type = std::size_t;
+	using container_type = std::array<T, ROWS*COLS>;
+
+	// elements are stored row after row
+	static constexpr bool is_row_major = true;
+
+	constexpr fmat() = default;
+	~fmat() = default;
+
+	static constexpr std::size_t size1() { return ROWS; }
+	static constexpr std::size_t size2() { return COLS; }
+
+	constexpr const T& operator()(std::size_t row, std::size_t col) const { return m_data[row*COLS + col]; }
+	constexpr T& operator()(std::size_t row, std::size_t col) { return m_data[row*COLS + col]; }
+
+	constexpr const T* data() const { return m_data.data(); }
+	constexpr T* data() { return m_data.data(); }
+
+	friend constexpr fmat operator+(const fmat& mat1, const fmat& mat2)
+	{
+		fmat mat;
+		unroll<ROWS*COLS>([&](std::size_t i) { mat.m_data[i] = mat1.m_data[i] + mat2.m_data[i]; });
+		return mat;
+	}
+
+	friend constexpr fmat operator-(const fmat& mat1, const fmat& mat2)
+	{
+		fmat mat;
+		unroll<ROWS*COLS>([&](std::size_t i) { mat.m_data[i] = mat1.m_data[i] - mat2.m_data[i]; });
+		return mat;
+	}
+
+	friend constexpr const fmat& operator+(const fmat& mat1) { return mat1; }
+
+	friend constexpr fmat operator-(const fmat& mat1)
+	{
+		fmat mat;
+		unroll<ROWS*COLS>([&](std::size_t i) { mat.m_data[i] = -mat1.m_data[i]; });
+		return mat;
+	}
+
+	friend constexpr fmat operator*(const fmat& mat1, value_type d)
+	{
+		fmat mat;
+		unroll<ROWS*COLS>([&](std::size_t i) { mat.m_data[i] = mat1.m_data[i] * d; });
+		return mat;
+	}
+
+	friend constexpr fmat operator/(const fmat& mat1, value_type d)
+	{
+		fmat mat;
+		unroll<ROWS*COLS>([&](std::size_t i) { mat.m_data[i] = mat1.m_data[i] / d; });
+		return mat;
+	}
+
+	friend constexpr fmat operator*(value_type d, const fmat& mat1) { return mat1 * d; }
+
+	/**
+	 * matrix-matrix product, unrolled for up to 4x4 matrices
+	 */
+	template<std::size_t COLS2>
+	friend constexpr fmat<T, ROWS, COLS2> operator*(const fmat& mat1, const fmat<T, COLS, COLS2>& mat2)
+	{
+		fmat<T, ROWS, COLS2> mat;
+
+		auto calc_elem = [&mat, &mat1, &mat2](std::size_t idx)
+		{
+			const std::size_t row = idx / COLS2;
+			const std::size_t col = idx % COLS2;
+
+			T elem{};
+			unroll<COLS>([&](std::size_t i) { elem += mat1(row, i) * mat2(i, col); });
+			mat(row, col) = elem;
+		};
+
+		if constexpr(ROWS <= 4 && COLS <= 4 && COLS2 <= 4)
+			unroll<ROWS*COLS2>(calc_elem);
+		else
+			for(std::size_t idx=0; idx<ROWS*COLS2; ++idx)
+				calc_elem(idx);
+
+		return mat;
+	}
+
+	/**
+	 * matrix-vector product, unrolled for up to 4x4 matrices
+	 */
+	friend constexpr fvec<T, ROWS> operator*(const fmat& mat1, const fvec<T, COLS>& vec2)
+	{
+		fvec<T, ROWS> vec;
+
+		auto calc_elem = [&vec, &mat1, &vec2](std::size_t row)
+		{
+			T elem{};
+			unroll<COLS>([&](std::size_t i) { elem += mat1(row, i) * vec2[i]; });
+			vec[row] = elem;
+		};
+
+		if constexpr(ROWS <= 4 && COLS <= 4)
+			unroll<ROWS>(calc_elem);
+		else
+			for(std::size_t row=0; row<ROWS; ++row)
+				calc_elem(row);
+
+		return vec;
+	}
+
+	constexpr fmat& operator+=(const fmat& mat2) { return *this = *this + mat2; }
+	constexpr fmat& operator-=(const fmat& mat2) { return *this = *this - mat2; }
+	constexpr fmat& operator*=(const fmat& mat2) requires (ROWS == COLS) { return *this = *this * mat2; }
+	constexpr fmat& operator*=(value_type d) { return *this = *this * d; }
+	constexpr fmat& operator/=(value_type d) { return *this = *this / d; }
+
+private:
+	container_type m_data{};
+};
+// ----------------------------------------------------------------------------
+
+
+/**
+ * ----------------------------------------------------------------------------
+ * compressed sparse matrix container, storing only the non-zero elements
+ * ROW_COMPRESSED = true: compressed sparse rows (CSR), false: compressed sparse columns (CSC)
+ * the elements can be read with operator(), but only the values of existing
+ * non-zero elements can be changed, so the structure is set up by the constructors
+ * and the read-only matrix algorithms can be used with it
+ * @see https://en.wikipedia.org/wiki/Sparse_matrix#Compressed_sparse_row_(CSR,_CRS_or_Yale_format)
+ * ----------------------------------------------------------------------------
+ */
+template<class T = double, bool ROW_COMPRESSED = true, class t_idx = std::size_t>
+class sparse_mat
+{
+public:
+	using value_type = T;
+	using size_type = std::size_t;
+	using index_type = t_idx;
+	using triplet_type = std::tuple<std::size_t, std::size_t, T>;
+
+	static constexpr bool is_row_compressed = ROW_COMPRESSED;
+
+
+public:
+	sparse_mat() = default;
+	~sparse_mat() = default;
+
+	sparse_mat(const sparse_mat&) = default;
+	sparse_mat(sparse_mat&&) = default;
+	sparse_mat& operator=(const sparse_mat&) = default;
+	sparse_mat& operator=(sparse_mat&&) = default;
+
+
+	/**
+	 * builds the matrix from (row, column, value) triplets in any order, duplicates are summed
+	 * @throws std::out_of_range if a triplet lies outside the matrix
+	 */
+	template<template<class...> class t_cont = std::vector>
+	sparse_mat(std::size_t rows, std::size_t cols, const t_cont<triplet_type>& triplets)
+		: m_rows{rows}, m_cols{cols}
+	{
+		const std::size_t num_outer = ROW_COMPRESSED ? rows : cols;
+
+		for(const triplet_type& triplet : triplets)
+		{
+			if(std::get<0>(triplet) >= rows || std::get<1>(triplet) >= cols)
+				throw std::out_of_range("Sparse matrix element index out of range.");
+		}
+
+		// count the elements per outer index
+		m_ptr.assign(num_outer + 1, t_idx(0));
+		for(const triplet_type& triplet : triplets)
+			++m_ptr[outer_of(std::get<0>(triplet), std::get<1>(triplet)) + 1];
+		for(std::size_t outer=0; outer<num_outer; ++outer)
+			m_ptr[outer + 1] += m_ptr[outer];
+
+		// scatter the elements into their outer segments
+		m_idx.resize(triplets.size());
+		m_vals.resize(triplets.size());
+		std::vector<t_idx> pos(m_ptr.begin(), m_ptr.end() - 1);
+		for(const triplet_type& triplet : triplets)
+		{
+			const auto [row, col, val] = triplet;
+			t_idx& dst = pos[outer_of(row, col)];
+
+			m_idx[dst] = t_idx(inner_of(row, col));
+			m_vals[dst] = val;
+			++dst;
+		}
+
+		// sort every segment by the inner index and sum the duplicates
+		std::vector<std::pair<t_idx, T>> segment;
+		t_idx num_nz = 0;
+		for(std::size_t outer=0; outer<num_outer; ++outer)
+		{
+			const t_idx begin = m_ptr[outer], end = m_ptr[outer + 1];
+			m_ptr[outer] = num_nz;
+
+			segment.clear();
+			for(t_idx i=begin; i<end; ++i)
+				segment.emplace_back(m_idx[i], m_vals[i]);
+			std::sort(segment.begin(), segment.end(),
+				[](const auto& elem1, const auto& elem2) -> bool
+					{ return elem1.first < elem2.first; });
+
+			for(std::size_t i=0; i<segment.size(); ++i)
+			{
+				if(i > 0 && segment[i].first == segment[i - 1].first)
+				{
+					m_vals[num_nz - 1] += segment[i].second;
+					continue;
+				}
+
+				m_idx[num_nz] = segment[i].first;
+				m_vals[num_nz] = segment[i].second;
+				++num_nz;
+			}
+		}
+
+		m_ptr[num_outer] = num_nz;
+		m_idx.resize(num_nz);
+		m_vals.resize(num_nz);
+	}
+
+
+	/**
+	 * converts a dense matrix, skipping its zero elements
+	 */
+	template<class t_mat>
+	explicit sparse_mat(const t_mat& mat)
+	requires is_basic_mat<t_mat> && (!std::is_same_v<t_mat, sparse_mat>)
+		: m_rows{std::size_t(mat.size1())}, m_cols{std::size_t(mat.size2())}
+	{
+		const std::size_t num_outer = ROW_COMPRESSED ? m_rows : m_cols;
+		const std::size_t num_inner = ROW_COMPRESSED ? m_cols : m_rows;
+
+		// m_ptr already contains the start of the first row or column
+		m_ptr.reserve(num_outer + 1);
+
+		for(std::size_t outer=0; outer<num_outer; ++outer)
+		{
+			for(std::size_t inner=0; inner<num_inner; ++inner)
+			{
+				const T val = ROW_COMPRESSED ? mat(outer, inner) : mat(inner, outer);
+				if(val == T(0))
+					continue;
+
+				m_idx.push_back(t_idx(inner));
+				m_vals.push_back(val);
+			}
+
+			m_ptr.push_back(t_idx(m_idx.size()));
+		}
+	}
+
+
+	/**
+	 * converts between the row- and column-compressed formats
+	 */
+	explicit sparse_mat(const sparse_mat<T, !ROW_COMPRESSED, t_idx>& mat)
+		: m_rows{mat.size1()}, m_cols{mat.size2()}
+	{
+		const std::size_t num_outer = ROW_COMPRESSED ? m_rows : m_cols;
+		const std::size_t num_outer_other = ROW_COMPRESSED ? m_cols : m_rows;
+		const auto& ptr_other = mat.outer_ptr();
+		const auto& idx_other = mat.inner_idx();
+		const auto& vals_other = mat.values();
+
+		// count the elements per outer index
+		m_ptr.assign(num_outer + 1, t_idx(0));
+		for(t_idx idx : idx_other)
+			++m_ptr[idx + 1];
+		for(std::size_t outer=0; outer<num_outer; ++outer)
+			m_ptr[outer + 1] += m_ptr[outer];
+
+		// the inner indices stay sorted, because the other matrix is traversed in order
+		m_idx.resize(idx_other.size());
+		m_vals.resize(vals_other.size());
+		std::vector<t_idx> pos(m_ptr.begin(), m_ptr.end() - 1);
+		for(std::size_t outer_other=0; outer_other<num_outer_other; ++outer_other)
+		{
+			for(t_idx i=ptr_other[outer_other]; i<ptr_other[outer_other + 1]; ++i)
+			{
+				t_idx& dst = pos[idx_other[i]];
+				m_idx[dst] = t_idx(outer_other);
+				m_vals[dst] = vals_other[i];
+				++dst;
+			}
+		}
+	}
+
+
+	std::size_t size1() const { return m_rows; }
+	std::size_t size2() const { return m_cols; }
+
+	/**
+	 * number of stored elements
+	 */
+	std::size_t nnz() const { return m_vals.size(); }
+
+
+	/**
+	 * element access, O(log(non-zero elements per row or column))
+	 */
+	T operator()(std::size_t row, std::size_t col) const
+	{
+		const std::size_t outer = outer_of(row, col);
+		const t_idx inner = t_idx(inner_of(row, col));
+
+		auto begin = m_idx.begin() + m_ptr[outer];
+		auto end = m_idx.begin() + m_ptr[outer + 1];
+		auto iter = std::lower_bound(begin, end, inner);
+
+		if(iter == end || *iter != inner)
+			return T(0);
+		return m_vals[iter - m_idx.begin()];
+	}
+
+
+	/**
+	 * raw compressed storage
+	 */
+	const std::vector<t_idx>& outer_ptr() const { return m_ptr; }
+	const std::vector<t_idx>& inner_idx() const { return m_idx; }
+	const std::vector<T>& values() const { return m_vals; }
+	std::vector<T>& values() { return m_vals; }
+
+
+	/**
+	 * y = alpha * A * x + beta * y, without allocating memory
+	 * @throws std::invalid_argument if the vector sizes don't match the matrix
+	 */
+	template<class t_vec_in, class t_vec_out>
+	void mult(const t_vec_in& x, t_vec_out& y, T alpha = T(1), T beta = T(0)) const
+	requires is_basic_vec<t_vec_in> && is_basic_vec<t_vec_out>
+	{
+		if(std::size_t(x.size()) != m_cols || std::size_t(y.size()) != m_rows)
+			throw std::invalid_argument("Sparse matrix-vector product size mismatch.");
+
+		if constexpr(ROW_COMPRESSED)
+		{
+			for(std::size_t row=0; row<m_rows; ++row)
+			{
+				T sum{};
+				for(t_idx i=m_ptr[row]; i<m_ptr[row + 1]; ++i)
+					sum += m_vals[i] * x[m_idx[i]];
+
+				y[row] = (beta == T(0) ? T(0) : beta * y[row]) + alpha * sum;
+			}
+		}
+		else
+		{
+			for(std::size_t row=0; row<m_rows; ++row)
+				y[row] = (beta == T(0) ? T(0) : beta * y[row]);
+
+			for(std::size_t col=0; col<m_cols; ++col)
+			{
+				const T x_col = alpha * x[col];
+				for(t_idx i=m_ptr[col]; i<m_ptr[col + 1]; ++i)
+					y[m_idx[i]] += m_vals[i] * x_col;
+			}
+		}
+	}
+
+
+	/**
+	 * C = A * B + C for a dense matrix B, without allocating memory
+	 * @throws std::invalid_argument if the matrix sizes don't match
+	 */
+	template<class t_mat_in, class t_mat_out>
+	void mult_add(const t_mat_in& B, t_mat_out& C) const
+	requires is_basic_mat<t_mat_in> && is_basic_mat<t_mat_out>
+	{
+		if(std::size_t(B.size1()) != m_cols || std::size_t(C.size1()) != m_rows
+			|| std::size_t(C.size2()) != std::size_t(B.size2()))
+			throw std::invalid_argument("Sparse matrix-matrix product size mismatch.");
+
+		const std::size_t cols_B = B.size2();
+		const std::size_t num_outer = ROW_COMPRESSED ? m_rows : m_cols;
+
+		for(std::size_t outer=0; outer<num_outer; ++outer)
+		{
+			for(t_idx i=m_ptr[outer]; i<m_ptr[outer + 1]; ++i)
+			{
+				const std::size_t row = ROW_COMPRESSED ? outer : std::size_t(m_idx[i]);
+				const std::size_t k = ROW_COMPRESSED ? std::size_t(m_idx[i]) : outer;
+				const T val = m_vals[i];
+
+				// add the scaled row of B to the row of C
+				for(std::size_t col=0; col<cols_B; ++col)
+					C(row, col) += val * B(k, col);
+			}
+		}
+	}
+
+
+	/**
+	 * sparse matrix-vector product
+	 * @throws std::invalid_argument if the vector size doesn't match the number of columns
+	 */
+	template<class t_vec>
+	friend t_vec operator*(const sparse_mat& mat, const t_vec& vec)
+	requires is_basic_vec<t_vec> && is_dyn_vec<t_vec>
+	{
+		t_vec vecRet(mat.size1());
+		mat.mult(vec, vecRet);
+		return vecRet;
+	}
+
+
+	/**
+	 * sparse-dense matrix product
+	 * @throws std::invalid_argument if the rows of the dense matrix don't match the columns of the sparse one
+	 */
+	template<class t_mat>
+	friend t_mat operator*(const sparse_mat& mat1, const t_mat& mat2)
+	requires is_basic_mat<t_mat> && is_dyn_mat<t_mat>
+	{
+		t_mat matRet(mat1.size1(), mat2.size2());
+		for(std::size_t row=0; row<matRet.size1(); ++row)
+			for(std::size_t col=0; col<matRet.size2(); ++col)
+				matRet(row, col) = T(0);
+
+		mat1.mult_add(mat2, matRet);
+		return matRet;
+	}
+
+
+	/**
+	 * element-wise sum, merging the non-zero elements of both matrices
+	 */
+	friend sparse_mat operator+(const sparse_mat& mat1, const sparse_mat& mat2)
+	{
+		return merge(mat1, mat2, T(1));
+	}
+
+
+	friend sparse_mat operator-(const sparse_mat& mat1, const sparse_mat& mat2)
+	{
+		return merge(mat1, mat2, T(-1));
+	}
+
+
+	friend sparse_mat operator-(const sparse_mat& mat1)
+	{
+		return mat1 * T(-1);
+	}
+
+
+	friend sparse_mat operator*(const sparse_mat& mat1, T d)
+	{
+		sparse_mat mat = mat1;
+		for(T& val : mat.m_vals)
+			val *= d;
+		return mat;
+	}
+
+	friend sparse_mat operator*(T d, const sparse_mat& mat1) { return mat1 * d; }
+
+	friend sparse_mat operator/(const sparse_mat& mat1, T d)
+	{
+		sparse_mat mat = mat1;
+		for(T& val : mat.m_vals)
+			val /= d;
+		return mat;
+	}
+
+
+protected:
+	/**
+	 * mat1 + sign*mat2
+	 */
+	static sparse_mat merge(const sparse_mat& mat1, const sparse_mat& mat2, T sign)
+	{
+		assert(mat1.size1() == mat2.size1() && mat1.size2() == mat2.size2());
+
+		sparse_mat mat;
+		mat.m_rows = mat1.m_rows;
+		mat.m_cols = mat1.m_cols;
+		mat.m_ptr.reserve(mat1.m_ptr.size());
+		mat.m_idx.reserve(std::max(mat1.nnz(), mat2.nnz()));
+		mat.m_vals.reserve(std::max(mat1.nnz(), mat2.nnz()));
+
+		for(std::size_t outer=0; outer+1<mat1.m_ptr.size(); ++outer)
+		{
+			t_idx i1 = mat1.m_ptr[outer], i2 = mat2.m_ptr[outer];
+			const t_idx end1 = mat1.m_ptr[outer + 1], end2 = mat2.m_ptr[outer + 1];
+
+			while(i1 < end1 || i2 < end2)
+			{
+				if(i2 >= end2 || (i1 < end1 && mat1.m_idx[i1] < mat2.m_idx[i2]))
+				{
+					mat.m_idx.push_back(mat1.m_idx[i1]);
+					mat.m_vals.push_back(mat1.m_vals[i1++]);
+				}
+				else if(i1 >= end1 || mat2.m_idx[i2] < mat1.m_idx[i1])
+				{
+					mat.m_idx.push_back(mat2.m_idx[i2]);
+					mat.m_vals.push_back(sign * mat2.m_vals[i2++]);
+				}
+				else
+				{
+					mat.m_idx.push_back(mat1.m_idx[i1]);
+					mat.m_vals.push_back(mat1.m_vals[i1++] + sign * mat2.m_vals[i2++]);
+				}
+			}
+
+			mat.m_ptr.push_back(t_idx(mat.m_idx.size()));
+		}
+
+		return mat;
+	}
+
+
+	std::size_t outer_of(std::size_t row, std::size_t col) const
+	{
+		return ROW_COMPRESSED ? row : col;
+	}
+
+	std::size_t inner_of(std::size_t row, std::size_t col) const
+	{
+		return ROW_COMPRESSED ? col : row;
+	}
+
+
+private:
+	std::size_t m_rows = 0, m_cols = 0;
+
+	// start of every row (CSR) or column (CSC) in the index and value arrays
+	std::vector<t_idx> m_ptr{ t_idx(0) };
+	// column (CSR) or row (CSC) indices of the non-zero elements
+	std::vector<t_idx> m_idx{};
+	// values of the non-zero elements
+	std::vector<T> m_vals{};
+};
+
+
+template<class T = double, class t_idx = std::size_t>
+using csr_mat = sparse_mat<T, true, t_idx>;
+
+template<class T = double, class t_idx = std::size_t>
+using csc_mat = sparse_mat<T, false, t_idx>;
+// ----------------------------------------------------------------------------
+
+
 /**
  * ----------------------------------------------------------------------------
  * quaternion container
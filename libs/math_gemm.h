@@ -0,0 +1,324 @@
+/**
+ * cache-blocked matrix-matrix product kernel for contiguous, row-major matrices
+ * @author Tobias Weber
+ * @date oct-2026
+ * @license see 'LICENSE.EUPL' file
+ *
+ * @see references for algorithms:
+ * 	- (Goto08): K. Goto and R. A. van de Geijn, ACM Trans. Math. Softw. 34(3), DOI: 10.1145/1356052.1356053 (2008).
+ *
+ * the simd micro-kernels are selected at compile time, e.g. with -mavx2 -mfma or -mavx512f,
+ * otherwise a scalar micro-kernel is used (which is also the one for complex types).
+ */
+
+#ifndef __MATH_GEMM_H__
+#define __MATH_GEMM_H__
+
+#include "math_concepts.h"
+#include "par_helpers.h"
+
+#include <cstddef>
+#include <algorithm>
+
+#if defined(__AVX512F__) || (defined(__AVX2__) && defined(__FMA__))
+	#include <immintrin.h>
+#endif
+
+
+// minimum number of multiply-adds (rows*cols*inner) for which several threads are used, 0: never
+#ifndef MATH_GEMM_THREAD_THRESHOLD
+	#define MATH_GEMM_THREAD_THRESHOLD (std::size_t(1) << 24)
+#endif
+
+
+namespace m {
+
+// ----------------------------------------------------------------------------
+// block sizes
+// ----------------------------------------------------------------------------
+// rows of A and C per micro-kernel (register block)
+constexpr std::size_t GEMM_MR = 4;
+// rows of A per cache block
+constexpr std::size_t GEMM_MC = 64;
+// inner dimension per cache block
+constexpr std::size_t GEMM_KC = 256;
+// columns of B and C per cache block
+constexpr std::size_t GEMM_NC = 256;
+// ----------------------------------------------------------------------------
+
+
+
+// ----------------------------------------------------------------------------
+// simd types
+// ----------------------------------------------------------------------------
+/**
+ * simd register traits, the scalar fallback has a width of 1
+ */
+template<class T>
+struct gemm_simd
+{
+	static constexpr bool enabled = false;
+	static constexpr std::size_t width = 1;
+};
+
+
+#if defined(__AVX512F__)
+template<>
+struct gemm_simd<double>
+{
+	using t_reg = __m512d;
+	static constexpr bool enabled = true;
+	static constexpr std::size_t width = 8;
+
+	static t_reg zero() { return _mm512_setzero_pd(); }
+	static t_reg set1(double d) { return _mm512_set1_pd(d); }
+	static t_reg load(const double* p) { return _mm512_loadu_pd(p); }
+	static void store(double* p, t_reg r) { _mm512_storeu_pd(p, r); }
+	static t_reg add(t_reg a, t_reg b) { return _mm512_add_pd(a, b); }
+	static t_reg fmadd(t_reg a, t_reg b, t_reg c) { return _mm512_fmadd_pd(a, b, c); }
+};
+
+
+template<>
+struct gemm_simd<float>
+{
+	using t_reg = __m512;
+	static constexpr bool enabled = true;
+	static constexpr std::size_t width = 16;
+
+	static t_reg zero() { return _mm512_setzero_ps(); }
+	static t_reg set1(float d) { return _mm512_set1_ps(d); }
+	static t_reg load(const float* p) { return _mm512_loadu_ps(p); }
+	static void store(float* p, t_reg r) { _mm512_storeu_ps(p, r); }
+	static t_reg add(t_reg a, t_reg b) { return _mm512_add_ps(a, b); }
+	static t_reg fmadd(t_reg a, t_reg b, t_reg c) { return _mm512_fmadd_ps(a, b, c); }
+};
+
+#elif defined(__AVX2__) && defined(__FMA__)
+template<>
+struct gemm_simd<double>
+{
+	using t_reg = __m256d;
+	static constexpr bool enabled = true;
+	static constexpr std::size_t width = 4;
+
+	static t_reg zero() { return _mm256_setzero_pd(); }
+	static t_reg set1(double d) { return _mm256_set1_pd(d); }
+	static t_reg load(const double* p) { return _mm256_loadu_pd(p); }
+	static void store(double* p, t_reg r) { _mm256_storeu_pd(p, r); }
+	static t_reg add(t_reg a, t_reg b) { return _mm256_add_pd(a, b); }
+	static t_reg fmadd(t_reg a, t_reg b, t_reg c) { return _mm256_fmadd_pd(a, b, c); }
+};
+
+
+template<>
+struct gemm_simd<float>
+{
+	using t_reg = __m256;
+	static constexpr bool enabled = true;
+	static constexpr std::size_t width = 8;
+
+	static t_reg zero() { return _mm256_setzero_ps(); }
+	static t_reg set1(float d) { return _mm256_set1_ps(d); }
+	static t_reg load(const float* p) { return _mm256_loadu_ps(p); }
+	static void store(float* p, t_reg r) { _mm256_storeu_ps(p, r); }
+	static t_reg add(t_reg a, t_reg b) { return _mm256_add_ps(a, b); }
+	static t_reg fmadd(t_reg a, t_reg b, t_reg c) { return _mm256_fmadd_ps(a, b, c); }
+};
+#endif
+// ----------------------------------------------------------------------------
+
+
+
+// ----------------------------------------------------------------------------
+// micro-kernels
+// ----------------------------------------------------------------------------
+/**
+ * c += a*b
+ * complex numbers are multiplied component-wise to avoid the slow inf/nan handling of std::complex
+ */
+template<class T>
+inline void gemm_madd(T& c, const T& a, const T& b)
+{
+	if constexpr(is_complex<T>)
+	{
+		c = T(c.real() + a.real()*b.real() - a.imag()*b.imag(),
+			c.imag() + a.real()*b.imag() + a.imag()*b.real());
+	}
+	else
+	{
+		c += a*b;
+	}
+}
+
+
+/**
+ * columns of B and C per micro-kernel (register block)
+ */
+template<class T>
+constexpr std::size_t gemm_nr()
+{
+	if constexpr(gemm_simd<T>::enabled)
+		return 2 * gemm_simd<T>::width;
+	else
+		return 4;
+}
+
+
+/**
+ * C[MR x NR] += A[MR x kc] * B[kc x NR], keeping the C block in registers
+ */
+template<class T>
+void gemm_micro(const T* A, std::size_t lda, const T* B, std::size_t ldb,
+	T* C, std::size_t ldc, std::size_t kc)
+{
+	constexpr std::size_t MR = GEMM_MR;
+	constexpr std::size_t NR = gemm_nr<T>();
+
+	if constexpr(gemm_simd<T>::enabled)
+	{
+		using t_simd = gemm_simd<T>;
+		using t_reg = typename t_simd::t_reg;
+		constexpr std::size_t W = t_simd::width;
+
+		t_reg c[MR][2];
+		for(std::size_t i=0; i<MR; ++i)
+			c[i][0] = c[i][1] = t_simd::zero();
+
+		for(std::size_t k=0; k<kc; ++k)
+		{
+			const t_reg b0 = t_simd::load(B + k*ldb);
+			const t_reg b1 = t_simd::load(B + k*ldb + W);
+
+			for(std::size_t i=0; i<MR; ++i)
+			{
+				const t_reg a = t_simd::set1(A[i*lda + k]);
+				c[i][0] = t_simd::fmadd(a, b0, c[i][0]);
+				c[i][1] = t_simd::fmadd(a, b1, c[i][1]);
+			}
+		}
+
+		for(std::size_t i=0; i<MR; ++i)
+		{
+			t_simd::store(C + i*ldc, t_simd::add(t_simd::load(C + i*ldc), c[i][0]));
+			t_simd::store(C + i*ldc + W, t_simd::add(t_simd::load(C + i*ldc + W), c[i][1]));
+		}
+	}
+	else
+	{
+		// the compiler keeps the C block in registers for small types
+		T c[MR][NR]{};
+
+		for(std::size_t k=0; k<kc; ++k)
+		{
+			for(std::size_t i=0; i<MR; ++i)
+			{
+				const T a = A[i*lda + k];
+				for(std::size_t j=0; j<NR; ++j)
+					gemm_madd<T>(c[i][j], a, B[k*ldb + j]);
+			}
+		}
+
+		for(std::size_t i=0; i<MR; ++i)
+			for(std::size_t j=0; j<NR; ++j)
+				C[i*ldc + j] += c[i][j];
+	}
+}
+
+
+/**
+ * C[mr x nr] += A[mr x kc] * B[kc x nr] for the remaining edges of a block
+ */
+template<class T>
+void gemm_edge(const T* A, std::size_t lda, const T* B, std::size_t ldb,
+	T* C, std::size_t ldc, std::size_t mr, std::size_t nr, std::size_t kc)
+{
+	for(std::size_t i=0; i<mr; ++i)
+	{
+		for(std::size_t k=0; k<kc; ++k)
+		{
+			const T a = A[i*lda + k];
+			for(std::size_t j=0; j<nr; ++j)
+				gemm_madd<T>(C[i*ldc + j], a, B[k*ldb + j]);
+		}
+	}
+}
+// ----------------------------------------------------------------------------
+
+
+
+// ----------------------------------------------------------------------------
+// blocked matrix-matrix product
+// ----------------------------------------------------------------------------
+/**
+ * C += A * B for the rows [row_begin, row_end) of A and C
+ * A: M x K, B: K x N, C: M x N, all in contiguous row-major storage
+ * @see (Goto08)
+ */
+template<class T>
+void gemm_rows(const T* A, const T* B, T* C,
+	std::size_t N, std::size_t K,
+	std::size_t row_begin, std::size_t row_end)
+{
+	constexpr std::size_t MR = GEMM_MR;
+	constexpr std::size_t NR = gemm_nr<T>();
+
+	for(std::size_t kk=0; kk<K; kk+=GEMM_KC)
+	{
+		const std::size_t kc = std::min(GEMM_KC, K-kk);
+
+		for(std::size_t jj=0; jj<N; jj+=GEMM_NC)
+		{
+			const std::size_t nc = std::min(GEMM_NC, N-jj);
+
+			for(std::size_t ii=row_begin; ii<row_end; ii+=GEMM_MC)
+			{
+				const std::size_t mc = std::min(GEMM_MC, row_end-ii);
+
+				for(std::size_t i=0; i<mc; i+=MR)
+				{
+					const std::size_t mr = std::min(MR, mc-i);
+					const T* blockA = A + (ii+i)*K + kk;
+
+					for(std::size_t j=0; j<nc; j+=NR)
+					{
+						const std::size_t nr = std::min(NR, nc-j);
+						const T* blockB = B + kk*N + jj + j;
+						T* blockC = C + (ii+i)*N + jj + j;
+
+						if(mr == MR && nr == NR)
+							gemm_micro<T>(blockA, K, blockB, N, blockC, N, kc);
+						else
+							gemm_edge<T>(blockA, K, blockB, N, blockC, N, mr, nr, kc);
+					}
+				}
+			}
+		}
+	}
+}
+
+
+/**
+ * C += A * B
+ * A: M x K, B: K x N, C: M x N, all in contiguous row-major storage
+ * large products are distributed over the available hardware threads
+ */
+template<class T>
+void gemm(const T* A, const T* B, T* C,
+	std::size_t M, std::size_t N, std::size_t K,
+	std::size_t thread_threshold = MATH_GEMM_THREAD_THRESHOLD)
+{
+	// each thread calculates its own row blocks of C
+	const std::size_t num_blocks = (M + GEMM_MR - 1) / GEMM_MR;
+
+	parallel_chunks(num_blocks, parallel_threads(M*N*K, thread_threshold),
+		[A, B, C, M, N, K](std::size_t, std::size_t block_begin, std::size_t block_end)
+	{
+		gemm_rows<T>(A, B, C, N, K, block_begin * GEMM_MR, std::min(block_end * GEMM_MR, M));
+	});
+}
+// ----------------------------------------------------------------------------
+
+}
+
+#endif
@@ -0,0 +1,117 @@
+/**
+ * tests and benchmarks the blocked matrix-matrix product
+ * @author Tobias Weber
+ * @date oct-2026
+ * @license: see 'LICENSE.EUPL' file
+ *
+ * g++ -std=c++20 -Wall -Wextra -Weffc++ -O2 -march=native -o math_gemm_tst math_gemm_tst.cpp -lpthread
+ */
+
+#include <iostream>
+#include <random>
+#include <chrono>
+
+#include "math_algos.h"
+#include "math_conts.h"
+
+using namespace m;
+using namespace m_ops;
+
+
+/**
+ * reference product using the naive triple loop
+ */
+template<class t_mat>
+t_mat mult_naive(const t_mat& mat1, const t_mat& mat2)
+{
+	t_mat matRet = zero<t_mat>(mat1.size1(), mat2.size2());
+
+	for(std::size_t row=0; row<matRet.size1(); ++row)
+		for(std::size_t col=0; col<matRet.size2(); ++col)
+			for(std::size_t i=0; i<mat1.size2(); ++i)
+				matRet(row, col) += mat1(row, i) * mat2(i, col);
+
+	return matRet;
+}
+
+
+template<class t_mat>
+t_mat rand_mat(std::size_t rows, std::size_t cols, std::mt19937& rnd)
+{
+	using T = typename t_mat::value_type;
+	std::uniform_real_distribution<double> dist(-1., 1.);
+
+	t_mat mat = create<t_mat>(rows, cols);
+	for(std::size_t i=0; i<rows; ++i)
+	{
+		for(std::size_t j=0; j<cols; ++j)
+		{
+			if constexpr(is_complex<T>)
+				mat(i, j) = T(dist(rnd), dist(rnd));
+			else
+				mat(i, j) = T(dist(rnd));
+		}
+	}
+
+	return mat;
+}
+
+
+template<class t_mat>
+void check_mult(std::size_t M, std::size_t N, std::size_t K, typename t_mat::value_type eps)
+{
+	std::mt19937 rnd{1234};
+	t_mat A = rand_mat<t_mat>(M, K, rnd);
+	t_mat B = rand_mat<t_mat>(K, N, rnd);
+
+	t_mat C = A * B;
+	t_mat C_ref = mult_naive<t_mat>(A, B);
+
+	std::cout << M << "x" << K << " * " << K << "x" << N << ": ok = "
+		<< equals<t_mat>(C, C_ref, eps) << std::endl;
+}
+
+
+template<class t_mat>
+void bench_mult(std::size_t N)
+{
+	std::mt19937 rnd{1234};
+	t_mat A = rand_mat<t_mat>(N, N, rnd);
+	t_mat B = rand_mat<t_mat>(N, N, rnd);
+
+	auto start_naive = std::chrono::steady_clock::now();
+	t_mat C_ref = mult_naive<t_mat>(A, B);
+	auto stop_naive = std::chrono::steady_clock::now();
+
+	auto start_gemm = std::chrono::steady_clock::now();
+	t_mat C = A * B;
+	auto stop_gemm = std::chrono::steady_clock::now();
+
+	std::cout << N << "x" << N << ": naive: "
+		<< std::chrono::duration<double>(stop_naive - start_naive).count() << " s, blocked: "
+		<< std::chrono::duration<double>(stop_gemm - start_gemm).count() << " s" << std::endl;
+}
+
+
+int main()
+{
+	using t_mat = mat<double, std::vector>;
+	using t_mat_f = mat<float, std::vector>;
+	using t_mat_cplx = mat<std::complex<double>, std::vector>;
+
+	std::cout << std::boolalpha;
+
+	// sizes which are not multiples of the block sizes
+	check_mult<t_mat>(1, 1, 1, 1e-12);
+	check_mult<t_mat>(3, 5, 7, 1e-12);
+	check_mult<t_mat>(67, 131, 301, 1e-10);
+	check_mult<t_mat>(300, 257, 513, 1e-10);
+	check_mult<t_mat_f>(67, 131, 301, 1e-3);
+	check_mult<t_mat_cplx>(67, 35, 129, 1e-10);
+
+	bench_mult<t_mat>(512);
+	bench_mult<t_mat_f>(512);
+	bench_mult<t_mat_cplx>(256);
+
+	return 0;
+}
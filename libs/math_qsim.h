@@ -0,0 +1,313 @@
+/**
+ * state-vector quantum circuit simulation
+ * @author Tobias Weber
+ * @date oct-2026
+ * @license see 'LICENSE.EUPL' file
+ *
+ * the gates are applied in place to the 2^n amplitudes of the state vector
+ * instead of building the 2^n x 2^n circuit operators with outer products.
+ *
+ * qubit numbering as in m::outer and m::outer_flat: qubit 0 is the leftmost factor,
+ * i.e. the most significant bit of the amplitude index, and |down> = (1, 0) is bit value 0.
+ * the gate matrices hadamard(), phasegate(), su2_matrix(), cnot() and cunitary()
+ * from math_algos.h can directly be used as inputs.
+ *
+ * @see (FUH 2021) and (DesktopBronstein08), Ch. 22 (Zusatzkapitel.pdf) for the gates
+ */
+
+#ifndef __MATH_QSIM_H__
+#define __MATH_QSIM_H__
+
+#include "math_algos.h"
+#include "par_helpers.h"
+
+#include <cstddef>
+#include <cmath>
+#include <complex>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <bit>
+#include <stdexcept>
+
+
+// minimum number of amplitudes for which several threads are used, 0: never
+#ifndef MATH_QSIM_THREAD_THRESHOLD
+	#define MATH_QSIM_THREAD_THRESHOLD (std::size_t(1) << 18)
+#endif
+
+
+namespace m {
+
+// ----------------------------------------------------------------------------
+// helpers
+// ----------------------------------------------------------------------------
+/**
+ * number of qubits of a state vector with 2^n amplitudes
+ */
+template<class t_vec>
+std::size_t qsim_num_qubits(const t_vec& state)
+requires is_basic_vec<t_vec>
+{
+	return std::bit_width(std::size_t(state.size())) - 1;
+}
+
+
+/**
+ * bit mask of a qubit in the amplitude index
+ * @throws std::out_of_range if the qubit does not exist
+ */
+inline std::size_t qsim_mask(std::size_t qubit, std::size_t num_qubits)
+{
+	if(qubit >= num_qubits)
+		throw std::out_of_range("Qubit index out of range.");
+
+	return std::size_t(1) << (num_qubits - 1 - qubit);
+}
+
+
+/**
+ * inserts a zero bit at the position given by the mask
+ */
+inline std::size_t qsim_insert_zero(std::size_t idx, std::size_t mask)
+{
+	return ((idx & ~(mask - 1)) << 1) | (idx & (mask - 1));
+}
+
+
+
+
+/**
+ * basis state |idx> of n qubits, by default |down down ... down>
+ */
+template<class t_vec>
+t_vec qsim_basis_state(std::size_t num_qubits, std::size_t idx = 0)
+requires is_vec<t_vec> && is_complex<typename t_vec::value_type>
+{
+	t_vec state = zero<t_vec>(std::size_t(1) << num_qubits);
+	state[idx] = typename t_vec::value_type(1);
+	return state;
+}
+// ----------------------------------------------------------------------------
+
+
+
+// ----------------------------------------------------------------------------
+// gates
+// ----------------------------------------------------------------------------
+/**
+ * applies the one-qubit gate U22 to the given qubit
+ * @throws std::out_of_range if the qubit does not exist
+ */
+template<class t_vec, class t_mat>
+void apply_gate(t_vec& state, const t_mat& U22, std::size_t qubit,
+	std::size_t thread_threshold = MATH_QSIM_THREAD_THRESHOLD)
+requires is_vec<t_vec> && is_mat<t_mat> && is_complex<typename t_vec::value_type>
+{
+	using t_cplx = typename t_vec::value_type;
+
+	const std::size_t num_amps = state.size();
+	const std::size_t mask = qsim_mask(qubit, qsim_num_qubits(state));
+
+	const t_cplx u00 = U22(0, 0), u01 = U22(0, 1);
+	const t_cplx u10 = U22(1, 0), u11 = U22(1, 1);
+
+	parallel_chunks(num_amps/2, parallel_threads(num_amps, thread_threshold),
+		[&state, mask, u00, u01, u10, u11](std::size_t, std::size_t begin, std::size_t end)
+	{
+		for(std::size_t pair=begin; pair<end; ++pair)
+		{
+			const std::size_t idx0 = qsim_insert_zero(pair, mask);
+			const std::size_t idx1 = idx0 | mask;
+
+			const t_cplx amp0 = state[idx0];
+			const t_cplx amp1 = state[idx1];
+			state[idx0] = u00*amp0 + u01*amp1;
+			state[idx1] = u10*amp0 + u11*amp1;
+		}
+	});
+}
+
+
+/**
+ * applies the two-qubit gate U44 to the given qubits
+ * qubit1 corresponds to the left and qubit2 to the right factor of the gate's basis,
+ * e.g. qubit1 is the control bit of cnot()
+ * @throws std::invalid_argument if both qubits are the same
+ * @throws std::out_of_range if a qubit does not exist
+ */
+template<class t_vec, class t_mat>
+void apply_gate2(t_vec& state, const t_mat& U44, std::size_t qubit1, std::size_t qubit2,
+	std::size_t thread_threshold = MATH_QSIM_THREAD_THRESHOLD)
+requires is_vec<t_vec> && is_mat<t_mat> && is_complex<typename t_vec::value_type>
+{
+	using t_cplx = typename t_vec::value_type;
+
+	if(qubit1 == qubit2)
+		throw std::invalid_argument("Two-qubit gate needs two different qubits.");
+
+	const std::size_t num_amps = state.size();
+	const std::size_t num_qubits = qsim_num_qubits(state);
+	const std::size_t mask1 = qsim_mask(qubit1, num_qubits);
+	const std::size_t mask2 = qsim_mask(qubit2, num_qubits);
+	const std::size_t mask_lo = std::min(mask1, mask2);
+	const std::size_t mask_hi = std::max(mask1, mask2);
+
+	t_cplx U[4][4];
+	for(std::size_t i=0; i<4; ++i)
+		for(std::size_t j=0; j<4; ++j)
+			U[i][j] = U44(i, j);
+
+	parallel_chunks(num_amps/4, parallel_threads(num_amps, thread_threshold),
+		[&state, &U, mask1, mask2, mask_lo, mask_hi](std::size_t, std::size_t begin, std::size_t end)
+	{
+		for(std::size_t group=begin; group<end; ++group)
+		{
+			const std::size_t idx00 = qsim_insert_zero(qsim_insert_zero(group, mask_lo), mask_hi);
+			const std::size_t idx[4] = { idx00, idx00 | mask2, idx00 | mask1, idx00 | mask1 | mask2 };
+
+			t_cplx amp[4];
+			for(std::size_t i=0; i<4; ++i)
+				amp[i] = state[idx[i]];
+
+			for(std::size_t i=0; i<4; ++i)
+				state[idx[i]] = U[i][0]*amp[0] + U[i][1]*amp[1] + U[i][2]*amp[2] + U[i][3]*amp[3];
+		}
+	});
+}
+
+
+/**
+ * applies the one-qubit gate U22 to the target qubit if the control qubit is |up>
+ * this only touches half of the amplitudes in comparison to the equivalent 4x4 gate
+ * @throws std::invalid_argument if the control and target qubits are the same
+ * @throws std::out_of_range if a qubit does not exist
+ */
+template<class t_vec, class t_mat>
+void apply_controlled_gate(t_vec& state, const t_mat& U22, std::size_t control, std::size_t target,
+	std::size_t thread_threshold = MATH_QSIM_THREAD_THRESHOLD)
+requires is_vec<t_vec> && is_mat<t_mat> && is_complex<typename t_vec::value_type>
+{
+	using t_cplx = typename t_vec::value_type;
+
+	if(control == target)
+		throw std::invalid_argument("Control and target qubits have to be different.");
+
+	const std::size_t num_amps = state.size();
+	const std::size_t num_qubits = qsim_num_qubits(state);
+	const std::size_t mask_ctrl = qsim_mask(control, num_qubits);
+	const std::size_t mask_tgt = qsim_mask(target, num_qubits);
+	const std::size_t mask_lo = std::min(mask_ctrl, mask_tgt);
+	const std::size_t mask_hi = std::max(mask_ctrl, mask_tgt);
+
+	const t_cplx u00 = U22(0, 0), u01 = U22(0, 1);
+	const t_cplx u10 = U22(1, 0), u11 = U22(1, 1);
+
+	parallel_chunks(num_amps/4, parallel_threads(num_amps, thread_threshold),
+		[&state, mask_ctrl, mask_tgt, mask_lo, mask_hi, u00, u01, u10, u11](std::size_t, std::size_t begin, std::size_t end)
+	{
+		for(std::size_t group=begin; group<end; ++group)
+		{
+			const std::size_t idx0 = qsim_insert_zero(qsim_insert_zero(group, mask_lo), mask_hi) | mask_ctrl;
+			const std::size_t idx1 = idx0 | mask_tgt;
+
+			const t_cplx amp0 = state[idx0];
+			const t_cplx amp1 = state[idx1];
+			state[idx0] = u00*amp0 + u01*amp1;
+			state[idx1] = u10*amp0 + u11*amp1;
+		}
+	});
+}
+
+
+/**
+ * applies the one-qubit gate U22 to all qubits, e.g. the hadamard transformation
+ */
+template<class t_vec, class t_mat>
+void apply_gate_all(t_vec& state, const t_mat& U22,
+	std::size_t thread_threshold = MATH_QSIM_THREAD_THRESHOLD)
+requires is_vec<t_vec> && is_mat<t_mat> && is_complex<typename t_vec::value_type>
+{
+	const std::size_t num_qubits = qsim_num_qubits(state);
+	for(std::size_t qubit=0; qubit<num_qubits; ++qubit)
+		apply_gate<t_vec, t_mat>(state, U22, qubit, thread_threshold);
+}
+// ----------------------------------------------------------------------------
+
+
+
+// ----------------------------------------------------------------------------
+// measurements
+// ----------------------------------------------------------------------------
+/**
+ * probability to measure the qubit as |up>
+ * @throws std::out_of_range if the qubit does not exist
+ */
+template<class t_vec, class t_real = typename t_vec::value_type::value_type>
+t_real measure_prob(const t_vec& state, std::size_t qubit)
+requires is_vec<t_vec> && is_complex<typename t_vec::value_type>
+{
+	const std::size_t mask = qsim_mask(qubit, qsim_num_qubits(state));
+
+	t_real prob{};
+	for(std::size_t pair=0; pair<state.size()/2; ++pair)
+		prob += std::norm(state[qsim_insert_zero(pair, mask) | mask]);
+
+	return prob;
+}
+
+
+/**
+ * projects the qubit onto |up> (value = true) or |down> (value = false)
+ * returns the probability of this outcome, the state is renormalised if it is non-zero
+ * @throws std::out_of_range if the qubit does not exist
+ */
+template<class t_vec, class t_real = typename t_vec::value_type::value_type>
+t_real project(t_vec& state, std::size_t qubit, bool value, bool normalise = true)
+requires is_vec<t_vec> && is_complex<typename t_vec::value_type>
+{
+	using t_cplx = typename t_vec::value_type;
+
+	const std::size_t mask = qsim_mask(qubit, qsim_num_qubits(state));
+	const std::size_t keep = value ? mask : 0;
+
+	t_real prob{};
+	for(std::size_t idx=0; idx<state.size(); ++idx)
+	{
+		if((idx & mask) == keep)
+			prob += std::norm(state[idx]);
+		else
+			state[idx] = t_cplx(0);
+	}
+
+	if(normalise && prob > t_real(0))
+	{
+		const t_real scale = t_real(1) / std::sqrt(prob);
+		for(std::size_t idx=0; idx<state.size(); ++idx)
+			state[idx] *= scale;
+	}
+
+	return prob;
+}
+
+
+/**
+ * measures the qubit, collapsing the state onto the random outcome
+ * returns true for |up> and false for |down>
+ * @throws std::out_of_range if the qubit does not exist
+ */
+template<class t_vec, class t_rng, class t_real = typename t_vec::value_type::value_type>
+bool measure(t_vec& state, std::size_t qubit, t_rng& rng)
+requires is_vec<t_vec> && is_complex<typename t_vec::value_type>
+{
+	const t_real prob_up = measure_prob<t_vec, t_real>(state, qubit);
+	const bool value = std::uniform_real_distribution<t_real>(0, 1)(rng) < prob_up;
+
+	project<t_vec, t_real>(state, qubit, value, true);
+	return value;
+}
+// ----------------------------------------------------------------------------
+
+}
+
+#endif
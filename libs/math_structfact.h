@@ -0,0 +1,385 @@
+/**
+ * batched structure factor calculation for many scattering vectors
+ * @author Tobias Weber
+ * @date oct-2026
+ * @license see 'LICENSE.EUPL' file
+ *
+ * the atoms are stored as structure of arrays and processed in blocks of SF_LANES,
+ * so that the phase and sin/cos calculations in the inner loops are vectorised by the compiler
+ * (e.g. with -O3 -march=native). on regular Q grids the phase factors are advanced by
+ * multiplying with precomputed per-atom step factors instead of evaluating sin and cos.
+ *
+ * @see m::structure_factor in math_algos.h for the single-Q version
+ * @see https://doi.org/10.1016/B978-044451050-1/50002-1
+ * @see (Shirane02), p. 25, equ. 2.26 and p. 40, equ. 2.81
+ */
+
+#ifndef __MATH_STRUCTFACT_H__
+#define __MATH_STRUCTFACT_H__
+
+#include "math_concepts.h"
+#include "par_helpers.h"
+
+#include <cstddef>
+#include <cmath>
+#include <complex>
+#include <array>
+#include <numbers>
+#include <vector>
+#include <algorithm>
+
+
+// minimum number of atom-Q pairs for which several threads are used, 0: never
+#ifndef MATH_SF_THREAD_THRESHOLD
+	#define MATH_SF_THREAD_THRESHOLD (std::size_t(1) << 20)
+#endif
+
+
+namespace m {
+
+// number of atoms processed together in the inner loops
+constexpr std::size_t SF_LANES = 8;
+
+// number of grid steps after which the phase factors are recalculated exactly
+constexpr std::size_t SF_RESEED = 64;
+
+
+// ----------------------------------------------------------------------------
+// atom table
+// ----------------------------------------------------------------------------
+/**
+ * atom positions and scattering amplitudes as structure of arrays
+ * COMPS = 1: nuclear or x-ray structure factor, COMPS = 3: magnetic structure factor
+ * the arrays are padded to a multiple of SF_LANES with zero amplitudes
+ */
+template<class t_real = double, std::size_t COMPS = 1>
+struct sf_atoms
+{
+	// number of actual atoms
+	std::size_t num_atoms = 0;
+
+	// positions in units of the lattice vectors
+	std::vector<t_real> x{}, y{}, z{};
+
+	// real and imaginary parts of the amplitudes, including the form factors
+	std::array<std::vector<t_real>, COMPS> re{}, im{};
+};
+
+
+/**
+ * converts the arguments of m::structure_factor into an atom table
+ * as in the single-Q version, the last amplitude or form factor is repeated if fewer are given
+ */
+template<class t_vec, class T = t_vec, template<class...> class t_cont = std::vector,
+	class t_real = double, std::size_t COMPS = (is_complex<T> ? 1 : 3)>
+sf_atoms<t_real, COMPS> make_sf_atoms(const t_cont<T>& Ms_or_bs, const t_cont<t_vec>& Rs,
+	const t_vec* fs = nullptr)
+requires is_basic_vec<t_vec>
+{
+	sf_atoms<t_real, COMPS> atoms;
+	if(Ms_or_bs.begin() == Ms_or_bs.end())
+		return atoms;
+
+	atoms.num_atoms = Rs.size();
+	const std::size_t num_padded = (atoms.num_atoms + SF_LANES - 1) / SF_LANES * SF_LANES;
+
+	atoms.x.resize(num_padded, t_real(0));
+	atoms.y.resize(num_padded, t_real(0));
+	atoms.z.resize(num_padded, t_real(0));
+	for(std::size_t comp=0; comp<COMPS; ++comp)
+	{
+		atoms.re[comp].resize(num_padded, t_real(0));
+		atoms.im[comp].resize(num_padded, t_real(0));
+	}
+
+	auto iterM_or_b = Ms_or_bs.begin();
+	auto iterR = Rs.begin();
+	for(std::size_t atom=0; atom<atoms.num_atoms; ++atom, std::advance(iterR, 1))
+	{
+		// if form factors are given, use them, otherwise set to 1
+		t_real f = t_real(1);
+		if(fs && fs->size())
+		{
+			auto fval = (*fs)[std::min<std::size_t>(atom, fs->size()-1)];
+			if constexpr(is_complex<decltype(fval)>)
+				f = fval.real();
+			else
+				f = fval;
+		}
+
+		atoms.x[atom] = (*iterR)[0];
+		atoms.y[atom] = (*iterR)[1];
+		atoms.z[atom] = (*iterR)[2];
+
+		for(std::size_t comp=0; comp<COMPS; ++comp)
+		{
+			std::complex<t_real> amp;
+			if constexpr(is_complex<T>)
+				amp = *iterM_or_b;
+			else
+				amp = (*iterM_or_b)[comp];
+
+			atoms.re[comp][atom] = f * amp.real();
+			atoms.im[comp][atom] = f * amp.imag();
+		}
+
+		// next M or b if available (otherwise keep current)
+		auto iterM_or_b_next = std::next(iterM_or_b, 1);
+		if(iterM_or_b_next != Ms_or_bs.end())
+			iterM_or_b = iterM_or_b_next;
+	}
+
+	return atoms;
+}
+// ----------------------------------------------------------------------------
+
+
+
+// ----------------------------------------------------------------------------
+// kernels
+// ----------------------------------------------------------------------------
+/**
+ * sin(2 pi x) and cos(2 pi x) without branches, so that loops calling it can be vectorised
+ * the argument is reduced to an octant, [-pi/4, pi/4], where the taylor series are accurate to machine precision
+ */
+template<class t_real>
+inline void sincos_2pi(t_real x, t_real& s, t_real& c)
+{
+	// reduce to x in [-1/2, 1/2] and to the nearest quadrant, q in {-2, ..., 2}
+	x -= std::nearbyint(x);
+	const t_real q = std::nearbyint(x * t_real(4));
+	const t_real a = (x - q * t_real(0.25)) * t_real(2) * std::numbers::pi_v<t_real>;
+	const t_real a2 = a * a;
+
+	const t_real sa = a * (t_real(1) + a2 * (t_real(-1./6.) + a2 * (t_real(1./120.)
+		+ a2 * (t_real(-1./5040.) + a2 * (t_real(1./362880.) + a2 * (t_real(-1./39916800.)
+		+ a2 * (t_real(1./6227020800.) + a2 * t_real(-1./1307674368000.))))))));
+	const t_real ca = t_real(1) + a2 * (t_real(-1./2.) + a2 * (t_real(1./24.)
+		+ a2 * (t_real(-1./720.) + a2 * (t_real(1./40320.) + a2 * (t_real(-1./3628800.)
+		+ a2 * (t_real(1./479001600.) + a2 * (t_real(-1./87178291200.)
+		+ a2 * t_real(1./20922789888000.))))))));
+
+	// rotate back by q * pi/2
+	const bool swap = (q*q == t_real(1));
+	const bool neg_cos = (q == t_real(1) || q*q == t_real(4));
+	const bool neg_sin = (q == t_real(-1) || q*q == t_real(4));
+
+	const t_real c0 = swap ? sa : ca;
+	const t_real s0 = swap ? ca : sa;
+	c = neg_cos ? -c0 : c0;
+	s = neg_sin ? -s0 : s0;
+}
+
+
+/**
+ * phase factors exp(-i 2pi Q*R) for the atoms in [atom_begin, atom_end)
+ */
+template<class t_real, std::size_t COMPS>
+void sf_phases(const sf_atoms<t_real, COMPS>& atoms, const t_real* Q,
+	t_real* phase_re, t_real* phase_im,
+	std::size_t atom_begin, std::size_t atom_end)
+{
+	const t_real* x = atoms.x.data();
+	const t_real* y = atoms.y.data();
+	const t_real* z = atoms.z.data();
+
+	for(std::size_t atom=atom_begin; atom<atom_end; ++atom)
+	{
+		t_real s, c;
+		sincos_2pi<t_real>(Q[0]*x[atom] + Q[1]*y[atom] + Q[2]*z[atom], s, c);
+		phase_re[atom] = c;
+		phase_im[atom] = -s;
+	}
+}
+
+
+/**
+ * F = sum_atoms amp * phase, using SF_LANES independent partial sums
+ */
+template<class t_real, std::size_t COMPS>
+void sf_accumulate(const sf_atoms<t_real, COMPS>& atoms,
+	const t_real* phase_re, const t_real* phase_im,
+	std::complex<t_real>* F)
+{
+	t_real acc_re[COMPS][SF_LANES]{};
+	t_real acc_im[COMPS][SF_LANES]{};
+
+	for(std::size_t atom=0; atom<atoms.x.size(); atom+=SF_LANES)
+	{
+		for(std::size_t comp=0; comp<COMPS; ++comp)
+		{
+			const t_real* amp_re = atoms.re[comp].data() + atom;
+			const t_real* amp_im = atoms.im[comp].data() + atom;
+
+			for(std::size_t lane=0; lane<SF_LANES; ++lane)
+			{
+				const t_real pr = phase_re[atom + lane];
+				const t_real pim = phase_im[atom + lane];
+
+				acc_re[comp][lane] += amp_re[lane]*pr - amp_im[lane]*pim;
+				acc_im[comp][lane] += amp_re[lane]*pim + amp_im[lane]*pr;
+			}
+		}
+	}
+
+	for(std::size_t comp=0; comp<COMPS; ++comp)
+	{
+		t_real sum_re{}, sum_im{};
+		for(std::size_t lane=0; lane<SF_LANES; ++lane)
+		{
+			sum_re += acc_re[comp][lane];
+			sum_im += acc_im[comp][lane];
+		}
+
+		F[comp] = std::complex<t_real>(sum_re, sum_im);
+	}
+}
+
+
+/**
+ * structure factors for the scattering vectors [q_begin, q_end) of the list Qs (x, y, z, x, y, z, ...)
+ */
+template<class t_real, std::size_t COMPS>
+void structure_factors_range(const sf_atoms<t_real, COMPS>& atoms, const t_real* Qs,
+	std::complex<t_real>* Fs, std::size_t q_begin, std::size_t q_end)
+{
+	const std::size_t num_padded = atoms.x.size();
+	std::vector<t_real> phase_re(num_padded), phase_im(num_padded);
+
+	for(std::size_t q=q_begin; q<q_end; ++q)
+	{
+		sf_phases<t_real, COMPS>(atoms, Qs + q*3, phase_re.data(), phase_im.data(), 0, num_padded);
+		sf_accumulate<t_real, COMPS>(atoms, phase_re.data(), phase_im.data(), Fs + q*COMPS);
+	}
+}
+
+
+/**
+ * structure factors for the grid rows [row_begin, row_end)
+ * along a row, the phase factors are multiplied by the per-atom step factors exp(-i 2pi dQ3*R)
+ */
+template<class t_real, std::size_t COMPS>
+void structure_factors_grid_rows(const sf_atoms<t_real, COMPS>& atoms,
+	const t_real* Q0, const t_real* dQ1, const t_real* dQ2, const t_real* dQ3,
+	std::size_t n2, std::size_t n3,
+	const t_real* step_re, const t_real* step_im,
+	std::complex<t_real>* Fs, std::size_t row_begin, std::size_t row_end)
+{
+	const std::size_t num_padded = atoms.x.size();
+	std::vector<t_real> phase_re(num_padded), phase_im(num_padded);
+
+	for(std::size_t row=row_begin; row<row_end; ++row)
+	{
+		const t_real i1 = t_real(row / n2);
+		const t_real i2 = t_real(row % n2);
+
+		for(std::size_t i3=0; i3<n3; ++i3)
+		{
+			if(i3 % SF_RESEED == 0)
+			{
+				// recalculate the phase factors exactly to avoid accumulating rounding errors
+				t_real Q[3];
+				for(std::size_t i=0; i<3; ++i)
+					Q[i] = Q0[i] + i1*dQ1[i] + i2*dQ2[i] + t_real(i3)*dQ3[i];
+				sf_phases<t_real, COMPS>(atoms, Q, phase_re.data(), phase_im.data(), 0, num_padded);
+			}
+			else
+			{
+				for(std::size_t atom=0; atom<num_padded; ++atom)
+				{
+					const t_real pr = phase_re[atom];
+					const t_real pim = phase_im[atom];
+					phase_re[atom] = pr*step_re[atom] - pim*step_im[atom];
+					phase_im[atom] = pr*step_im[atom] + pim*step_re[atom];
+				}
+			}
+
+			sf_accumulate<t_real, COMPS>(atoms, phase_re.data(), phase_im.data(),
+				Fs + (row*n3 + i3)*COMPS);
+		}
+	}
+}
+
+
+// ----------------------------------------------------------------------------
+
+
+
+// ----------------------------------------------------------------------------
+// batched structure factors
+// ----------------------------------------------------------------------------
+/**
+ * structure factors for a list of scattering vectors
+ * the result is a contiguous buffer with the COMPS components of F(Q) for each Q
+ * @see m::structure_factor
+ */
+template<class t_vec, template<class...> class t_cont = std::vector,
+	class t_real = double, std::size_t COMPS = 1>
+std::vector<std::complex<t_real>> structure_factors(const sf_atoms<t_real, COMPS>& atoms,
+	const t_cont<t_vec>& Qs, std::size_t thread_threshold = MATH_SF_THREAD_THRESHOLD)
+requires is_basic_vec<t_vec>
+{
+	// copy the scattering vectors into a contiguous array
+	std::vector<t_real> Qs_flat;
+	Qs_flat.reserve(Qs.size() * 3);
+	for(const t_vec& Q : Qs)
+	{
+		Qs_flat.push_back(Q[0]);
+		Qs_flat.push_back(Q[1]);
+		Qs_flat.push_back(Q[2]);
+	}
+
+	const std::size_t num_Qs = Qs_flat.size() / 3;
+	std::vector<std::complex<t_real>> Fs(num_Qs * COMPS);
+
+	parallel_chunks(num_Qs, parallel_threads(num_Qs * atoms.x.size(), thread_threshold),
+		[&atoms, &Qs_flat, &Fs](std::size_t, std::size_t begin, std::size_t end)
+	{
+		structure_factors_range<t_real, COMPS>(atoms, Qs_flat.data(), Fs.data(), begin, end);
+	});
+
+	return Fs;
+}
+
+
+/**
+ * structure factors on the regular grid Q = Q0 + i1*dQ1 + i2*dQ2 + i3*dQ3,
+ * with 0 <= i1 < n1, 0 <= i2 < n2, 0 <= i3 < n3
+ * the result is a contiguous buffer with the COMPS components of F(Q)
+ * for each Q at the index (i1*n2 + i2)*n3 + i3
+ */
+template<class t_vec, class t_real = double, std::size_t COMPS = 1>
+std::vector<std::complex<t_real>> structure_factors_grid(const sf_atoms<t_real, COMPS>& atoms,
+	const t_vec& Q0, const t_vec& dQ1, const t_vec& dQ2, const t_vec& dQ3,
+	std::size_t n1, std::size_t n2, std::size_t n3,
+	std::size_t thread_threshold = MATH_SF_THREAD_THRESHOLD)
+requires is_basic_vec<t_vec>
+{
+	const t_real _Q0[3] = { t_real(Q0[0]), t_real(Q0[1]), t_real(Q0[2]) };
+	const t_real _dQ1[3] = { t_real(dQ1[0]), t_real(dQ1[1]), t_real(dQ1[2]) };
+	const t_real _dQ2[3] = { t_real(dQ2[0]), t_real(dQ2[1]), t_real(dQ2[2]) };
+	const t_real _dQ3[3] = { t_real(dQ3[0]), t_real(dQ3[1]), t_real(dQ3[2]) };
+
+	std::vector<std::complex<t_real>> Fs(n1 * n2 * n3 * COMPS);
+	if(Fs.empty())
+		return Fs;
+
+	// precalculate the phase steps along the innermost grid direction
+	const std::size_t num_padded = atoms.x.size();
+	std::vector<t_real> step_re(num_padded), step_im(num_padded);
+	sf_phases<t_real, COMPS>(atoms, _dQ3, step_re.data(), step_im.data(), 0, num_padded);
+
+	parallel_chunks(n1 * n2, parallel_threads(n1 * n2 * n3 * num_padded, thread_threshold),
+		[&](std::size_t, std::size_t begin, std::size_t end)
+	{
+		structure_factors_grid_rows<t_real, COMPS>(atoms, _Q0, _dQ1, _dQ2, _dQ3, n2, n3,
+			step_re.data(), step_im.data(), Fs.data(), begin, end);
+	});
+
+	return Fs;
+}
+// ----------------------------------------------------------------------------
+
+}
+
+#endif
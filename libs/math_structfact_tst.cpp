@@ -0,0 +1,151 @@
+/**
+ * tests and benchmarks the batched structure factor calculation
+ * @author Tobias Weber
+ * @date oct-2026
+ * @license: see 'LICENSE.EUPL' file
+ *
+ * g++ -std=c++20 -Wall -Wextra -Weffc++ -O3 -march=native -o math_structfact_tst math_structfact_tst.cpp -lpthread
+ */
+
+#include <iostream>
+#include <random>
+#include <chrono>
+
+#include "math_algos.h"
+#include "math_conts.h"
+#include "math_structfact.h"
+
+using namespace m;
+using namespace m_ops;
+
+using t_real = double;
+using t_cplx = std::complex<t_real>;
+using t_vec = vec<t_real, std::vector>;
+using t_vec_cplx = vec<t_cplx, std::vector>;
+
+
+/**
+ * maximum deviation between the batched and the single-Q results
+ */
+template<class T>
+t_real max_deviation(const std::vector<T>& Fs_single, const std::vector<t_cplx>& Fs)
+{
+	t_real dev = 0;
+
+	for(std::size_t q=0; q<Fs_single.size(); ++q)
+	{
+		if constexpr(is_complex<T>)
+		{
+			dev = std::max(dev, std::abs(Fs_single[q] - Fs[q]));
+		}
+		else
+		{
+			for(std::size_t comp=0; comp<3; ++comp)
+				dev = std::max(dev, std::abs(Fs_single[q][comp] - Fs[q*3 + comp]));
+		}
+	}
+
+	return dev;
+}
+
+
+int main()
+{
+	std::mt19937 rnd{1234};
+	std::uniform_real_distribution<t_real> dist(-1., 1.);
+	std::cout << std::boolalpha;
+
+	// random atoms
+	const std::size_t num_atoms = 201;
+	std::vector<t_vec> Rs;
+	std::vector<t_cplx> bs;
+	std::vector<t_vec_cplx> Ms;
+	t_vec fs;
+
+	for(std::size_t atom=0; atom<num_atoms; ++atom)
+	{
+		Rs.emplace_back(create<t_vec>({ dist(rnd), dist(rnd), dist(rnd) }));
+		bs.emplace_back(t_cplx(dist(rnd), dist(rnd)));
+		Ms.emplace_back(create<t_vec_cplx>({ dist(rnd), dist(rnd), dist(rnd) }));
+		fs.push_back(std::abs(dist(rnd)));
+	}
+
+	// Q grid
+	const t_vec Q0 = create<t_vec>({ -5.1, -3.2, 0.7 });
+	const t_vec dQ1 = create<t_vec>({ 0.2, 0.1, 0. });
+	const t_vec dQ2 = create<t_vec>({ 0., 0.25, 0.05 });
+	const t_vec dQ3 = create<t_vec>({ 0.03, 0., 0.02 });
+	const std::size_t n1 = 7, n2 = 5, n3 = 150;
+
+	std::vector<t_vec> Qs;
+	for(std::size_t i1=0; i1<n1; ++i1)
+		for(std::size_t i2=0; i2<n2; ++i2)
+			for(std::size_t i3=0; i3<n3; ++i3)
+				Qs.emplace_back(Q0 + dQ1*t_real(i1) + dQ2*t_real(i2) + dQ3*t_real(i3));
+
+	// nuclear structure factors
+	{
+		std::vector<t_cplx> Fs_single;
+		for(const t_vec& Q : Qs)
+			Fs_single.push_back(structure_factor<t_vec, t_cplx>(bs, Rs, Q, &fs));
+
+		auto atoms = make_sf_atoms<t_vec, t_cplx>(bs, Rs, &fs);
+		auto Fs = structure_factors<t_vec>(atoms, Qs);
+		auto Fs_grid = structure_factors_grid<t_vec>(atoms, Q0, dQ1, dQ2, dQ3, n1, n2, n3);
+		auto Fs_threads = structure_factors<t_vec>(atoms, Qs, 1);
+
+		std::cout << "nuclear, Q list: ok = " << (max_deviation(Fs_single, Fs) < 1e-10) << std::endl;
+		std::cout << "nuclear, Q grid: ok = " << (max_deviation(Fs_single, Fs_grid) < 1e-10) << std::endl;
+		std::cout << "nuclear, threaded: ok = " << (Fs == Fs_threads) << std::endl;
+	}
+
+	// magnetic structure factors
+	{
+		std::vector<t_vec_cplx> Fs_single;
+		for(const t_vec& Q : Qs)
+			Fs_single.push_back(structure_factor<t_vec, t_vec_cplx>(Ms, Rs, Q));
+
+		auto atoms = make_sf_atoms<t_vec, t_vec_cplx>(Ms, Rs);
+		auto Fs = structure_factors<t_vec>(atoms, Qs);
+		auto Fs_grid = structure_factors_grid<t_vec>(atoms, Q0, dQ1, dQ2, dQ3, n1, n2, n3);
+
+		std::cout << "magnetic, Q list: ok = " << (max_deviation(Fs_single, Fs) < 1e-10) << std::endl;
+		std::cout << "magnetic, Q grid: ok = " << (max_deviation(Fs_single, Fs_grid) < 1e-10) << std::endl;
+	}
+
+	// benchmark
+	{
+		const std::size_t n = 40;
+		std::vector<t_vec> Qs_bench;
+		for(std::size_t i1=0; i1<n; ++i1)
+			for(std::size_t i2=0; i2<n; ++i2)
+				for(std::size_t i3=0; i3<n; ++i3)
+					Qs_bench.emplace_back(Q0 + dQ1*t_real(i1) + dQ2*t_real(i2) + dQ3*t_real(i3));
+
+		auto atoms = make_sf_atoms<t_vec, t_cplx>(bs, Rs, &fs);
+
+		auto start_single = std::chrono::steady_clock::now();
+		std::vector<t_cplx> Fs_single;
+		Fs_single.reserve(Qs_bench.size());
+		for(const t_vec& Q : Qs_bench)
+			Fs_single.push_back(structure_factor<t_vec, t_cplx>(bs, Rs, Q, &fs));
+		auto stop_single = std::chrono::steady_clock::now();
+
+		auto start_list = std::chrono::steady_clock::now();
+		auto Fs = structure_factors<t_vec>(atoms, Qs_bench);
+		auto stop_list = std::chrono::steady_clock::now();
+
+		auto start_grid = std::chrono::steady_clock::now();
+		auto Fs_grid = structure_factors_grid<t_vec>(atoms, Q0, dQ1, dQ2, dQ3, n, n, n);
+		auto stop_grid = std::chrono::steady_clock::now();
+
+		std::cout << Qs_bench.size() << " Qs, " << num_atoms << " atoms: single: "
+			<< std::chrono::duration<double>(stop_single - start_single).count() << " s, batched: "
+			<< std::chrono::duration<double>(stop_list - start_list).count() << " s, grid: "
+			<< std::chrono::duration<double>(stop_grid - start_grid).count() << " s, ok = "
+			<< (max_deviation(Fs_single, Fs) < 1e-10 && max_deviation(Fs_single, Fs_grid) < 1e-10)
+			<< std::endl;
+	}
+
+	return 0;
+}
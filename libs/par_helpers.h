@@ -0,0 +1,78 @@
+/**
+ * helpers to distribute work over threads
+ * @author Tobias Weber
+ * @date oct-2026
+ * @license see 'LICENSE.EUPL' file
+ */
+
+#ifndef __PAR_HELPERS_H__
+#define __PAR_HELPERS_H__
+
+#include <cstddef>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+
+namespace m {
+
+/**
+ * the given number of threads, or all hardware threads for num_threads = 0
+ */
+inline std::size_t hardware_threads(std::size_t num_threads = 0)
+{
+	if(num_threads == 0)
+		num_threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+	return num_threads;
+}
+
+
+/**
+ * number of threads for the given amount of work, num_threads = 0: all hardware threads
+ * a single thread is used below the threshold, thread_threshold = 0: always
+ */
+inline std::size_t parallel_threads(std::size_t work, std::size_t thread_threshold,
+	std::size_t num_threads = 0)
+{
+	if(!thread_threshold || work < thread_threshold)
+		return 1;
+	return hardware_threads(num_threads);
+}
+
+
+/**
+ * distributes the work items [0, num) over at most num_threads threads
+ * func(thread, begin, end) is called for each chunk, thread < num_threads
+ */
+template<class t_func>
+void parallel_chunks(std::size_t num, std::size_t num_threads, t_func func)
+{
+	num_threads = std::min(num_threads, num);
+
+	if(num_threads <= 1)
+	{
+		func(std::size_t{0}, std::size_t{0}, num);
+		return;
+	}
+
+	const std::size_t items_per_thread = (num + num_threads - 1) / num_threads;
+	std::vector<std::thread> threads;
+	threads.reserve(num_threads);
+
+	for(std::size_t thread=0; thread<num_threads; ++thread)
+	{
+		const std::size_t begin = std::min(thread * items_per_thread, num);
+		const std::size_t end = std::min(begin + items_per_thread, num);
+		if(begin >= end)
+			break;
+
+		threads.emplace_back([&func, thread, begin, end]() { func(thread, begin, end); });
+	}
+
+	for(std::thread& thread : threads)
+		thread.join();
+}
+
+}
+
+#endif
@@ -14,14 +14,48 @@
 
 
 #include <vector>
+#include <array>
+#include <span>
 #include <unordered_map>
 #include <queue>
 #include <optional>
 #include <memory>
 #include <concepts>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <cstring>
+#include <cstdint>
+#include <bit>
+#include <functional>
 #include <iostream>
+#include <istream>
+#include <ostream>
 #include <boost/dynamic_bitset.hpp>
 
+#if defined(__AVX2__)
+	#include <immintrin.h>
+	#define STR_SIMD 1
+#elif defined(__SSE2__)
+	#include <emmintrin.h>
+	#define STR_SIMD 1
+#else
+	#define STR_SIMD 0
+#endif
+
+
+// maximum length of the huffman codes, determines the size of the decoding table
+#ifndef STR_HUFFMAN_MAX_LEN
+	#define STR_HUFFMAN_MAX_LEN 12
+#endif
+
+// block size for the huffman codec
+#ifndef STR_HUFFMAN_BLOCK
+	#define STR_HUFFMAN_BLOCK (std::size_t(1) << 20)
+#endif
+
 
 /**
  * requirements for an iterable container
@@ -38,79 +72,616 @@ concept is_iterable = requires(const T& a)
 
 
 
+// ----------------------------------------------------------------------------
+// pattern matching
+// ----------------------------------------------------------------------------
 /**
- * KMP pattern matching algo
+ * range over all (also overlapping) matches of a precompiled pattern in a text
+ * the searcher provides a t_state with the search position and Next(text, state),
+ * which returns the next match or nullopt at the end of the text
+ */
+template<class t_searcher, class t_text>
+class match_range
+{
+public:
+	using t_match = typename t_searcher::t_match;
+	using t_state = typename t_searcher::t_state;
+
+
+	class iterator
+	{
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type = t_match;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const t_match*;
+		using reference = const t_match&;
+
+		// end iterator
+		iterator() = default;
+
+		iterator(const t_searcher& searcher, const t_text& text)
+			: m_searcher{&searcher}, m_text{&text}
+		{
+			++*this;
+		}
+
+		iterator(const iterator&) = default;
+		iterator& operator=(const iterator&) = default;
+		~iterator() = default;
+
+		reference operator*() const { return *m_match; }
+		pointer operator->() const { return &*m_match; }
+
+		iterator& operator++()
+		{
+			m_match = m_searcher->Next(*m_text, m_state);
+			return *this;
+		}
+
+		iterator operator++(int)
+		{
+			iterator iter{*this};
+			++*this;
+			return iter;
+		}
+
+		// iterators are only compared with the end iterator
+		bool operator==(const iterator& other) const { return m_match.has_value() == other.m_match.has_value(); }
+
+	private:
+		const t_searcher *m_searcher{nullptr};
+		const t_text *m_text{nullptr};
+		t_state m_state{};
+		std::optional<t_match> m_match{};
+	};
+
+
+public:
+	match_range(const t_searcher& searcher, const t_text& text)
+		: m_searcher{searcher}, m_text{text}
+	{}
+
+	iterator begin() const { return iterator{m_searcher, m_text}; }
+	iterator end() const { return iterator{}; }
+
+
+private:
+	const t_searcher& m_searcher;
+	const t_text& m_text;
+};
+
+
+/**
+ * KMP pattern matching algo with a precompiled prefix table
  * @see (FUH 2021), Kurseinheit 3, p. 9 and p. 11.
  * @see https://en.wikipedia.org/wiki/Knuth%E2%80%93Morris%E2%80%93Pratt_algorithm
  */
 template<class t_str>
-std::size_t find_pattern(const t_str& str, const t_str& pattern)
 requires requires(const t_str& str, std::size_t idx)
 {
 	// needed t_str interface
 	str[idx];
 	str.size();
 }
+class kmp_matcher
 {
-	std::size_t len_str = str.size();
-	std::size_t len_pattern = pattern.size();
+public:
+	// match position
+	using t_match = std::size_t;
+
+	struct t_state
+	{
+		std::size_t pos{0};
+		// length of the matched pattern prefix
+		std::size_t matched{0};
+	};
+
+
+public:
+	explicit kmp_matcher(const t_str& pattern)
+		: m_pattern{pattern}, m_prefix(pattern.size(), 0)
+	{
+		// m_prefix[i]: length of the longest proper prefix of pattern[0..i] which is also its suffix
+		for(std::size_t pattern_pos=1; pattern_pos<m_pattern.size(); ++pattern_pos)
+		{
+			std::size_t prefix_pos = m_prefix[pattern_pos-1];
+
+			while(prefix_pos > 0 && m_pattern[prefix_pos] != m_pattern[pattern_pos])
+				prefix_pos = m_prefix[prefix_pos-1];
+
+			m_prefix[pattern_pos] = (m_pattern[prefix_pos] == m_pattern[pattern_pos] ? prefix_pos+1 : 0);
+		}
+	}
 
 
-	auto get_prefix = [](const t_str& pattern, std::size_t len_pattern)
-		-> std::vector<std::size_t>
+	/**
+	 * next match starting from the state's position, the state continues after it
+	 */
+	template<class t_text>
+	std::optional<std::size_t> Next(const t_text& str, t_state& state) const
 	{
-		std::vector<std::size_t> prefix{0};
+		const std::size_t len_pattern = m_pattern.size();
+
+		// the empty pattern matches everywhere
+		if(len_pattern == 0)
+		{
+			if(state.pos > str.size())
+				return std::nullopt;
+			return state.pos++;
+		}
 
-		for(std::size_t pattern_pos=1; pattern_pos<len_pattern; ++pattern_pos)
+		while(state.pos < str.size())
 		{
-			std::size_t prefix_pos = prefix[pattern_pos-1];
+			while(state.matched > 0 && m_pattern[state.matched] != str[state.pos])
+				state.matched = m_prefix[state.matched-1];
 
-			while(prefix_pos > 0 && pattern[prefix_pos] != pattern[pattern_pos])
-				prefix_pos = prefix[prefix_pos-1];
+			if(m_pattern[state.matched] == str[state.pos])
+				++state.matched;
+			++state.pos;
 
-			prefix.push_back(pattern[prefix_pos] == pattern[pattern_pos] ? prefix_pos+1 : 0);
+			if(state.matched == len_pattern)
+			{
+				state.matched = m_prefix[len_pattern-1];
+				return state.pos - len_pattern;
+			}
 		}
 
-		prefix.insert(prefix.begin(), 0);
-		return prefix;
+		// pattern not found
+		return std::nullopt;
+	}
+
+
+	/**
+	 * first match at or after the start position
+	 */
+	template<class t_text>
+	std::optional<std::size_t> Find(const t_text& str, std::size_t start = 0) const
+	{
+		t_state state{ .pos = start, .matched = 0 };
+		return Next(str, state);
+	}
+
+
+	template<class t_text>
+	match_range<kmp_matcher, t_text> Matches(const t_text& str) const
+	{
+		return match_range<kmp_matcher, t_text>{*this, str};
+	}
+
+
+	template<class t_text>
+	std::vector<std::size_t> FindAll(const t_text& str) const
+	{
+		std::vector<std::size_t> matches;
+		for(std::size_t pos : Matches(str))
+			matches.push_back(pos);
+		return matches;
+	}
+
+
+private:
+	t_str m_pattern{};
+	std::vector<std::size_t> m_prefix{};
+};
+
+
+/**
+ * KMP pattern matching algo
+ * returns the position of the first match or the length of the string if the pattern is not found
+ * @see kmp_matcher to search several strings with the same pattern
+ */
+template<class t_str>
+std::size_t find_pattern(const t_str& str, const t_str& pattern)
+requires requires(const t_str& str, std::size_t idx)
+{
+	// needed t_str interface
+	str[idx];
+	str.size();
+}
+{
+	std::optional<std::size_t> pos = kmp_matcher<t_str>{pattern}.Find(str);
+	return pos ? *pos : str.size();
+}
+// ----------------------------------------------------------------------------
+
+
+
+// ----------------------------------------------------------------------------
+// byte string search
+// ----------------------------------------------------------------------------
+#if STR_SIMD
+/**
+ * simd register traits for comparing bytes
+ */
+struct str_simd
+{
+#if defined(__AVX2__)
+	using t_reg = __m256i;
+	static constexpr std::size_t width = 32;
+
+	static t_reg set1(char c) { return _mm256_set1_epi8(c); }
+	static t_reg load(const char* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+
+	// bit mask of the positions where a == ch_a and b == ch_b
+	static std::uint32_t eq2(t_reg a, t_reg ch_a, t_reg b, t_reg ch_b)
+	{
+		return static_cast<std::uint32_t>(_mm256_movemask_epi8(
+			_mm256_and_si256(_mm256_cmpeq_epi8(a, ch_a), _mm256_cmpeq_epi8(b, ch_b))));
+	}
+
+#else
+	using t_reg = __m128i;
+	static constexpr std::size_t width = 16;
+
+	static t_reg set1(char c) { return _mm_set1_epi8(c); }
+	static t_reg load(const char* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+
+	// bit mask of the positions where a == ch_a and b == ch_b
+	static std::uint32_t eq2(t_reg a, t_reg ch_a, t_reg b, t_reg ch_b)
+	{
+		return static_cast<std::uint32_t>(_mm_movemask_epi8(
+			_mm_and_si128(_mm_cmpeq_epi8(a, ch_a), _mm_cmpeq_epi8(b, ch_b))));
+	}
+#endif
+};
+#endif
+
+
+/**
+ * single-pattern search in byte strings with a precompiled pattern
+ * the simd version filters the candidate positions by comparing the first and the last
+ * byte of the pattern for a whole register of positions at once, only the candidates
+ * are compared with the full pattern, the scalar version looks for the first byte with memchr,
+ * which is also used if the target has no simd support
+ * @see http://0x80.pl/articles/simd-strfind.html
+ */
+template<bool use_simd = bool(STR_SIMD)>
+class byte_searcher
+{
+public:
+	// match position
+	using t_match = std::size_t;
+
+	struct t_state
+	{
+		std::size_t pos{0};
 	};
 
 
-	auto prefix = get_prefix(pattern, len_pattern);
-	//for(std::size_t i : prefix)
-	//	std::cout << i << " ";
-	//std::cout << std::endl;
+public:
+	explicit byte_searcher(std::string_view pattern)
+		: m_pattern{pattern}
+	{}
+
+
+	/**
+	 * first match at or after the start position
+	 */
+	std::optional<std::size_t> Find(std::string_view str, std::size_t start = 0) const
+	{
+		const std::size_t len_str = str.size();
+		const std::size_t len_pattern = m_pattern.size();
+
+		if(len_pattern == 0)
+			return start <= len_str ? std::make_optional(start) : std::nullopt;
+		if(len_pattern > len_str || start > len_str - len_pattern)
+			return std::nullopt;
+
+		const char *s = str.data();
+		const char *p = m_pattern.data();
+		const std::size_t last = len_str - len_pattern;	// last possible match position
+
+		if(len_pattern == 1)
+		{
+			const void *hit = std::memchr(s + start, p[0], len_str - start);
+			return hit ? std::make_optional<std::size_t>(static_cast<const char*>(hit) - s) : std::nullopt;
+		}
+
+		std::size_t pos = start;
+
+#if STR_SIMD
+		if constexpr(use_simd)
+		{
+			constexpr std::size_t width = str_simd::width;
+			const typename str_simd::t_reg first_ch = str_simd::set1(p[0]);
+			const typename str_simd::t_reg last_ch = str_simd::set1(p[len_pattern - 1]);
+
+			for(; pos + width <= last + 1; pos += width)
+			{
+				std::uint32_t mask = str_simd::eq2(
+					str_simd::load(s + pos), first_ch,
+					str_simd::load(s + pos + len_pattern - 1), last_ch);
+
+				while(mask)
+				{
+					const std::size_t candidate = pos + std::countr_zero(mask);
+					if(std::memcmp(s + candidate + 1, p + 1, len_pattern - 2) == 0)
+						return candidate;
+					mask &= mask - 1;
+				}
+			}
+		}
+#endif
+
+		// scalar search, also for the remaining positions of the simd version
+		while(pos <= last)
+		{
+			const void *hit = std::memchr(s + pos, p[0], last - pos + 1);
+			if(!hit)
+				break;
+
+			pos = static_cast<const char*>(hit) - s;
+			if(s[pos + len_pattern - 1] == p[len_pattern - 1]
+				&& std::memcmp(s + pos + 1, p + 1, len_pattern - 2) == 0)
+				return pos;
+			++pos;
+		}
+
+		// pattern not found
+		return std::nullopt;
+	}
+
+
+	/**
+	 * next match starting from the state's position, the state continues after it
+	 */
+	std::optional<std::size_t> Next(std::string_view str, t_state& state) const
+	{
+		std::optional<std::size_t> pos = Find(str, state.pos);
+		state.pos = pos ? *pos + 1 : str.size() + 1;
+		return pos;
+	}
+
+
+	template<class t_text>
+	match_range<byte_searcher, t_text> Matches(const t_text& str) const
+	{
+		return match_range<byte_searcher, t_text>{*this, str};
+	}
+
+
+	std::vector<std::size_t> FindAll(std::string_view str) const
+	{
+		std::vector<std::size_t> matches;
+		for(std::size_t pos : Matches(str))
+			matches.push_back(pos);
+		return matches;
+	}
+
+
+private:
+	std::string m_pattern{};
+};
+// ----------------------------------------------------------------------------
+
+
+
+// ----------------------------------------------------------------------------
+// multi-pattern search
+// ----------------------------------------------------------------------------
+/**
+ * aho-corasick automaton to find the occurrences of several patterns in one pass over a byte string
+ * the goto and failure functions are merged into a dense transition table,
+ * the bytes which don't appear in the patterns share a single column of it.
+ * identical patterns are reported with the index of the first one, empty patterns are ignored.
+ * @see https://en.wikipedia.org/wiki/Aho%E2%80%93Corasick_algorithm
+ * @see https://doi.org/10.1145/360825.360855
+ */
+class aho_corasick
+{
+public:
+	using t_idx = std::uint32_t;
+	static constexpr t_idx no_idx = std::numeric_limits<t_idx>::max();
+
+	// match position and pattern index
+	using t_match = std::pair<std::size_t, std::size_t>;
 
+	struct t_state
+	{
+		std::size_t pos{0};
+		t_idx node{0};
+		// next node on the chain of matches ending at pos
+		t_idx out{no_idx};
+	};
 
-	std::size_t str_pos = 0;
-	std::size_t start_pos = 0;
 
-	while(str_pos < len_str)
+public:
+	template<class t_patterns>
+	explicit aho_corasick(const t_patterns& patterns)
 	{
-		if(pattern[str_pos-start_pos] == str[str_pos])
+		// byte classes, 0 is the one for the bytes which are not in any pattern
+		m_classes.fill(0);
+		for(const auto& pattern : patterns)
+			for(char ch : pattern)
+				m_classes[static_cast<unsigned char>(ch)] = 1;
+		for(std::size_t ch=0; ch<m_classes.size(); ++ch)
+			if(m_classes[ch])
+				m_classes[ch] = static_cast<t_idx>(m_num_classes++);
+
+		AddNode();
+
+		// trie
+		for(const auto& pattern : patterns)
 		{
-			if(str_pos-start_pos+1 == len_pattern)
-				return start_pos;
-			else
-				++str_pos;
+			const std::size_t patidx = m_lengths.size();
+			m_lengths.push_back(pattern.size());
+			if(pattern.size() == 0)
+				continue;
+
+			t_idx node = 0;
+			for(char ch : pattern)
+			{
+				t_idx& next = m_trans[node*m_num_classes + m_classes[static_cast<unsigned char>(ch)]];
+				if(next == no_idx)
+				{
+					t_idx newnode = AddNode();
+					// m_trans can have been reallocated
+					m_trans[node*m_num_classes + m_classes[static_cast<unsigned char>(ch)]] = newnode;
+					node = newnode;
+				}
+				else
+				{
+					node = next;
+				}
+			}
+
+			if(m_terminal[node] == no_idx)
+				m_terminal[node] = static_cast<t_idx>(patidx);
 		}
-		else
+
+		// failure links in breadth-first order, the missing transitions follow them
+		std::vector<t_idx> fail(m_terminal.size(), 0);
+		std::vector<t_idx> queue;
+		queue.reserve(m_terminal.size());
+		queue.push_back(0);
+
+		for(std::size_t queueidx=0; queueidx<queue.size(); ++queueidx)
 		{
-			if(start_pos != str_pos)
+			const t_idx node = queue[queueidx];
+
+			for(std::size_t cls=0; cls<m_num_classes; ++cls)
 			{
-				start_pos = str_pos - prefix[str_pos-start_pos];
+				t_idx& next = m_trans[node*m_num_classes + cls];
+				const t_idx fail_next = node == 0 ? 0 : m_trans[fail[node]*m_num_classes + cls];
+
+				if(next == no_idx)
+				{
+					next = fail_next;
+					continue;
+				}
+
+				fail[next] = fail_next;
+				m_dict[next] = m_terminal[fail_next] != no_idx ? fail_next : m_dict[fail_next];
+				queue.push_back(next);
 			}
-			else
+		}
+
+		// first node to report when reaching a node
+		m_report.resize(m_terminal.size());
+		for(std::size_t node=0; node<m_terminal.size(); ++node)
+			m_report[node] = m_terminal[node] != no_idx ? static_cast<t_idx>(node) : m_dict[node];
+	}
+
+
+	std::size_t GetNumPatterns() const
+	{
+		return m_lengths.size();
+	}
+
+
+	std::size_t GetNumStates() const
+	{
+		return m_terminal.size();
+	}
+
+
+	/**
+	 * calls func(pos, patidx) for all matches in the order of their end positions
+	 */
+	template<class t_func>
+	void ForEach(std::string_view str, t_func func) const
+	{
+		const unsigned char *s = reinterpret_cast<const unsigned char*>(str.data());
+		t_idx node = 0;
+
+		for(std::size_t pos=0; pos<str.size(); ++pos)
+		{
+			node = m_trans[node*m_num_classes + m_classes[s[pos]]];
+
+			for(t_idx out=m_report[node]; out!=no_idx; out=m_dict[out])
 			{
-				++start_pos;
-				++str_pos;
+				const std::size_t patidx = m_terminal[out];
+				func(pos + 1 - m_lengths[patidx], patidx);
 			}
 		}
 	}
 
-	// pattern not found
-	return len_str;
-}
+
+	/**
+	 * next match starting from the state's position, the state continues after it
+	 */
+	std::optional<t_match> Next(std::string_view str, t_state& state) const
+	{
+		while(true)
+		{
+			if(state.out != no_idx)
+			{
+				const std::size_t patidx = m_terminal[state.out];
+				state.out = m_dict[state.out];
+				return std::make_pair(state.pos - m_lengths[patidx], patidx);
+			}
+
+			if(state.pos >= str.size())
+				return std::nullopt;
+
+			state.node = m_trans[state.node*m_num_classes + m_classes[static_cast<unsigned char>(str[state.pos])]];
+			state.out = m_report[state.node];
+			++state.pos;
+		}
+	}
+
+
+	template<class t_text>
+	match_range<aho_corasick, t_text> Matches(const t_text& str) const
+	{
+		return match_range<aho_corasick, t_text>{*this, str};
+	}
+
+
+	std::vector<t_match> FindAll(std::string_view str) const
+	{
+		std::vector<t_match> matches;
+		ForEach(str, [&matches](std::size_t pos, std::size_t patidx)
+		{
+			matches.emplace_back(std::make_pair(pos, patidx));
+		});
+		return matches;
+	}
+
+
+	/**
+	 * number of matches per pattern
+	 */
+	std::vector<std::size_t> Count(std::string_view str) const
+	{
+		std::vector<std::size_t> counts(GetNumPatterns(), 0);
+		ForEach(str, [&counts](std::size_t, std::size_t patidx)
+		{
+			++counts[patidx];
+		});
+		return counts;
+	}
+
+
+protected:
+	t_idx AddNode()
+	{
+		m_trans.resize(m_trans.size() + m_num_classes, no_idx);
+		m_terminal.push_back(no_idx);
+		m_dict.push_back(no_idx);
+		return static_cast<t_idx>(m_terminal.size() - 1);
+	}
+
+
+private:
+	// byte classes
+	std::array<t_idx, 256> m_classes{};
+	std::size_t m_num_classes{1};
+
+	// transitions, node-major
+	std::vector<t_idx> m_trans{};
+	// pattern ending at the node
+	std::vector<t_idx> m_terminal{};
+	// next node on the suffix chain which ends a pattern
+	std::vector<t_idx> m_dict{};
+	// first node on the suffix chain which ends a pattern, including the node itself
+	std::vector<t_idx> m_report{};
+
+	// pattern lengths
+	std::vector<std::size_t> m_lengths{};
+};
+// ----------------------------------------------------------------------------
 
 
 
@@ -248,4 +819,989 @@ huffman_mapping(const std::shared_ptr<HuffmanNode<typename t_str::value_type>>&
 	return map;
 }
 
+
+
+
+// ----------------------------------------------------------------------------
+// suffix array index
+// ----------------------------------------------------------------------------
+/**
+ * SA-IS suffix array construction by induced sorting in O(n)
+ * the string has to end with a unique, smallest symbol 0, the symbols are < alphabet_size
+ * @see G. Nong, S. Zhang and W. H. Chan, "Two Efficient Algorithms for Linear Time Suffix Array Construction",
+ *      IEEE Trans. Comput. 60(10), DOI: 10.1109/TC.2010.188 (2011).
+ */
+template<class t_idx>
+void suffix_array_sais(const std::vector<t_idx>& str, std::vector<t_idx>& sa, std::size_t alphabet_size)
+{
+	const std::size_t len = str.size();
+	constexpr t_idx empty = std::numeric_limits<t_idx>::max();
+
+	sa.assign(len, empty);
+	if(len == 1)
+	{
+		sa[0] = 0;
+		return;
+	}
+
+	// suffix types: s-type if it is smaller than the next suffix, l-type otherwise
+	std::vector<unsigned char> is_s(len, 0);
+	is_s[len - 1] = 1;
+	for(std::size_t idx=len-1; idx-- > 0;)
+		is_s[idx] = str[idx] < str[idx + 1] || (str[idx] == str[idx + 1] && is_s[idx + 1]);
+
+	// leftmost s-type positions
+	auto is_lms = [&is_s](std::size_t idx) -> bool
+	{
+		return idx > 0 && is_s[idx] && !is_s[idx - 1];
+	};
+
+	std::vector<std::size_t> bucket_sizes(alphabet_size, 0);
+	for(t_idx sym : str)
+		++bucket_sizes[sym];
+
+	std::vector<std::size_t> buckets(alphabet_size);
+	auto bucket_starts = [&bucket_sizes, &buckets]()
+	{
+		std::size_t sum = 0;
+		for(std::size_t sym=0; sym<bucket_sizes.size(); ++sym)
+		{
+			buckets[sym] = sum;
+			sum += bucket_sizes[sym];
+		}
+	};
+	auto bucket_ends = [&bucket_sizes, &buckets]()
+	{
+		std::size_t sum = 0;
+		for(std::size_t sym=0; sym<bucket_sizes.size(); ++sym)
+		{
+			sum += bucket_sizes[sym];
+			buckets[sym] = sum;
+		}
+	};
+
+	// sorts all suffixes from the sorted lms suffixes
+	auto induce = [&](const std::vector<t_idx>& lms)
+	{
+		std::fill(sa.begin(), sa.end(), empty);
+
+		bucket_ends();
+		for(std::size_t idx=lms.size(); idx-- > 0;)
+			sa[--buckets[str[lms[idx]]]] = lms[idx];
+
+		// l-type suffixes from left to right, the types are derived from the symbols
+		// where possible, which saves a random memory access
+		bucket_starts();
+		for(std::size_t idx=0; idx<len; ++idx)
+		{
+			// the scanned suffixes are l-type or lms, so pos-1 is l-type iff str[pos-1] >= str[pos]
+			const t_idx pos = sa[idx];
+			if(pos != empty && pos > 0 && str[pos - 1] >= str[pos])
+				sa[buckets[str[pos - 1]]++] = pos - 1;
+		}
+
+		// s-type suffixes from right to left
+		bucket_ends();
+		for(std::size_t idx=len; idx-- > 0;)
+		{
+			const t_idx pos = sa[idx];
+			if(pos != empty && pos > 0 && (str[pos - 1] < str[pos] || (str[pos - 1] == str[pos] && is_s[pos])))
+				sa[--buckets[str[pos - 1]]] = pos - 1;
+		}
+	};
+
+	// sort the lms substrings
+	std::vector<t_idx> lms;
+	for(std::size_t idx=1; idx<len; ++idx)
+		if(is_lms(idx))
+			lms.push_back(static_cast<t_idx>(idx));
+	induce(lms);
+
+	// sorted lms substrings
+	std::vector<t_idx> sorted_lms;
+	sorted_lms.reserve(lms.size());
+	for(t_idx pos : sa)
+		if(is_lms(pos))
+			sorted_lms.push_back(pos);
+
+	// name the lms substrings in their sorted order, equal substrings get the same name,
+	// the lms positions are at least two apart, so the names are stored at pos/2
+	std::vector<t_idx> names(len/2 + 1, empty);
+	t_idx num_names = 0;
+	t_idx prev = empty;
+	for(t_idx pos : sorted_lms)
+	{
+		bool same = prev != empty;
+		for(std::size_t dist=0; same; ++dist)
+		{
+			if(str[pos + dist] != str[prev + dist] || is_s[pos + dist] != is_s[prev + dist])
+				same = false;
+			else if(dist > 0 && (is_lms(pos + dist) || is_lms(prev + dist)))
+				break;
+		}
+
+		if(!same)
+			++num_names;
+		names[pos/2] = num_names - 1;
+		prev = pos;
+	}
+	sorted_lms = std::vector<t_idx>{};
+
+	// reduced string of the names in text order, it ends with the unique name 0 of the sentinel
+	std::vector<t_idx> reduced;
+	reduced.reserve(lms.size());
+	for(t_idx pos : lms)
+		reduced.push_back(names[pos/2]);
+	names = std::vector<t_idx>{};
+
+	std::vector<t_idx> reduced_sa(reduced.size());
+	if(num_names < reduced.size())
+	{
+		suffix_array_sais<t_idx>(reduced, reduced_sa, num_names);
+	}
+	else
+	{
+		for(std::size_t idx=0; idx<reduced.size(); ++idx)
+			reduced_sa[reduced[idx]] = static_cast<t_idx>(idx);
+	}
+
+	// sort all suffixes from the sorted lms suffixes
+	for(t_idx& idx : reduced_sa)
+		idx = lms[idx];
+	induce(reduced_sa);
+}
+
+
+/**
+ * suffix array of a byte string: the start positions of the suffixes in lexicographical order
+ * @throws std::length_error if the string and the sentinel cannot be indexed by t_idx
+ */
+template<class t_idx = std::uint32_t>
+std::vector<t_idx> suffix_array(std::string_view str)
+{
+	if(str.size() >= std::numeric_limits<t_idx>::max())
+		throw std::length_error("String is too long for the suffix array index type.");
+
+	// shift the bytes by one and append the sentinel
+	std::vector<t_idx> syms(str.size() + 1);
+	for(std::size_t idx=0; idx<str.size(); ++idx)
+		syms[idx] = static_cast<t_idx>(static_cast<unsigned char>(str[idx])) + 1;
+	syms[str.size()] = 0;
+
+	std::vector<t_idx> sa;
+	suffix_array_sais<t_idx>(syms, sa, 257);
+
+	// remove the sentinel suffix
+	sa.erase(sa.begin());
+	return sa;
+}
+
+
+/**
+ * longest common prefix of the neighbouring suffixes in the suffix array, lcp[0] = 0
+ * @see T. Kasai et al., "Linear-Time Longest-Common-Prefix Computation in Suffix Arrays and Its Applications",
+ *      CPM 2001, DOI: 10.1007/3-540-48194-X_17 (2001).
+ */
+template<class t_idx = std::uint32_t>
+std::vector<t_idx> lcp_array(std::string_view str, std::span<const t_idx> sa)
+{
+	const std::size_t len = str.size();
+
+	std::vector<t_idx> rank(len);
+	for(std::size_t idx=0; idx<len; ++idx)
+		rank[sa[idx]] = static_cast<t_idx>(idx);
+
+	std::vector<t_idx> lcp(len, 0);
+	std::size_t common = 0;
+	for(std::size_t pos=0; pos<len; ++pos)
+	{
+		if(rank[pos] == 0)
+		{
+			common = 0;
+			continue;
+		}
+
+		const std::size_t prev = sa[rank[pos] - 1];
+		while(pos + common < len && prev + common < len && str[pos + common] == str[prev + common])
+			++common;
+
+		lcp[rank[pos]] = static_cast<t_idx>(common);
+		if(common)
+			--common;
+	}
+
+	return lcp;
+}
+
+
+/**
+ * suffix array and lcp index of a text for repeated substring queries
+ * the index can be written to a file and used directly from a memory-mapped copy of it,
+ * the file format is: header, text (padded to 8 bytes), suffix array, lcp array,
+ * where the integers are stored in the native byte order
+ */
+template<class t_idx = std::uint32_t>
+class suffix_index
+{
+public:
+	static constexpr char magic[8] = { 'S', 'F', 'X', 'I', 'D', 'X', '0', '1' };
+	static constexpr std::size_t header_size = 32;
+
+
+public:
+	/**
+	 * builds the index, the text is copied
+	 * @throws std::length_error if the text cannot be indexed by t_idx
+	 */
+	explicit suffix_index(std::string_view text)
+	{
+		if(text.size() >= std::numeric_limits<t_idx>::max())
+			throw std::length_error("Text is too long for the suffix index type.");
+
+		m_text_owned.assign(text.begin(), text.end());
+		m_sa_owned = suffix_array<t_idx>(text);
+		m_lcp_owned = lcp_array<t_idx>(text, m_sa_owned);
+
+		m_text = std::string_view{m_text_owned.data(), m_text_owned.size()};
+		m_sa = m_sa_owned;
+		m_lcp = m_lcp_owned;
+	}
+
+
+	suffix_index(suffix_index&&) = default;
+	suffix_index& operator=(suffix_index&&) = default;
+	~suffix_index() = default;
+
+	// the views would point to the other index
+	suffix_index(const suffix_index&) = delete;
+	suffix_index& operator=(const suffix_index&) = delete;
+
+
+	/**
+	 * uses a serialised index without copying it, e.g. from a memory-mapped file
+	 * the buffer has to stay valid and to be aligned to the index type
+	 */
+	static std::optional<suffix_index> FromBuffer(std::string_view buf)
+	{
+		if(buf.size() < header_size || std::memcmp(buf.data(), magic, sizeof(magic)) != 0)
+			return std::nullopt;
+
+		std::uint64_t text_size = 0, idx_size = 0;
+		std::memcpy(&text_size, buf.data() + 8, sizeof(text_size));
+		std::memcpy(&idx_size, buf.data() + 16, sizeof(idx_size));
+
+		if(idx_size != sizeof(t_idx) || reinterpret_cast<std::uintptr_t>(buf.data()) % alignof(t_idx) != 0)
+			return std::nullopt;
+		if(text_size >= std::numeric_limits<t_idx>::max())
+			return std::nullopt;
+
+		// compare the sizes with the buffer before computing the offsets, which could overflow
+		const std::size_t text_pos = header_size;
+		if(text_size > buf.size() - text_pos || PaddedSize(text_size) > buf.size() - text_pos)
+			return std::nullopt;
+		const std::size_t sa_pos = text_pos + PaddedSize(text_size);
+		if(text_size > (buf.size() - sa_pos) / sizeof(t_idx) / 2)
+			return std::nullopt;
+		const std::size_t lcp_pos = sa_pos + text_size*sizeof(t_idx);
+
+		suffix_index index{};
+		index.m_text = buf.substr(text_pos, text_size);
+		index.m_sa = std::span<const t_idx>{reinterpret_cast<const t_idx*>(buf.data() + sa_pos), text_size};
+		index.m_lcp = std::span<const t_idx>{reinterpret_cast<const t_idx*>(buf.data() + lcp_pos), text_size};
+		return index;
+	}
+
+
+	/**
+	 * writes the index in the format read by FromBuffer
+	 */
+	bool Save(std::ostream& ostr) const
+	{
+		const std::uint64_t header[3] = { m_text.size(), sizeof(t_idx), 0 };
+		ostr.write(magic, sizeof(magic));
+		ostr.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+		const char padding[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+		ostr.write(m_text.data(), static_cast<std::streamsize>(m_text.size()));
+		ostr.write(padding, static_cast<std::streamsize>(PaddedSize(m_text.size()) - m_text.size()));
+
+		ostr.write(reinterpret_cast<const char*>(m_sa.data()), static_cast<std::streamsize>(m_sa.size_bytes()));
+		ostr.write(reinterpret_cast<const char*>(m_lcp.data()), static_cast<std::streamsize>(m_lcp.size_bytes()));
+
+		return ostr.good();
+	}
+
+
+	std::string_view GetText() const { return m_text; }
+	std::span<const t_idx> GetSuffixArray() const { return m_sa; }
+	std::span<const t_idx> GetLcp() const { return m_lcp; }
+
+
+	/**
+	 * range [begin, end) of the suffix array with the suffixes starting with the pattern
+	 * binary search in O(m log n)
+	 */
+	std::pair<std::size_t, std::size_t> Range(std::string_view pattern) const
+	{
+		// compares the pattern with the prefix of the suffix
+		auto compare = [this, &pattern](std::size_t sa_idx) -> int
+		{
+			const std::string_view suffix = m_text.substr(m_sa[sa_idx]);
+			const std::size_t len = std::min(suffix.size(), pattern.size());
+			if(int cmp = std::memcmp(suffix.data(), pattern.data(), len); cmp != 0)
+				return cmp;
+			return suffix.size() < pattern.size() ? -1 : 0;
+		};
+
+		// first suffix which is not smaller than the pattern
+		std::size_t begin = 0, end = m_sa.size();
+		while(begin < end)
+		{
+			const std::size_t mid = begin + (end - begin)/2;
+			if(compare(mid) < 0)
+				begin = mid + 1;
+			else
+				end = mid;
+		}
+
+		// first suffix whose prefix is larger than the pattern
+		end = m_sa.size();
+		for(std::size_t lo=begin; lo<end;)
+		{
+			const std::size_t mid = lo + (end - lo)/2;
+			if(compare(mid) <= 0)
+				lo = mid + 1;
+			else
+				end = mid;
+		}
+
+		return std::make_pair(begin, end);
+	}
+
+
+	/**
+	 * number of occurrences of the pattern
+	 */
+	std::size_t Count(std::string_view pattern) const
+	{
+		const auto [begin, end] = Range(pattern);
+		return end - begin;
+	}
+
+
+	/**
+	 * sorted positions of the occurrences of the pattern
+	 */
+	std::vector<std::size_t> Locate(std::string_view pattern) const
+	{
+		const auto [begin, end] = Range(pattern);
+
+		std::vector<std::size_t> positions;
+		positions.reserve(end - begin);
+		for(std::size_t sa_idx=begin; sa_idx<end; ++sa_idx)
+			positions.push_back(m_sa[sa_idx]);
+
+		std::sort(positions.begin(), positions.end());
+		return positions;
+	}
+
+
+	/**
+	 * position and length of the (first in suffix order) longest substring which occurs at least twice
+	 */
+	std::pair<std::size_t, std::size_t> LongestRepeat() const
+	{
+		if(m_lcp.empty())
+			return std::make_pair(0, 0);
+
+		const auto iter = std::max_element(m_lcp.begin(), m_lcp.end());
+		return std::make_pair(m_sa[iter - m_lcp.begin()], *iter);
+	}
+
+
+protected:
+	suffix_index() = default;
+
+
+	static std::size_t PaddedSize(std::size_t size)
+	{
+		return (size + 7) / 8 * 8;
+	}
+
+
+private:
+	// storage of an index built in memory
+	std::vector<char> m_text_owned{};
+	std::vector<t_idx> m_sa_owned{}, m_lcp_owned{};
+
+	// views of the own storage or of an external buffer
+	std::string_view m_text{};
+	std::span<const t_idx> m_sa{}, m_lcp{};
+};
+// ----------------------------------------------------------------------------
+
+
+// ----------------------------------------------------------------------------
+// huffman codec for byte strings
+// ----------------------------------------------------------------------------
+/**
+ * code lengths per byte value
+ */
+using t_huffman_lengths = std::array<std::uint8_t, 256>;
+
+/**
+ * canonical codes per byte value, the code is in the lowest bits
+ */
+using t_huffman_codes = std::array<std::uint32_t, 256>;
+
+
+/**
+ * huffman code lengths for the given byte frequencies, limited to max_len bits
+ * if the optimal code is too long, the frequencies are halved until it fits,
+ * max_len is raised if it is too short for the number of used bytes,
+ * a single used byte gets a code of length 1
+ * @see (FUH 2021), Kurseinheit 2, p. 27
+ */
+inline t_huffman_lengths huffman_lengths(const std::array<std::size_t, 256>& freqs,
+	std::size_t max_len = STR_HUFFMAN_MAX_LEN)
+{
+	t_huffman_lengths lengths{};
+	std::array<std::size_t, 256> scaled_freqs = freqs;
+
+	const std::size_t num_used = 256 - std::count(freqs.begin(), freqs.end(), 0);
+	if(num_used > 1)
+		max_len = std::max<std::size_t>(max_len, std::bit_width(num_used - 1));
+
+	while(true)
+	{
+		// the first 256 nodes are the leaves, the others are inner nodes
+		std::vector<std::size_t> parents(256, 0);
+		using t_node = std::pair<std::size_t, std::size_t>;	// [freq, node]
+		std::priority_queue<t_node, std::vector<t_node>, std::greater<t_node>> queue;
+
+		for(std::size_t ch=0; ch<256; ++ch)
+			if(scaled_freqs[ch])
+				queue.push(std::make_pair(scaled_freqs[ch], ch));
+
+		if(queue.size() == 1)
+		{
+			lengths.fill(0);
+			lengths[queue.top().second] = 1;
+			return lengths;
+		}
+
+		// build huffman tree
+		while(queue.size() > 1)
+		{
+			auto [freq1, node1] = queue.top();
+			queue.pop();
+			auto [freq2, node2] = queue.top();
+			queue.pop();
+
+			const std::size_t node = parents.size();
+			parents.push_back(node);	// the root is its own parent
+			parents[node1] = parents[node2] = node;
+			queue.push(std::make_pair(freq1 + freq2, node));
+		}
+
+		// depths of the leaves, the parents have larger indices than their children
+		std::vector<std::size_t> depths(parents.size(), 0);
+		std::size_t longest = 0;
+		for(std::size_t node=parents.size(); node-- > 0;)
+		{
+			if(parents[node] != node)
+				depths[node] = depths[parents[node]] + 1;
+		}
+
+		for(std::size_t ch=0; ch<256; ++ch)
+		{
+			lengths[ch] = scaled_freqs[ch] ? static_cast<std::uint8_t>(depths[ch]) : 0;
+			longest = std::max<std::size_t>(longest, lengths[ch]);
+		}
+
+		if(longest <= max_len)
+			return lengths;
+
+		// flatten the frequency distribution and try again
+		for(std::size_t& freq : scaled_freqs)
+			if(freq)
+				freq = (freq >> 1) | 1;
+	}
+}
+
+
+/**
+ * canonical codes: the codes of the same length are consecutive in the order of the byte values,
+ * and the shorter codes come before the longer ones
+ * @see https://en.wikipedia.org/wiki/Canonical_Huffman_code
+ */
+inline t_huffman_codes huffman_canonical(const t_huffman_lengths& lengths)
+{
+	// number of codes per length
+	std::array<std::uint32_t, 33> num_lengths{};
+	for(std::uint8_t len : lengths)
+		++num_lengths[len];
+	num_lengths[0] = 0;
+
+	// first code per length
+	std::array<std::uint32_t, 33> next_code{};
+	std::uint32_t code = 0;
+	for(std::size_t len=1; len<next_code.size(); ++len)
+	{
+		code = (code + num_lengths[len-1]) << 1;
+		next_code[len] = code;
+	}
+
+	t_huffman_codes codes{};
+	for(std::size_t ch=0; ch<256; ++ch)
+		if(lengths[ch])
+			codes[ch] = next_code[lengths[ch]]++;
+
+	return codes;
+}
+
+
+/**
+ * writes codes msb-first into a byte string
+ */
+class bit_writer
+{
+public:
+	explicit bit_writer(std::string& out) : m_out{out}
+	{}
+
+	~bit_writer() = default;
+	bit_writer(const bit_writer&) = delete;
+	bit_writer& operator=(const bit_writer&) = delete;
+
+
+	/**
+	 * writes the lowest len bits of the code, len <= 32
+	 */
+	void Write(std::uint32_t code, std::size_t len)
+	{
+		m_bits = (m_bits << len) | code;
+		m_num_bits += len;
+
+		if(m_num_bits >= 32)
+		{
+			m_num_bits -= 32;
+			const std::uint64_t word = m_bits >> m_num_bits;
+			const char bytes[4] = {
+				static_cast<char>(word >> 24), static_cast<char>(word >> 16),
+				static_cast<char>(word >> 8), static_cast<char>(word) };
+			m_out.append(bytes, 4);
+		}
+	}
+
+
+	/**
+	 * writes the remaining bits padded with zeros
+	 */
+	void Flush()
+	{
+		// pad to full bytes
+		if(m_num_bits % 8)
+		{
+			m_bits <<= 8 - m_num_bits % 8;
+			m_num_bits += 8 - m_num_bits % 8;
+		}
+
+		while(m_num_bits)
+		{
+			m_num_bits -= 8;
+			m_out.push_back(static_cast<char>(m_bits >> m_num_bits));
+		}
+	}
+
+
+private:
+	std::string& m_out;
+	std::uint64_t m_bits{0};
+	std::size_t m_num_bits{0};
+};
+
+
+/**
+ * reads bits msb-first from a byte string, the bits after its end are zero
+ */
+class bit_reader
+{
+public:
+	explicit bit_reader(std::string_view in) : m_in{in}
+	{
+		Refill();
+	}
+
+
+	/**
+	 * the next len bits without consuming them, len <= 32
+	 */
+	std::uint32_t Peek(std::size_t len) const
+	{
+		return static_cast<std::uint32_t>(m_bits >> (64 - len));
+	}
+
+
+	void Skip(std::size_t len)
+	{
+		Consume(len);
+		if(m_num_bits < 32)
+			Refill();
+	}
+
+
+	/**
+	 * skips bits without refilling, at most the number of available bits
+	 */
+	void Consume(std::size_t len)
+	{
+		m_bits <<= len;
+		m_num_bits -= len;
+	}
+
+
+	/**
+	 * at least 56 bits are available afterwards
+	 */
+	void Refill()
+	{
+		// load 8 bytes at once, the bits which don't fit are loaded again with the next refill
+		if(m_pos + 8 <= m_in.size())
+		{
+			const unsigned char *bytes = reinterpret_cast<const unsigned char*>(m_in.data() + m_pos);
+			std::uint64_t word = 0;
+			for(std::size_t byte=0; byte<8; ++byte)
+				word = (word << 8) | bytes[byte];
+
+			m_bits |= word >> m_num_bits;
+			const std::size_t num_bytes = (63 - m_num_bits) / 8;
+			m_pos += num_bytes;
+			m_num_bits += num_bytes * 8;
+			return;
+		}
+
+		while(m_num_bits <= 56)
+		{
+			const std::uint64_t byte = m_pos < m_in.size() ? static_cast<unsigned char>(m_in[m_pos]) : 0;
+			m_bits |= byte << (56 - m_num_bits);
+			m_num_bits += 8;
+			++m_pos;
+		}
+	}
+
+
+private:
+	std::string_view m_in{};
+	std::size_t m_pos{0};
+
+	// the next bits are the highest ones
+	std::uint64_t m_bits{0};
+	std::size_t m_num_bits{0};
+};
+
+
+/**
+ * table-driven decoder for canonical codes
+ * the next max_len bits index a table which gives the symbol and the length of its code,
+ * so every symbol is decoded in one step instead of walking the tree bit by bit
+ */
+class huffman_decoder
+{
+public:
+	explicit huffman_decoder(const t_huffman_lengths& lengths)
+	{
+		m_max_len = *std::max_element(lengths.begin(), lengths.end());
+		m_table.resize(std::size_t(1) << m_max_len);
+
+		const t_huffman_codes codes = huffman_canonical(lengths);
+		for(std::size_t ch=0; ch<256; ++ch)
+		{
+			const std::size_t len = lengths[ch];
+			if(!len)
+				continue;
+
+			// all table indices starting with the code
+			const std::size_t shift = m_max_len - len;
+			const std::size_t begin = std::size_t(codes[ch]) << shift;
+			const std::size_t end = std::size_t(codes[ch] + 1) << shift;
+			for(std::size_t idx=begin; idx<end; ++idx)
+				m_table[idx] = static_cast<std::uint16_t>((len << 8) | ch);
+		}
+	}
+
+
+	std::uint8_t Decode(bit_reader& bits) const
+	{
+		const std::uint16_t entry = m_table[bits.Peek(m_max_len)];
+		bits.Skip(entry >> 8);
+		return static_cast<std::uint8_t>(entry & 0xff);
+	}
+
+
+	/**
+	 * decodes num symbols into the output buffer
+	 * one refill of the bit buffer gives the bits for several symbols
+	 */
+	void Decode(bit_reader& bits, char* out, std::size_t num) const
+	{
+		// local copies, the output can alias the members
+		bit_reader local_bits = bits;
+		const std::uint16_t *table = m_table.data();
+		const std::size_t max_len = m_max_len;
+		const std::size_t symbols_per_refill = 56 / max_len;
+
+		std::size_t idx = 0;
+		for(; idx + symbols_per_refill <= num; idx += symbols_per_refill)
+		{
+			local_bits.Refill();
+			for(std::size_t sym=0; sym<symbols_per_refill; ++sym)
+			{
+				const std::uint16_t entry = table[local_bits.Peek(max_len)];
+				local_bits.Consume(entry >> 8);
+				out[idx + sym] = static_cast<char>(entry & 0xff);
+			}
+		}
+
+		for(; idx<num; ++idx)
+			out[idx] = static_cast<char>(Decode(local_bits));
+
+		bits = local_bits;
+	}
+
+
+private:
+	std::size_t m_max_len{0};
+	// code length in the high and symbol in the low byte
+	std::vector<std::uint16_t> m_table{};
+};
+
+
+/**
+ * encodes a block and appends it to the output, every block has its own code table
+ * block format: number of symbols (4 bytes, little endian), payload size (4 bytes),
+ * code lengths (256 4-bit values), payload
+ */
+inline void huffman_encode_block(std::string_view in, std::string& out)
+{
+	static_assert(STR_HUFFMAN_MAX_LEN <= 15, "The code lengths are stored in 4 bits.");
+
+	std::array<std::size_t, 256> freqs{};
+	for(char ch : in)
+		++freqs[static_cast<unsigned char>(ch)];
+
+	const t_huffman_lengths lengths = huffman_lengths(freqs);
+	const t_huffman_codes codes = huffman_canonical(lengths);
+
+	auto write_u32 = [&out](std::size_t pos, std::size_t val)
+	{
+		for(std::size_t byte=0; byte<4; ++byte)
+			out[pos + byte] = static_cast<char>((val >> (byte*8)) & 0xff);
+	};
+
+	// header
+	const std::size_t header_pos = out.size();
+	out.resize(header_pos + 8);
+	write_u32(header_pos, in.size());
+	for(std::size_t ch=0; ch<256; ch+=2)
+		out.push_back(static_cast<char>((lengths[ch] << 4) | lengths[ch+1]));
+
+	// payload
+	const std::size_t payload_pos = out.size();
+	bit_writer bits{out};
+	for(char ch : in)
+	{
+		const unsigned char uch = static_cast<unsigned char>(ch);
+		bits.Write(codes[uch], lengths[uch]);
+	}
+	bits.Flush();
+
+	write_u32(header_pos + 4, out.size() - payload_pos);
+}
+
+
+/**
+ * size of the block header
+ */
+constexpr std::size_t huffman_header_size = 8 + 128;
+
+
+/**
+ * reads the number of symbols and the payload size from a block header
+ */
+inline std::tuple<std::size_t, std::size_t> huffman_block_sizes(std::string_view header)
+{
+	auto read_u32 = [&header](std::size_t pos) -> std::size_t
+	{
+		std::size_t val = 0;
+		for(std::size_t byte=0; byte<4; ++byte)
+			val |= std::size_t(static_cast<unsigned char>(header[pos + byte])) << (byte*8);
+		return val;
+	};
+
+	return std::make_tuple(read_u32(0), read_u32(4));
+}
+
+
+/**
+ * decodes the block at the beginning of the input and appends it to the output
+ * returns the size of the encoded block or nullopt if the input is invalid
+ */
+inline std::optional<std::size_t> huffman_decode_block(std::string_view in, std::string& out)
+{
+	if(in.size() < huffman_header_size)
+		return std::nullopt;
+
+	const auto [num_symbols, payload_size] = huffman_block_sizes(in);
+	if(in.size() - huffman_header_size < payload_size)
+		return std::nullopt;
+
+	t_huffman_lengths lengths{};
+	for(std::size_t ch=0; ch<256; ch+=2)
+	{
+		const unsigned char byte = static_cast<unsigned char>(in[8 + ch/2]);
+		lengths[ch] = byte >> 4;
+		lengths[ch+1] = byte & 0x0f;
+	}
+
+	if(!num_symbols && payload_size)
+		return std::nullopt;
+
+	if(num_symbols)
+	{
+		// the code has to be complete or consist of a single code word
+		std::size_t kraft = 0, num_codes = 0;
+		for(std::uint8_t len : lengths)
+		{
+			if(len)
+			{
+				kraft += std::size_t(1) << (15 - len);
+				++num_codes;
+			}
+		}
+		if(!(kraft == (std::size_t(1) << 15) || (num_codes == 1 && kraft == (std::size_t(1) << 14))))
+			return std::nullopt;
+
+		// the payload has to hold the symbols, which need between the minimum and maximum code length
+		std::size_t min_len = 15, max_len = 0;
+		for(std::uint8_t len : lengths)
+		{
+			if(len)
+			{
+				min_len = std::min<std::size_t>(min_len, len);
+				max_len = std::max<std::size_t>(max_len, len);
+			}
+		}
+		if(num_symbols*min_len > payload_size*8 || payload_size*8 >= num_symbols*max_len + 8)
+			return std::nullopt;
+
+		const huffman_decoder decoder{lengths};
+		bit_reader bits{in.substr(huffman_header_size, payload_size)};
+
+		const std::size_t out_pos = out.size();
+		out.resize(out_pos + num_symbols);
+		decoder.Decode(bits, out.data() + out_pos, num_symbols);
+	}
+
+	return huffman_header_size + payload_size;
+}
+
+
+/**
+ * encodes a byte string, e.g. a memory-mapped file, in blocks with their own code tables
+ */
+inline std::string huffman_encode(std::string_view in, std::size_t block_size = STR_HUFFMAN_BLOCK)
+{
+	std::string out;
+	out.reserve(in.size()/2);
+
+	for(std::size_t pos=0; pos<in.size(); pos+=block_size)
+		huffman_encode_block(in.substr(pos, block_size), out);
+
+	return out;
+}
+
+
+/**
+ * decodes a byte string of encoded blocks
+ */
+inline std::optional<std::string> huffman_decode(std::string_view in)
+{
+	std::string out;
+
+	for(std::size_t pos=0; pos<in.size();)
+	{
+		std::optional<std::size_t> block_size = huffman_decode_block(in.substr(pos), out);
+		if(!block_size)
+			return std::nullopt;
+		pos += *block_size;
+	}
+
+	return out;
+}
+
+
+/**
+ * encodes a stream block by block, the memory is bounded by the block size
+ */
+inline bool huffman_encode_stream(std::istream& istr, std::ostream& ostr,
+	std::size_t block_size = STR_HUFFMAN_BLOCK)
+{
+	std::string block(block_size, 0), out;
+
+	while(istr)
+	{
+		istr.read(block.data(), static_cast<std::streamsize>(block_size));
+		const std::size_t num_read = static_cast<std::size_t>(istr.gcount());
+		if(!num_read)
+			break;
+
+		out.clear();
+		huffman_encode_block(std::string_view{block.data(), num_read}, out);
+		ostr.write(out.data(), static_cast<std::streamsize>(out.size()));
+	}
+
+	return !istr.bad() && ostr.good();
+}
+
+
+/**
+ * decodes a stream block by block
+ */
+inline bool huffman_decode_stream(std::istream& istr, std::ostream& ostr)
+{
+	std::string block, out;
+
+	while(true)
+	{
+		block.resize(huffman_header_size);
+		istr.read(block.data(), static_cast<std::streamsize>(huffman_header_size));
+		const std::size_t num_read = static_cast<std::size_t>(istr.gcount());
+		if(num_read == 0)
+			break;
+		if(num_read != huffman_header_size)
+			return false;
+
+		// read the payload in chunks, so that a corrupt size doesn't allocate more than the stream holds
+		const std::size_t payload_size = std::get<1>(huffman_block_sizes(block));
+		constexpr std::size_t chunk_size = std::size_t(1) << 20;
+		for(std::size_t pos=0; pos<payload_size; pos+=chunk_size)
+		{
+			const std::size_t len = std::min(chunk_size, payload_size - pos);
+			block.resize(huffman_header_size + pos + len);
+			istr.read(block.data() + huffman_header_size + pos, static_cast<std::streamsize>(len));
+			if(static_cast<std::size_t>(istr.gcount()) != len)
+				return false;
+		}
+
+		out.clear();
+		if(!huffman_decode_block(block, out))
+			return false;
+		ostr.write(out.data(), static_cast<std::streamsize>(out.size()));
+	}
+
+	return !istr.bad() && ostr.good();
+}
+// ----------------------------------------------------------------------------
+
 #endif
@@ -0,0 +1,217 @@
+/**
+ * round trips and throughput of the huffman codec
+ * @author Tobias Weber
+ * @date oct-2026
+ * @license see 'LICENSE.EUPL' file
+ *
+ * g++ -std=c++20 -Wall -Wextra -Weffc++ -O2 -o str_huffman_tst str_huffman_tst.cpp
+ */
+
+#include "str_algos.h"
+#include "tst_helpers.h"
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+
+
+/**
+ * random bytes with a geometric distribution of the byte values
+ */
+std::string random_bytes(std::size_t len, double p, std::mt19937& rnd)
+{
+	std::geometric_distribution<int> dist(p);
+
+	std::string str(len, 0);
+	for(char& ch : str)
+		ch = static_cast<char>(dist(rnd) % 256);
+	return str;
+}
+
+
+/**
+ * is the code prefix-free and complete?
+ */
+bool check_code(const t_huffman_lengths& lengths, std::size_t max_len)
+{
+	const t_huffman_codes codes = huffman_canonical(lengths);
+
+	double kraft = 0.;
+	std::size_t num_codes = 0;
+	for(std::size_t ch1=0; ch1<256; ++ch1)
+	{
+		if(!lengths[ch1])
+			continue;
+		if(lengths[ch1] > max_len)
+			return false;
+		kraft += 1. / double(std::size_t(1) << lengths[ch1]);
+		++num_codes;
+
+		for(std::size_t ch2=0; ch2<256; ++ch2)
+		{
+			if(ch1 == ch2 || !lengths[ch2] || lengths[ch2] < lengths[ch1])
+				continue;
+			if((codes[ch2] >> (lengths[ch2] - lengths[ch1])) == codes[ch1])
+				return false;
+		}
+	}
+
+	return num_codes <= 1 || kraft == 1.;
+}
+
+
+/**
+ * decodes bit by bit by walking the huffman tree
+ */
+std::string decode_tree(const std::shared_ptr<HuffmanNode<char>>& tree, std::string_view in, std::size_t num_symbols)
+{
+	std::string out;
+	out.reserve(num_symbols);
+	bit_reader bits{in};
+
+	while(out.size() < num_symbols)
+	{
+		const HuffmanNode<char> *node = tree.get();
+		while(!node->ch)
+		{
+			// huffman_mapping() assigns 1 to the left and 0 to the right branches
+			node = bits.Peek(1) ? node->left.get() : node->right.get();
+			bits.Skip(1);
+		}
+		out.push_back(*node->ch);
+	}
+
+	return out;
+}
+
+
+int main()
+{
+	std::mt19937 rnd{1234};
+	std::cout << std::boolalpha;
+
+	// code construction
+	{
+		bool ok = true;
+		for(double p : { 0.9, 0.5, 0.2, 0.05, 0.01 })
+		{
+			std::array<std::size_t, 256> freqs{};
+			for(char ch : random_bytes(100000, p, rnd))
+				++freqs[static_cast<unsigned char>(ch)];
+
+			ok = ok && check_code(huffman_lengths(freqs), STR_HUFFMAN_MAX_LEN);
+
+			// the maximum length is raised if there are too many different bytes
+			const std::size_t num_used = 256 - std::count(freqs.begin(), freqs.end(), 0);
+			const std::size_t max_len = std::max<std::size_t>(6, std::bit_width(num_used - 1));
+			ok = ok && check_code(huffman_lengths(freqs, 6), max_len);
+		}
+
+		// fibonacci frequencies give the longest codes
+		std::array<std::size_t, 256> freqs{};
+		for(std::size_t ch=0, f1=1, f2=1; ch<40; ++ch, f2=f1+f2, f1=f2-f1)
+			freqs[ch] = f1;
+		const t_huffman_lengths lengths_fib = huffman_lengths(freqs);
+		ok = ok && check_code(lengths_fib, STR_HUFFMAN_MAX_LEN)
+			&& *std::max_element(lengths_fib.begin(), lengths_fib.end()) == STR_HUFFMAN_MAX_LEN;
+
+		std::cout << "canonical, length-limited codes: ok = " << ok << std::endl;
+	}
+
+	// round trips
+	{
+		std::vector<std::string> inputs{ "", "a", "aaaaaaaa", "abbcccdddd" };
+		for(std::size_t len : { 1, 2, 17, 1000, 100000 })
+			for(double p : { 0.9, 0.3, 0.01 })
+				inputs.push_back(random_bytes(len, p, rnd));
+
+		bool ok_mem = true, ok_stream = true;
+		for(const std::string& in : inputs)
+		{
+			for(std::size_t block_size : { std::size_t(1), std::size_t(7), std::size_t(4096), std::size_t(STR_HUFFMAN_BLOCK) })
+			{
+				if(block_size == 1 && in.size() > 1000)
+					continue;
+
+				const std::string enc = huffman_encode(in, block_size);
+				std::optional<std::string> dec = huffman_decode(enc);
+				ok_mem = ok_mem && dec && *dec == in;
+
+				std::istringstream istr_enc{in};
+				std::ostringstream ostr_enc;
+				ok_stream = ok_stream && huffman_encode_stream(istr_enc, ostr_enc, block_size);
+				std::istringstream istr_dec{ostr_enc.str()};
+				std::ostringstream ostr_dec;
+				ok_stream = ok_stream && ostr_enc.str() == enc
+					&& huffman_decode_stream(istr_dec, ostr_dec) && ostr_dec.str() == in;
+			}
+		}
+
+		// truncated input
+		const std::string enc = huffman_encode(inputs.back());
+		ok_mem = ok_mem && !huffman_decode(std::string_view{enc}.substr(0, enc.size() - 1));
+
+		// corrupt sizes in the block header
+		for(std::size_t byte : { 3, 7 })
+		{
+			std::string corrupt = enc;
+			corrupt[byte] = static_cast<char>(0x7f);
+			ok_mem = ok_mem && !huffman_decode(corrupt);
+
+			std::istringstream istr{corrupt};
+			std::ostringstream ostr;
+			ok_mem = ok_mem && !huffman_decode_stream(istr, ostr);
+		}
+		std::string empty_block(huffman_header_size, 0);
+		empty_block[4] = 1;
+		ok_mem = ok_mem && !huffman_decode(empty_block + "x");
+
+		std::cout << "in-memory round trips: ok = " << ok_mem << std::endl;
+		std::cout << "stream round trips: ok = " << ok_stream << std::endl;
+	}
+
+	// throughput
+	{
+		const std::string in = random_bytes(std::size_t(64) << 20, 0.1, rnd);
+		std::cout << "\n" << (in.size() >> 20) << " MB:" << std::endl;
+
+		auto start_enc = std::chrono::steady_clock::now();
+		const std::string enc = huffman_encode(in);
+		double time_enc = seconds_since(start_enc);
+
+		auto start_dec = std::chrono::steady_clock::now();
+		std::optional<std::string> dec = huffman_decode(enc);
+		double time_dec = seconds_since(start_dec);
+
+		std::cout << "\tcompressed to " << double(enc.size()) / double(in.size()) * 100. << " %" << std::endl;
+		std::cout << "\tencode: " << double(in.size() >> 20) / time_enc << " MB/s" << std::endl;
+		std::cout << "\tdecode with table: " << double(in.size() >> 20) / time_dec << " MB/s"
+			<< ", ok = " << (dec && *dec == in) << std::endl;
+
+		// bitwise decoding with the tree of huffman() using the code of huffman_mapping()
+		const std::string_view block{in.data(), STR_HUFFMAN_BLOCK};
+		auto tree = huffman<std::string_view>(block);
+		auto mapping = huffman_mapping<std::string_view>(tree);
+
+		std::string enc_tree;
+		bit_writer bits{enc_tree};
+		for(char ch : block)
+		{
+			const auto& code = mapping[ch];
+			for(std::size_t bit=0; bit<code.size(); ++bit)
+				bits.Write(code[bit], 1);
+		}
+		bits.Flush();
+
+		auto start_tree = std::chrono::steady_clock::now();
+		const std::string dec_tree = decode_tree(tree, enc_tree, block.size());
+		double time_tree = seconds_since(start_tree);
+		std::cout << "\tdecode bit by bit with tree: " << double(block.size() >> 20) / time_tree << " MB/s"
+			<< ", ok = " << (dec_tree == block) << std::endl;
+	}
+
+	return 0;
+}
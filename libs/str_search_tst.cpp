@@ -0,0 +1,199 @@
+/**
+ * compares the pattern searchers with std::string::find and the std searchers
+ * @author Tobias Weber
+ * @date oct-2026
+ * @license see 'LICENSE.EUPL' file
+ *
+ * g++ -std=c++20 -Wall -Wextra -Weffc++ -O2 -march=native -o str_search_tst str_search_tst.cpp
+ *
+ * build check for targets without sse2/avx2 (e.g. aarch64), using the scalar fallback:
+ * g++ -std=c++20 -Wall -Wextra -Weffc++ -O2 -U__SSE2__ -U__AVX2__ -o str_search_tst_scalar str_search_tst.cpp
+ */
+
+#include "str_algos.h"
+#include "tst_helpers.h"
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <functional>
+#include <algorithm>
+#include <random>
+#include <chrono>
+
+
+/**
+ * random text over the first num_chars letters
+ */
+std::string random_text(std::size_t len, std::size_t num_chars, std::mt19937& rnd)
+{
+	std::uniform_int_distribution<int> dist(0, int(num_chars) - 1);
+
+	std::string str(len, ' ');
+	for(char& ch : str)
+		ch = char('a' + dist(rnd));
+	return str;
+}
+
+
+/**
+ * log-like text of random words
+ */
+std::string random_log(std::size_t len, std::mt19937& rnd)
+{
+	std::uniform_int_distribution<int> dist_ch('a', 'z'), dist_len(2, 9);
+
+	std::string str;
+	str.reserve(len + 16);
+	while(str.size() < len)
+	{
+		const int word_len = dist_len(rnd);
+		for(int i=0; i<word_len; ++i)
+			str.push_back(char(dist_ch(rnd)));
+		str.push_back(dist_len(rnd) == 2 ? '\n' : ' ');
+	}
+	str.resize(len);
+	return str;
+}
+
+
+/**
+ * all matches found by std::string::find
+ */
+std::vector<std::size_t> find_all_std(const std::string& str, const std::string& pattern)
+{
+	std::vector<std::size_t> matches;
+	for(std::size_t pos = str.find(pattern); pos != std::string::npos; pos = str.find(pattern, pos + 1))
+		matches.push_back(pos);
+	return matches;
+}
+
+
+int main()
+{
+	std::mt19937 rnd{1234};
+	std::cout << std::boolalpha;
+
+	// compare the matches with the ones of std::string::find on small alphabets with many overlaps
+	{
+		bool ok_kmp = true, ok_simd = true, ok_scalar = true, ok_ac = true;
+
+		for(std::size_t iter=0; iter<200; ++iter)
+		{
+			const std::size_t num_chars = 2 + iter%3;
+			const std::string str = random_text(1 + iter*7, num_chars, rnd);
+
+			std::vector<std::string> patterns;
+			for(std::size_t len=1; len<=40; len+=3)
+				patterns.push_back(random_text(len % 9 + 1 + (len > 30 ? len : 0), num_chars, rnd));
+			patterns.push_back(patterns[0]);	// duplicate
+			patterns.push_back("");		// ignored
+
+			aho_corasick ac{patterns};
+			std::vector<std::vector<std::size_t>> ac_matches(patterns.size());
+			for(const auto& [pos, patidx] : ac.Matches(str))
+				ac_matches[patidx].push_back(pos);
+
+			std::vector<std::pair<std::size_t, std::size_t>> ac_all = ac.FindAll(str);
+			std::vector<std::size_t> counts = ac.Count(str);
+
+			for(std::size_t patidx=0; patidx<patterns.size(); ++patidx)
+			{
+				const std::string& pattern = patterns[patidx];
+				const std::vector<std::size_t> ref = find_all_std(str, pattern);
+
+				if(pattern.size())
+				{
+					ok_kmp = ok_kmp && kmp_matcher<std::string>{pattern}.FindAll(str) == ref
+						&& find_pattern<std::string>(str, pattern) == (ref.size() ? ref[0] : str.size());
+					ok_simd = ok_simd && byte_searcher<true>{pattern}.FindAll(str) == ref;
+					ok_scalar = ok_scalar && byte_searcher<false>{pattern}.FindAll(str) == ref;
+				}
+
+				// duplicate patterns are reported with the first index, empty ones not at all
+				std::vector<std::size_t> ac_ref = ref;
+				if(std::find(patterns.begin(), patterns.end(), pattern) != patterns.begin() + patidx || pattern.empty())
+					ac_ref.clear();
+				std::vector<std::size_t> ac_pat = ac_matches[patidx];
+				std::sort(ac_pat.begin(), ac_pat.end());
+				ok_ac = ok_ac && ac_pat == ac_ref && counts[patidx] == ac_ref.size();
+			}
+
+			std::vector<std::pair<std::size_t, std::size_t>> ac_iter{ ac.Matches(str).begin(), ac.Matches(str).end() };
+			ok_ac = ok_ac && ac_iter == ac_all;
+		}
+
+		std::cout << "kmp: ok = " << ok_kmp << std::endl;
+#if STR_SIMD
+		std::cout << "byte searcher, simd (width " << str_simd::width << "): ok = " << ok_simd << std::endl;
+#else
+		std::cout << "byte searcher, simd (not available): ok = " << ok_simd << std::endl;
+#endif
+		std::cout << "byte searcher, scalar: ok = " << ok_scalar << std::endl;
+		std::cout << "aho-corasick: ok = " << ok_ac << std::endl;
+	}
+
+	const std::string log = random_log(std::size_t(64) << 20, rnd);
+	std::cout << "\nsearching in " << (log.size() >> 20) << " MB of random words" << std::endl;
+
+	// single pattern
+	{
+		const std::string pattern = "qzx";
+		const std::vector<std::size_t> ref = find_all_std(log, pattern);
+
+		auto bench = [&log, &ref](const char* name, const std::function<std::vector<std::size_t>()>& func)
+		{
+			auto start = std::chrono::steady_clock::now();
+			std::vector<std::size_t> matches = func();
+			double time = seconds_since(start);
+
+			std::cout << "\t" << name << ": " << time << " s, "
+				<< double(log.size()) / time / double(1 << 30) << " GB/s, "
+				<< matches.size() << " matches, ok = " << (matches == ref) << std::endl;
+		};
+
+		std::cout << "single pattern \"" << pattern << "\":" << std::endl;
+		bench("std::string::find", [&]() { return find_all_std(log, pattern); });
+		bench("boyer_moore_horspool_searcher", [&]()
+		{
+			std::vector<std::size_t> matches;
+			std::boyer_moore_horspool_searcher searcher(pattern.begin(), pattern.end());
+			for(auto iter = log.begin(); ; ++iter)
+			{
+				iter = std::search(iter, log.end(), searcher);
+				if(iter == log.end())
+					break;
+				matches.push_back(iter - log.begin());
+			}
+			return matches;
+		});
+		bench("kmp_matcher", [&]() { return kmp_matcher<std::string>{pattern}.FindAll(log); });
+		bench("byte_searcher, scalar", [&]() { return byte_searcher<false>{pattern}.FindAll(log); });
+		bench("byte_searcher, simd", [&]() { return byte_searcher<true>{pattern}.FindAll(log); });
+	}
+
+	// several patterns
+	{
+		std::vector<std::string> patterns;
+		for(std::size_t i=0; i<200; ++i)
+			patterns.push_back(random_text(4 + i%5, 26, rnd));
+
+		auto start_ac = std::chrono::steady_clock::now();
+		aho_corasick ac{patterns};
+		double time_build = seconds_since(start_ac);
+		std::vector<std::size_t> counts = ac.Count(log);
+		double time_ac = seconds_since(start_ac);
+
+		auto start_std = std::chrono::steady_clock::now();
+		bool ok = true;
+		for(std::size_t patidx=0; patidx<patterns.size(); ++patidx)
+			ok = ok && find_all_std(log, patterns[patidx]).size() == counts[patidx];
+		double time_std = seconds_since(start_std);
+
+		std::cout << patterns.size() << " patterns, " << ac.GetNumStates() << " states:" << std::endl;
+		std::cout << "\tstd::string::find per pattern: " << time_std << " s" << std::endl;
+		std::cout << "\taho-corasick: " << time_ac << " s (build: " << time_build << " s), ok = " << ok << std::endl;
+	}
+
+	return 0;
+}
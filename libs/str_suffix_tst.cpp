@@ -0,0 +1,253 @@
+/**
+ * compares the suffix array index with naive constructions and searches
+ * @author Tobias Weber
+ * @date oct-2026
+ * @license see 'LICENSE.EUPL' file
+ *
+ * g++ -std=c++20 -Wall -Wextra -Weffc++ -O2 -o str_suffix_tst str_suffix_tst.cpp -lboost_iostreams
+ */
+
+#include "str_algos.h"
+#include "tst_helpers.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <algorithm>
+#include <random>
+#include <chrono>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+
+/**
+ * random text over the first num_chars letters
+ */
+std::string random_text(std::size_t len, std::size_t num_chars, std::mt19937& rnd)
+{
+	std::uniform_int_distribution<int> dist(0, int(num_chars) - 1);
+
+	std::string str(len, ' ');
+	for(char& ch : str)
+		ch = char('a' + dist(rnd));
+	return str;
+}
+
+
+/**
+ * suffix array by sorting the suffixes
+ */
+std::vector<std::uint32_t> naive_suffix_array(std::string_view str)
+{
+	std::vector<std::uint32_t> sa(str.size());
+	for(std::size_t idx=0; idx<sa.size(); ++idx)
+		sa[idx] = std::uint32_t(idx);
+
+	std::sort(sa.begin(), sa.end(), [&str](std::uint32_t idx1, std::uint32_t idx2)
+	{
+		return str.substr(idx1) < str.substr(idx2);
+	});
+	return sa;
+}
+
+
+/**
+ * all matches found by std::string::find
+ */
+std::vector<std::size_t> find_all_std(const std::string& str, const std::string& pattern)
+{
+	std::vector<std::size_t> matches;
+	for(std::size_t pos = str.find(pattern); pos != std::string::npos; pos = str.find(pattern, pos + 1))
+		matches.push_back(pos);
+	return matches;
+}
+
+
+/**
+ * length of the longest substring occurring twice by trying all pairs of positions
+ */
+std::size_t naive_longest_repeat(std::string_view str)
+{
+	std::size_t longest = 0;
+	for(std::size_t idx1=0; idx1<str.size(); ++idx1)
+	{
+		for(std::size_t idx2=idx1+1; idx2<str.size(); ++idx2)
+		{
+			std::size_t len = 0;
+			while(idx2 + len < str.size() && str[idx1 + len] == str[idx2 + len])
+				++len;
+			longest = std::max(longest, len);
+		}
+	}
+	return longest;
+}
+
+
+int main()
+{
+	std::mt19937 rnd{1234};
+	std::cout << std::boolalpha;
+
+	// compare with the naive versions
+	{
+		std::vector<std::string> texts{ "", "a", "aaaaaaaa", "banana", "mississippi", "abababababab" };
+		for(std::size_t iter=0; iter<200; ++iter)
+			texts.push_back(random_text(1 + iter*3, 1 + iter%4, rnd));
+		for(std::size_t iter=0; iter<10; ++iter)
+		{
+			std::string text(500, 0);
+			for(char& ch : text)
+				ch = static_cast<char>(rnd());
+			texts.push_back(text);
+		}
+
+		bool ok_sa = true, ok_lcp = true, ok_query = true, ok_repeat = true;
+		for(const std::string& text : texts)
+		{
+			const suffix_index<std::uint32_t> index{text};
+			const std::vector<std::uint32_t> sa_ref = naive_suffix_array(text);
+			ok_sa = ok_sa && std::equal(sa_ref.begin(), sa_ref.end(),
+				index.GetSuffixArray().begin(), index.GetSuffixArray().end());
+
+			for(std::size_t idx=1; idx<text.size(); ++idx)
+			{
+				const std::string_view suffix1 = std::string_view{text}.substr(sa_ref[idx - 1]);
+				const std::string_view suffix2 = std::string_view{text}.substr(sa_ref[idx]);
+				std::size_t common = 0;
+				while(common < suffix1.size() && common < suffix2.size() && suffix1[common] == suffix2[common])
+					++common;
+				ok_lcp = ok_lcp && index.GetLcp()[idx] == common;
+			}
+
+			for(std::size_t len=1; len<6; ++len)
+			{
+				const std::string pattern = text.size() >= len
+					? text.substr(rnd() % (text.size() - len + 1), len) : std::string("ab");
+				const std::vector<std::size_t> ref = find_all_std(text, pattern);
+				ok_query = ok_query && index.Locate(pattern) == ref && index.Count(pattern) == ref.size();
+				ok_query = ok_query && index.Count(pattern + "~") == find_all_std(text, pattern + "~").size();
+			}
+
+			const auto [pos, len] = index.LongestRepeat();
+			ok_repeat = ok_repeat && len == naive_longest_repeat(text)
+				&& (len == 0 || find_all_std(text, text.substr(pos, len)).size() >= 2);
+		}
+
+		std::cout << "suffix array: ok = " << ok_sa << std::endl;
+		std::cout << "lcp array: ok = " << ok_lcp << std::endl;
+		std::cout << "count and locate: ok = " << ok_query << std::endl;
+		std::cout << "longest repeat: ok = " << ok_repeat << std::endl;
+	}
+
+	// serialisation
+	{
+		const std::string text = random_text(100000, 4, rnd);
+		const suffix_index<std::uint32_t> index{text};
+
+		std::ostringstream ostr;
+		bool ok = index.Save(ostr);
+		const std::string buf = ostr.str();
+
+		// the buffer of std::string is suitably aligned for the index type
+		std::optional<suffix_index<std::uint32_t>> loaded = suffix_index<std::uint32_t>::FromBuffer(buf);
+		ok = ok && loaded && loaded->GetText() == text
+			&& std::ranges::equal(loaded->GetSuffixArray(), index.GetSuffixArray())
+			&& std::ranges::equal(loaded->GetLcp(), index.GetLcp())
+			&& loaded->Locate("abcab") == find_all_std(text, "abcab");
+
+		// invalid buffers
+		ok = ok && !suffix_index<std::uint32_t>::FromBuffer(std::string_view{buf}.substr(0, buf.size() - 1));
+		ok = ok && !suffix_index<std::uint64_t>::FromBuffer(buf);
+
+		// text sizes whose offsets overflow
+		for(std::uint64_t text_size : { std::uint64_t(1) << 62, ~std::uint64_t(0) - 3, std::uint64_t(buf.size()) })
+		{
+			std::string corrupt = buf;
+			std::memcpy(corrupt.data() + 8, &text_size, sizeof(text_size));
+			ok = ok && !suffix_index<std::uint32_t>::FromBuffer(corrupt);
+		}
+		std::cout << "serialisation: ok = " << ok << std::endl;
+
+		// memory-mapped file
+		const std::filesystem::path file = std::filesystem::temp_directory_path() / "str_suffix_tst.idx";
+		{
+			std::ofstream ofstr{file, std::ios::binary};
+			index.Save(ofstr);
+		}
+		{
+			boost::iostreams::mapped_file_source mapped{file.string()};
+			std::optional<suffix_index<std::uint32_t>> mapped_index =
+				suffix_index<std::uint32_t>::FromBuffer(std::string_view{mapped.data(), mapped.size()});
+			std::cout << "memory-mapped index: ok = " << (mapped_index
+				&& mapped_index->Locate("dcba") == find_all_std(text, "dcba")) << std::endl;
+		}
+		std::filesystem::remove(file);
+	}
+
+	// texts which are too long for the index type
+	{
+		const std::string text = random_text(std::numeric_limits<std::uint16_t>::max(), 4, rnd);
+		const std::string_view shorter = std::string_view{text}.substr(0, text.size() - 1);
+		bool ok = suffix_array<std::uint16_t>(shorter).size() == shorter.size()
+			&& suffix_index<std::uint16_t>{shorter}.GetSuffixArray().size() == shorter.size();
+
+		bool rejected_sa = false, rejected_index = false;
+		try { suffix_array<std::uint16_t>(text); }
+		catch(const std::length_error&) { rejected_sa = true; }
+		try { suffix_index<std::uint16_t>{text}; }
+		catch(const std::length_error&) { rejected_index = true; }
+
+		// serialised index claiming such a text, padded to the size it would need
+		std::ostringstream ostr;
+		suffix_index<std::uint16_t>{shorter}.Save(ostr);
+		std::string buf = ostr.str() + std::string(4*text.size(), 0);
+		const std::uint64_t text_size = text.size();
+		std::memcpy(buf.data() + 8, &text_size, sizeof(text_size));
+		const bool rejected_buf = !suffix_index<std::uint16_t>::FromBuffer(buf);
+
+		std::cout << "too long texts rejected: ok = "
+			<< (ok && rejected_sa && rejected_index && rejected_buf) << std::endl;
+	}
+
+	// repeated queries on a larger text
+	{
+		const std::size_t len = std::size_t(32) << 20;
+		const std::string text = random_text(len, 26, rnd);
+
+		auto start_build = std::chrono::steady_clock::now();
+		const std::vector<std::uint32_t> sa = suffix_array<std::uint32_t>(text);
+		double time_sa = seconds_since(start_build);
+		const std::vector<std::uint32_t> lcp = lcp_array<std::uint32_t>(text, sa);
+		double time_build = seconds_since(start_build);
+
+		const suffix_index<std::uint32_t> index{text};
+
+		std::vector<std::string> patterns;
+		for(std::size_t i=0; i<100; ++i)
+			patterns.push_back(text.substr(rnd() % (len - 6), 3 + i%4));
+
+		auto start_index = std::chrono::steady_clock::now();
+		std::size_t count_index = 0;
+		for(const std::string& pattern : patterns)
+			count_index += index.Count(pattern);
+		double time_index = seconds_since(start_index);
+
+		auto start_scan = std::chrono::steady_clock::now();
+		std::size_t count_scan = 0;
+		for(const std::string& pattern : patterns)
+			count_scan += find_all_std(text, pattern).size();
+		double time_scan = seconds_since(start_scan);
+
+		std::cout << "\n" << (len >> 20) << " MB text:" << std::endl;
+		std::cout << "\tbuild: suffix array: " << time_sa << " s, with lcp: " << time_build << " s"
+			<< ", ok = " << (std::ranges::equal(sa, index.GetSuffixArray()) && std::ranges::equal(lcp, index.GetLcp())) << std::endl;
+		std::cout << "\t" << patterns.size() << " count queries: index: " << time_index
+			<< " s, std::string::find: " << time_scan << " s, ok = " << (count_index == count_scan) << std::endl;
+	}
+
+	return 0;
+}
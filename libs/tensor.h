@@ -9,21 +9,33 @@
 #define __TENSOR_H__
 
 #include <array>
+#include <vector>
 #include <tuple>
 #include <type_traits>
+#include <concepts>
+#include <algorithm>
+#include <initializer_list>
 #include <iostream>
 
+#include "math_gemm.h"
+
+
+// tile size for the axis permutations
+#ifndef TENSOR_TILE
+	#define TENSOR_TILE 32
+#endif
+
 
 // ----------------------------------------------------------------------------
 // helper functions
 // ----------------------------------------------------------------------------
 /**
- * multiply all function arguments
+ * multiply all function arguments, an empty argument list gives 1
  */
 template<class t_ret, class... t_args>
 constexpr t_ret mult_args(const t_args&&... args)
 {
-	return ( args * ... );
+	return ( args * ... * t_ret(1) );
 }
 
 
@@ -101,16 +113,18 @@ constexpr std::size_t get_idx(const t_tup_dims& dims, const t_tup_sizes& sizes)
 	//	return std::get<0>(dims)*std::get<1>(sizes) + std::get<1>(dims);
 	else if constexpr(N > 1)
 	{
-		// remove first element of the sizes tuple
-		auto sizes_1 = pick_from_tuple<1>(sizes, std::make_index_sequence<N-1>());
-		// add a "1" to the tuple
-		auto sizes_2 = std::tuple_cat(sizes_1, std::make_tuple(1));
-
-		auto sizes_without_first = pick_from_tuple<1>(sizes_2, std::make_index_sequence<N-1>());
+		// remove the first element of the dims and sizes tuples
+		auto sizes_without_first = pick_from_tuple<1>(sizes, std::make_index_sequence<N-1>());
 		auto dims_without_first = pick_from_tuple<1>(dims, std::make_index_sequence<N-1>());
 
+		// the first index jumps over all elements spanned by the remaining sizes
+		std::size_t stride = std::apply([](auto... sizes_rest) -> std::size_t
+		{
+			return ( std::size_t(sizes_rest) * ... );
+		}, sizes_without_first);
+
 		std::size_t idx =
-			std::get<0>(dims) * std::get<0>(sizes_2) +
+			std::get<0>(dims) * stride +
 			get_idx(dims_without_first, sizes_without_first);
 
 		return idx;
@@ -132,6 +146,13 @@ class Tensor
 public:
 	using t_size = std::size_t;
 	using t_cont = std::array<t_scalar, mult_args<t_size>(SIZES...)>;
+	using value_type = t_scalar;
+
+	// number of axes
+	static constexpr t_size order = sizeof...(SIZES);
+
+	// number of elements along each axis
+	static constexpr std::array<t_size, sizeof...(SIZES)> shape{ SIZES... };
 
 
 public:
@@ -202,6 +223,24 @@ public:
 	}
 
 
+	/**
+	 * contiguous, row-major element storage
+	 */
+	constexpr t_scalar* data() noexcept
+	{
+		return m_elems.data();
+	}
+
+
+	/**
+	 * contiguous, row-major element storage
+	 */
+	constexpr const t_scalar* data() const noexcept
+	{
+		return m_elems.data();
+	}
+
+
 	/**
 	 * linear element access
 	 */
@@ -395,4 +434,766 @@ private:
 // ----------------------------------------------------------------------------
 
 
+
+// ----------------------------------------------------------------------------
+// kernels for contiguous, row-major tensors
+// ----------------------------------------------------------------------------
+/**
+ * permutes the axes of a tensor: axis k of dst is axis perm[k] of src
+ * the innermost axes of src and dst are traversed in tiles, so that both
+ * the reads and the writes stay within a few cache lines
+ */
+template<class t_scalar>
+void tensor_permute(const t_scalar* src, t_scalar* dst,
+	const std::size_t* src_sizes, const std::size_t* perm, std::size_t order)
+{
+	using t_size = std::size_t;
+	constexpr t_size TILE = TENSOR_TILE;
+
+	if(order == 0)
+	{
+		dst[0] = src[0];
+		return;
+	}
+
+	// strides of the source tensor
+	std::vector<t_size> src_strides(order);
+	t_size total = 1;
+	for(t_size axis=order; axis>0; --axis)
+	{
+		src_strides[axis-1] = total;
+		total *= src_sizes[axis-1];
+	}
+	if(total == 0)
+		return;
+
+	// sizes and strides along the axes of the destination tensor
+	std::vector<t_size> sizes(order), dst_strides(order), strides(order);
+	t_size dst_stride = 1;
+	for(t_size axis=order; axis>0; --axis)
+	{
+		sizes[axis-1] = src_sizes[perm[axis-1]];
+		strides[axis-1] = src_strides[perm[axis-1]];
+		dst_strides[axis-1] = dst_stride;
+		dst_stride *= sizes[axis-1];
+	}
+
+	// axis that is contiguous in the destination and the one that is contiguous in the source
+	const t_size axis_dst = order - 1;
+	t_size axis_src = 0;
+	for(t_size axis=0; axis<order; ++axis)
+	{
+		if(perm[axis] == order - 1)
+			axis_src = axis;
+	}
+
+	// the remaining axes are iterated by an odometer
+	std::vector<t_size> outer_axes;
+	outer_axes.reserve(order);
+	for(t_size axis=0; axis<order; ++axis)
+	{
+		if(axis != axis_dst && axis != axis_src)
+			outer_axes.push_back(axis);
+	}
+	std::vector<t_size> idx(outer_axes.size(), 0);
+	t_size offs_src = 0, offs_dst = 0;
+
+	while(true)
+	{
+		if(axis_dst == axis_src)
+		{
+			// both innermost axes agree: copy the whole row
+			std::copy_n(src + offs_src, sizes[axis_dst], dst + offs_dst);
+		}
+		else
+		{
+			// tiled two-dimensional transposition
+			const t_size n_dst = sizes[axis_dst], n_src = sizes[axis_src];
+			const t_size stride_dst = strides[axis_dst];
+			const t_size stride_src = dst_strides[axis_src];
+
+			for(t_size tile_src=0; tile_src<n_src; tile_src+=TILE)
+			{
+				const t_size end_src = std::min(tile_src + TILE, n_src);
+
+				for(t_size tile_dst=0; tile_dst<n_dst; tile_dst+=TILE)
+				{
+					const t_size end_dst = std::min(tile_dst + TILE, n_dst);
+
+					for(t_size i=tile_src; i<end_src; ++i)
+						for(t_size j=tile_dst; j<end_dst; ++j)
+							dst[offs_dst + i*stride_src + j] = src[offs_src + j*stride_dst + i];
+				}
+			}
+		}
+
+		// next index of the outer axes
+		t_size k = outer_axes.size();
+		for(; k>0; --k)
+		{
+			const t_size axis = outer_axes[k-1];
+			++idx[k-1];
+			offs_src += strides[axis];
+			offs_dst += dst_strides[axis];
+			if(idx[k-1] < sizes[axis])
+				break;
+
+			offs_src -= idx[k-1] * strides[axis];
+			offs_dst -= idx[k-1] * dst_strides[axis];
+			idx[k-1] = 0;
+		}
+
+		if(k == 0)
+			break;
+	}
+}
+
+
+/**
+ * contracts axis axis_A of tensor A with axis axis_B of tensor B
+ * the result C has the remaining axes of A followed by the remaining axes of B
+ *
+ * the contraction is a matrix product of A reshaped to M x K and B reshaped to K x N,
+ * it is therefore calculated by the blocked gemm kernel; if the contracted axes are not
+ * already the last one of A and the first one of B, they are moved there by a permutation
+ */
+template<class t_scalar>
+void tensor_contract(
+	const t_scalar* A, const std::size_t* sizes_A, std::size_t order_A, std::size_t axis_A,
+	const t_scalar* B, const std::size_t* sizes_B, std::size_t order_B, std::size_t axis_B,
+	t_scalar* C)
+{
+	using t_size = std::size_t;
+
+	const t_size K = sizes_A[axis_A];
+	t_size M = 1, N = 1;
+	for(t_size axis=0; axis<order_A; ++axis)
+	{
+		if(axis != axis_A)
+			M *= sizes_A[axis];
+	}
+	for(t_size axis=0; axis<order_B; ++axis)
+	{
+		if(axis != axis_B)
+			N *= sizes_B[axis];
+	}
+
+	// move the contracted axis of A to the end
+	std::vector<t_scalar> A_perm;
+	if(axis_A != order_A - 1)
+	{
+		std::vector<t_size> perm;
+		perm.reserve(order_A);
+		for(t_size axis=0; axis<order_A; ++axis)
+		{
+			if(axis != axis_A)
+				perm.push_back(axis);
+		}
+		perm.push_back(axis_A);
+
+		A_perm.resize(M*K);
+		tensor_permute<t_scalar>(A, A_perm.data(), sizes_A, perm.data(), order_A);
+		A = A_perm.data();
+	}
+
+	// move the contracted axis of B to the front
+	std::vector<t_scalar> B_perm;
+	if(axis_B != 0)
+	{
+		std::vector<t_size> perm;
+		perm.reserve(order_B);
+		perm.push_back(axis_B);
+		for(t_size axis=0; axis<order_B; ++axis)
+		{
+			if(axis != axis_B)
+				perm.push_back(axis);
+		}
+
+		B_perm.resize(K*N);
+		tensor_permute<t_scalar>(B, B_perm.data(), sizes_B, perm.data(), order_B);
+		B = B_perm.data();
+	}
+
+	std::fill_n(C, M*N, t_scalar{});
+	m::gemm<t_scalar>(A, B, C, M, N, K);
+}
+
+
+/**
+ * outer product C = A (x) B of tensors with num_A and num_B elements
+ */
+template<class t_scalar>
+void tensor_outer(const t_scalar* A, std::size_t num_A,
+	const t_scalar* B, std::size_t num_B, t_scalar* C)
+{
+	for(std::size_t i=0; i<num_A; ++i)
+	{
+		const t_scalar a = A[i];
+		t_scalar* row = C + i*num_B;
+
+		for(std::size_t j=0; j<num_B; ++j)
+			row[j] = a * B[j];
+	}
+}
+// ----------------------------------------------------------------------------
+
+
+
+// ----------------------------------------------------------------------------
+// compile-time shapes
+// ----------------------------------------------------------------------------
+/**
+ * remove an axis from a shape
+ */
+template<std::size_t N>
+constexpr std::array<std::size_t, N-1> shape_remove_axis(
+	const std::array<std::size_t, N>& shape, std::size_t axis)
+{
+	std::array<std::size_t, N-1> shape_new{};
+
+	for(std::size_t i=0, j=0; i<N; ++i)
+	{
+		if(i != axis)
+			shape_new[j++] = shape[i];
+	}
+
+	return shape_new;
+}
+
+
+/**
+ * concatenate two shapes
+ */
+template<std::size_t N1, std::size_t N2>
+constexpr std::array<std::size_t, N1+N2> shape_concat(
+	const std::array<std::size_t, N1>& shape1, const std::array<std::size_t, N2>& shape2)
+{
+	std::array<std::size_t, N1+N2> shape_new{};
+
+	for(std::size_t i=0; i<N1; ++i)
+		shape_new[i] = shape1[i];
+	for(std::size_t i=0; i<N2; ++i)
+		shape_new[N1 + i] = shape2[i];
+
+	return shape_new;
+}
+
+
+/**
+ * permute the axes of a shape
+ */
+template<std::size_t N>
+constexpr std::array<std::size_t, N> shape_permute(
+	const std::array<std::size_t, N>& shape, const std::array<std::size_t, N>& perm)
+{
+	std::array<std::size_t, N> shape_new{};
+
+	for(std::size_t i=0; i<N; ++i)
+		shape_new[i] = shape[perm[i]];
+
+	return shape_new;
+}
+
+
+/**
+ * does the index array contain every axis exactly once?
+ */
+template<std::size_t N>
+constexpr bool is_axis_permutation(const std::array<std::size_t, N>& perm)
+{
+	std::array<bool, N> seen{};
+
+	for(std::size_t i=0; i<N; ++i)
+	{
+		if(perm[i] >= N || seen[perm[i]])
+			return false;
+		seen[perm[i]] = true;
+	}
+
+	return true;
+}
+
+
+template<class t_scalar, auto shape, std::size_t ...idx>
+Tensor<t_scalar, shape[idx]...> tensor_from_shape(const std::index_sequence<idx...>&);
+
+
+/**
+ * tensor type with the given shape array
+ */
+template<class t_scalar, auto shape>
+using tensor_of_shape = decltype(tensor_from_shape<t_scalar, shape>(
+	std::make_index_sequence<shape.size()>()));
+// ----------------------------------------------------------------------------
+
+
+
+// ----------------------------------------------------------------------------
+// operations on tensors with static size
+// ----------------------------------------------------------------------------
+/**
+ * contraction of axis I of A with axis J of B
+ * the result has the remaining axes of A followed by the remaining axes of B
+ */
+template<std::size_t I, std::size_t J, class t_scalar, std::size_t ...SIZES_A, std::size_t ...SIZES_B>
+auto contract(const Tensor<t_scalar, SIZES_A...>& A, const Tensor<t_scalar, SIZES_B...>& B)
+{
+	using t_A = Tensor<t_scalar, SIZES_A...>;
+	using t_B = Tensor<t_scalar, SIZES_B...>;
+
+	static_assert(I < t_A::order, "Invalid axis of the first tensor.");
+	static_assert(J < t_B::order, "Invalid axis of the second tensor.");
+	static_assert(t_A::shape[I] == t_B::shape[J], "Contracted axes have different sizes.");
+
+	constexpr auto shape = shape_concat(
+		shape_remove_axis(t_A::shape, I),
+		shape_remove_axis(t_B::shape, J));
+	tensor_of_shape<t_scalar, shape> C;
+
+	tensor_contract<t_scalar>(
+		A.data(), t_A::shape.data(), t_A::order, I,
+		B.data(), t_B::shape.data(), t_B::order, J,
+		C.data());
+
+	return C;
+}
+
+
+/**
+ * outer product
+ */
+template<class t_scalar, std::size_t ...SIZES_A, std::size_t ...SIZES_B>
+Tensor<t_scalar, SIZES_A..., SIZES_B...> outer(
+	const Tensor<t_scalar, SIZES_A...>& A, const Tensor<t_scalar, SIZES_B...>& B)
+{
+	Tensor<t_scalar, SIZES_A..., SIZES_B...> C(false);
+	tensor_outer<t_scalar>(A.data(), A.size(), B.data(), B.size(), C.data());
+	return C;
+}
+
+
+/**
+ * axis permutation, axis k of the result is axis PERM[k] of the argument
+ */
+template<std::size_t ...PERM, class t_scalar, std::size_t ...SIZES>
+auto permute(const Tensor<t_scalar, SIZES...>& t)
+{
+	using t_tensor = Tensor<t_scalar, SIZES...>;
+	constexpr std::array<std::size_t, sizeof...(PERM)> perm{ PERM... };
+
+	static_assert(sizeof...(PERM) == t_tensor::order, "Wrong number of axes.");
+	static_assert(is_axis_permutation(perm), "Invalid axis permutation.");
+
+	constexpr auto shape = shape_permute(t_tensor::shape, perm);
+	tensor_of_shape<t_scalar, shape> t_perm(false);
+
+	tensor_permute<t_scalar>(t.data(), t_perm.data(), t_tensor::shape.data(), perm.data(), t_tensor::order);
+	return t_perm;
+}
+// ----------------------------------------------------------------------------
+
+
+
+// ----------------------------------------------------------------------------
+/**
+ * tensor with dynamic size, for shapes that are only known at runtime
+ */
+template<class t_scalar>
+class DynTensor
+{
+public:
+	using t_size = std::size_t;
+	using t_cont = std::vector<t_scalar>;
+	using value_type = t_scalar;
+
+
+public:
+	/**
+	 * tensor of order 0, i.e. a scalar
+	 */
+	DynTensor() : DynTensor(std::vector<t_size>{})
+	{}
+
+
+	/**
+	 * zero tensor with the given shape
+	 */
+	explicit DynTensor(const std::vector<t_size>& shape)
+		: m_shape{shape}, m_strides(shape.size()), m_elems{}
+	{
+		t_size total = 1;
+		for(t_size axis=shape.size(); axis>0; --axis)
+		{
+			m_strides[axis-1] = total;
+			total *= shape[axis-1];
+		}
+
+		m_elems.resize(total);
+	}
+
+
+	/**
+	 * zero tensor with the given shape
+	 */
+	explicit DynTensor(std::initializer_list<t_size> shape)
+		: DynTensor(std::vector<t_size>(shape))
+	{}
+
+
+	/**
+	 * copy a tensor with static size
+	 */
+	template<t_size ...SIZES>
+	explicit DynTensor(const Tensor<t_scalar, SIZES...>& t)
+		: DynTensor(std::vector<t_size>{ SIZES... })
+	{
+		std::copy_n(t.data(), t.size(), m_elems.data());
+	}
+
+
+	DynTensor(const DynTensor<t_scalar>& other) = default;
+	DynTensor(DynTensor<t_scalar>&& other) noexcept = default;
+	DynTensor<t_scalar>& operator=(const DynTensor<t_scalar>& other) = default;
+	DynTensor<t_scalar>& operator=(DynTensor<t_scalar>&& other) noexcept = default;
+	~DynTensor() = default;
+
+
+	/**
+	 * get the total number of elements
+	 */
+	t_size size() const noexcept
+	{
+		return m_elems.size();
+	}
+
+
+	/**
+	 * get the number of elements along the given axis
+	 */
+	t_size size(t_size axis) const
+	{
+		return m_shape[axis];
+	}
+
+
+	/**
+	 * get the number of axes
+	 */
+	t_size order() const noexcept
+	{
+		return m_shape.size();
+	}
+
+
+	/**
+	 * get the number of elements along all axes
+	 */
+	const std::vector<t_size>& shape() const noexcept
+	{
+		return m_shape;
+	}
+
+
+	/**
+	 * contiguous, row-major element storage
+	 */
+	t_scalar* data() noexcept
+	{
+		return m_elems.data();
+	}
+
+
+	/**
+	 * contiguous, row-major element storage
+	 */
+	const t_scalar* data() const noexcept
+	{
+		return m_elems.data();
+	}
+
+
+	/**
+	 * linear element access
+	 */
+	t_scalar& operator[](t_size i)
+	{
+		return m_elems[i];
+	}
+
+
+	/**
+	 * linear element access
+	 */
+	const t_scalar& operator[](t_size i) const
+	{
+		return m_elems[i];
+	}
+
+
+	/**
+	 * element access
+	 */
+	template<std::integral ...t_dims>
+	t_scalar& operator()(t_dims... dims)
+	{
+		return m_elems[get_idx(dims...)];
+	}
+
+
+	/**
+	 * element access
+	 */
+	template<std::integral ...t_dims>
+	const t_scalar& operator()(t_dims... dims) const
+	{
+		return m_elems[get_idx(dims...)];
+	}
+
+
+	/**
+	 * do the shapes of both tensors agree?
+	 */
+	bool same_shape(const DynTensor<t_scalar>& t) const
+	{
+		return m_shape == t.m_shape;
+	}
+
+
+
+	// ------------------------------------------------------------------------
+	// operators
+
+	/**
+	 * unary +
+	 */
+	friend const DynTensor<t_scalar>& operator+(const DynTensor<t_scalar>& t)
+	{
+		return t;
+	}
+
+
+	/**
+	 * unary -
+	 */
+	friend DynTensor<t_scalar> operator-(const DynTensor<t_scalar>& t)
+	{
+		DynTensor<t_scalar> t2 = t;
+		for(t_size i=0; i<t2.size(); ++i)
+			t2[i] = -t2[i];
+
+		return t2;
+	}
+
+
+	/**
+	 * binary +
+	 */
+	friend DynTensor<t_scalar> operator+(const DynTensor<t_scalar>& t1, const DynTensor<t_scalar>& t2)
+	{
+		DynTensor<t_scalar> tret = t1;
+		tret += t2;
+		return tret;
+	}
+
+
+	/**
+	 * binary -
+	 */
+	friend DynTensor<t_scalar> operator-(const DynTensor<t_scalar>& t1, const DynTensor<t_scalar>& t2)
+	{
+		DynTensor<t_scalar> tret = t1;
+		tret -= t2;
+		return tret;
+	}
+
+
+	/**
+	 * scalar multiplication
+	 */
+	friend DynTensor<t_scalar> operator*(const DynTensor<t_scalar>& t1, const t_scalar& s)
+	{
+		DynTensor<t_scalar> tret = t1;
+		tret *= s;
+		return tret;
+	}
+
+
+	/**
+	 * scalar multiplication
+	 */
+	friend DynTensor<t_scalar> operator*(const t_scalar& s, const DynTensor<t_scalar>& t1)
+	{
+		return operator*(t1, s);
+	}
+
+
+	/**
+	 * scalar division
+	 */
+	friend DynTensor<t_scalar> operator/(const DynTensor<t_scalar>& t1, const t_scalar& s)
+	{
+		return operator*(t1, t_scalar(1)/s);
+	}
+
+
+	/**
+	 * addition, the shapes have to agree
+	 */
+	DynTensor<t_scalar>& operator+=(const DynTensor<t_scalar>& t)
+	{
+		for(t_size i=0; i<size(); ++i)
+			m_elems[i] += t[i];
+
+		return *this;
+	}
+
+
+	/**
+	 * subtraction, the shapes have to agree
+	 */
+	DynTensor<t_scalar>& operator-=(const DynTensor<t_scalar>& t)
+	{
+		for(t_size i=0; i<size(); ++i)
+			m_elems[i] -= t[i];
+
+		return *this;
+	}
+
+
+	/**
+	 * scalar multiplication
+	 */
+	DynTensor<t_scalar>& operator*=(const t_scalar& s)
+	{
+		for(t_size i=0; i<size(); ++i)
+			m_elems[i] *= s;
+
+		return *this;
+	}
+
+
+	/**
+	 * scalar division
+	 */
+	DynTensor<t_scalar>& operator/=(const t_scalar& s)
+	{
+		return operator*=(t_scalar(1)/s);
+	}
+	// ------------------------------------------------------------------------
+
+
+protected:
+	/**
+	 * get the linear index of the given element
+	 */
+	template<class ...t_dims>
+	t_size get_idx(t_dims... dims) const
+	{
+		const std::array<t_size, sizeof...(t_dims)> idx{ t_size(dims)... };
+
+		t_size lin_idx = 0;
+		for(t_size axis=0; axis<idx.size(); ++axis)
+			lin_idx += idx[axis] * m_strides[axis];
+
+		return lin_idx;
+	}
+
+
+private:
+	// number of elements along each axis
+	std::vector<t_size> m_shape{};
+
+	// linear index distance between neighbouring elements along each axis
+	std::vector<t_size> m_strides{};
+
+	// tensor elements
+	t_cont m_elems{};
+};
+// ----------------------------------------------------------------------------
+
+
+
+// ----------------------------------------------------------------------------
+// operations on tensors with dynamic size
+// ----------------------------------------------------------------------------
+/**
+ * contraction of axis axis_A of A with axis axis_B of B
+ * the result has the remaining axes of A followed by the remaining axes of B
+ * returns false if the axes are invalid or have different sizes
+ */
+template<class t_scalar>
+std::tuple<DynTensor<t_scalar>, bool> contract(
+	const DynTensor<t_scalar>& A, const DynTensor<t_scalar>& B,
+	std::size_t axis_A, std::size_t axis_B)
+{
+	if(axis_A >= A.order() || axis_B >= B.order() || A.size(axis_A) != B.size(axis_B))
+		return std::make_tuple(DynTensor<t_scalar>{}, false);
+
+	std::vector<std::size_t> shape;
+	shape.reserve(A.order() + B.order() - 2);
+	for(std::size_t axis=0; axis<A.order(); ++axis)
+	{
+		if(axis != axis_A)
+			shape.push_back(A.size(axis));
+	}
+	for(std::size_t axis=0; axis<B.order(); ++axis)
+	{
+		if(axis != axis_B)
+			shape.push_back(B.size(axis));
+	}
+
+	DynTensor<t_scalar> C(shape);
+	tensor_contract<t_scalar>(
+		A.data(), A.shape().data(), A.order(), axis_A,
+		B.data(), B.shape().data(), B.order(), axis_B,
+		C.data());
+
+	return std::make_tuple(std::move(C), true);
+}
+
+
+/**
+ * outer product
+ */
+template<class t_scalar>
+DynTensor<t_scalar> outer(const DynTensor<t_scalar>& A, const DynTensor<t_scalar>& B)
+{
+	std::vector<std::size_t> shape = A.shape();
+	shape.insert(shape.end(), B.shape().begin(), B.shape().end());
+
+	DynTensor<t_scalar> C(shape);
+	tensor_outer<t_scalar>(A.data(), A.size(), B.data(), B.size(), C.data());
+	return C;
+}
+
+
+/**
+ * axis permutation, axis k of the result is axis perm[k] of the argument
+ * returns false if perm is not a permutation of the tensor's axes
+ */
+template<class t_scalar>
+std::tuple<DynTensor<t_scalar>, bool> permute(
+	const DynTensor<t_scalar>& t, const std::vector<std::size_t>& perm)
+{
+	if(perm.size() != t.order())
+		return std::make_tuple(DynTensor<t_scalar>{}, false);
+
+	std::vector<bool> seen(perm.size(), false);
+	std::vector<std::size_t> shape(perm.size());
+	for(std::size_t axis=0; axis<perm.size(); ++axis)
+	{
+		if(perm[axis] >= perm.size() || seen[perm[axis]])
+			return std::make_tuple(DynTensor<t_scalar>{}, false);
+
+		seen[perm[axis]] = true;
+		shape[axis] = t.size(perm[axis]);
+	}
+
+	DynTensor<t_scalar> t_perm(shape);
+	tensor_permute<t_scalar>(t.data(), t_perm.data(), t.shape().data(), perm.data(), t.order());
+	return std::make_tuple(std::move(t_perm), true);
+}
+// ----------------------------------------------------------------------------
+
+
 #endif
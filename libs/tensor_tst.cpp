@@ -4,17 +4,207 @@
  * @date November 2021
  * @license: see 'LICENSE.EUPL' file
  *
- * g++ -std=c++20 -Wall -Wextra -Weffc++ -o tensor_tst tensor_tst.cpp
+ * g++ -std=c++20 -Wall -Wextra -Weffc++ -O2 -o tensor_tst tensor_tst.cpp -lpthread
  */
 
 #include "tensor.h"
 
 #include <iostream>
+#include <random>
+#include <chrono>
+#include <cmath>
 
 
 using t_real = double;
 
 
+/**
+ * fill a tensor with random values
+ */
+template<class t_tensor>
+void randomise(t_tensor& t, std::mt19937& rnd)
+{
+	std::uniform_real_distribution<t_real> dist(-1., 1.);
+	for(std::size_t i=0; i<t.size(); ++i)
+		t[i] = dist(rnd);
+}
+
+
+/**
+ * maximum deviation between two tensors
+ */
+template<class t_tensor1, class t_tensor2>
+t_real max_deviation(const t_tensor1& t1, const t_tensor2& t2)
+{
+	if(t1.size() != t2.size())
+		return t_real(1e10);
+
+	t_real dev = 0;
+	for(std::size_t i=0; i<t1.size(); ++i)
+		dev = std::max(dev, std::abs(t1[i] - t2[i]));
+	return dev;
+}
+
+
+/**
+ * contractions, outer products and permutations of tensors with static size
+ */
+void check_static(std::mt19937& rnd)
+{
+	Tensor<t_real, 3,4,5> A{};
+	Tensor<t_real, 5,2> B{};
+	Tensor<t_real, 4,6> C{};
+	randomise(A, rnd);
+	randomise(B, rnd);
+	randomise(C, rnd);
+
+	// gemm-shaped contraction: last axis of A with first axis of B
+	{
+		auto AB = contract<2, 0>(A, B);
+		Tensor<t_real, 3,4,2> AB_ref{};
+		for(std::size_t i=0; i<3; ++i)
+			for(std::size_t j=0; j<4; ++j)
+				for(std::size_t l=0; l<2; ++l)
+					for(std::size_t k=0; k<5; ++k)
+						AB_ref[(i*4 + j)*2 + l] += A[(i*4 + j)*5 + k] * B[k*2 + l];
+
+		std::cout << "contract<2, 0>: ok = " << (max_deviation(AB, AB_ref) < 1e-12) << std::endl;
+	}
+
+	// contraction of inner axes that need a permutation
+	{
+		auto AC = contract<1, 0>(A, C);
+		Tensor<t_real, 3,5,6> AC_ref{};
+		for(std::size_t i=0; i<3; ++i)
+			for(std::size_t k=0; k<5; ++k)
+				for(std::size_t l=0; l<6; ++l)
+					for(std::size_t j=0; j<4; ++j)
+						AC_ref[(i*5 + k)*6 + l] += A[(i*4 + j)*5 + k] * C[j*6 + l];
+
+		auto BA = contract<0, 2>(B, A);
+		Tensor<t_real, 2,3,4> BA_ref{};
+		for(std::size_t l=0; l<2; ++l)
+			for(std::size_t i=0; i<3; ++i)
+				for(std::size_t j=0; j<4; ++j)
+					for(std::size_t k=0; k<5; ++k)
+						BA_ref[(l*3 + i)*4 + j] += B[k*2 + l] * A[(i*4 + j)*5 + k];
+
+		std::cout << "contract<1, 0>: ok = " << (max_deviation(AC, AC_ref) < 1e-12) << std::endl;
+		std::cout << "contract<0, 2>: ok = " << (max_deviation(BA, BA_ref) < 1e-12) << std::endl;
+	}
+
+	// full contraction of two vectors gives a tensor of order 0
+	{
+		Tensor<t_real, 5> v1{}, v2{};
+		randomise(v1, rnd);
+		randomise(v2, rnd);
+
+		auto s = contract<0, 0>(v1, v2);
+		t_real s_ref = 0;
+		for(std::size_t i=0; i<5; ++i)
+			s_ref += v1[i] * v2[i];
+
+		std::cout << "scalar product: ok = " << (s.order == 0 && std::abs(s[0] - s_ref) < 1e-12) << std::endl;
+	}
+
+	// outer product
+	{
+		auto BC = outer(B, C);
+		bool ok = BC.order == 4 && BC.size<3>() == 6;
+		for(std::size_t i=0; i<B.size(); ++i)
+			for(std::size_t j=0; j<C.size(); ++j)
+				ok = ok && BC[i*C.size() + j] == B[i]*C[j];
+
+		std::cout << "outer: ok = " << ok << std::endl;
+	}
+
+	// axis permutations
+	{
+		auto A_perm = permute<2, 0, 1>(A);
+		bool ok = A_perm.size<0>() == 5 && A_perm.size<1>() == 3 && A_perm.size<2>() == 4;
+		for(std::size_t i=0; i<3; ++i)
+			for(std::size_t j=0; j<4; ++j)
+				for(std::size_t k=0; k<5; ++k)
+					ok = ok && A_perm[(k*3 + i)*4 + j] == A[(i*4 + j)*5 + k];
+
+		auto A_same = permute<1, 2, 0>(A_perm);
+		auto A_rows = permute<1, 0, 2>(A);
+		auto A_back = permute<1, 0, 2>(A_rows);
+
+		std::cout << "permute: ok = " << (ok && max_deviation(A, A_same) == 0.
+			&& max_deviation(A, A_back) == 0.) << std::endl;
+	}
+}
+
+
+/**
+ * contractions, outer products and permutations of tensors with dynamic size
+ */
+void check_dynamic(std::mt19937& rnd)
+{
+	Tensor<t_real, 3,4,5> A_static{};
+	Tensor<t_real, 4,6> C_static{};
+	randomise(A_static, rnd);
+	randomise(C_static, rnd);
+
+	DynTensor<t_real> A(A_static), C(C_static);
+
+	auto [AC, ok_AC] = contract(A, C, 1, 0);
+	auto AC_static = contract<1, 0>(A_static, C_static);
+	auto [A_perm, ok_perm] = permute(A, { 2, 0, 1 });
+	auto A_perm_static = permute<2, 0, 1>(A_static);
+	auto AC_outer = outer(A, C);
+	auto AC_outer_static = outer(A_static, C_static);
+
+	auto [A_inv1, ok_inv1] = contract(A, C, 2, 0);
+	auto [A_inv2, ok_inv2] = permute(A, { 0, 0, 1 });
+
+	std::cout << "dynamic contract: ok = " << (ok_AC && AC.shape() == std::vector<std::size_t>{ 3, 5, 6 }
+		&& max_deviation(AC, AC_static) < 1e-12) << std::endl;
+	std::cout << "dynamic permute: ok = " << (ok_perm && A_perm(4, 2, 3) == A_static(2, 3, 4)
+		&& max_deviation(A_perm, A_perm_static) == 0.) << std::endl;
+	std::cout << "dynamic outer: ok = " << (AC_outer.order() == 5
+		&& max_deviation(AC_outer, AC_outer_static) == 0.) << std::endl;
+	std::cout << "dynamic invalid arguments: ok = " << (!ok_inv1 && !ok_inv2) << std::endl;
+}
+
+
+/**
+ * compares the contraction with a direct loop over all indices
+ */
+void benchmark(std::mt19937& rnd)
+{
+	const std::size_t n = 48;
+	DynTensor<t_real> A{ n, n, n }, B{ n, n, n };
+	randomise(A, rnd);
+	randomise(B, rnd);
+
+	// contract the middle axes: C_iklm = sum_j A_ijk B_ljm
+	auto start_loop = std::chrono::steady_clock::now();
+	DynTensor<t_real> C_loop{ n, n, n, n };
+	for(std::size_t i=0; i<n; ++i)
+		for(std::size_t k=0; k<n; ++k)
+			for(std::size_t l=0; l<n; ++l)
+				for(std::size_t m=0; m<n; ++m)
+				{
+					t_real sum = 0;
+					for(std::size_t j=0; j<n; ++j)
+						sum += A(i, j, k) * B(l, j, m);
+					C_loop(i, k, l, m) = sum;
+				}
+	auto stop_loop = std::chrono::steady_clock::now();
+
+	auto start_contract = std::chrono::steady_clock::now();
+	auto [C, ok] = contract(A, B, 1, 1);
+	auto stop_contract = std::chrono::steady_clock::now();
+
+	std::cout << "contraction of " << n << "^3 tensors: loop: "
+		<< std::chrono::duration<double>(stop_loop - start_loop).count() << " s, contract: "
+		<< std::chrono::duration<double>(stop_contract - start_contract).count() << " s, ok = "
+		<< (ok && max_deviation(C, C_loop) < 1e-10) << std::endl;
+}
+
+
 int main()
 {
 	Tensor<t_real, 2,3> t1{}, t2{};
@@ -34,5 +224,11 @@ int main()
 		std::cout << t1[i] << " ";
 	std::cout << std::endl;
 
+	std::mt19937 rnd{1234};
+	std::cout << std::boolalpha;
+	check_static(rnd);
+	check_dynamic(rnd);
+	benchmark(rnd);
+
 	return 0;
 }
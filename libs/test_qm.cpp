@@ -4,15 +4,18 @@
  * @date jun-2021
  * @license: see 'LICENSE.EUPL' file
  *
- * g++ -std=c++20 -Wall -Wextra -Weffc++ -o test_qm test_qm.cpp
+ * g++ -std=c++20 -Wall -Wextra -Weffc++ -o test_qm test_qm.cpp -lpthread
  */
 
 #include <vector>
 #include <iostream>
 #include <fstream>
+#include <random>
+#include <chrono>
 
 #include "math_algos.h"
 #include "math_conts.h"
+#include "math_qsim.h"
 
 using namespace m;
 using namespace m_ops;
@@ -126,6 +129,147 @@ static bool check_grover(std::size_t n, std::size_t num_steps, std::size_t idx_t
 }
 
 
+/**
+ * compare the in-place gate application with the full circuit operators
+ */
+template<class t_mat, class t_vec>
+requires is_mat<t_mat> && is_vec<t_vec>
+static bool check_statevec()
+{
+	const t_mat I = unit<t_mat>(2);
+	const t_mat& H = hadamard<t_mat>();
+	const t_mat& S = phasegate<t_mat>();
+	const t_mat Y = su2_matrix<t_mat>(1);
+	const t_mat& C = cnot<t_mat>();
+	const t_mat U = cunitary<t_mat>(Y);
+
+	// random three-qubit state
+	std::mt19937 rnd{1234};
+	std::uniform_real_distribution<double> dist(-1., 1.);
+	t_vec state = create<t_vec>(8);
+	for(std::size_t i=0; i<state.size(); ++i)
+		state[i] = typename t_vec::value_type(dist(rnd), dist(rnd));
+	state /= norm<t_vec>(state);
+
+	// circuit operators
+	t_mat op1 = outer<t_mat>(outer<t_mat>(I, H), I);
+	t_mat op2 = outer<t_mat>(outer<t_mat>(I, I), S);
+	t_mat op3 = outer<t_mat>(C, I);
+	t_mat op4 = outer<t_mat>(I, U);
+	t_vec state_op = op4 * (op3 * (op2 * (op1 * state)));
+
+	// in-place gates
+	t_vec state_inplace = state;
+	apply_gate<t_vec, t_mat>(state_inplace, H, 1);
+	apply_gate<t_vec, t_mat>(state_inplace, S, 2);
+	apply_gate2<t_vec, t_mat>(state_inplace, C, 0, 1);
+	apply_gate2<t_vec, t_mat>(state_inplace, U, 1, 2);
+
+	bool ok = equals<t_vec>(state_op, state_inplace, 1e-6);
+	std::cout << "in-place gates = circuit operators: " << ok << std::endl;
+
+	// controlled gate with control bit 2 and target bit 0
+	t_vec state_ctrl = state;
+	apply_controlled_gate<t_vec, t_mat>(state_ctrl, su2_matrix<t_mat>(0), 2, 0);
+	t_vec state_swap = state;
+	apply_gate2<t_vec, t_mat>(state_swap, cnot<t_mat>(true), 0, 2);
+	bool ok_ctrl = equals<t_vec>(state_ctrl, state_swap, 1e-6);
+	std::cout << "controlled not = flipped cnot: " << ok_ctrl << std::endl;
+
+	// gates acting twice on the same qubit are rejected and leave the state unchanged
+	t_vec state_same = state;
+	bool rejected_gate2 = false, rejected_ctrl = false;
+	try { apply_gate2<t_vec, t_mat>(state_same, C, 1, 1); }
+	catch(const std::invalid_argument&) { rejected_gate2 = true; }
+	try { apply_controlled_gate<t_vec, t_mat>(state_same, su2_matrix<t_mat>(0), 2, 2); }
+	catch(const std::invalid_argument&) { rejected_ctrl = true; }
+	bool ok_same = rejected_gate2 && rejected_ctrl && equals<t_vec>(state_same, state, 1e-6);
+	std::cout << "same qubits rejected: " << ok_same << std::endl;
+
+	// gates acting on non-existing qubits are rejected
+	t_vec state_range = state;
+	bool rejected_range1 = false, rejected_range2 = false, rejected_prob = false;
+	try { apply_gate<t_vec, t_mat>(state_range, hadamard<t_mat>(), 3); }
+	catch(const std::out_of_range&) { rejected_range1 = true; }
+	try { apply_gate2<t_vec, t_mat>(state_range, C, 0, 7); }
+	catch(const std::out_of_range&) { rejected_range2 = true; }
+	try { measure_prob<t_vec>(state_range, 64); }
+	catch(const std::out_of_range&) { rejected_prob = true; }
+	bool ok_range = rejected_range1 && rejected_range2 && rejected_prob
+		&& equals<t_vec>(state_range, state, 1e-6);
+	std::cout << "non-existing qubits rejected: " << ok_range << std::endl;
+
+	// projections onto the first qubit
+	t_vec state_up = state, state_down = state;
+	auto prob_up = project<t_vec>(state_up, 0, true);
+	auto prob_down = project<t_vec>(state_down, 0, false);
+	bool ok_proj = equals<double>(prob_up + prob_down, 1., 1e-6) &&
+		equals<double>(prob_up, measure_prob<t_vec>(state, 0), 1e-6) &&
+		equals<double>(measure_prob<t_vec>(state_up, 0), 1., 1e-6) &&
+		equals<double>(measure_prob<t_vec>(state_down, 0), 0., 1e-6);
+	std::cout << "P(up) = " << prob_up << ", P(down) = " << prob_down << ", ok = " << ok_proj << std::endl;
+
+	// measuring a bell state gives the same result for both qubits
+	bool ok_bell = true;
+	for(std::size_t i=0; i<16; ++i)
+	{
+		t_vec bell = qsim_basis_state<t_vec>(2);
+		apply_gate<t_vec, t_mat>(bell, H, 0);
+		apply_gate2<t_vec, t_mat>(bell, C, 0, 1);
+
+		bool bit0 = measure<t_vec>(bell, 0, rnd);
+		bool bit1 = measure<t_vec>(bell, 1, rnd);
+		ok_bell = ok_bell && (bit0 == bit1);
+	}
+	std::cout << "bell state measurements: " << ok_bell << std::endl;
+
+	return ok && ok_ctrl && ok_same && ok_range && ok_proj && ok_bell;
+}
+
+
+/**
+ * grover search algorithm, applying the gates in place to the state vector
+ * @see https://en.wikipedia.org/wiki/Grover%27s_algorithm
+ */
+template<class t_mat, class t_vec>
+requires is_mat<t_mat> && is_vec<t_vec>
+static bool check_grover_statevec(std::size_t n, std::size_t idx_to_find)
+{
+	using t_val = typename t_vec::value_type;
+	const t_mat& H = hadamard<t_mat>();
+
+	auto start = std::chrono::steady_clock::now();
+
+	t_vec state = qsim_basis_state<t_vec>(n);
+	apply_gate_all<t_vec, t_mat>(state, H);
+
+	const std::size_t num_steps = std::size_t(pi<double>/4. * std::sqrt(double(state.size())));
+	for(std::size_t step=0; step<num_steps; ++step)
+	{
+		// oracle: flip the sign of the searched state
+		state[idx_to_find] = -state[idx_to_find];
+
+		// mirror at mean: H (2|0><0| - 1) H
+		apply_gate_all<t_vec, t_mat>(state, H);
+		for(std::size_t i=1; i<state.size(); ++i)
+			state[i] = -state[i];
+		apply_gate_all<t_vec, t_mat>(state, H);
+	}
+
+	auto stop = std::chrono::steady_clock::now();
+
+	// check if the correct index has been recovered
+	auto iter_max = std::max_element(state.begin(), state.end(),
+		[](const t_val& val1, const t_val& val2) -> bool
+			{ return std::norm(val1) < std::norm(val2); });
+
+	std::cout << n << " qubits, " << num_steps << " steps: P = " << std::norm(*iter_max)
+		<< ", time: " << std::chrono::duration<double>(stop - start).count() << " s" << std::endl;
+
+	return (iter_max - state.begin()) == std::ptrdiff_t(idx_to_find);
+}
+
+
 template<class t_mat, class t_vec>
 requires is_mat<t_mat> && is_vec<t_vec>
 static bool check_measurements(const t_vec& up, const t_vec& down, const t_vec& twobitstate)
@@ -305,6 +449,9 @@ void qm_tests()
 
 
 	std::cout << "\n" << std::boolalpha << check_grover<t_mat, t_vec>(4, 8, 5) << std::endl;
+
+	std::cout << "\n" << std::boolalpha << check_statevec<t_mat, t_vec>() << std::endl;
+	std::cout << "\n" << std::boolalpha << check_grover_statevec<t_mat, t_vec>(12, 1234) << std::endl;
 }
 
 
@@ -11,6 +11,10 @@
 #include <memory>
 #include <functional>
 #include <unordered_map>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
 #include <sstream>
 #include <iostream>
 
@@ -422,6 +426,946 @@ t_nodeptr avltree_doublerotate(t_nodeptr root, t_nodeptr node, bool rot_rightlef
 }
 
 
+// ----------------------------------------------------------------------------
+
+// ----------------------------------------------------------------------------
+// balanced trees with the nodes in a contiguous pool
+// ----------------------------------------------------------------------------
+
+/**
+ * binary search tree whose nodes are stored in a vector and linked by 32-bit indices
+ * index 0 is a sentinel node which stands for all missing children, see (Cormen 2009), ch. 13
+ * each node stores the size of its subtree for the order-statistic queries
+ * t_extra is the balancing information of the derived trees
+ * @see T. H. Cormen et al., "Introduction to Algorithms" (2009), ch. 12-14
+ */
+template<class t_val, class t_extra, class t_cmp = std::less<t_val>>
+class pool_tree
+{
+public:
+	using t_idx = std::uint32_t;
+	static constexpr t_idx nil = 0;
+
+	struct Node
+	{
+		t_val value{};
+
+		t_idx parent{nil};
+		t_idx left{nil};
+		t_idx right{nil};
+
+		// number of nodes in the subtree
+		t_idx size{0};
+
+		t_extra extra{};
+	};
+
+
+public:
+	pool_tree()
+	{
+		m_nodes.emplace_back();
+	}
+
+	~pool_tree() = default;
+
+
+	std::size_t GetSize() const
+	{
+		return m_nodes[m_root].size;
+	}
+
+
+	bool IsEmpty() const
+	{
+		return m_root == nil;
+	}
+
+
+	void Clear()
+	{
+		m_nodes.resize(1);
+		m_nodes[nil] = Node{};
+		m_free.clear();
+		m_root = nil;
+	}
+
+
+	void Reserve(std::size_t N)
+	{
+		m_nodes.reserve(N + 1);
+	}
+
+
+	/**
+	 * node with the given value, nil if there's none
+	 */
+	t_idx Find(const t_val& val) const
+	{
+		t_idx node = m_root;
+
+		while(node != nil)
+		{
+			if(m_cmp(val, m_nodes[node].value))
+				node = m_nodes[node].left;
+			else if(m_cmp(m_nodes[node].value, val))
+				node = m_nodes[node].right;
+			else
+				break;
+		}
+
+		return node;
+	}
+
+
+	bool Contains(const t_val& val) const
+	{
+		return Find(val) != nil;
+	}
+
+
+	/**
+	 * first node whose value is not smaller than the given one, nil if there's none
+	 */
+	t_idx LowerBound(const t_val& val) const
+	{
+		t_idx node = m_root;
+		t_idx found = nil;
+
+		while(node != nil)
+		{
+			if(m_cmp(m_nodes[node].value, val))
+			{
+				node = m_nodes[node].right;
+			}
+			else
+			{
+				found = node;
+				node = m_nodes[node].left;
+			}
+		}
+
+		return found;
+	}
+
+
+	const t_val& GetValue(t_idx node) const
+	{
+		return m_nodes[node].value;
+	}
+
+
+	/**
+	 * k-th smallest value (counting from 0), k has to be smaller than the size of the tree
+	 */
+	const t_val& Select(std::size_t k) const
+	{
+		t_idx node = m_root;
+
+		while(true)
+		{
+			const std::size_t left_size = m_nodes[m_nodes[node].left].size;
+
+			if(k < left_size)
+			{
+				node = m_nodes[node].left;
+			}
+			else if(k == left_size)
+			{
+				break;
+			}
+			else
+			{
+				k -= left_size + 1;
+				node = m_nodes[node].right;
+			}
+		}
+
+		return m_nodes[node].value;
+	}
+
+
+	/**
+	 * number of values which are smaller than the given one
+	 */
+	std::size_t Rank(const t_val& val) const
+	{
+		std::size_t rank = 0;
+		t_idx node = m_root;
+
+		while(node != nil)
+		{
+			if(m_cmp(m_nodes[node].value, val))
+			{
+				rank += m_nodes[m_nodes[node].left].size + 1;
+				node = m_nodes[node].right;
+			}
+			else
+			{
+				node = m_nodes[node].left;
+			}
+		}
+
+		return rank;
+	}
+
+
+	/**
+	 * execute function "func" for all values in linear order
+	 */
+	template<class t_func>
+	void ForEach(t_func func) const
+	{
+		std::vector<t_idx> stack;
+		t_idx node = m_root;
+
+		while(node != nil || !stack.empty())
+		{
+			while(node != nil)
+			{
+				stack.push_back(node);
+				node = m_nodes[node].left;
+			}
+
+			node = stack.back();
+			stack.pop_back();
+
+			func(m_nodes[node].value);
+			node = m_nodes[node].right;
+		}
+	}
+
+
+	std::vector<t_val> GetValues() const
+	{
+		std::vector<t_val> vals;
+		vals.reserve(GetSize());
+		ForEach([&vals](const t_val& val) { vals.push_back(val); });
+		return vals;
+	}
+
+
+	/**
+	 * number of nodes on the longest path from the root to a leaf
+	 */
+	std::size_t GetHeight() const
+	{
+		std::function<std::size_t(t_idx)> _get_height;
+		_get_height = [this, &_get_height](t_idx node) -> std::size_t
+		{
+			if(node == nil)
+				return 0;
+			return std::max(_get_height(m_nodes[node].left), _get_height(m_nodes[node].right)) + 1;
+		};
+
+		return _get_height(m_root);
+	}
+
+
+protected:
+	t_idx NewNode(const t_val& val)
+	{
+		t_idx node;
+
+		if(m_free.empty())
+		{
+			node = static_cast<t_idx>(m_nodes.size());
+			m_nodes.emplace_back();
+		}
+		else
+		{
+			node = m_free.back();
+			m_free.pop_back();
+			m_nodes[node] = Node{};
+		}
+
+		m_nodes[node].value = val;
+		m_nodes[node].size = 1;
+		return node;
+	}
+
+
+	void FreeNode(t_idx node)
+	{
+		m_nodes[node] = Node{};
+		m_free.push_back(node);
+	}
+
+
+	void UpdateSize(t_idx node)
+	{
+		m_nodes[node].size = m_nodes[m_nodes[node].left].size + m_nodes[m_nodes[node].right].size + 1;
+	}
+
+
+	t_idx Minimum(t_idx node) const
+	{
+		while(m_nodes[node].left != nil)
+			node = m_nodes[node].left;
+		return node;
+	}
+
+
+	/**
+	 * put the subtree "node2" at the position of "node1"
+	 */
+	void Transplant(t_idx node1, t_idx node2)
+	{
+		const t_idx parent = m_nodes[node1].parent;
+
+		if(parent == nil)
+			m_root = node2;
+		else if(m_nodes[parent].left == node1)
+			m_nodes[parent].left = node2;
+		else
+			m_nodes[parent].right = node2;
+
+		// also for the sentinel, which is used by the red-black deletion
+		m_nodes[node2].parent = parent;
+	}
+
+
+	/**
+	 * the right child of "node" becomes its parent
+	 */
+	void RotateLeft(t_idx node)
+	{
+		const t_idx right = m_nodes[node].right;
+
+		m_nodes[node].right = m_nodes[right].left;
+		if(m_nodes[right].left != nil)
+			m_nodes[m_nodes[right].left].parent = node;
+
+		Transplant(node, right);
+		m_nodes[right].left = node;
+		m_nodes[node].parent = right;
+
+		m_nodes[right].size = m_nodes[node].size;
+		UpdateSize(node);
+	}
+
+
+	/**
+	 * the left child of "node" becomes its parent
+	 */
+	void RotateRight(t_idx node)
+	{
+		const t_idx left = m_nodes[node].left;
+
+		m_nodes[node].left = m_nodes[left].right;
+		if(m_nodes[left].right != nil)
+			m_nodes[m_nodes[left].right].parent = node;
+
+		Transplant(node, left);
+		m_nodes[left].right = node;
+		m_nodes[node].parent = left;
+
+		m_nodes[left].size = m_nodes[node].size;
+		UpdateSize(node);
+	}
+
+
+	/**
+	 * build a perfectly balanced subtree from the sorted values [begin, end)
+	 * func(node, depth) sets the balancing information
+	 */
+	template<class t_iter, class t_func>
+	t_idx BuildSorted(t_iter begin, t_iter end, t_idx parent, std::size_t depth, t_func func)
+	{
+		if(begin == end)
+			return nil;
+
+		t_iter mid = begin + (end - begin) / 2;
+		const t_idx node = NewNode(*mid);
+		m_nodes[node].parent = parent;
+
+		const t_idx left = BuildSorted(begin, mid, node, depth + 1, func);
+		const t_idx right = BuildSorted(mid + 1, end, node, depth + 1, func);
+		m_nodes[node].left = left;
+		m_nodes[node].right = right;
+
+		UpdateSize(node);
+		func(node, depth);
+		return node;
+	}
+
+
+	/**
+	 * checks the order, the parent links and the subtree sizes
+	 */
+	bool CheckStructure() const
+	{
+		if(m_nodes[m_root].parent != nil && m_root != nil)
+			return false;
+
+		std::function<bool(t_idx)> _check;
+		_check = [this, &_check](t_idx node) -> bool
+		{
+			if(node == nil)
+				return true;
+
+			const Node& n = m_nodes[node];
+			if(n.left != nil && (m_nodes[n.left].parent != node || m_cmp(n.value, m_nodes[n.left].value)))
+				return false;
+			if(n.right != nil && (m_nodes[n.right].parent != node || m_cmp(m_nodes[n.right].value, n.value)))
+				return false;
+			if(n.size != m_nodes[n.left].size + m_nodes[n.right].size + 1)
+				return false;
+
+			return _check(n.left) && _check(n.right);
+		};
+
+		return _check(m_root);
+	}
+
+
+	/**
+	 * write the tree out as directed graph, like bintree_print_graph()
+	 * @see https://graphviz.org/doc/info/lang.html
+	 */
+	template<class t_func>
+	void PrintGraph(std::ostream& ostr, t_func label) const
+	{
+		ostr << "// directed graph\n" << "digraph tree\n{";
+		ostr << "\n\t// states\n";
+		for(t_idx node=1; node<m_nodes.size(); ++node)
+		{
+			if(m_nodes[node].size == 0 || (node != m_root && m_nodes[node].parent == nil))
+				continue;
+			ostr << "\t" << node << " [label=\"" << m_nodes[node].value;
+			label(ostr, node);
+			ostr << "\"];\n";
+		}
+
+		ostr << "\n\t// transitions\n";
+		for(t_idx node=1; node<m_nodes.size(); ++node)
+		{
+			if(m_nodes[node].size == 0 || (node != m_root && m_nodes[node].parent == nil))
+				continue;
+			if(m_nodes[node].left != nil)
+				ostr << "\t" << node << ":sw -> " << m_nodes[node].left << ":n [label=\"l\"];\n";
+			if(m_nodes[node].right != nil)
+				ostr << "\t" << node << ":se -> " << m_nodes[node].right << ":n [label=\"r\"];\n";
+		}
+		ostr << "\n}\n";
+	}
+
+
+protected:
+	// node pool, the sentinel is at index 0
+	std::vector<Node> m_nodes{};
+
+	// indices of erased nodes to be reused
+	std::vector<t_idx> m_free{};
+
+	t_idx m_root{nil};
+	t_cmp m_cmp{};
+};
+
+
+/**
+ * avl tree in a node pool, each node stores the height of its subtree
+ * equal values are inserted to the right
+ * @see https://en.wikipedia.org/wiki/AVL_tree
+ */
+template<class t_val, class t_cmp = std::less<t_val>>
+class avl_tree : public pool_tree<t_val, std::uint8_t, t_cmp>
+{
+public:
+	using t_base = pool_tree<t_val, std::uint8_t, t_cmp>;
+	using t_idx = typename t_base::t_idx;
+	using t_base::nil;
+
+
+public:
+	avl_tree() = default;
+	~avl_tree() = default;
+
+
+	/**
+	 * build the tree from sorted values in linear time
+	 */
+	template<class t_cont>
+	void Build(const t_cont& sorted_vals)
+	{
+		this->Clear();
+		this->Reserve(sorted_vals.size());
+
+		this->m_root = this->BuildSorted(sorted_vals.begin(), sorted_vals.end(), nil, 0,
+			[this](t_idx node, std::size_t)
+		{
+			UpdateHeight(node);
+		});
+	}
+
+
+	void Insert(const t_val& val)
+	{
+		t_idx parent = nil;
+		t_idx node = this->m_root;
+
+		while(node != nil)
+		{
+			parent = node;
+			node = this->m_cmp(val, this->m_nodes[node].value)
+				? this->m_nodes[node].left : this->m_nodes[node].right;
+		}
+
+		const t_idx newnode = this->NewNode(val);
+		this->m_nodes[newnode].extra = 1;
+		this->m_nodes[newnode].parent = parent;
+
+		if(parent == nil)
+			this->m_root = newnode;
+		else if(this->m_cmp(val, this->m_nodes[parent].value))
+			this->m_nodes[parent].left = newnode;
+		else
+			this->m_nodes[parent].right = newnode;
+
+		Rebalance(parent);
+	}
+
+
+	/**
+	 * erase one node with the given value
+	 * @returns false if the value is not in the tree
+	 */
+	bool Erase(const t_val& val)
+	{
+		const t_idx node = this->Find(val);
+		if(node == nil)
+			return false;
+
+		auto& nodes = this->m_nodes;
+		t_idx start = nodes[node].parent;
+
+		if(nodes[node].left == nil)
+		{
+			this->Transplant(node, nodes[node].right);
+		}
+		else if(nodes[node].right == nil)
+		{
+			this->Transplant(node, nodes[node].left);
+		}
+		else
+		{
+			// replace the node by its successor
+			const t_idx succ = this->Minimum(nodes[node].right);
+			start = succ;
+
+			if(nodes[succ].parent != node)
+			{
+				start = nodes[succ].parent;
+				this->Transplant(succ, nodes[succ].right);
+				nodes[succ].right = nodes[node].right;
+				nodes[nodes[succ].right].parent = succ;
+			}
+
+			this->Transplant(node, succ);
+			nodes[succ].left = nodes[node].left;
+			nodes[nodes[succ].left].parent = succ;
+		}
+
+		nodes[nil].parent = nil;
+		this->FreeNode(node);
+		Rebalance(start);
+		return true;
+	}
+
+
+	/**
+	 * balance factor: height of the right minus the one of the left subtree
+	 */
+	int GetBalance(t_idx node) const
+	{
+		return int(this->m_nodes[this->m_nodes[node].right].extra)
+			- int(this->m_nodes[this->m_nodes[node].left].extra);
+	}
+
+
+	/**
+	 * checks the search tree structure and the avl condition
+	 */
+	bool Check() const
+	{
+		if(!this->CheckStructure())
+			return false;
+
+		for(t_idx node=1; node<this->m_nodes.size(); ++node)
+		{
+			if(this->m_nodes[node].size == 0)
+				continue;
+
+			const auto& n = this->m_nodes[node];
+			if(n.extra != std::max(this->m_nodes[n.left].extra, this->m_nodes[n.right].extra) + 1)
+				return false;
+			if(std::abs(GetBalance(node)) > 1)
+				return false;
+		}
+
+		return true;
+	}
+
+
+	void PrintGraph(std::ostream& ostr = std::cout) const
+	{
+		t_base::PrintGraph(ostr, [this](std::ostream& ostr, t_idx node)
+		{
+			ostr << " (balance: " << GetBalance(node) << ")";
+		});
+	}
+
+
+protected:
+	void UpdateHeight(t_idx node)
+	{
+		auto& nodes = this->m_nodes;
+		nodes[node].extra = std::max(nodes[nodes[node].left].extra, nodes[nodes[node].right].extra) + 1;
+	}
+
+
+	/**
+	 * update the heights and sizes on the path to the root and rotate where needed
+	 */
+	void Rebalance(t_idx node)
+	{
+		auto& nodes = this->m_nodes;
+
+		while(node != nil)
+		{
+			this->UpdateSize(node);
+			UpdateHeight(node);
+			const int balance = GetBalance(node);
+
+			if(balance > 1)
+			{
+				const t_idx right = nodes[node].right;
+				if(GetBalance(right) < 0)
+				{
+					this->RotateRight(right);
+					UpdateHeight(right);
+					UpdateHeight(nodes[right].parent);
+				}
+
+				this->RotateLeft(node);
+				UpdateHeight(node);
+				node = nodes[node].parent;
+				UpdateHeight(node);
+			}
+			else if(balance < -1)
+			{
+				const t_idx left = nodes[node].left;
+				if(GetBalance(left) > 0)
+				{
+					this->RotateLeft(left);
+					UpdateHeight(left);
+					UpdateHeight(nodes[left].parent);
+				}
+
+				this->RotateRight(node);
+				UpdateHeight(node);
+				node = nodes[node].parent;
+				UpdateHeight(node);
+			}
+
+			node = nodes[node].parent;
+		}
+	}
+};
+
+
+/**
+ * red-black tree in a node pool, the extra node information is the colour (true: red)
+ * equal values are inserted to the right
+ * @see T. H. Cormen et al., "Introduction to Algorithms" (2009), ch. 13
+ * @see https://en.wikipedia.org/wiki/Red%E2%80%93black_tree
+ */
+template<class t_val, class t_cmp = std::less<t_val>>
+class rb_tree : public pool_tree<t_val, bool, t_cmp>
+{
+public:
+	using t_base = pool_tree<t_val, bool, t_cmp>;
+	using t_idx = typename t_base::t_idx;
+	using t_base::nil;
+
+
+public:
+	rb_tree() = default;
+	~rb_tree() = default;
+
+
+	/**
+	 * build the tree from sorted values in linear time
+	 * the nodes on an incomplete lowest level are red, all others black
+	 */
+	template<class t_cont>
+	void Build(const t_cont& sorted_vals)
+	{
+		this->Clear();
+		this->Reserve(sorted_vals.size());
+
+		const std::size_t N = sorted_vals.size();
+		std::size_t max_depth = 0;
+		while((std::size_t(2) << max_depth) - 1 < N)
+			++max_depth;
+		const bool complete = (std::size_t(2) << max_depth) - 1 == N;
+
+		this->m_root = this->BuildSorted(sorted_vals.begin(), sorted_vals.end(), nil, 0,
+			[this, max_depth, complete](t_idx node, std::size_t depth)
+		{
+			this->m_nodes[node].extra = !complete && depth == max_depth;
+		});
+	}
+
+
+	void Insert(const t_val& val)
+	{
+		auto& nodes = this->m_nodes;
+		t_idx parent = nil;
+		t_idx node = this->m_root;
+
+		while(node != nil)
+		{
+			parent = node;
+			++nodes[node].size;
+			node = this->m_cmp(val, nodes[node].value) ? nodes[node].left : nodes[node].right;
+		}
+
+		node = this->NewNode(val);
+		nodes[node].extra = true;
+		nodes[node].parent = parent;
+
+		if(parent == nil)
+			this->m_root = node;
+		else if(this->m_cmp(val, nodes[parent].value))
+			nodes[parent].left = node;
+		else
+			nodes[parent].right = node;
+
+		// restore the red-black properties
+		while(nodes[nodes[node].parent].extra)
+		{
+			parent = nodes[node].parent;
+			const t_idx grandparent = nodes[parent].parent;
+			const bool parent_is_left = nodes[grandparent].left == parent;
+			const t_idx uncle = parent_is_left ? nodes[grandparent].right : nodes[grandparent].left;
+
+			if(nodes[uncle].extra)
+			{
+				nodes[parent].extra = false;
+				nodes[uncle].extra = false;
+				nodes[grandparent].extra = true;
+				node = grandparent;
+				continue;
+			}
+
+			if(parent_is_left)
+			{
+				if(node == nodes[parent].right)
+				{
+					node = parent;
+					this->RotateLeft(node);
+				}
+
+				nodes[nodes[node].parent].extra = false;
+				nodes[grandparent].extra = true;
+				this->RotateRight(grandparent);
+			}
+			else
+			{
+				if(node == nodes[parent].left)
+				{
+					node = parent;
+					this->RotateRight(node);
+				}
+
+				nodes[nodes[node].parent].extra = false;
+				nodes[grandparent].extra = true;
+				this->RotateLeft(grandparent);
+			}
+		}
+
+		nodes[this->m_root].extra = false;
+	}
+
+
+	/**
+	 * erase one node with the given value
+	 * @returns false if the value is not in the tree
+	 */
+	bool Erase(const t_val& val)
+	{
+		auto& nodes = this->m_nodes;
+		const t_idx node = this->Find(val);
+		if(node == nil)
+			return false;
+
+		// the node which is removed from its position
+		t_idx moved = node;
+		if(nodes[node].left != nil && nodes[node].right != nil)
+			moved = this->Minimum(nodes[node].right);
+		bool moved_red = nodes[moved].extra;
+
+		for(t_idx ancestor=nodes[moved].parent; ancestor!=nil; ancestor=nodes[ancestor].parent)
+			--nodes[ancestor].size;
+
+		// child which takes the place of the moved node
+		t_idx child;
+
+		if(nodes[node].left == nil)
+		{
+			child = nodes[node].right;
+			this->Transplant(node, child);
+		}
+		else if(nodes[node].right == nil)
+		{
+			child = nodes[node].left;
+			this->Transplant(node, child);
+		}
+		else
+		{
+			child = nodes[moved].right;
+
+			if(nodes[moved].parent == node)
+			{
+				nodes[child].parent = moved;
+			}
+			else
+			{
+				this->Transplant(moved, child);
+				nodes[moved].right = nodes[node].right;
+				nodes[nodes[moved].right].parent = moved;
+			}
+
+			this->Transplant(node, moved);
+			nodes[moved].left = nodes[node].left;
+			nodes[nodes[moved].left].parent = moved;
+			nodes[moved].extra = nodes[node].extra;
+			nodes[moved].size = nodes[node].size;
+		}
+
+		if(!moved_red)
+			EraseFixup(child);
+
+		nodes[nil].parent = nil;
+		nodes[nil].extra = false;
+		this->FreeNode(node);
+		return true;
+	}
+
+
+	bool IsRed(t_idx node) const
+	{
+		return this->m_nodes[node].extra;
+	}
+
+
+	/**
+	 * checks the search tree structure and the red-black properties
+	 */
+	bool Check() const
+	{
+		if(!this->CheckStructure() || IsRed(this->m_root))
+			return false;
+
+		// returns the number of black nodes on each path, or 0 for a violation
+		std::function<std::size_t(t_idx)> _check;
+		_check = [this, &_check](t_idx node) -> std::size_t
+		{
+			if(node == nil)
+				return 1;
+
+			const auto& n = this->m_nodes[node];
+			if(n.extra && (IsRed(n.left) || IsRed(n.right)))
+				return 0;
+
+			const std::size_t black_left = _check(n.left);
+			const std::size_t black_right = _check(n.right);
+			if(black_left == 0 || black_left != black_right)
+				return 0;
+
+			return black_left + (n.extra ? 0 : 1);
+		};
+
+		return _check(this->m_root) != 0;
+	}
+
+
+	void PrintGraph(std::ostream& ostr = std::cout) const
+	{
+		t_base::PrintGraph(ostr, [this](std::ostream& ostr, t_idx node)
+		{
+			ostr << (IsRed(node) ? " (red)" : " (black)");
+		});
+	}
+
+
+protected:
+	/**
+	 * restore the red-black properties after removing a black node
+	 */
+	void EraseFixup(t_idx node)
+	{
+		auto& nodes = this->m_nodes;
+
+		while(node != this->m_root && !nodes[node].extra)
+		{
+			const t_idx parent = nodes[node].parent;
+			const bool node_is_left = nodes[parent].left == node;
+			t_idx sibling = node_is_left ? nodes[parent].right : nodes[parent].left;
+
+			if(nodes[sibling].extra)
+			{
+				nodes[sibling].extra = false;
+				nodes[parent].extra = true;
+				if(node_is_left)
+					this->RotateLeft(parent);
+				else
+					this->RotateRight(parent);
+				sibling = node_is_left ? nodes[parent].right : nodes[parent].left;
+			}
+
+			const t_idx near = node_is_left ? nodes[sibling].left : nodes[sibling].right;
+			const t_idx far = node_is_left ? nodes[sibling].right : nodes[sibling].left;
+
+			if(!nodes[near].extra && !nodes[far].extra)
+			{
+				nodes[sibling].extra = true;
+				node = parent;
+				continue;
+			}
+
+			if(!nodes[far].extra)
+			{
+				nodes[near].extra = false;
+				nodes[sibling].extra = true;
+				if(node_is_left)
+					this->RotateRight(sibling);
+				else
+					this->RotateLeft(sibling);
+				sibling = node_is_left ? nodes[parent].right : nodes[parent].left;
+			}
+
+			nodes[sibling].extra = nodes[parent].extra;
+			nodes[parent].extra = false;
+			if(node_is_left)
+			{
+				nodes[nodes[sibling].right].extra = false;
+				this->RotateLeft(parent);
+			}
+			else
+			{
+				nodes[nodes[sibling].left].extra = false;
+				this->RotateRight(parent);
+			}
+
+			node = this->m_root;
+		}
+
+		nodes[node].extra = false;
+	}
+};
+
 // ----------------------------------------------------------------------------
 
 #endif
@@ -0,0 +1,194 @@
+/**
+ * compares the pool-based avl and red-black trees with std::multiset
+ * @author Tobias Weber
+ * @date oct-2026
+ * @license see 'LICENSE.EUPL' file
+ *
+ * g++ -std=c++20 -Wall -Wextra -Weffc++ -O2 -o tree_pool_tst tree_pool_tst.cpp
+ */
+
+#include "tree_algos.h"
+#include "tst_helpers.h"
+
+#include <set>
+#include <random>
+#include <chrono>
+
+
+/**
+ * random inserts and erases, compared with a multiset
+ */
+template<class t_tree>
+bool check_tree(std::mt19937& rnd)
+{
+	std::uniform_int_distribution<int> dist_val(0, 500);
+	std::uniform_int_distribution<int> dist_op(0, 2);
+
+	t_tree tree;
+	std::multiset<int> ref;
+	bool ok = true;
+
+	for(std::size_t i=0; i<20000; ++i)
+	{
+		const int val = dist_val(rnd);
+
+		if(dist_op(rnd) == 0)
+		{
+			const bool erased = tree.Erase(val);
+			auto iter = ref.find(val);
+			ok = ok && erased == (iter != ref.end());
+			if(iter != ref.end())
+				ref.erase(iter);
+		}
+		else
+		{
+			tree.Insert(val);
+			ref.insert(val);
+		}
+
+		if(i % 1000 == 0)
+			ok = ok && tree.Check();
+	}
+
+	ok = ok && tree.Check() && tree.GetSize() == ref.size();
+	ok = ok && tree.GetValues() == std::vector<int>(ref.begin(), ref.end());
+
+	// order statistics
+	std::vector<int> sorted(ref.begin(), ref.end());
+	for(std::size_t k=0; k<sorted.size(); k+=7)
+		ok = ok && tree.Select(k) == sorted[k];
+	for(int val=-1; val<=501; val+=3)
+	{
+		const std::size_t rank = std::lower_bound(sorted.begin(), sorted.end(), val) - sorted.begin();
+		ok = ok && tree.Rank(val) == rank;
+
+		const auto lower = tree.LowerBound(val);
+		ok = ok && (rank == sorted.size() ? lower == t_tree::nil : tree.GetValue(lower) == sorted[rank]);
+	}
+
+	// erase everything
+	for(int val : sorted)
+		ok = ok && tree.Erase(val);
+	ok = ok && tree.IsEmpty() && tree.Check();
+
+	return ok;
+}
+
+
+/**
+ * bulk build from sorted values
+ */
+template<class t_tree>
+bool check_build()
+{
+	bool ok = true;
+
+	for(std::size_t N : { 0, 1, 2, 3, 6, 7, 8, 100, 1023, 1024, 1000 })
+	{
+		std::vector<int> vals(N);
+		for(std::size_t i=0; i<N; ++i)
+			vals[i] = int(i*2);
+
+		t_tree tree;
+		tree.Build(vals);
+		ok = ok && tree.Check() && tree.GetValues() == vals && tree.GetSize() == N;
+
+		// modify the built tree
+		tree.Insert(5);
+		const bool erased = tree.Erase(0);
+		ok = ok && erased == (N > 0) && tree.Check() && tree.GetSize() == (N > 0 ? N : 1);
+	}
+
+	return ok;
+}
+
+
+int main()
+{
+	std::mt19937 rnd{1234};
+	std::cout << std::boolalpha;
+
+	std::cout << "avl tree: ok = " << check_tree<avl_tree<int>>(rnd) << std::endl;
+	std::cout << "red-black tree: ok = " << check_tree<rb_tree<int>>(rnd) << std::endl;
+	std::cout << "avl tree build: ok = " << check_build<avl_tree<int>>() << std::endl;
+	std::cout << "red-black tree build: ok = " << check_build<rb_tree<int>>() << std::endl;
+
+	// benchmark
+	{
+		const std::size_t N = 1000000;
+		std::vector<int> vals(N);
+		std::uniform_int_distribution<int> dist_val;
+		for(int& val : vals)
+			val = dist_val(rnd);
+
+		// shared_ptr nodes, only a few values since the balance factors are recalculated for the whole tree
+		const std::size_t N_ptr = 2000;
+		auto start_ptr = std::chrono::steady_clock::now();
+		{
+			using t_node = avl_node<int>;
+			auto header = t_node::create(0);
+			header->right = t_node::create(vals[0]);
+			header->right->parent = header;
+			for(std::size_t i=1; i<N_ptr; ++i)
+				avltree_insert<typename t_node::t_nodeptr>(header->right, t_node::create(vals[i]));
+		}
+		double time_ptr = seconds_since(start_ptr);
+
+		auto start_set = std::chrono::steady_clock::now();
+		std::multiset<int> set;
+		for(int val : vals)
+			set.insert(val);
+		double time_set = seconds_since(start_set);
+
+		auto start_avl = std::chrono::steady_clock::now();
+		avl_tree<int> avl;
+		avl.Reserve(N);
+		for(int val : vals)
+			avl.Insert(val);
+		double time_avl = seconds_since(start_avl);
+
+		auto start_rb = std::chrono::steady_clock::now();
+		rb_tree<int> rb;
+		rb.Reserve(N);
+		for(int val : vals)
+			rb.Insert(val);
+		double time_rb = seconds_since(start_rb);
+
+		std::vector<int> sorted(set.begin(), set.end());
+		auto start_build = std::chrono::steady_clock::now();
+		avl_tree<int> avl_built;
+		avl_built.Build(sorted);
+		double time_build = seconds_since(start_build);
+
+		std::size_t sum_set = 0, sum_avl = 0;
+		auto start_query_set = std::chrono::steady_clock::now();
+		for(std::size_t i=0; i<N; ++i)
+			sum_set += set.count(vals[i]);
+		double time_query_set = seconds_since(start_query_set);
+
+		auto start_query_avl = std::chrono::steady_clock::now();
+		for(std::size_t i=0; i<N; ++i)
+			sum_avl += avl.Contains(vals[i]);
+		double time_query_avl = seconds_since(start_query_avl);
+
+		auto start_select = std::chrono::steady_clock::now();
+		bool ok_select = true;
+		for(std::size_t k=0; k<N; k+=N/1000)
+			ok_select = ok_select && avl.Select(k) == sorted[k] && rb.Select(k) == sorted[k];
+		double time_select = seconds_since(start_select);
+
+		std::cout << "\n" << N << " random inserts:" << std::endl;
+		std::cout << "\tshared_ptr avl nodes (" << N_ptr << " inserts): " << time_ptr << " s" << std::endl;
+		std::cout << "\tstd::multiset: " << time_set << " s" << std::endl;
+		std::cout << "\tavl tree: " << time_avl << " s, height " << avl.GetHeight() << std::endl;
+		std::cout << "\tred-black tree: " << time_rb << " s, height " << rb.GetHeight() << std::endl;
+		std::cout << "\tavl tree, build from sorted values: " << time_build << " s" << std::endl;
+		std::cout << N << " lookups: std::multiset: " << time_query_set << " s, avl tree: " << time_query_avl
+			<< " s, ok = " << (sum_set >= sum_avl && sum_avl == N) << std::endl;
+		std::cout << "1000 order-statistic queries: " << time_select << " s, ok = " << ok_select << std::endl;
+		std::cout << "ok = " << (avl.Check() && rb.Check() && avl_built.Check()
+			&& avl.GetValues() == sorted && rb.GetValues() == sorted && avl_built.GetValues() == sorted) << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,46 @@
+/**
+ * helpers shared by the tests and benchmarks
+ * @author Tobias Weber
+ * @date oct-2026
+ * @license see 'LICENSE.EUPL' file
+ */
+
+#ifndef __TST_HELPERS_H__
+#define __TST_HELPERS_H__
+
+#include <cstddef>
+#include <vector>
+#include <tuple>
+#include <random>
+#include <chrono>
+
+
+/**
+ * seconds elapsed since the given time point
+ */
+inline double seconds_since(const std::chrono::steady_clock::time_point& start)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+/**
+ * random directed graph with the given number of vertices and edges
+ */
+template<class t_weight = unsigned int>
+std::vector<std::tuple<std::size_t, std::size_t, t_weight>>
+random_edges(std::size_t num_verts, std::size_t num_edges, std::mt19937& rnd)
+{
+	std::uniform_int_distribution<std::size_t> dist_vert(0, num_verts - 1);
+	std::uniform_int_distribution<t_weight> dist_weight(1, 100);
+
+	std::vector<std::tuple<std::size_t, std::size_t, t_weight>> edges;
+	edges.reserve(num_edges);
+	for(std::size_t i=0; i<num_edges; ++i)
+		edges.emplace_back(std::make_tuple(dist_vert(rnd), dist_vert(rnd), dist_weight(rnd)));
+
+	return edges;
+}
+
+
+#endif
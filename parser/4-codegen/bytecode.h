@@ -0,0 +1,367 @@
+/**
+ * binary bytecode for the zero-address machine
+ * @author Tobias Weber
+ * @date oct-2026
+ * @license: see 'LICENSE.GPL' file
+ *
+ * File layout (host byte order):
+ *	"0ACBC001"					magic
+ *	u32 num_vars, u32 num_funcs, u32 code_size
+ *	num_vars  x (u32 len, chars)			variable names, indexed by slot
+ *	num_funcs x (u32 num_args, u32 len, chars)	called functions
+ *	code_size bytes of code, each instruction is an u8 opcode followed by its operand
+ */
+
+#ifndef __BYTECODE_H__
+#define __BYTECODE_H__
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <optional>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+
+enum class OpCode : std::uint8_t
+{
+	END = 0,	// stop the program
+	PUSH,		// push f64 operand
+	PUSHVAL,	// push value of variable in u32 slot
+	ASSIGN,		// pop value into variable in u32 slot
+
+	UMIN,
+	ADD, SUB, MUL, DIV, MOD, POW,
+
+	CALL1,		// call function with u32 index, the first argument is on top of the stack
+	CALL2,
+
+	NUM_OPCODES
+};
+
+
+class Bytecode
+{
+public:
+	static constexpr std::string_view magic{"0ACBC001"};
+
+	struct Func
+	{
+		std::string name{};
+		std::uint32_t num_args{};
+	};
+
+
+public:
+	// ------------------------------------------------------------------------
+	// code generation
+	// ------------------------------------------------------------------------
+	void Emit(OpCode op)
+	{
+		m_code.push_back(static_cast<std::uint8_t>(op));
+	}
+
+
+	void EmitConst(double val)
+	{
+		Emit(OpCode::PUSH);
+		Append(val);
+	}
+
+
+	void EmitVar(OpCode op, const std::string& name)
+	{
+		Emit(op);
+		Append(AddVar(name));
+	}
+
+
+	/**
+	 * @throws std::invalid_argument for functions that do not take one or two arguments
+	 */
+	void EmitCall(const std::string& name, std::uint32_t num_args)
+	{
+		if(num_args != 1 && num_args != 2)
+		{
+			throw std::invalid_argument("Cannot call function \"" + name + "\" with "
+				+ std::to_string(num_args) + " arguments, only one or two are supported.");
+		}
+
+		std::uint32_t idx = 0;
+		for(; idx<m_funcs.size(); ++idx)
+		{
+			if(m_funcs[idx].name == name && m_funcs[idx].num_args == num_args)
+				break;
+		}
+		if(idx == m_funcs.size())
+			m_funcs.emplace_back(Func{name, num_args});
+
+		Emit(num_args == 2 ? OpCode::CALL2 : OpCode::CALL1);
+		Append(idx);
+	}
+
+
+	std::uint32_t AddVar(const std::string& name)
+	{
+		auto iter = std::find(m_vars.begin(), m_vars.end(), name);
+		if(iter != m_vars.end())
+			return std::uint32_t(iter - m_vars.begin());
+
+		m_vars.push_back(name);
+		return std::uint32_t(m_vars.size() - 1);
+	}
+	// ------------------------------------------------------------------------
+
+
+
+	// ------------------------------------------------------------------------
+	// serialisation
+	// ------------------------------------------------------------------------
+	void Save(std::ostream& ostr) const
+	{
+		auto write = [&ostr](const auto& val)
+		{
+			ostr.write(reinterpret_cast<const char*>(&val), sizeof(val));
+		};
+
+		auto write_str = [&ostr, &write](const std::string& str)
+		{
+			write(std::uint32_t(str.size()));
+			ostr.write(str.data(), str.size());
+		};
+
+		ostr.write(magic.data(), magic.size());
+		write(std::uint32_t(m_vars.size()));
+		write(std::uint32_t(m_funcs.size()));
+		write(std::uint32_t(m_code.size()));
+
+		for(const std::string& var : m_vars)
+			write_str(var);
+
+		for(const Func& func : m_funcs)
+		{
+			write(func.num_args);
+			write_str(func.name);
+		}
+
+		ostr.write(reinterpret_cast<const char*>(m_code.data()), m_code.size());
+	}
+
+
+	/**
+	 * loads and verifies a program
+	 * @return program, or nothing if it is malformed
+	 */
+	static std::optional<Bytecode> Load(std::istream& istr)
+	{
+		auto read = [&istr](auto& val) -> bool
+		{
+			return bool(istr.read(reinterpret_cast<char*>(&val), sizeof(val)));
+		};
+
+		auto read_str = [&istr, &read](std::string& str) -> bool
+		{
+			std::uint32_t len = 0;
+			if(!read(len) || len > max_name_len)
+				return false;
+			str.resize(len);
+			return bool(istr.read(str.data(), len));
+		};
+
+		char file_magic[magic.size()];
+		if(!istr.read(file_magic, magic.size()) || std::string_view{file_magic, magic.size()} != magic)
+			return std::nullopt;
+
+		std::uint32_t num_vars = 0, num_funcs = 0, code_size = 0;
+		if(!read(num_vars) || !read(num_funcs) || !read(code_size))
+			return std::nullopt;
+
+		// the sizes have to fit into the rest of the input, if its length is known
+		const std::uint64_t min_size = std::uint64_t(num_vars)*sizeof(std::uint32_t)
+			+ std::uint64_t(num_funcs)*2*sizeof(std::uint32_t) + code_size;
+		if(std::optional<std::uint64_t> remaining = RemainingSize(istr); remaining && min_size > *remaining)
+			return std::nullopt;
+
+		// otherwise the containers only grow with the data actually read
+		Bytecode prog;
+		for(std::uint32_t idx=0; idx<num_vars; ++idx)
+		{
+			std::string var;
+			if(!read_str(var))
+				return std::nullopt;
+			prog.m_vars.emplace_back(std::move(var));
+		}
+
+		for(std::uint32_t idx=0; idx<num_funcs; ++idx)
+		{
+			Func func;
+			if(!read(func.num_args) || !read_str(func.name))
+				return std::nullopt;
+			prog.m_funcs.emplace_back(std::move(func));
+		}
+
+		constexpr std::size_t chunk_size = 1 << 20;
+		for(std::size_t pos=0; pos<code_size; pos+=chunk_size)
+		{
+			const std::size_t len = std::min<std::size_t>(chunk_size, code_size - pos);
+			prog.m_code.resize(pos + len);
+			if(!istr.read(reinterpret_cast<char*>(prog.m_code.data() + pos), len))
+				return std::nullopt;
+		}
+
+		if(!prog.Verify())
+			return std::nullopt;
+		return prog;
+	}
+	// ------------------------------------------------------------------------
+
+
+
+	/**
+	 * checks the operands and the stack depth of the instructions,
+	 * so that the machine can run the code without any checks
+	 */
+	bool Verify()
+	{
+		m_inputs.assign(m_vars.size(), false);
+		std::vector<bool> assigned(m_vars.size(), false);
+
+		std::size_t depth = 0;
+		m_max_stack = 0;
+
+		for(std::size_t pc=0; pc<m_code.size();)
+		{
+			const OpCode op = static_cast<OpCode>(m_code[pc++]);
+			std::size_t pops = 0, pushes = 0;
+			std::uint32_t idx = 0;
+
+			switch(op)
+			{
+				case OpCode::END:
+					return true;
+
+				case OpCode::PUSH:
+					if(pc + sizeof(double) > m_code.size())
+						return false;
+					pc += sizeof(double);
+					pushes = 1;
+					break;
+
+				case OpCode::PUSHVAL:
+				case OpCode::ASSIGN:
+					if(!ReadOperand(pc, idx) || idx >= m_vars.size())
+						return false;
+					if(op == OpCode::PUSHVAL)
+					{
+						pushes = 1;
+						if(!assigned[idx])
+							m_inputs[idx] = true;
+					}
+					else
+					{
+						pops = 1;
+						assigned[idx] = true;
+					}
+					break;
+
+				case OpCode::UMIN:
+					pops = pushes = 1;
+					break;
+
+				case OpCode::ADD: case OpCode::SUB: case OpCode::MUL:
+				case OpCode::DIV: case OpCode::MOD: case OpCode::POW:
+					pops = 2;
+					pushes = 1;
+					break;
+
+				case OpCode::CALL1:
+				case OpCode::CALL2:
+					if(!ReadOperand(pc, idx) || idx >= m_funcs.size())
+						return false;
+					pops = op == OpCode::CALL1 ? 1 : 2;
+					pushes = 1;
+					if(m_funcs[idx].num_args != pops)
+						return false;
+					break;
+
+				default:
+					return false;
+			}
+
+			if(depth < pops)
+				return false;
+			depth = depth - pops + pushes;
+			m_max_stack = std::max(m_max_stack, depth);
+		}
+
+		// missing END
+		return false;
+	}
+
+
+	const std::vector<std::uint8_t>& GetCode() const { return m_code; }
+	const std::vector<std::string>& GetVars() const { return m_vars; }
+	const std::vector<Func>& GetFuncs() const { return m_funcs; }
+
+	// only valid after verification
+	std::size_t GetMaxStack() const { return m_max_stack; }
+	bool IsInput(std::size_t slot) const { return m_inputs[slot]; }
+
+
+protected:
+	/**
+	 * number of bytes left in a seekable stream
+	 */
+	static std::optional<std::uint64_t> RemainingSize(std::istream& istr)
+	{
+		const std::istream::pos_type pos = istr.tellg();
+		if(pos == std::istream::pos_type(-1))
+			return std::nullopt;
+
+		istr.seekg(0, std::ios::end);
+		const std::istream::pos_type end = istr.tellg();
+		istr.clear();
+		istr.seekg(pos);
+
+		if(end == std::istream::pos_type(-1) || !istr)
+			return std::nullopt;
+		return std::uint64_t(end - pos);
+	}
+
+
+	template<class t_val>
+	void Append(t_val val)
+	{
+		const std::size_t pos = m_code.size();
+		m_code.resize(pos + sizeof(val));
+		std::memcpy(m_code.data() + pos, &val, sizeof(val));
+	}
+
+
+	bool ReadOperand(std::size_t& pc, std::uint32_t& val) const
+	{
+		if(pc + sizeof(val) > m_code.size())
+			return false;
+		std::memcpy(&val, m_code.data() + pc, sizeof(val));
+		pc += sizeof(val);
+		return true;
+	}
+
+
+private:
+	static constexpr std::uint32_t max_name_len = 1024;
+
+	std::vector<std::uint8_t> m_code{};
+	std::vector<std::string> m_vars{};
+	std::vector<Func> m_funcs{};
+
+	// variables read before they are assigned
+	std::vector<bool> m_inputs{};
+	std::size_t m_max_stack{0};
+};
+
+
+#endif
@@ -2,6 +2,7 @@
 
 rm -f parser
 rm -f vm_0ac
+rm -f vm_0ac_bench
 rm -f parser_impl.cpp
 rm -f parser_defs.h
 rm -f stack.hh
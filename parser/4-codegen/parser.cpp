@@ -6,6 +6,7 @@
  *
  * Test:
  * echo -e "(2+3)*(4-5)\n1+2" | ./parser
+ * echo -e "(2+3)*(4-5)\n1+2" | ./parser --binary > prog.bc
  */
 
 #include "ast.h"
@@ -13,6 +14,8 @@
 #include "zeroac.h"
 #include "threeac.h"
 
+#include <string_view>
+
 
 /**
  * Lexer error output
@@ -50,11 +53,14 @@ extern yy::Parser::symbol_type yylex(yy::ParserContext &context)
 }
 
 
-int main()
+int main(int argc, char** argv)
 {
 	bool b0AC = 1;
 	bool b3AC = 1;
 
+	// only write the binary zero-address code
+	bool bBinary = argc > 1 && std::string_view{argv[1]} == "--binary";
+
 	yy::ParserContext ctx;
 	yy::Parser parser(ctx);
 	int res = parser.parse();
@@ -63,6 +69,26 @@ int main()
 		return res;
 
 
+	if(bBinary)
+	{
+		ZeroAC zeroac(&std::cout, true);
+
+		try
+		{
+			for(auto iter=ctx.GetStatements().rbegin(); iter!=ctx.GetStatements().rend(); ++iter)
+				(*iter)->accept(&zeroac);
+		}
+		catch(const std::exception& ex)
+		{
+			std::cerr << "Code generation error: " << ex.what() << std::endl;
+			return -1;
+		}
+
+		zeroac.Finish().Save(std::cout);
+		return 0;
+	}
+
+
 	if(b0AC)
 	{
 		ZeroAC zeroac;
@@ -0,0 +1,512 @@
+/**
+ * zero-address (stack) machines for the textual and the binary code
+ * @author Tobias Weber
+ * @date 20-dec-19
+ * @license: see 'LICENSE.GPL' file
+ */
+
+#ifndef __VM_0AC_H__
+#define __VM_0AC_H__
+
+#include <boost/algorithm/string.hpp>
+#include <iostream>
+#include <stack>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+#include <tuple>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+
+#include "bytecode.h"
+
+
+// dispatch the binary code via computed gotos (a gcc extension) instead of a switch
+#ifndef VM_COMPUTED_GOTO
+	#if defined(__GNUC__)
+		#define VM_COMPUTED_GOTO 1
+	#else
+		#define VM_COMPUTED_GOTO 0
+	#endif
+#endif
+
+
+namespace vm0ac {
+
+using t_real = double;
+
+// final symbol table and stack contents (from bottom to top)
+using t_vmstate = std::tuple<std::unordered_map<std::string, t_real>, std::vector<t_real>>;
+
+
+inline std::unordered_map<std::string, t_real> get_predefined_syms()
+{
+	return
+	{{
+		{ "pi", M_PI },
+	}};
+}
+
+
+/**
+ * functions known to both machines
+ */
+inline const std::unordered_map<std::string, t_real(*)(t_real)>& get_funcs1()
+{
+	static const std::unordered_map<std::string, t_real(*)(t_real)> funcs1 =
+	{
+		{ "sin", [](t_real x) -> t_real { return std::sin(x); } },
+		{ "cos", [](t_real x) -> t_real { return std::cos(x); } },
+		{ "tan", [](t_real x) -> t_real { return std::tan(x); } },
+		{ "sqrt", [](t_real x) -> t_real { return std::sqrt(x); } },
+		{ "exp", [](t_real x) -> t_real { return std::exp(x); } },
+		{ "log", [](t_real x) -> t_real { return std::log(x); } },
+	};
+
+	return funcs1;
+}
+
+
+inline const std::unordered_map<std::string, t_real(*)(t_real, t_real)>& get_funcs2()
+{
+	static const std::unordered_map<std::string, t_real(*)(t_real, t_real)> funcs2 =
+	{
+		{ "pow", [](t_real x, t_real y) -> t_real { return std::pow(x, y); } },
+		{ "atan2", [](t_real y, t_real x) -> t_real { return std::atan2(y, x); } },
+	};
+
+	return funcs2;
+}
+
+
+inline void print_state(const t_vmstate& state)
+{
+	const auto& [syms, stack] = state;
+
+	std::cout << "End of program.\n";
+	std::cout << "\nSymbols:\n";
+	for(const auto& sym : syms)
+		std::cout << "\t" << sym.first << " = " << sym.second << std::endl;
+
+	if(!stack.empty())
+	{
+		std::cout << "\nStack contents:\n";
+		for(auto iter=stack.rbegin(); iter!=stack.rend(); ++iter)
+			std::cout << "\t" << *iter << std::endl;
+	}
+}
+
+
+
+// ----------------------------------------------------------------------------
+// text interpreter
+// ----------------------------------------------------------------------------
+template<class t_str=std::string, template<class...> class t_cont=std::vector>
+t_cont<t_str> tokenise(const t_str& _str, const t_str& strSeparators=" \t")
+{
+	t_cont<t_str> vec;
+
+	// separator predicate
+	auto is_sep = [&strSeparators](auto c) -> bool
+	{
+		for(auto csep : strSeparators)
+			if(c == csep)
+				return true;
+		return false;
+	};
+
+	// trim whitespaces
+	t_str str = boost::trim_copy_if(_str, is_sep);
+	boost::split(vec, str, is_sep, boost::token_compress_on);
+
+	return vec;
+}
+
+
+/**
+ * interprets the textual zero-address code line by line
+ */
+inline t_vmstate run(std::istream& istr)
+{
+	std::unordered_map<std::string, t_real> syms = get_predefined_syms();
+
+	std::stack<std::variant<t_real, std::string>> stack;
+
+
+	const std::string white{" \t"};
+	std::string line;
+
+	while(istr)
+	{
+		std::getline(istr, line);
+		boost::trim(line);
+		if(line == "")
+			continue;
+
+		std::vector<std::string> tokens;
+		tokens = tokenise<std::string, std::vector>(line, white);
+
+		if(tokens.size() == 0)
+			continue;
+
+		else if(tokens[0] == "PUSH")
+		{
+			if(tokens.size() < 2)
+			{
+				std::cerr << "Need argument to push." << std::endl;
+				continue;
+			}
+
+			t_real val = std::stod(tokens[1]);
+			stack.push(val);
+		}
+
+		else if(tokens[0] == "PUSHVAL")
+		{
+			if(tokens.size() < 2)
+			{
+				std::cerr << "Need variable name to push." << std::endl;
+				continue;
+			}
+
+			auto iter = syms.find(tokens[1]);
+			if(iter != syms.end())
+				stack.push(iter->second);
+			else
+				std::cerr << "Unknown variable: " << tokens[1] << "." << std::endl;
+		}
+
+		else if(tokens[0] == "PUSHVAR")
+		{
+			if(tokens.size() < 2)
+			{
+				std::cerr << "Need variable name to push." << std::endl;
+				continue;
+			}
+
+			std::string var = tokens[1];
+			stack.emplace(std::move(var));
+		}
+
+		else if(tokens[0] == "ASSIGN")
+		{
+			std::string var = std::get<std::string>(stack.top()); stack.pop();
+			t_real val = std::get<t_real>(stack.top()); stack.pop();
+
+			syms[var] = val;
+		}
+
+		else if(tokens[0] == "UMIN")
+		{
+			t_real val = std::get<t_real>(stack.top()); stack.pop();
+			stack.push(-val);
+		}
+
+		else if(tokens[0] == "ADD")
+		{
+			t_real val1 = std::get<t_real>(stack.top()); stack.pop();
+			t_real val0 = std::get<t_real>(stack.top()); stack.pop();
+			stack.push(val0 + val1);
+		}
+
+		else if(tokens[0] == "SUB")
+		{
+			t_real val1 = std::get<t_real>(stack.top()); stack.pop();
+			t_real val0 = std::get<t_real>(stack.top()); stack.pop();
+			stack.push(val0 - val1);
+		}
+
+		else if(tokens[0] == "MUL")
+		{
+			t_real val1 = std::get<t_real>(stack.top()); stack.pop();
+			t_real val0 = std::get<t_real>(stack.top()); stack.pop();
+			stack.push(val0 * val1);
+		}
+
+		else if(tokens[0] == "DIV")
+		{
+			t_real val1 = std::get<t_real>(stack.top()); stack.pop();
+			t_real val0 = std::get<t_real>(stack.top()); stack.pop();
+			stack.push(val0 / val1);
+		}
+
+		else if(tokens[0] == "MOD")
+		{
+			t_real val1 = std::get<t_real>(stack.top()); stack.pop();
+			t_real val0 = std::get<t_real>(stack.top()); stack.pop();
+			stack.push(std::fmod(val0, val1));
+		}
+
+		else if(tokens[0] == "POW")
+		{
+			t_real val1 = std::get<t_real>(stack.top()); stack.pop();
+			t_real val0 = std::get<t_real>(stack.top()); stack.pop();
+			stack.push(std::pow(val0, val1));
+		}
+
+		else if(tokens[0] == "CALL")
+		{
+			if(tokens.size() < 3)
+			{
+				std::cerr << "Need function name and argument count for call." << std::endl;
+				continue;
+			}
+
+			// the first argument is on top of the stack
+			int argCnt = std::stoi(tokens[2]);
+			const auto& funcs1 = get_funcs1();
+			const auto& funcs2 = get_funcs2();
+
+			if(auto iter = funcs1.find(tokens[1]); argCnt==1 && iter != funcs1.end())
+			{
+				t_real val = std::get<t_real>(stack.top()); stack.pop();
+				stack.push(iter->second(val));
+			}
+			else if(auto iter = funcs2.find(tokens[1]); argCnt==2 && iter != funcs2.end())
+			{
+				t_real val0 = std::get<t_real>(stack.top()); stack.pop();
+				t_real val1 = std::get<t_real>(stack.top()); stack.pop();
+				stack.push(iter->second(val0, val1));
+			}
+			else
+			{
+				std::cerr << "Unknown function: " << tokens[1] << "." << std::endl;
+			}
+		}
+		else if(tokens[0] == "END")
+		{
+			break;
+		}
+	}
+
+
+	std::vector<t_real> stack_vals;
+	while(stack.size())
+	{
+		stack_vals.push_back(std::get<t_real>(stack.top()));
+		stack.pop();
+	}
+	std::reverse(stack_vals.begin(), stack_vals.end());
+
+	return std::make_tuple(std::move(syms), std::move(stack_vals));
+}
+// ----------------------------------------------------------------------------
+
+
+
+// ----------------------------------------------------------------------------
+// binary code machine
+// ----------------------------------------------------------------------------
+/**
+ * runs verified bytecode with a flat stack and slot-indexed variables
+ */
+class VM0AC
+{
+public:
+	struct Func
+	{
+		t_real(*func1)(t_real) = nullptr;
+		t_real(*func2)(t_real, t_real) = nullptr;
+	};
+
+
+	/**
+	 * binds the variables and functions of the program
+	 */
+	bool Load(const Bytecode& prog)
+	{
+		const auto& funcs1 = get_funcs1();
+		const auto& funcs2 = get_funcs2();
+
+		bool ok = true;
+		m_loaded = false;
+		m_code = prog.GetCode();
+		m_names = prog.GetVars();
+		m_stack.resize(prog.GetMaxStack() + 1);
+		m_sp = 0;
+
+		const std::unordered_map<std::string, t_real> predef = get_predefined_syms();
+		m_vars.resize(m_names.size());
+		for(std::size_t slot=0; slot<m_names.size(); ++slot)
+		{
+			auto iter = predef.find(m_names[slot]);
+			m_vars[slot] = iter == predef.end() ? t_real{0} : iter->second;
+
+			if(prog.IsInput(slot) && iter == predef.end())
+			{
+				std::cerr << "Unknown variable: " << m_names[slot] << "." << std::endl;
+				ok = false;
+			}
+		}
+
+		m_funcs.clear();
+		for(const Bytecode::Func& func : prog.GetFuncs())
+		{
+			Func vmfunc;
+			if(auto iter = funcs1.find(func.name); func.num_args == 1 && iter != funcs1.end())
+				vmfunc.func1 = iter->second;
+			else if(auto iter = funcs2.find(func.name); func.num_args == 2 && iter != funcs2.end())
+				vmfunc.func2 = iter->second;
+			else
+			{
+				std::cerr << "Unknown function: " << func.name << "." << std::endl;
+				ok = false;
+			}
+
+			m_funcs.push_back(vmfunc);
+		}
+
+		m_loaded = ok;
+		return ok;
+	}
+
+
+	/**
+	 * runs the loaded program
+	 * @return false if no program has been loaded successfully
+	 */
+	bool Run()
+	{
+		if(!m_loaded)
+			return false;
+
+		const std::uint8_t *ip = m_code.data();
+		t_real *sp = m_stack.data();	// points behind the top of the stack
+		t_real *vars = m_vars.data();
+		const Func *funcs = m_funcs.data();
+		std::uint32_t idx = 0;
+
+#if VM_COMPUTED_GOTO
+		// jump targets in the order of the opcodes
+		static const void* const labels[] =
+		{
+			&&op_END, &&op_PUSH, &&op_PUSHVAL, &&op_ASSIGN,
+			&&op_UMIN,
+			&&op_ADD, &&op_SUB, &&op_MUL, &&op_DIV, &&op_MOD, &&op_POW,
+			&&op_CALL1, &&op_CALL2,
+		};
+		static_assert(sizeof(labels)/sizeof(*labels) == std::size_t(OpCode::NUM_OPCODES));
+
+		#define VM_OP(op) op_##op:
+		#define VM_NEXT() goto *labels[*ip++]
+
+		VM_NEXT();
+#else
+		#define VM_OP(op) case OpCode::op:
+		#define VM_NEXT() continue
+
+		while(true) switch(static_cast<OpCode>(*ip++))
+#endif
+		{
+			VM_OP(END)
+				goto end;
+
+			VM_OP(PUSH)
+				std::memcpy(sp++, ip, sizeof(t_real));
+				ip += sizeof(t_real);
+				VM_NEXT();
+
+			VM_OP(PUSHVAL)
+				std::memcpy(&idx, ip, sizeof(idx));
+				ip += sizeof(idx);
+				*sp++ = vars[idx];
+				VM_NEXT();
+
+			VM_OP(ASSIGN)
+				std::memcpy(&idx, ip, sizeof(idx));
+				ip += sizeof(idx);
+				vars[idx] = *--sp;
+				VM_NEXT();
+
+			VM_OP(UMIN)
+				sp[-1] = -sp[-1];
+				VM_NEXT();
+
+			VM_OP(ADD)
+				--sp;
+				sp[-1] = sp[-1] + sp[0];
+				VM_NEXT();
+
+			VM_OP(SUB)
+				--sp;
+				sp[-1] = sp[-1] - sp[0];
+				VM_NEXT();
+
+			VM_OP(MUL)
+				--sp;
+				sp[-1] = sp[-1] * sp[0];
+				VM_NEXT();
+
+			VM_OP(DIV)
+				--sp;
+				sp[-1] = sp[-1] / sp[0];
+				VM_NEXT();
+
+			VM_OP(MOD)
+				--sp;
+				sp[-1] = std::fmod(sp[-1], sp[0]);
+				VM_NEXT();
+
+			VM_OP(POW)
+				--sp;
+				sp[-1] = std::pow(sp[-1], sp[0]);
+				VM_NEXT();
+
+			VM_OP(CALL1)
+				std::memcpy(&idx, ip, sizeof(idx));
+				ip += sizeof(idx);
+				sp[-1] = funcs[idx].func1(sp[-1]);
+				VM_NEXT();
+
+			VM_OP(CALL2)
+				// the first argument is on top of the stack
+				std::memcpy(&idx, ip, sizeof(idx));
+				ip += sizeof(idx);
+				--sp;
+				sp[-1] = funcs[idx].func2(sp[0], sp[-1]);
+				VM_NEXT();
+
+#if !VM_COMPUTED_GOTO
+			default:
+				goto end;
+#endif
+		}
+
+		#undef VM_OP
+		#undef VM_NEXT
+
+	end:
+		m_sp = std::size_t(sp - m_stack.data());
+		return true;
+	}
+
+
+	t_vmstate GetState() const
+	{
+		std::unordered_map<std::string, t_real> syms = get_predefined_syms();
+		for(std::size_t slot=0; slot<m_names.size(); ++slot)
+			syms[m_names[slot]] = m_vars[slot];
+
+		return std::make_tuple(std::move(syms),
+			std::vector<t_real>(m_stack.begin(), m_stack.begin() + m_sp));
+	}
+
+
+private:
+	std::vector<std::uint8_t> m_code{};
+	std::vector<Func> m_funcs{};
+	bool m_loaded{false};
+
+	std::vector<std::string> m_names{};
+	std::vector<t_real> m_vars{};
+
+	std::vector<t_real> m_stack{};
+	std::size_t m_sp{0};
+};
+// ----------------------------------------------------------------------------
+
+}	// namespace vm0ac
+
+
+#endif
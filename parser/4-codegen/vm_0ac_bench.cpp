@@ -0,0 +1,224 @@
+/**
+ * compares the text interpreter with the bytecode machine on generated programs
+ * @author Tobias Weber
+ * @date oct-2026
+ * @license: see 'LICENSE.GPL' file
+ *
+ * g++ -O2 -march=native -std=c++17 -o vm_0ac_bench vm_0ac_bench.cpp
+ */
+
+#include "ast.h"
+#include "zeroac.h"
+#include "vm_0ac.h"
+using namespace vm0ac;
+
+#include <sstream>
+#include <cstring>
+#include <random>
+#include <chrono>
+
+
+/**
+ * random expression over the variables
+ */
+std::shared_ptr<AST> random_expr(std::mt19937& rnd, std::size_t num_vars, std::size_t depth)
+{
+	auto var = [&rnd, num_vars]() { return "v" + std::to_string(rnd() % num_vars); };
+
+	// constants are integers to print them exactly in the text code
+	if(depth == 0)
+	{
+		if(rnd() % 2)
+			return std::make_shared<ASTConst>(double(rnd() % 9 + 1));
+		return std::make_shared<ASTVar>(var());
+	}
+
+	auto term1 = random_expr(rnd, num_vars, depth - 1);
+	auto term2 = random_expr(rnd, num_vars, depth - 1);
+
+	static const char* funcs1[] = { "sin", "cos", "tan", "sqrt", "exp", "log" };
+	static const char* funcs2[] = { "pow", "atan2" };
+
+	switch(rnd() % 10)
+	{
+		case 0: return std::make_shared<ASTPlus>(term1, term2);
+		case 1: return std::make_shared<ASTMinus>(term1, term2);
+		case 2: return std::make_shared<ASTMult>(term1, term2);
+		case 3: return std::make_shared<ASTDiv>(term1, std::make_shared<ASTConst>(double(rnd() % 9 + 1)));
+		case 4: return std::make_shared<ASTMod>(term1, std::make_shared<ASTConst>(double(rnd() % 9 + 1)));
+		case 5: return std::make_shared<ASTPow>(term1, std::make_shared<ASTConst>(double(rnd() % 3 + 1)));
+		case 6: return std::make_shared<ASTUMinus>(term1);
+		case 7: return std::make_shared<ASTCall>(funcs1[rnd() % std::size(funcs1)], term1);
+		case 8: return std::make_shared<ASTCall>(funcs2[rnd() % std::size(funcs2)], term1, term2);
+		default: return std::make_shared<ASTPlus>(term1, std::make_shared<ASTVar>("pi"));
+	}
+}
+
+
+/**
+ * are the symbols and the stack contents the same?
+ */
+bool same_state(const t_vmstate& state1, const t_vmstate& state2)
+{
+	auto same = [](t_real val1, t_real val2) -> bool
+	{
+		return val1 == val2 || (std::isnan(val1) && std::isnan(val2));
+	};
+
+	const auto& [syms1, stack1] = state1;
+	const auto& [syms2, stack2] = state2;
+
+	if(syms1.size() != syms2.size() || stack1.size() != stack2.size())
+		return false;
+
+	for(const auto& [name, val] : syms1)
+	{
+		auto iter = syms2.find(name);
+		if(iter == syms2.end() || !same(val, iter->second))
+			return false;
+	}
+
+	for(std::size_t idx=0; idx<stack1.size(); ++idx)
+	{
+		if(!same(stack1[idx], stack2[idx]))
+			return false;
+	}
+
+	return true;
+}
+
+
+int main()
+{
+	std::mt19937 rnd{1234};
+	std::cout << std::boolalpha;
+
+	for(std::size_t num_statements : { 1000, 100000, 1000000 })
+	{
+		// generate the program, mostly assignments and some expressions left on the stack
+		const std::size_t num_vars = 16;
+		std::vector<std::shared_ptr<AST>> statements;
+		for(std::size_t var=0; var<num_vars; ++var)
+		{
+			statements.push_back(std::make_shared<ASTAssign>("v" + std::to_string(var),
+				std::make_shared<ASTConst>(double(var + 1))));
+		}
+		for(std::size_t stmt=0; stmt<num_statements; ++stmt)
+		{
+			auto expr = random_expr(rnd, num_vars, rnd() % 4);
+			if(rnd() % 20)
+				expr = std::make_shared<ASTAssign>("v" + std::to_string(rnd() % num_vars), expr);
+			statements.push_back(expr);
+		}
+
+		// emit the code
+		std::ostringstream ostr_text;
+		ZeroAC zeroac_text(&ostr_text);
+		ZeroAC zeroac_bin(nullptr, true);
+		for(const auto& stmt : statements)
+		{
+			stmt->accept(&zeroac_text);
+			stmt->accept(&zeroac_bin);
+			ostr_text << "\n";
+		}
+		ostr_text << "END\n";
+
+		std::ostringstream ostr_bin;
+		zeroac_bin.Finish().Save(ostr_bin);
+
+		const std::string text = ostr_text.str();
+		const std::string bin = ostr_bin.str();
+
+		// run both codes
+		auto start_text = std::chrono::steady_clock::now();
+		std::istringstream istr_text{text};
+		t_vmstate state_text = run(istr_text);
+		double time_text = std::chrono::duration<double>{std::chrono::steady_clock::now() - start_text}.count();
+
+		auto start_load = std::chrono::steady_clock::now();
+		std::istringstream istr_bin{bin};
+		std::optional<Bytecode> prog = Bytecode::Load(istr_bin);
+		VM0AC vm;
+		bool ok = prog && vm.Load(*prog);
+		double time_load = std::chrono::duration<double>{std::chrono::steady_clock::now() - start_load}.count();
+
+		if(!ok)
+		{
+			std::cerr << num_statements << " statements: could not load the bytecode." << std::endl;
+			return -1;
+		}
+
+		auto start_run = std::chrono::steady_clock::now();
+		vm.Run();
+		double time_run = std::chrono::duration<double>{std::chrono::steady_clock::now() - start_run}.count();
+
+		ok = ok && same_state(state_text, vm.GetState());
+
+		std::cout << num_statements << " statements, " << text.size() / 1024 << " kB text code, "
+			<< bin.size() / 1024 << " kB bytecode, " << prog->GetCode().size() << " bytes of instructions:" << std::endl;
+		std::cout << "\ttext interpreter: " << time_text << " s" << std::endl;
+		std::cout << "\tbytecode machine (computed goto: " << bool(VM_COMPUTED_GOTO) << "): load: "
+			<< time_load << " s, run: " << time_run << " s, ok = " << ok << std::endl;
+	}
+
+	// malformed code
+	{
+		Bytecode prog;
+		prog.EmitVar(OpCode::PUSHVAL, "x");
+		prog.Emit(OpCode::ADD);
+		prog.Emit(OpCode::END);
+
+		std::ostringstream ostr;
+		prog.Save(ostr);
+		std::istringstream istr{ostr.str()};
+		bool ok = !Bytecode::Load(istr);
+
+		const std::string truncated = ostr.str().substr(0, ostr.str().size() - 1);
+		std::istringstream istr_truncated{truncated};
+		ok = ok && !Bytecode::Load(istr_truncated);
+
+		// sizes in the header which exceed the buffer
+		for(std::size_t field=0; field<3; ++field)
+		{
+			std::string corrupt = ostr.str();
+			const std::uint32_t size = 0xffffffff;
+			std::memcpy(corrupt.data() + Bytecode::magic.size() + field*sizeof(size), &size, sizeof(size));
+			std::istringstream istr_corrupt{corrupt};
+			ok = ok && !Bytecode::Load(istr_corrupt);
+		}
+		std::cout << "rejected stack underflow, truncated code and corrupt sizes: ok = " << ok << std::endl;
+	}
+
+	// calls with an unsupported number of arguments
+	{
+		bool ok = true;
+		for(std::uint32_t num_args : { 0, 3 })
+		{
+			Bytecode prog;
+			try
+			{
+				prog.EmitCall("f", num_args);
+				ok = false;
+			}
+			catch(const std::invalid_argument&)
+			{
+				ok = ok && prog.GetCode().empty() && prog.GetFuncs().empty();
+			}
+		}
+		std::cout << "rejected calls with 0 and 3 arguments: ok = " << ok << std::endl;
+	}
+
+	// running without a successfully loaded program
+	{
+		VM0AC vm;
+		bool ok = !vm.Run();
+
+		Bytecode prog;
+		prog.EmitVar(OpCode::PUSHVAL, "unknown_var");
+		prog.Emit(OpCode::END);
+		ok = ok && prog.Verify() && !vm.Load(prog) && !vm.Run();
+		std::cout << "refused to run unloaded programs: ok = " << ok << std::endl;
+	}
+
+	return 0;
+}
@@ -9,15 +9,37 @@
 #define __ZEROAC_H__
 
 #include "ast.h"
+#include "bytecode.h"
 
 
+/**
+ * emits the zero-address code either as text or as binary bytecode
+ */
 class ZeroAC : public ASTVisitor
 {
 public:
+	ZeroAC(std::ostream* ostr = &std::cout, bool binary = false)
+		: m_ostr(ostr), m_binary(binary)
+	{}
+
+
+	/**
+	 * terminates the binary program
+	 */
+	const Bytecode& Finish()
+	{
+		m_code.Emit(OpCode::END);
+		return m_code;
+	}
+
+
 	virtual t_astret visit(const ASTUMinus* ast) override
 	{
 		ast->GetTerm()->accept(this);
-		(*m_ostr) << "UMIN\n";
+		if(m_binary)
+			m_code.Emit(OpCode::UMIN);
+		else
+			(*m_ostr) << "UMIN\n";
 		return t_astret{};
 	}
 
@@ -26,7 +48,10 @@ public:
 	{
 		ast->GetTerm1()->accept(this);
 		ast->GetTerm2()->accept(this);
-		(*m_ostr) << "ADD\n";
+		if(m_binary)
+			m_code.Emit(OpCode::ADD);
+		else
+			(*m_ostr) << "ADD\n";
 		return t_astret{};
 	}
 
@@ -35,7 +60,10 @@ public:
 	{
 		ast->GetTerm1()->accept(this);
 		ast->GetTerm2()->accept(this);
-		(*m_ostr) << "SUB\n";
+		if(m_binary)
+			m_code.Emit(OpCode::SUB);
+		else
+			(*m_ostr) << "SUB\n";
 		return t_astret{};
 	}
 
@@ -44,7 +72,10 @@ public:
 	{
 		ast->GetTerm1()->accept(this);
 		ast->GetTerm2()->accept(this);
-		(*m_ostr) << "MUL\n";
+		if(m_binary)
+			m_code.Emit(OpCode::MUL);
+		else
+			(*m_ostr) << "MUL\n";
 		return t_astret{};
 	}
 
@@ -53,7 +84,10 @@ public:
 	{
 		ast->GetTerm1()->accept(this);
 		ast->GetTerm2()->accept(this);
-		(*m_ostr) << "DIV\n";
+		if(m_binary)
+			m_code.Emit(OpCode::DIV);
+		else
+			(*m_ostr) << "DIV\n";
 		return t_astret{};
 	}
 
@@ -62,7 +96,10 @@ public:
 	{
 		ast->GetTerm1()->accept(this);
 		ast->GetTerm2()->accept(this);
-		(*m_ostr) << "MOD\n";
+		if(m_binary)
+			m_code.Emit(OpCode::MOD);
+		else
+			(*m_ostr) << "MOD\n";
 		return t_astret{};
 	}
 
@@ -71,21 +108,30 @@ public:
 	{
 		ast->GetTerm1()->accept(this);
 		ast->GetTerm2()->accept(this);
-		(*m_ostr) << "POW\n";
+		if(m_binary)
+			m_code.Emit(OpCode::POW);
+		else
+			(*m_ostr) << "POW\n";
 		return t_astret{};
 	}
 
 
 	virtual t_astret visit(const ASTConst* ast) override
 	{
-		(*m_ostr) << "PUSH " << ast->GetVal() << "\n";
+		if(m_binary)
+			m_code.EmitConst(ast->GetVal());
+		else
+			(*m_ostr) << "PUSH " << ast->GetVal() << "\n";
 		return t_astret{};
 	}
 
 
 	virtual t_astret visit(const ASTVar* ast) override
 	{
-		(*m_ostr) << "PUSHVAL " << ast->GetIdent() << "\n";
+		if(m_binary)
+			m_code.EmitVar(OpCode::PUSHVAL, ast->GetIdent());
+		else
+			(*m_ostr) << "PUSHVAL " << ast->GetIdent() << "\n";
 		return t_astret{};
 	}
 
@@ -106,7 +152,10 @@ public:
 			++numArgs;
 		}
 
-		(*m_ostr) << "CALL " << ast->GetIdent() << " " << numArgs << "\n";
+		if(m_binary)
+			m_code.EmitCall(ast->GetIdent(), numArgs);
+		else
+			(*m_ostr) << "CALL " << ast->GetIdent() << " " << numArgs << "\n";
 		return t_astret{};
 	}
 
@@ -114,14 +163,25 @@ public:
 	virtual t_astret visit(const ASTAssign* ast) override
 	{
 		ast->GetExpr()->accept(this);
-		(*m_ostr) << "PUSHVAR " << ast->GetIdent() << "\n";
-		(*m_ostr) << "ASSIGN\n";
+		if(m_binary)
+		{
+			m_code.EmitVar(OpCode::ASSIGN, ast->GetIdent());
+		}
+		else
+		{
+			(*m_ostr) << "PUSHVAR " << ast->GetIdent() << "\n";
+			(*m_ostr) << "ASSIGN\n";
+		}
 		return t_astret{};
 	}
 
 
 private:
 	std::ostream* m_ostr = &std::cout;
+
+	// binary output
+	bool m_binary = false;
+	Bytecode m_code{};
 };
 
 
@@ -8,6 +8,7 @@
 
 BISON=bison
 FLEX=flex
+LLVM_CONFIG=llvm-config
 
 if [ "${CXX}" == "" ]; then
 	CXX=g++
@@ -42,7 +43,23 @@ echo -e "\n---------------------------------------------------------------------
 echo -e "Running $($CXX --version | head -n 1)...\n"
 echo -e "Building parser...\n"
 
-if ! ${CXX} -O2 -march=native -Wall -Wextra -std=c++17 -o ${OUTNAME} parser.cpp parser_impl.cpp lexer_impl.cpp llasm.cpp -lboost_program_options; then
+# the in-process jit is only built if llvm is available
+JIT_FLAGS=
+JIT_SRCS=
+JIT_LIBS=
+if command -v ${LLVM_CONFIG} >/dev/null 2>&1 \
+	&& [ "$(${LLVM_CONFIG} --version | cut -d. -f1)" -ge 14 ]; then
+	echo -e "Building the jit with LLVM $(${LLVM_CONFIG} --version).\n"
+	JIT_FLAGS="-DHAVE_LLJIT -isystem $(${LLVM_CONFIG} --includedir)"
+	JIT_SRCS="lljit.cpp runtime.cpp"
+	JIT_LIBS="$(${LLVM_CONFIG} --ldflags --libs orcjit native asmparser passes)"
+else
+	echo -e "${LLVM_CONFIG} not found or llvm older than version 14, building without the jit.\n"
+fi
+
+if ! ${CXX} -O2 -march=native -Wall -Wextra -std=c++17 ${JIT_FLAGS} \
+	-o ${OUTNAME} parser.cpp parser_impl.cpp lexer_impl.cpp llasm.cpp ${JIT_SRCS} \
+	-lboost_program_options ${JIT_LIBS}; then
 	echo -e "Compilation of parser failed."
 	exit -1
 fi
@@ -0,0 +1,245 @@
+/**
+ * parser test - run the generated llvm code in-process using the orc jit
+ * @author Tobias Weber
+ * @date oct-2026
+ * @license: see 'LICENSE.GPL' file
+ *
+ * The orc interface changed between the llvm versions, version 14 is the minimum,
+ * newer interfaces are selected with LLVM_VERSION_MAJOR.
+ *
+ * References:
+ *	* https://llvm.org/docs/ORCv2.html
+ *	* https://llvm.org/docs/NewPassManager.html
+ *	* https://llvm.org/docs/tutorial/BuildingAJIT1.html
+ */
+
+#include "lljit.h"
+
+#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+
+#include <llvm/Config/llvm-config.h>
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/raw_ostream.h>
+
+#if LLVM_VERSION_MAJOR < 14
+	#error "The jit needs at least llvm version 14."
+#endif
+
+
+// ----------------------------------------------------------------------------
+// external runtime functions from runtime.cpp, linked into the compiler
+// ----------------------------------------------------------------------------
+using t_real = double;
+using t_int = std::int64_t;
+
+extern "C" bool ext_equals(t_real x, t_real y, t_real eps);
+extern "C" void ext_submat(const t_real* M, t_int N, t_real* M_new, t_int iremove, t_int jremove);
+extern "C" t_real ext_determinant(const t_real* M, t_int N);
+extern "C" t_int ext_inverse(const t_real* M, t_real* I, t_int N);
+extern "C" void ext_mult(const t_real* M1, const t_real* M2, t_real *RES, t_int I, t_int J, t_int K);
+extern "C" t_int ext_power(const t_real* M, t_real* P, t_int N, t_int POW);
+extern "C" void ext_transpose(const t_real* M, t_real* T, t_int rows, t_int cols);
+// ----------------------------------------------------------------------------
+
+
+/**
+ * print an llvm error and consume it
+ */
+static bool report(llvm::Error err, const char* what)
+{
+	if(!err)
+		return true;
+
+	std::cerr << "JIT error: " << what << ": " << llvm::toString(std::move(err)) << "." << std::endl;
+	return false;
+}
+
+
+struct LLJit::Impl
+{
+	std::unique_ptr<llvm::orc::LLJIT> jit{};
+};
+
+
+LLJit::LLJit(bool optimise) : m_impl{std::make_unique<Impl>()}, m_optimise{optimise}
+{
+	llvm::InitializeNativeTarget();
+	llvm::InitializeNativeTargetAsmPrinter();
+	llvm::InitializeNativeTargetAsmParser();
+
+	auto machine = llvm::orc::JITTargetMachineBuilder::detectHost();
+	if(!machine)
+	{
+		report(machine.takeError(), "cannot detect host");
+		return;
+	}
+#if LLVM_VERSION_MAJOR >= 18
+	machine->setCodeGenOptLevel(optimise ? llvm::CodeGenOptLevel::Default : llvm::CodeGenOptLevel::None);
+#else
+	machine->setCodeGenOptLevel(optimise ? llvm::CodeGenOpt::Default : llvm::CodeGenOpt::None);
+#endif
+
+	auto jit = llvm::orc::LLJITBuilder().setJITTargetMachineBuilder(std::move(*machine)).create();
+	if(!jit)
+	{
+		report(jit.takeError(), "cannot create jit");
+		return;
+	}
+
+	// resolve the libc functions in the compiler process
+	llvm::orc::JITDylib& lib = (*jit)->getMainJITDylib();
+	auto process_syms = llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+		(*jit)->getDataLayout().getGlobalPrefix());
+	if(!process_syms)
+	{
+		report(process_syms.takeError(), "cannot search process symbols");
+		return;
+	}
+	lib.addGenerator(std::move(*process_syms));
+
+	// directly bind the runtime functions
+	llvm::orc::MangleAndInterner mangle{(*jit)->getExecutionSession(), (*jit)->getDataLayout()};
+	llvm::orc::SymbolMap runtime_syms;
+	auto add_runtime = [&runtime_syms, &mangle](const char* name, auto* func)
+	{
+		const llvm::JITSymbolFlags flags = llvm::JITSymbolFlags::Exported | llvm::JITSymbolFlags::Callable;
+#if LLVM_VERSION_MAJOR >= 17
+		runtime_syms[mangle(name)] = llvm::orc::ExecutorSymbolDef(
+			llvm::orc::ExecutorAddr::fromPtr(func), flags);
+#else
+		runtime_syms[mangle(name)] = llvm::JITEvaluatedSymbol(
+			llvm::pointerToJITTargetAddress(func), flags);
+#endif
+	};
+
+	add_runtime("ext_equals", &ext_equals);
+	add_runtime("ext_submat", &ext_submat);
+	add_runtime("ext_determinant", &ext_determinant);
+	add_runtime("ext_inverse", &ext_inverse);
+	add_runtime("ext_mult", &ext_mult);
+	add_runtime("ext_power", &ext_power);
+	add_runtime("ext_transpose", &ext_transpose);
+
+	if(!report(lib.define(llvm::orc::absoluteSymbols(std::move(runtime_syms))), "cannot define runtime functions"))
+		return;
+
+	m_impl->jit = std::move(*jit);
+}
+
+
+LLJit::~LLJit() = default;
+
+
+bool LLJit::AddModule(const std::string& code, const std::string& name)
+{
+	if(!m_impl->jit)
+		return false;
+
+	// parse llvm assembly
+	auto start_parse = std::chrono::steady_clock::now();
+
+	auto ctx = std::make_unique<llvm::LLVMContext>();
+	llvm::SMDiagnostic diag;
+	std::unique_ptr<llvm::Module> mod = llvm::parseAssemblyString(code, diag, *ctx);
+	if(!mod)
+	{
+		diag.print(name.c_str(), llvm::errs());
+		return false;
+	}
+
+	mod->setModuleIdentifier(name);
+	mod->setDataLayout(m_impl->jit->getDataLayout());
+#if LLVM_VERSION_MAJOR >= 21
+	mod->setTargetTriple(m_impl->jit->getTargetTriple());
+#else
+	mod->setTargetTriple(m_impl->jit->getTargetTriple().str());
+#endif
+
+	// the bitcode assembler would reject invalid modules
+	if(llvm::verifyModule(*mod, &llvm::errs()))
+	{
+		std::cerr << "JIT error: invalid module \"" << name << "\"." << std::endl;
+		return false;
+	}
+
+	m_times.parse += std::chrono::duration<double>{std::chrono::steady_clock::now() - start_parse}.count();
+
+
+	// optimise, corresponding to "opt -O2"
+	if(m_optimise)
+	{
+		auto start_opt = std::chrono::steady_clock::now();
+
+		llvm::LoopAnalysisManager loop_analyses;
+		llvm::FunctionAnalysisManager func_analyses;
+		llvm::CGSCCAnalysisManager cgscc_analyses;
+		llvm::ModuleAnalysisManager module_analyses;
+
+		llvm::PassBuilder passes;
+		passes.registerModuleAnalyses(module_analyses);
+		passes.registerCGSCCAnalyses(cgscc_analyses);
+		passes.registerFunctionAnalyses(func_analyses);
+		passes.registerLoopAnalyses(loop_analyses);
+		passes.crossRegisterProxies(loop_analyses, func_analyses, cgscc_analyses, module_analyses);
+
+		llvm::ModulePassManager pipeline = passes.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O2);
+		pipeline.run(*mod, module_analyses);
+
+		m_times.optimise += std::chrono::duration<double>{std::chrono::steady_clock::now() - start_opt}.count();
+	}
+
+	return report(m_impl->jit->addIRModule(
+		llvm::orc::ThreadSafeModule{std::move(mod), std::move(ctx)}), "cannot add module");
+}
+
+
+void* LLJit::Lookup(const std::string& func)
+{
+	if(!m_impl->jit)
+		return nullptr;
+
+	// the first lookup materialises the module
+	auto start_codegen = std::chrono::steady_clock::now();
+	auto sym = m_impl->jit->lookup(func);
+	m_times.codegen += std::chrono::duration<double>{std::chrono::steady_clock::now() - start_codegen}.count();
+
+	if(!sym)
+	{
+		report(sym.takeError(), "cannot find function");
+		return nullptr;
+	}
+
+#if LLVM_VERSION_MAJOR >= 15
+	return sym->toPtr<void*>();
+#else
+	return llvm::jitTargetAddressToPointer<void*>(sym->getAddress());
+#endif
+}
+
+
+bool LLJit::Run(const std::string& func)
+{
+	using t_entry = void(*)();
+	t_entry entry = reinterpret_cast<t_entry>(Lookup(func));
+	if(!entry)
+		return false;
+
+	// the jitted code writes to the c stdio streams
+	std::cout.flush();
+	entry();
+	std::fflush(stdout);
+
+	return true;
+}
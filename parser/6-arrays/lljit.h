@@ -0,0 +1,71 @@
+/**
+ * parser test - run the generated llvm code in-process using the orc jit
+ * @author Tobias Weber
+ * @date oct-2026
+ * @license: see 'LICENSE.GPL' file
+ *
+ * References:
+ *	* https://llvm.org/docs/ORCv2.html
+ *	* https://llvm.org/docs/NewPassManager.html
+ */
+
+#ifndef __LLJIT_H__
+#define __LLJIT_H__
+
+#include <string>
+#include <memory>
+
+
+/**
+ * durations of the jit compilation steps in seconds
+ */
+struct LLJitTimes
+{
+	double parse = 0.;	// llvm assembly -> in-memory module
+	double optimise = 0.;	// O2 pass pipeline
+	double codegen = 0.;	// module -> machine code, including symbol resolution
+};
+
+
+/**
+ * compiles a module of llvm assembly to machine code in memory
+ * and links it to the libc and to the ext_* functions of runtime.cpp
+ */
+class LLJit
+{
+public:
+	LLJit(bool optimise = false);
+	~LLJit();
+
+	LLJit(const LLJit&) = delete;
+	LLJit& operator=(const LLJit&) = delete;
+
+	/**
+	 * parses and optionally optimises the module
+	 */
+	bool AddModule(const std::string& code, const std::string& name = "module");
+
+	/**
+	 * generates the machine code of the module and looks up a function
+	 * @return address of the function, or nullptr on failure
+	 */
+	void* Lookup(const std::string& func);
+
+	/**
+	 * compiles and calls an entry function without arguments, like start()
+	 */
+	bool Run(const std::string& func = "start");
+
+	const LLJitTimes& GetTimes() const { return m_times; }
+
+
+private:
+	struct Impl;
+	std::unique_ptr<Impl> m_impl{};
+
+	bool m_optimise = false;
+	LLJitTimes m_times{};
+};
+
+
+#endif
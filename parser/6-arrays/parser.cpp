@@ -8,8 +8,13 @@
 #include "ast.h"
 #include "parser.h"
 #include "llasm.h"
+#ifdef HAVE_LLJIT
+	#include "lljit.h"
+#endif
 
 #include <fstream>
+#include <sstream>
+#include <chrono>
 #include <boost/program_options.hpp>
 namespace args = boost::program_options;
 
@@ -73,6 +78,9 @@ int main(int argc, char** argv)
 		// --------------------------------------------------------------------
 		std::vector<std::string> vecProgs;
 		bool interpret = false;
+#ifdef HAVE_LLJIT
+		bool jit = false;
+#endif
 		bool optimise = false;
 		bool show_symbols = false;
 		std::string outprog;
@@ -82,6 +90,9 @@ int main(int argc, char** argv)
 			("out,o", args::value(&outprog), "compiled program output")
 			("optimise,O", args::bool_switch(&optimise), "optimise program")
 			("interpret,i", args::bool_switch(&interpret), "directly run program in interpreter")
+#ifdef HAVE_LLJIT
+			("jit,j", args::bool_switch(&jit), "compile and run program in-process using the llvm jit")
+#endif
 			("symbols,s", args::bool_switch(&show_symbols), "print symbol table")
 			("program", args::value<decltype(vecProgs)>(&vecProgs), "input program to compile");
 
@@ -140,6 +151,7 @@ int main(int argc, char** argv)
 		// parse input
 		// --------------------------------------------------------------------
 		const std::string& inprog = vecProgs[0];
+		[[maybe_unused]] auto start_frontend = std::chrono::steady_clock::now();
 		std::cout << "Parsing \"" << inprog << "\"..." << std::endl;
 
 		std::ifstream ifstr{inprog};
@@ -194,8 +206,8 @@ int main(int argc, char** argv)
 		std::cout << "Generating intermediate code: \""
 			<< inprog << "\" -> \"" << outprog_3ac << "\"..." << std::endl;
 
-		std::ofstream ofstr{outprog_3ac};
-		std::ostream* ostr = &ofstr /*&std::cout*/;
+		std::ostringstream ostr_3ac;
+		std::ostream* ostr = &ostr_3ac /*&std::cout*/;
 		LLAsm llasm{&ctx.GetSymbols(), ostr};
 		auto stmts = ctx.GetStatements()->GetStatementList();
 		for(auto iter=stmts.rbegin(); iter!=stmts.rend(); ++iter)
@@ -354,6 +366,49 @@ define i32 @main()
 )START";
 
 		(*ostr) << std::endl;
+
+		const std::string code_3ac = ostr_3ac.str();
+		std::ofstream{outprog_3ac} << code_3ac;
+		// --------------------------------------------------------------------
+
+
+
+		// --------------------------------------------------------------------
+		// in-process compilation and execution
+		// --------------------------------------------------------------------
+#ifdef HAVE_LLJIT
+		if(jit)
+		{
+			const double time_frontend = std::chrono::duration<double>(
+				std::chrono::steady_clock::now() - start_frontend).count();
+			std::cout << "JIT-compiling intermediate code \"" << outprog_3ac << "\"..." << std::endl;
+
+			// the runtime functions are linked into the compiler, no runtime code is needed
+			LLJit lljit{optimise};
+			if(!lljit.AddModule(code_3ac, outprog_3ac) || !lljit.Lookup("start"))
+			{
+				std::cerr << "Failed." << std::endl;
+				return -1;
+			}
+
+			const LLJitTimes& times = lljit.GetTimes();
+			std::cout << "Compile times: parser and code generator: " << time_frontend << " s"
+				<< ", llvm assembly parser: " << times.parse << " s"
+				<< ", optimiser: " << times.optimise << " s"
+				<< ", machine code: " << times.codegen << " s"
+				<< ", total: " << time_frontend + times.parse + times.optimise + times.codegen << " s."
+				<< std::endl;
+
+			std::cout << "Running start()..." << std::endl;
+			if(!lljit.Run("start"))
+			{
+				std::cerr << "Failed." << std::endl;
+				return -1;
+			}
+
+			return 0;
+		}
+#endif
 		// --------------------------------------------------------------------
 
 
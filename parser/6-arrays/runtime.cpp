@@ -14,7 +14,7 @@
 using t_real = double;
 using t_int = std::int64_t;
 
-t_real g_eps = std::numeric_limits<t_real>::epsilon();
+static t_real g_eps = std::numeric_limits<t_real>::epsilon();
 
 
 /**
@@ -171,14 +171,14 @@ extern "C" t_int ext_power(const t_real* M, t_real* P, t_int N, t_int POW)
 	t_int POW_pos = POW<0 ? -POW : POW;
 	t_int status = 1;
 
-	// temporary matrices
-	t_real *Mtmp = reinterpret_cast<t_real*>(std::malloc(sizeof(t_real)*N*N));
-	t_real *Mtmp2 = reinterpret_cast<t_real*>(std::malloc(sizeof(t_real)*N*N));
+	// temporary matrices, zero-initialised
+	t_real *Mtmp = reinterpret_cast<t_real*>(std::calloc(N*N, sizeof(t_real)));
+	t_real *Mtmp2 = reinterpret_cast<t_real*>(std::calloc(N*N, sizeof(t_real)));
 
-	// Mtmp = M
+	// Mtmp = M, or the identity for a zero power
 	for(t_int i=0; i<N; ++i)
 		for(t_int j=0; j<N; ++j)
-			Mtmp[i*N + j] = M[i*N + j];
+			Mtmp[i*N + j] = POW_pos ? M[i*N + j] : (i==j ? 1. : 0.);
 
 	// matrix power
 	for(t_int i=0; i<POW_pos-1; ++i)
@@ -192,13 +192,17 @@ extern "C" t_int ext_power(const t_real* M, t_real* P, t_int N, t_int POW)
 	}
 
 	// invert
+	const t_real *result = Mtmp;
 	if(POW < 0)
+	{
 		status = ext_inverse(Mtmp, Mtmp2, N);
+		result = Mtmp2;
+	}
 
-	// P = Mtmp2
+	// P = result
 	for(t_int i=0; i<N; ++i)
 		for(t_int j=0; j<N; ++j)
-			P[i*N + j] = Mtmp2[i*N + j];
+			P[i*N + j] = result[i*N + j];
 
 	std::free(Mtmp);
 	std::free(Mtmp2);
@@ -0,0 +1,265 @@
+/**
+ * compares evaluating a compiled expression with re-parsing it for every input
+ *
+ * @author Tobias Weber
+ * @date oct-2026
+ * @license see 'LICENSE.EUPL' file
+ */
+
+#include "expr_parser.h"
+
+#include <chrono>
+
+
+template<class t_func>
+double bench(t_func&& func)
+{
+	auto start = std::chrono::steady_clock::now();
+	func();
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+/**
+ * largest relative deviation between the results
+ */
+template<typename t_real>
+t_real max_rel_error(const std::vector<t_real>& vals1, const std::vector<t_real>& vals2)
+{
+	t_real err{0};
+	for(std::size_t i=0; i<vals1.size(); ++i)
+	{
+		t_real diff = std::abs(vals1[i] - vals2[i]);
+		err = std::max(err, diff / std::max(std::abs(vals1[i]), t_real{1}));
+	}
+	return err;
+}
+
+
+int main()
+{
+	using t_real = double;
+	std::cout << std::boolalpha;
+
+	// compare with the results of the parser
+	{
+		const char* exprs[] =
+		{
+			"a = 2 + 3*4", "(2 + (b=3))*4 + b*2", "-2^2 + 2^3^2",
+			"pow((2 + 3)*4, 2) % 7", "sqrt(400) - atan2(1, 2)*cos(pi)",
+			"c = c + 1", "-x*y - x/y - (x - y)",
+		};
+
+		ExprParser<t_real> parser, parser_compile;
+		parser.set_symbol("x", 1.5);
+		parser.set_symbol("y", -4.);
+		parser.set_symbol("c", 5.);
+		parser_compile.set_symbol("x", 1.5);
+		parser_compile.set_symbol("y", -4.);
+		parser_compile.set_symbol("c", 5.);
+
+		bool ok = parser.parse("-2^2 + 2^3^2") == 60.;
+		for(const char* expr : exprs)
+		{
+			t_real val = parser.parse(expr);
+
+			std::optional<ExprProgram<t_real>> prog = parser_compile.compile(expr);
+			if(!prog)
+			{
+				ok = false;
+				continue;
+			}
+
+			std::vector<t_real> slots = prog->make_slots();
+			ok = ok && prog->eval(slots) == val;
+		}
+
+		// syntax errors and unknown functions
+		ok = ok && !parser_compile.compile("2 + ") && !parser_compile.compile("foo(1)");
+		std::cout << "compiled results: ok = " << ok << std::endl;
+
+		// too few variable values or input columns
+		std::optional<ExprProgram<t_real>> prog = parser_compile.compile("x*y + c");
+		std::vector<t_real> slots_short(prog->get_vars().size() - 1);
+		std::vector<const t_real*> columns_short(prog->get_vars().size() - 1, nullptr);
+		std::vector<t_real> results(4);
+
+		auto rejects = [](auto&& func) -> bool
+		{
+			try { func(); }
+			catch(const std::invalid_argument&) { return true; }
+			return false;
+		};
+		bool ok_rejected = rejects([&]() { prog->eval(slots_short); })
+			&& rejects([&]() { prog->eval_columns(columns_short, results.size(), results.data()); })
+			&& rejects([&]() { prog->eval_blocks(columns_short, results.size(), results.data(), 1); });
+		std::cout << "mismatching inputs rejected: ok = " << ok_rejected << std::endl;
+	}
+
+	// evaluate a formula over many rows
+	{
+		const std::size_t num_rows = 1'000'000;
+		std::vector<t_real> xs(num_rows), ys(num_rows);
+		std::mt19937 rnd{1234};
+		std::uniform_real_distribution<t_real> dist(-10., 10.);
+		for(std::size_t row=0; row<num_rows; ++row)
+		{
+			xs[row] = dist(rnd);
+			ys[row] = dist(rnd);
+		}
+
+		const char* formula = "sqrt(x*x + y*y) + 2*x*y/(1 + y*y) - x^3 + sin(x)";
+		ExprParser<t_real> parser;
+
+		// re-parse the formula for every row
+		const std::size_t num_parse = num_rows / 20;
+		std::vector<t_real> results_parse(num_parse);
+		double time_parse = bench([&]()
+		{
+			for(std::size_t row=0; row<num_parse; ++row)
+			{
+				parser.set_symbol("x", xs[row]);
+				parser.set_symbol("y", ys[row]);
+				results_parse[row] = parser.parse(formula);
+			}
+		});
+
+		// compile once, evaluate for every row
+		std::optional<ExprProgram<t_real>> prog = parser.compile(formula);
+		const std::size_t slot_x = *prog->get_slot("x"), slot_y = *prog->get_slot("y");
+
+		std::vector<t_real> results_eval(num_rows);
+		double time_eval = bench([&]()
+		{
+			std::vector<t_real> slots = prog->make_slots();
+			for(std::size_t row=0; row<num_rows; ++row)
+			{
+				slots[slot_x] = xs[row];
+				slots[slot_y] = ys[row];
+				results_eval[row] = prog->eval(slots);
+			}
+		});
+
+		std::vector<t_real> results_cols(num_rows);
+		double time_cols = bench([&]()
+		{
+			std::vector<const t_real*> columns(prog->get_vars().size(), nullptr);
+			columns[slot_x] = xs.data();
+			columns[slot_y] = ys.data();
+			prog->eval_columns(columns, num_rows, results_cols.data());
+		});
+
+		bool ok = std::equal(results_parse.begin(), results_parse.end(), results_eval.begin())
+			&& results_eval == results_cols;
+
+		std::cout << "\n\"" << formula << "\", " << prog->get_code().size() << " instructions:" << std::endl;
+		std::cout << "\tparse: " << double(num_parse) / time_parse / 1e6 << " Mrows/s" << std::endl;
+		std::cout << "\teval: " << double(num_rows) / time_eval / 1e6 << " Mrows/s" << std::endl;
+		std::cout << "\teval_columns: " << double(num_rows) / time_cols / 1e6 << " Mrows/s"
+			<< ", ok = " << ok << std::endl;
+	}
+
+	// block-wise evaluation, including a partial block at the end of each thread's rows
+	{
+		const std::size_t num_rows = 3*EXPR_ROWS_PER_THREAD + 17;
+		std::vector<t_real> xs(num_rows), ys(num_rows);
+		std::vector<int> xs_int(num_rows), ys_int(num_rows);
+		std::mt19937 rnd{5678};
+		std::uniform_real_distribution<t_real> dist(-10., 10.);
+		for(std::size_t row=0; row<num_rows; ++row)
+		{
+			xs[row] = dist(rnd);
+			ys[row] = dist(rnd);
+			xs_int[row] = int(xs[row] * 100.);
+			ys_int[row] = int(ys[row] * 100.) | 1;
+		}
+
+		ExprParser<t_real> parser;
+		parser.set_symbol("z", 0.5);
+		std::optional<ExprProgram<t_real>> prog = parser.compile(
+			"(c = x*2) + c*y + pow(x, 2) - sqrt(y*y) % 3 + exp(x/10) + cos(y)*z - x^3 + atan2(y, x)");
+
+		std::vector<const t_real*> columns(prog->get_vars().size(), nullptr);
+		columns[*prog->get_slot("x")] = xs.data();
+		columns[*prog->get_slot("y")] = ys.data();
+
+		std::vector<t_real> results_rows(num_rows), results_blocks(num_rows), results_threads(num_rows);
+		prog->eval_columns(columns, num_rows, results_rows.data());
+		prog->eval_blocks(columns, num_rows, results_blocks.data(), 1);
+		prog->eval_blocks(columns, num_rows, results_threads.data(), 3);
+
+		ExprParser<int> parser_int;
+		std::optional<ExprProgram<int>> prog_int = parser_int.compile("x*3 - y % 4 + (x - y)*2 + (w = y) / 7 - w");
+		std::vector<const int*> columns_int(prog_int->get_vars().size(), nullptr);
+		columns_int[*prog_int->get_slot("x")] = xs_int.data();
+		columns_int[*prog_int->get_slot("y")] = ys_int.data();
+
+		std::vector<int> results_int_rows(num_rows), results_int_blocks(num_rows);
+		prog_int->eval_columns(columns_int, num_rows, results_int_rows.data());
+		prog_int->eval_blocks(columns_int, num_rows, results_int_blocks.data(), 2);
+
+		// integer division in a partial block, the padding lanes must not divide by zero
+		const std::size_t num_rows_div = 300;
+		std::vector<int> divisors(num_rows_div);
+		for(std::size_t row=0; row<num_rows_div; ++row)
+			divisors[row] = int(row) + 1;
+
+		std::optional<ExprProgram<int>> prog_div = parser_int.compile("100 / x");
+		std::vector<const int*> columns_div(prog_div->get_vars().size(), nullptr);
+		columns_div[*prog_div->get_slot("x")] = divisors.data();
+
+		std::vector<int> results_div_rows(num_rows_div), results_div_blocks(num_rows_div);
+		prog_div->eval_columns(columns_div, num_rows_div, results_div_rows.data());
+		prog_div->eval_blocks(columns_div, num_rows_div, results_div_blocks.data(), 1);
+
+		const t_real err = std::max(max_rel_error(results_rows, results_blocks), max_rel_error(results_rows, results_threads));
+		std::cout << "\nblock evaluation (simd: " << expr_block<t_real>::use_simd
+			<< ", libmvec: " << bool(EXPR_USE_LIBMVEC) << "): max. relative error: " << err
+			<< ", ok = " << (err < 1e-12 && results_int_rows == results_int_blocks
+				&& results_div_rows == results_div_blocks) << std::endl;
+	}
+
+	// throughput of the block-wise evaluation
+	{
+		const std::size_t num_rows = 10'000'000;
+		std::vector<t_real> xs(num_rows), ys(num_rows);
+		std::mt19937 rnd{1234};
+		std::uniform_real_distribution<t_real> dist(-10., 10.);
+		for(std::size_t row=0; row<num_rows; ++row)
+		{
+			xs[row] = dist(rnd);
+			ys[row] = dist(rnd);
+		}
+
+		const char* formulas[] =
+		{
+			"x*y + 2*x - y/3 + (x - 1)*(y + 1)",
+			"sqrt(x*x + y*y) + 2*x*y/(1 + y*y) - x^3 + sin(x)",
+			"exp(-x*x/2)*cos(y) + pow(y*y, 0.25)",
+		};
+
+		ExprParser<t_real> parser;
+		for(const char* formula : formulas)
+		{
+			std::optional<ExprProgram<t_real>> prog = parser.compile(formula);
+			std::vector<const t_real*> columns(prog->get_vars().size(), nullptr);
+			columns[*prog->get_slot("x")] = xs.data();
+			columns[*prog->get_slot("y")] = ys.data();
+
+			std::vector<t_real> results_rows(num_rows), results_blocks(num_rows), results_threads(num_rows);
+			double time_rows = bench([&]() { prog->eval_columns(columns, num_rows, results_rows.data()); });
+			double time_blocks = bench([&]() { prog->eval_blocks(columns, num_rows, results_blocks.data(), 1); });
+			double time_threads = bench([&]() { prog->eval_blocks(columns, num_rows, results_threads.data()); });
+
+			std::cout << "\n\"" << formula << "\", " << num_rows << " rows:" << std::endl;
+			std::cout << "\tper row: " << double(num_rows) / time_rows / 1e6 << " Mrows/s" << std::endl;
+			std::cout << "\tblocks: " << double(num_rows) / time_blocks / 1e6 << " Mrows/s" << std::endl;
+			std::cout << "\tblocks, " << std::thread::hardware_concurrency() << " threads: "
+				<< double(num_rows) / time_threads / 1e6 << " Mrows/s, max. relative error: "
+				<< std::max(max_rel_error(results_rows, results_blocks), max_rel_error(results_rows, results_threads))
+				<< std::endl;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,292 @@
+/**
+ * compares the dfa lexer of the expression parser with the previous regex-based one
+ *
+ * @author Tobias Weber
+ * @date oct-2026
+ * @license see 'LICENSE.EUPL' file
+ */
+
+#include "expr_parser.h"
+
+#include <sstream>
+#include <regex>
+#include <memory>
+#include <chrono>
+#include <cctype>
+
+
+/**
+ * exposes the dfa lexer of the parser
+ */
+template<typename t_real>
+class DfaLexer : public ExprParser<t_real>
+{
+public:
+	std::vector<std::tuple<int, t_real, std::string>> tokenise(std::string_view str)
+	{
+		std::vector<std::tuple<int, t_real, std::string>> tokens;
+		this->set_input(str);
+
+		while(true)
+		{
+			auto [tok, val, text] = this->lex();
+			if(tok == (int)ExprParser<t_real>::Token::TOK_END)
+				break;
+			tokens.emplace_back(tok, val, std::string{text});
+		}
+
+		return tokens;
+	}
+
+
+	std::size_t count_tokens(std::string_view str)
+	{
+		std::size_t num_tokens = 0;
+		this->set_input(str);
+		while(std::get<0>(this->lex()) != (int)ExprParser<t_real>::Token::TOK_END)
+			++num_tokens;
+		return num_tokens;
+	}
+};
+
+
+/**
+ * the previous lexer, matching the regular expressions character by character
+ */
+template<typename t_real>
+class RegexLexer
+{
+public:
+	enum class Token : int
+	{
+		TOK_REAL	= 1000,
+		TOK_IDENT	= 1001,
+		TOK_END		= 1002,
+	};
+
+	std::vector<std::tuple<int, t_real, std::string>> tokenise(const std::string& str)
+	{
+		std::vector<std::tuple<int, t_real, std::string>> tokens;
+		m_istr = std::make_shared<std::istringstream>(str);
+
+		while(true)
+		{
+			auto [tok, val, text] = lex();
+			if(tok == (int)Token::TOK_END)
+				break;
+			tokens.emplace_back(tok, val, text);
+		}
+
+		return tokens;
+	}
+
+
+protected:
+	/**
+	 * find all matching tokens for input string
+	 */
+	std::vector<std::pair<int, t_real>> get_matching_tokens(const std::string& str)
+	{
+		std::vector<std::pair<int, t_real>> matches;
+
+		{	// real
+			std::regex regex{std::is_floating_point_v<t_real> ? "[0-9]+(\\.[0-9]*)?" : "[0-9]+"};
+			std::smatch smatch;
+			if(std::regex_match(str, smatch, regex))
+			{
+				t_real val{};
+				std::istringstream{str} >> val;
+				matches.emplace_back(std::make_pair((int)Token::TOK_REAL, val));
+			}
+		}
+
+		{	// ident
+			std::regex regex{"[A-Za-z]+[A-Za-z0-9]*"};
+			std::smatch smatch;
+			if(std::regex_match(str, smatch, regex))
+				matches.emplace_back(std::make_pair((int)Token::TOK_IDENT, 0.));
+		}
+
+		{	// tokens represented by themselves
+			if(str == "+" || str == "-" || str == "*" || str == "/" || str == "%" ||
+				str == "^" || str == "(" || str == ")" || str == "," || str == "=")
+				matches.emplace_back(std::make_pair((int)str[0], 0.));
+		}
+
+		return matches;
+	}
+
+
+	/**
+	 * @return [token, yylval, yytext]
+	 */
+	std::tuple<int, t_real, std::string> lex()
+	{
+		std::string input, longest_input;
+		std::vector<std::pair<int, t_real>> longest_matching;
+
+		// find longest matching token
+		while(1)
+		{
+			char c = m_istr->get();
+
+			if(m_istr->eof())
+				break;
+			// if outside any other match...
+			if(longest_matching.size() == 0)
+			{
+				// ...ignore white spaces
+				if(c==' ' || c=='\t')
+					continue;
+				// ...end on new line
+				if(c=='\n')
+					return std::make_tuple((int)Token::TOK_END, t_real{0}, longest_input);
+			}
+
+			input += c;
+			auto matching = get_matching_tokens(input);
+			if(matching.size())
+			{
+				longest_input = input;
+				longest_matching = matching;
+
+				if(m_istr->peek() == std::char_traits<char>::eof() || m_istr->eof())
+					break;
+			}
+			else
+			{
+				// no more matches
+				m_istr->putback(c);
+				break;
+			}
+		}
+
+		// at EOF or nothing matches
+		if(longest_matching.size() == 0)
+			return std::make_tuple((int)Token::TOK_END, t_real{0}, longest_input);
+
+		return std::make_tuple((int)std::get<0>(longest_matching[0]), std::get<1>(longest_matching[0]), longest_input);
+	}
+
+
+private:
+	std::shared_ptr<std::istream> m_istr{};
+};
+
+
+/**
+ * random formula consisting of all token types
+ */
+std::string random_formula(std::size_t num_tokens, std::mt19937& rnd)
+{
+	static const char* idents[] = { "a", "xyz", "sqrt", "pow", "var12", "B7c" };
+	static const char* ops[] = { "+", "-", "*", "/", "%", "^", "(", ")", ",", "=" };
+	static const char* spaces[] = { "", "", " ", "\t", "  " };
+
+	std::string str;
+	for(std::size_t tok=0; tok<num_tokens; ++tok)
+	{
+		switch(rnd() % 4)
+		{
+			case 0: str += std::to_string(rnd() % 10000); break;
+			case 1: str += std::to_string(rnd() % 1000) + "." + std::to_string(rnd() % 1000); break;
+			case 2: str += idents[rnd() % std::size(idents)]; break;
+			case 3: str += ops[rnd() % std::size(ops)]; break;
+		}
+
+		// a space is needed to separate adjacent numbers and identifiers
+		str += spaces[rnd() % std::size(spaces)];
+		if(!str.empty() && str.back() != ' ' && str.back() != '\t' && std::isalnum(str.back()))
+			str += ' ';
+	}
+
+	return str;
+}
+
+
+template<class t_func>
+double bench(t_func&& func)
+{
+	auto start = std::chrono::steady_clock::now();
+	func();
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+int main()
+{
+	using t_real = double;
+	std::mt19937 rnd{1234};
+	std::cout << std::boolalpha;
+
+	// compare tokens with the ones of the regex lexer
+	std::vector<std::string> formulas;
+	for(std::size_t i=0; i<500; ++i)
+		formulas.push_back(random_formula(1 + i%32, rnd));
+	formulas.push_back("12ab3 4.5 1. x1y2 007");
+
+	{
+		DfaLexer<t_real> dfa;
+		RegexLexer<t_real> regex;
+		DfaLexer<int> dfa_int;
+		RegexLexer<int> regex_int;
+
+		bool ok = true;
+		for(const std::string& formula : formulas)
+		{
+			const std::string without_dots = std::regex_replace(formula, std::regex{"\\."}, "");
+			ok = ok && dfa.tokenise(formula) == regex.tokenise(formula)
+				&& dfa_int.tokenise(without_dots) == regex_int.tokenise(without_dots);
+		}
+		std::cout << "tokens equal to regex lexer: ok = " << ok << std::endl;
+	}
+
+	// parser results
+	{
+		ExprParser<t_real> parser;
+		bool ok = parser.parse("a = 2 + 3*4") == 14.;
+		ok = ok && parser.parse("(2 + (b=3))*4 + b*2") == 26.;
+		ok = ok && parser.parse("pow((2 + 3)*4, 2)") == 400.;
+		ok = ok && parser.parse("sqrt(400) + 1.5 + 2.") == 23.5;
+		ok = ok && parser.parse("a*b\nignored") == 42.;
+
+		ExprParser<int> parser_int;
+		ok = ok && parser_int.parse("(2 + 3)*4 % 7") == 6;
+		std::cout << "parser results: ok = " << ok << std::endl;
+	}
+
+	// throughput
+	{
+		std::size_t num_chars = 0;
+		for(const std::string& formula : formulas)
+			num_chars += formula.size();
+
+		RegexLexer<t_real> regex;
+		std::size_t num_regex = 0;
+		double time_regex = bench([&]()
+		{
+			for(const std::string& formula : formulas)
+				num_regex += regex.tokenise(formula).size();
+		});
+
+		// repeat the dfa lexer for measurable times
+		constexpr std::size_t dfa_repeats = 2000;
+		DfaLexer<t_real> dfa;
+		std::size_t num_dfa = 0;
+		double time_dfa = bench([&]()
+		{
+			for(std::size_t rep=0; rep<dfa_repeats; ++rep)
+				for(const std::string& formula : formulas)
+					num_dfa += dfa.count_tokens(formula);
+		});
+
+		std::cout << "\n" << formulas.size() << " formulas, " << num_chars << " characters, "
+			<< num_regex << " tokens:" << std::endl;
+		std::cout << "\tregex lexer: " << double(num_chars) / time_regex / 1e6 << " MB/s, "
+			<< double(num_regex) / time_regex / 1e6 << " Mtokens/s" << std::endl;
+		std::cout << "\tdfa lexer: " << double(num_chars*dfa_repeats) / time_dfa / 1e6 << " MB/s, "
+			<< double(num_dfa) / time_dfa / 1e6 << " Mtokens/s" << std::endl;
+	}
+
+	return 0;
+}
@@ -15,25 +15,634 @@
 
 
 #include <iostream>
-#include <fstream>
-#include <sstream>
-#include <regex>
+#include <string>
+#include <string_view>
+#include <charconv>
 #include <unordered_map>
 #include <vector>
-#include <memory>
+#include <array>
+#include <span>
+#include <tuple>
+#include <optional>
+#include <stdexcept>
+#include <algorithm>
+#include <functional>
+#include <thread>
 #include <random>
+#include <cstdint>
 #include <cmath>
 
 
+#ifndef EXPR_STACK_SIZE
+	#define EXPR_STACK_SIZE 64
+#endif
+
+// number of rows evaluated at once by ExprProgram::eval_blocks()
+#ifndef EXPR_BLOCK_SIZE
+	#define EXPR_BLOCK_SIZE 256
+#endif
+
+// minimum number of rows per thread in ExprProgram::eval_blocks()
+#ifndef EXPR_ROWS_PER_THREAD
+	#define EXPR_ROWS_PER_THREAD (1 << 16)
+#endif
+
+// use the vector math functions of glibc's libmvec, needs -lmvec
+#ifndef EXPR_USE_LIBMVEC
+	#define EXPR_USE_LIBMVEC 0
+#endif
+
+
+#if defined(__AVX2__)
+	#include <immintrin.h>
+
+	#if EXPR_USE_LIBMVEC
+		extern "C"
+		{
+			__m256d _ZGVdN4v_sin(__m256d);
+			__m256d _ZGVdN4v_cos(__m256d);
+			__m256d _ZGVdN4v_exp(__m256d);
+			__m256d _ZGVdN4vv_pow(__m256d, __m256d);
+		}
+	#endif
+#endif
+
+
+// ----------------------------------------------------------------------------
+// block operations
+// ----------------------------------------------------------------------------
+/**
+ * simd register traits for doubles, the scalar fallback is disabled
+ */
+struct expr_simd
+{
+#if defined(__AVX2__)
+	using t_reg = __m256d;
+	static constexpr bool enabled = true;
+	static constexpr std::size_t width = 4;
+
+	static t_reg load(const double* p) { return _mm256_loadu_pd(p); }
+	static void store(double* p, t_reg r) { _mm256_storeu_pd(p, r); }
+
+	static t_reg sqrt(t_reg a) { return _mm256_sqrt_pd(a); }
+
+#if EXPR_USE_LIBMVEC
+	static t_reg sin(t_reg a) { return _ZGVdN4v_sin(a); }
+	static t_reg cos(t_reg a) { return _ZGVdN4v_cos(a); }
+	static t_reg exp(t_reg a) { return _ZGVdN4v_exp(a); }
+	static t_reg pow(t_reg a, t_reg b) { return _ZGVdN4vv_pow(a, b); }
+#else
+	static t_reg sin(t_reg a) { return lanes(a, a, [](double x, double) { return std::sin(x); }); }
+	static t_reg cos(t_reg a) { return lanes(a, a, [](double x, double) { return std::cos(x); }); }
+	static t_reg exp(t_reg a) { return lanes(a, a, [](double x, double) { return std::exp(x); }); }
+	static t_reg pow(t_reg a, t_reg b) { return lanes(a, b, [](double x, double y) { return std::pow(x, y); }); }
+
+	// applies a scalar function to each lane
+	template<class t_func>
+	static t_reg lanes(t_reg a, t_reg b, t_func func)
+	{
+		alignas(32) double vals_a[width], vals_b[width];
+		_mm256_store_pd(vals_a, a);
+		_mm256_store_pd(vals_b, b);
+		for(std::size_t i=0; i<width; ++i)
+			vals_a[i] = func(vals_a[i], vals_b[i]);
+		return _mm256_load_pd(vals_a);
+	}
+#endif
+
+#else
+	using t_reg = double;
+	static constexpr bool enabled = false;
+	static constexpr std::size_t width = 1;
+
+	static t_reg load(const double* p) { return *p; }
+	static void store(double* p, t_reg r) { *p = r; }
+
+	static t_reg sqrt(t_reg a) { return std::sqrt(a); }
+	static t_reg sin(t_reg a) { return std::sin(a); }
+	static t_reg cos(t_reg a) { return std::cos(a); }
+	static t_reg exp(t_reg a) { return std::exp(a); }
+	static t_reg pow(t_reg a, t_reg b) { return std::pow(a, b); }
+#endif
+};
+
+
+/**
+ * in-place operations on blocks of EXPR_BLOCK_SIZE values,
+ * blocks of doubles are processed in simd registers
+ */
+template<typename t_real>
+struct expr_block
+{
+	static constexpr std::size_t size = EXPR_BLOCK_SIZE;
+	static constexpr bool use_simd = expr_simd::enabled && std::is_same_v<t_real, double>;
+	static_assert(size % expr_simd::width == 0, "Block size has to be a multiple of the simd width.");
+
+
+	/**
+	 * x = op(x), op_simd is used on the registers and op on the scalars
+	 */
+	template<class t_op, class t_op_simd>
+	static void unary(t_real* x, t_op&& op, t_op_simd&& op_simd)
+	{
+		if constexpr(use_simd)
+		{
+			for(std::size_t i=0; i<size; i+=expr_simd::width)
+				expr_simd::store(x + i, op_simd(expr_simd::load(x + i)));
+		}
+		else
+		{
+			for(std::size_t i=0; i<size; ++i)
+				x[i] = op(x[i]);
+		}
+	}
+
+
+	/**
+	 * x = op(x, y), op_simd is used on the registers and op on the scalars
+	 */
+	template<class t_op, class t_op_simd>
+	static void binary(t_real* x, const t_real* y, t_op&& op, t_op_simd&& op_simd)
+	{
+		if constexpr(use_simd)
+		{
+			for(std::size_t i=0; i<size; i+=expr_simd::width)
+				expr_simd::store(x + i, op_simd(expr_simd::load(x + i), expr_simd::load(y + i)));
+		}
+		else
+		{
+			for(std::size_t i=0; i<size; ++i)
+				x[i] = op(x[i], y[i]);
+		}
+	}
+
+
+	// the arithmetic operators work on scalars and on gcc's vector types
+	static void neg(t_real* x) { unary(x, [](auto a) { return -a; }, [](auto a) { return -a; }); }
+	static void add(t_real* x, const t_real* y) { binary(x, y, std::plus<>{}, std::plus<>{}); }
+	static void sub(t_real* x, const t_real* y) { binary(x, y, std::minus<>{}, std::minus<>{}); }
+	static void mul(t_real* x, const t_real* y) { binary(x, y, std::multiplies<>{}, std::multiplies<>{}); }
+	static void div(t_real* x, const t_real* y) { binary(x, y, std::divides<>{}, std::divides<>{}); }
+
+	static void mod(t_real* x, const t_real* y)
+	{
+		for(std::size_t i=0; i<size; ++i)
+			x[i] = (t_real)std::fmod(x[i], y[i]);
+	}
+
+	static void sqrt(t_real* x)
+	{
+		unary(x, [](t_real a) { return (t_real)std::sqrt(a); }, [](auto a) { return expr_simd::sqrt(a); });
+	}
+
+	static void sin(t_real* x)
+	{
+		unary(x, [](t_real a) { return (t_real)std::sin(a); }, [](auto a) { return expr_simd::sin(a); });
+	}
+
+	static void cos(t_real* x)
+	{
+		unary(x, [](t_real a) { return (t_real)std::cos(a); }, [](auto a) { return expr_simd::cos(a); });
+	}
+
+	static void exp(t_real* x)
+	{
+		unary(x, [](t_real a) { return (t_real)std::exp(a); }, [](auto a) { return expr_simd::exp(a); });
+	}
+
+	static void pow(t_real* x, const t_real* y)
+	{
+		binary(x, y, [](t_real a, t_real b) { return (t_real)std::pow(a, b); },
+			[](auto a, auto b) { return expr_simd::pow(a, b); });
+	}
+};
+// ----------------------------------------------------------------------------
+
+
+template<typename t_real> class ExprParser;
+
+
+/**
+ * compiled expression in postfix form with the variables resolved to slot indices
+ */
+template<typename t_real=double>
+class ExprProgram
+{
+	friend class ExprParser<t_real>;
+
+public:
+	enum class Op : std::uint8_t
+	{
+		PUSH,		// push constant
+		LOAD,		// push slot value
+		STORE,		// assign top of stack to slot, leaving it on the stack
+
+		NEG, ADD, SUB, MUL, DIV, MOD, POW,
+
+		CALL0,		// function calls with 0, 1 or 2 arguments
+		CALL1,
+		CALL2,
+	};
+
+	struct Instr
+	{
+		Op op{};
+		std::uint32_t arg{};
+	};
+
+
+	/**
+	 * evaluates the program with the given variable values
+	 * @param slots variable values, assigned variables are written back
+	 * @throws std::invalid_argument if there are fewer values than variables
+	 */
+	t_real eval(std::span<t_real> slots) const
+	{
+		if(slots.size() < m_vars.size())
+			throw std::invalid_argument("Expected a value for each variable of the program.");
+
+		if(m_max_stack <= EXPR_STACK_SIZE)
+		{
+			t_real stack[EXPR_STACK_SIZE];
+			return run(slots.data(), stack);
+		}
+
+		std::vector<t_real> stack(m_max_stack);
+		return run(slots.data(), stack.data());
+	}
+
+
+	/**
+	 * evaluates the program for each row of the input columns
+	 * @param columns input column for each slot, or nullptr to use the slot's default value
+	 * @throws std::invalid_argument if the number of columns does not match the number of variables
+	 */
+	void eval_columns(std::span<const t_real* const> columns, std::size_t num_rows, t_real* results) const
+	{
+		check_columns(columns);
+
+		std::vector<t_real> slots = m_defaults;
+		std::vector<t_real> stack(m_max_stack);
+
+		std::vector<std::pair<std::size_t, const t_real*>> bound;
+		for(std::size_t slot=0; slot<slots.size(); ++slot)
+		{
+			if(columns[slot])
+				bound.emplace_back(slot, columns[slot]);
+		}
+
+		for(std::size_t row=0; row<num_rows; ++row)
+		{
+			// reset the variables that may have been assigned in the previous row
+			std::copy(m_defaults.begin(), m_defaults.end(), slots.begin());
+			for(const auto& [slot, column] : bound)
+				slots[slot] = column[row];
+
+			results[row] = run(slots.data(), stack.data());
+		}
+	}
+
+
+	/**
+	 * evaluates the program for each row of the input columns in blocks of EXPR_BLOCK_SIZE rows,
+	 * the blocks are distributed over the threads
+	 * @param columns input column for each slot, or nullptr to use the slot's default value
+	 * @param num_threads number of threads, or 0 to use all cores
+	 * @throws std::invalid_argument if the number of columns does not match the number of variables
+	 */
+	void eval_blocks(std::span<const t_real* const> columns, std::size_t num_rows,
+		t_real* results, std::size_t num_threads = 0) const
+	{
+		check_columns(columns);
+
+		constexpr std::size_t block_size = EXPR_BLOCK_SIZE;
+		const std::size_t num_blocks = (num_rows + block_size - 1) / block_size;
+
+		if(!num_threads)
+			num_threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+		num_threads = std::min(num_threads, std::max<std::size_t>(num_rows / EXPR_ROWS_PER_THREAD, 1));
+
+		if(num_threads <= 1)
+		{
+			run_blocks(columns, 0, num_rows, results);
+			return;
+		}
+
+		// split the rows at block boundaries
+		std::vector<std::thread> threads;
+		threads.reserve(num_threads);
+		for(std::size_t thread=0; thread<num_threads; ++thread)
+		{
+			const std::size_t row_begin = num_blocks * thread / num_threads * block_size;
+			const std::size_t row_end = std::min(num_blocks * (thread + 1) / num_threads * block_size, num_rows);
+
+			threads.emplace_back([this, columns, row_begin, row_end, results]()
+			{
+				run_blocks(columns, row_begin, row_end, results);
+			});
+		}
+
+		for(std::thread& thread : threads)
+			thread.join();
+	}
+
+
+	/**
+	 * variable values bound at compile time, or zero
+	 */
+	std::vector<t_real> make_slots() const
+	{
+		return m_defaults;
+	}
+
+
+	std::optional<std::size_t> get_slot(std::string_view name) const
+	{
+		auto iter = std::find(m_vars.begin(), m_vars.end(), name);
+		if(iter == m_vars.end())
+			return std::nullopt;
+		return iter - m_vars.begin();
+	}
+
+
+	const std::vector<std::string>& get_vars() const { return m_vars; }
+	bool is_input(std::size_t slot) const { return m_inputs[slot]; }
+	bool is_assigned(std::size_t slot) const { return m_assigned[slot]; }
+
+	const std::vector<Instr>& get_code() const { return m_code; }
+	std::size_t get_max_stack() const { return m_max_stack; }
+
+
+protected:
+	void check_columns(std::span<const t_real* const> columns) const
+	{
+		if(columns.size() != m_vars.size())
+			throw std::invalid_argument("Expected an input column for each variable of the program.");
+	}
+
+
+	t_real run(t_real* slots, t_real* stack) const
+	{
+		t_real *sp = stack;
+
+		for(const Instr& instr : m_code)
+		{
+			switch(instr.op)
+			{
+				case Op::PUSH: *sp++ = m_consts[instr.arg]; break;
+				case Op::LOAD: *sp++ = slots[instr.arg]; break;
+				case Op::STORE: slots[instr.arg] = sp[-1]; break;
+
+				case Op::NEG: sp[-1] = -sp[-1]; break;
+				case Op::ADD: --sp; sp[-1] = sp[-1] + sp[0]; break;
+				case Op::SUB: --sp; sp[-1] = sp[-1] - sp[0]; break;
+				case Op::MUL: --sp; sp[-1] = sp[-1] * sp[0]; break;
+				case Op::DIV: --sp; sp[-1] = sp[-1] / sp[0]; break;
+				case Op::MOD: --sp; sp[-1] = (t_real)std::fmod(sp[-1], sp[0]); break;
+				case Op::POW: --sp; sp[-1] = (t_real)std::pow(sp[-1], sp[0]); break;
+
+				case Op::CALL0: *sp++ = m_funcs0[instr.arg](); break;
+				case Op::CALL1: sp[-1] = m_funcs1[instr.arg](sp[-1]); break;
+				case Op::CALL2: --sp; sp[-1] = m_funcs2[instr.arg](sp[-1], sp[0]); break;
+			}
+		}
+
+		return sp[-1];
+	}
+
+
+	/**
+	 * evaluates the rows [row_begin, row_end) block by block,
+	 * every stack entry and variable holds the values of a whole block
+	 */
+	void run_blocks(std::span<const t_real* const> columns,
+		std::size_t row_begin, std::size_t row_end, t_real* results) const
+	{
+		using t_block = expr_block<t_real>;
+		constexpr std::size_t N = t_block::size;
+		const std::size_t num_slots = m_vars.size();
+
+		std::vector<t_real> stack(std::max<std::size_t>(m_max_stack, 1) * N);
+		std::vector<t_real> slots(num_slots * N);
+		std::vector<const t_real*> loads(num_slots);
+
+		// variables not bound to a column or assigned keep their value
+		for(std::size_t slot=0; slot<num_slots; ++slot)
+		{
+			if(!columns[slot])
+				std::fill_n(slots.data() + slot*N, N, m_defaults[slot]);
+			loads[slot] = slots.data() + slot*N;
+		}
+
+		for(std::size_t row=row_begin; row<row_end; row+=N)
+		{
+			const std::size_t num = std::min(N, row_end - row);
+
+			for(std::size_t slot=0; slot<num_slots; ++slot)
+			{
+				t_real *block = slots.data() + slot*N;
+				const t_real *column = columns[slot];
+
+				if(column && num == N && !m_assigned[slot])
+				{
+					// read full blocks directly from the column
+					loads[slot] = column + row;
+				}
+				else if(column)
+				{
+					// pad a partial block with the last row, so the padding lanes
+					// can't fail where the valid rows don't, e.g. by an integer division by zero
+					std::copy_n(column + row, num, block);
+					std::fill(block + num, block + N, column[row + num - 1]);
+					loads[slot] = block;
+				}
+				else if(m_assigned[slot])
+				{
+					std::fill_n(block, N, m_defaults[slot]);
+				}
+			}
+
+			// sp points behind the top block
+			t_real *sp = stack.data();
+
+			for(const Instr& instr : m_code)
+			{
+				switch(instr.op)
+				{
+					case Op::PUSH: std::fill_n(sp, N, m_consts[instr.arg]); sp += N; break;
+					case Op::LOAD: std::copy_n(loads[instr.arg], N, sp); sp += N; break;
+					case Op::STORE: std::copy_n(sp - N, N, slots.data() + instr.arg*N); break;
+
+					case Op::NEG: t_block::neg(sp - N); break;
+					case Op::ADD: sp -= N; t_block::add(sp - N, sp); break;
+					case Op::SUB: sp -= N; t_block::sub(sp - N, sp); break;
+					case Op::MUL: sp -= N; t_block::mul(sp - N, sp); break;
+					case Op::DIV: sp -= N; t_block::div(sp - N, sp); break;
+					case Op::MOD: sp -= N; t_block::mod(sp - N, sp); break;
+					case Op::POW: sp -= N; t_block::pow(sp - N, sp); break;
+
+					case Op::CALL0:
+						for(std::size_t i=0; i<N; ++i)
+							sp[i] = m_funcs0[instr.arg]();
+						sp += N;
+						break;
+
+					case Op::CALL1:
+						if(m_funcs1_block[instr.arg])
+						{
+							m_funcs1_block[instr.arg](sp - N);
+						}
+						else
+						{
+							for(std::size_t i=0; i<N; ++i)
+								sp[i - N] = m_funcs1[instr.arg](sp[i - N]);
+						}
+						break;
+
+					case Op::CALL2:
+						sp -= N;
+						if(m_funcs2_block[instr.arg])
+						{
+							m_funcs2_block[instr.arg](sp - N, sp);
+						}
+						else
+						{
+							for(std::size_t i=0; i<N; ++i)
+								sp[i - N] = m_funcs2[instr.arg](sp[i - N], sp[i]);
+						}
+						break;
+				}
+			}
+
+			std::copy_n(stack.data(), num, results + row);
+		}
+	}
+
+
+	/**
+	 * appends an instruction and keeps track of the stack depth
+	 */
+	void emit(Op op, std::uint32_t arg = 0)
+	{
+		switch(op)
+		{
+			case Op::PUSH: case Op::LOAD: case Op::CALL0:
+				++m_stack;
+				break;
+			case Op::ADD: case Op::SUB: case Op::MUL: case Op::DIV:
+			case Op::MOD: case Op::POW: case Op::CALL2:
+				--m_stack;
+				break;
+			default:
+				break;
+		}
+
+		m_max_stack = std::max<std::size_t>(m_max_stack, std::max(m_stack, std::ptrdiff_t(0)));
+		m_code.emplace_back(Instr{op, arg});
+	}
+
+
+	std::uint32_t add_const(t_real val)
+	{
+		m_consts.push_back(val);
+		return std::uint32_t(m_consts.size() - 1);
+	}
+
+
+	/**
+	 * @return slot index of the variable, and if it was newly added
+	 */
+	std::tuple<std::uint32_t, bool> add_var(std::string_view name)
+	{
+		if(std::optional<std::size_t> slot = get_slot(name); slot)
+			return std::make_tuple(std::uint32_t(*slot), false);
+
+		m_vars.emplace_back(name);
+		m_defaults.push_back(t_real{0});
+		m_inputs.push_back(false);
+		m_assigned.push_back(false);
+		return std::make_tuple(std::uint32_t(m_vars.size() - 1), true);
+	}
+
+
+private:
+	std::vector<Instr> m_code{};
+	std::vector<t_real> m_consts{};
+
+	std::vector<t_real(*)()> m_funcs0{};
+	std::vector<t_real(*)(t_real)> m_funcs1{};
+	std::vector<t_real(*)(t_real, t_real)> m_funcs2{};
+
+	// block versions of the functions, or nullptr
+	std::vector<void(*)(t_real*)> m_funcs1_block{};
+	std::vector<void(*)(t_real*, const t_real*)> m_funcs2_block{};
+
+	// variable names and values
+	std::vector<std::string> m_vars{};
+	std::vector<t_real> m_defaults{};
+
+	// variables read before they are assigned
+	std::vector<bool> m_inputs{};
+	std::vector<bool> m_assigned{};
+
+	std::ptrdiff_t m_stack{0};
+	std::size_t m_max_stack{0};
+};
+
+
 template<typename t_real=double>
 class ExprParser
 {
 public:
-	t_real parse(const std::string& str)
+	using t_program = ExprProgram<t_real>;
+	using t_op = typename t_program::Op;
+
+
+	/**
+	 * translates the expression into a postfix program
+	 * @return program, or nothing on syntax errors
+	 */
+	std::optional<t_program> compile(std::string_view str)
 	{
-		m_istr = std::make_shared<std::istringstream>(str);
+		m_prog = t_program{};
+		m_ok = true;
+
+		set_input(str);
 		next_lookahead();
-		return plus_term();
+		plus_term();
+
+		if(!m_ok)
+			return std::nullopt;
+		return std::move(m_prog);
+	}
+
+
+	/**
+	 * compiles and evaluates the expression with the variables from the symbol table
+	 */
+	t_real parse(std::string_view str)
+	{
+		std::optional<t_program> prog = compile(str);
+		if(!prog)
+			return t_real{0};
+
+		std::vector<t_real> slots = prog->make_slots();
+		const std::vector<std::string>& vars = prog->get_vars();
+		for(std::size_t slot=0; slot<vars.size(); ++slot)
+		{
+			if(prog->is_input(slot) && m_mapSymbols.find(vars[slot]) == m_mapSymbols.end())
+				std::cerr << "Unknown identifier \"" << vars[slot] << "\"." << std::endl;
+		}
+
+		t_real val = prog->eval(slots);
+
+		for(std::size_t slot=0; slot<vars.size(); ++slot)
+		{
+			if(prog->is_assigned(slot))
+				m_mapSymbols[vars[slot]] = slots[slot];
+		}
+
+		return val;
 	}
 
 
@@ -43,6 +652,12 @@ public:
 	}
 
 
+	void set_symbol(const std::string& name, t_real val)
+	{
+		m_mapSymbols[name] = val;
+	}
+
+
 protected:
 	// ------------------------------------------------------------------------
 	// Lexer
@@ -58,127 +673,130 @@ protected:
 
 
 	/**
-	 * find all matching tokens for input string
+	 * states of the lexer's dfa, all states except the start state are accepting
 	 */
-	std::vector<std::pair<int, t_real>> get_matching_tokens(const std::string& str)
+	enum LexState : std::uint8_t
 	{
-		std::vector<std::pair<int, t_real>> matches;
+		LEX_START = 0,
+		LEX_INT,	// [0-9]+
+		LEX_REAL,	// [0-9]+\.[0-9]*
+		LEX_IDENT,	// [A-Za-z]+[A-Za-z0-9]*
+		LEX_OP,		// tokens represented by themselves
+
+		LEX_NUM_STATES,
+		LEX_REJECT = LEX_NUM_STATES,
+	};
 
-		if constexpr(std::is_floating_point_v<t_real>)
-		{	// real
-			std::regex regex{"[0-9]+(\\.[0-9]*)?"};
-			std::smatch smatch;
-			if(std::regex_match(str, smatch, regex))
-			{
-				t_real val{};
-				std::istringstream{str} >> val;
-				matches.emplace_back(std::make_pair((int)Token::TOK_REAL, val));
-			}
-		}
-		else if constexpr(std::is_integral_v<t_real>)
-		{	// int
-			std::regex regex{"[0-9]+"};
-			std::smatch smatch;
-			if(std::regex_match(str, smatch, regex))
-			{
-				t_real val{};
-				std::istringstream{str} >> val;
-				matches.emplace_back(std::make_pair((int)Token::TOK_REAL, val));
-			}
-		}
-		else
+	using t_lextable = std::array<std::array<std::uint8_t, 256>, LEX_NUM_STATES>;
+
+
+	/**
+	 * transition table of the dfa recognising the tokens:
+	 *   real:  [0-9]+(\.[0-9]*)? (or [0-9]+ for integer types)
+	 *   ident: [A-Za-z]+[A-Za-z0-9]*
+	 *   tokens represented by themselves: + - * / % ^ ( ) , =
+	 */
+	static constexpr t_lextable make_lex_table()
+	{
+		t_lextable table{};
+		for(auto& row : table)
+			for(auto& next : row)
+				next = LEX_REJECT;
+
+		for(unsigned char c : std::string_view{"+-*/%^(),="})
+			table[LEX_START][c] = LEX_OP;
+
+		for(unsigned char c='0'; c<='9'; ++c)
 		{
-			std::cerr << "Invalid number type." << std::endl;
+			table[LEX_START][c] = LEX_INT;
+			table[LEX_INT][c] = LEX_INT;
+			table[LEX_REAL][c] = LEX_REAL;
+			table[LEX_IDENT][c] = LEX_IDENT;
 		}
 
-		{	// ident
-			std::regex regex{"[A-Za-z]+[A-Za-z0-9]*"};
-			std::smatch smatch;
-			if(std::regex_match(str, smatch, regex))
-				matches.emplace_back(std::make_pair((int)Token::TOK_IDENT, 0.));
-		}
+		if constexpr(std::is_floating_point_v<t_real>)
+			table[LEX_INT]['.'] = LEX_REAL;
 
-		{	// tokens represented by themselves
-			if(str == "+" || str == "-" || str == "*" || str == "/" || str == "%" ||
-				str == "^" || str == "(" || str == ")" || str == "," || str == "=")
-				matches.emplace_back(std::make_pair((int)str[0], 0.));
+		for(unsigned char c='a'; c<='z'; ++c)
+		{
+			for(unsigned char ch : { c, static_cast<unsigned char>(c - 'a' + 'A') })
+			{
+				table[LEX_START][ch] = LEX_IDENT;
+				table[LEX_IDENT][ch] = LEX_IDENT;
+			}
 		}
 
-		return matches;
+		return table;
 	}
 
 
 	/**
+	 * longest-match lexer running the dfa on the input
 	 * @return [token, yylval, yytext]
 	 */
-	std::tuple<int, t_real, std::string> lex()
+	std::tuple<int, t_real, std::string_view> lex()
 	{
-		std::string input, longest_input;
-		std::vector<std::pair<int, t_real>> longest_matching;
+		static constexpr t_lextable lextable = make_lex_table();
+		const std::string_view input = m_input;
 
-		// find longest matching token
-		while(1)
-		{
-			char c = m_istr->get();
-
-			if(m_istr->eof())
-				break;
-			// if outside any other match...
-			if(longest_matching.size() == 0)
-			{
-				// ...ignore white spaces
-				if(c==' ' || c=='\t')
-					continue;
-				// ...end on new line
-				if(c=='\n')
-					return std::make_tuple((int)Token::TOK_END, t_real{0}, longest_input);
-			}
+		// ignore white spaces
+		while(m_inputpos < input.size() && (input[m_inputpos] == ' ' || input[m_inputpos] == '\t'))
+			++m_inputpos;
 
-			input += c;
-			auto matching = get_matching_tokens(input);
-			if(matching.size())
-			{
-				longest_input = input;
-				longest_matching = matching;
+		// at EOF
+		if(m_inputpos >= input.size())
+			return std::make_tuple((int)Token::TOK_END, t_real{0}, std::string_view{});
 
-				if(m_istr->peek() == std::char_traits<char>::eof() || m_istr->eof())
-					break;
-			}
-			else
-			{
-				// no more matches
-				m_istr->putback(c);
-				break;
-			}
+		// end on new line
+		if(input[m_inputpos] == '\n')
+		{
+			++m_inputpos;
+			return std::make_tuple((int)Token::TOK_END, t_real{0}, std::string_view{});
 		}
 
-		// at EOF
-		if(longest_matching.size() == 0 && input.length() == 0)
+		// find longest matching token
+		std::uint8_t state = LEX_START, accepted = LEX_START;
+		std::size_t pos = m_inputpos;
+		for(; pos < input.size(); ++pos)
 		{
-			return std::make_tuple((int)Token::TOK_END, t_real{0}, longest_input);
+			state = lextable[state][static_cast<unsigned char>(input[pos])];
+			if(state == LEX_REJECT)
+				break;
+			accepted = state;
 		}
 
+		const std::string_view text = input.substr(m_inputpos, pos - m_inputpos);
+
 		// nothing matches
-		if(longest_matching.size() == 0)
+		if(accepted == LEX_START)
 		{
-			std::cerr << "Invalid input in lexer: \"" << input << "\"." << std::endl;
-			return std::make_tuple((int)Token::TOK_INVALID, t_real{0}, longest_input);
+			std::cerr << "Invalid input in lexer: \"" << input[m_inputpos] << "\"." << std::endl;
+			++m_inputpos;
+			return std::make_tuple((int)Token::TOK_INVALID, t_real{0}, input.substr(m_inputpos - 1, 1));
 		}
 
-		// several possible matches
-		if(longest_matching.size() > 1)
-		{
-			std::cerr << "Warning: Ambiguous match in lexer for token \"" << longest_input << "\"." << std::endl;
-		}
+		m_inputpos = pos;
 
 		// found match
-		if(longest_matching.size())
+		if(accepted == LEX_INT || accepted == LEX_REAL)
+		{
+			t_real val{};
+			std::from_chars(text.data(), text.data() + text.size(), val);
+			return std::make_tuple((int)Token::TOK_REAL, val, text);
+		}
+		else if(accepted == LEX_IDENT)
 		{
-			return std::make_tuple((int)std::get<0>(longest_matching[0]), std::get<1>(longest_matching[0]), longest_input);
+			return std::make_tuple((int)Token::TOK_IDENT, t_real{0}, text);
 		}
 
-		// should not get here
-		return std::make_tuple((int)Token::TOK_INVALID, t_real{0}, longest_input);
+		return std::make_tuple((int)text[0], t_real{0}, text);
+	}
+
+
+	void set_input(std::string_view str)
+	{
+		m_input = str;
+		m_inputpos = 0;
 	}
 	// ------------------------------------------------------------------------
 
@@ -217,70 +835,66 @@ protected:
 	 * +,- terms
 	 * (lowest precedence, 1)
 	 */
-	t_real plus_term()
+	void plus_term()
 	{
 		// plus_term -> mul_term plus_term_rest
 		if(m_lookahead == '(' || m_lookahead == (int)Token::TOK_REAL || m_lookahead == (int)Token::TOK_IDENT)
 		{
-			t_real term_val = mul_term();
-			t_real expr_rest_val = plus_term_rest(term_val);
-
-			return expr_rest_val;
+			mul_term();
+			plus_term_rest();
+			return;
 		}
 		else if(m_lookahead == '+')	// unary +
 		{
 			next_lookahead();
-			t_real term_val = mul_term();
-			t_real expr_rest_val = plus_term_rest(term_val);
-
-			return expr_rest_val;
+			mul_term();
+			plus_term_rest();
+			return;
 		}
 		else if(m_lookahead == '-')	// unary -
 		{
 			next_lookahead();
-			t_real term_val = -mul_term();
-			t_real expr_rest_val = plus_term_rest(term_val);
-
-			return expr_rest_val;
+			mul_term();
+			m_prog.emit(t_op::NEG);
+			plus_term_rest();
+			return;
 		}
 
 		if(m_lookahead == 0 || m_lookahead == EOF)
 			exit(0);
 
-		std::cerr << "Invalid lookahead in " << __func__ << ": " << m_lookahead << "." << std::endl;
-		return 0.;
+		error_lookahead(__func__);
 	}
 
 
-	t_real plus_term_rest(t_real arg)
+	void plus_term_rest()
 	{
 		// plus_term_rest -> '+' mul_term plus_term_rest
 		if(m_lookahead == '+')
 		{
 			next_lookahead();
-			t_real term_val = arg + mul_term();
-			t_real expr_rest_val = plus_term_rest(term_val);
-
-			return expr_rest_val;
+			mul_term();
+			m_prog.emit(t_op::ADD);
+			plus_term_rest();
+			return;
 		}
 
 		// plus_term_rest -> '-' mul_term plus_term_rest
 		else if(m_lookahead == '-')
 		{
 			next_lookahead();
-			t_real term_val = arg - mul_term();
-			t_real expr_rest_val = plus_term_rest(term_val);
-
-			return expr_rest_val;
+			mul_term();
+			m_prog.emit(t_op::SUB);
+			plus_term_rest();
+			return;
 		}
 		// plus_term_rest -> epsilon
 		else if(m_lookahead == ')' || m_lookahead == (int)Token::TOK_END || m_lookahead == ',')
 		{
-			return arg;
+			return;
 		}
 
-		std::cerr << "Invalid lookahead in " << __func__ << ": " << m_lookahead << "." << std::endl;
-		return 0.;
+		error_lookahead(__func__);
 	}
 
 
@@ -288,63 +902,60 @@ protected:
 	 * *,/,% terms
 	 * (precedence 2)
 	 */
-	t_real mul_term()
+	void mul_term()
 	{
 		// mul_term -> pow_term mul_term_rest
 		if(m_lookahead == '(' || m_lookahead == (int)Token::TOK_REAL || m_lookahead == (int)Token::TOK_IDENT)
 		{
-			t_real factor_val = pow_term();
-			t_real term_rest_val = mul_term_rest(factor_val);
-
-			return term_rest_val;
+			pow_term();
+			mul_term_rest();
+			return;
 		}
 
-		std::cerr << "Invalid lookahead in " << __func__ << ": " << m_lookahead << "." << std::endl;
-		return 0.;
+		error_lookahead(__func__);
 	}
 
 
-	t_real mul_term_rest(t_real arg)
+	void mul_term_rest()
 	{
 		// mul_term_rest -> '*' pow_term mul_term_rest
 		if(m_lookahead == '*')
 		{
 			next_lookahead();
-			t_real factor_val = arg * pow_term();
-			t_real term_rest_val = mul_term_rest(factor_val);
-
-			return term_rest_val;
+			pow_term();
+			m_prog.emit(t_op::MUL);
+			mul_term_rest();
+			return;
 		}
 
 		// mul_term_rest -> '/' pow_term mul_term_rest
 		else if(m_lookahead == '/')
 		{
 			next_lookahead();
-			t_real factor_val = arg / pow_term();
-			t_real term_rest_val = mul_term_rest(factor_val);
-
-			return term_rest_val;
+			pow_term();
+			m_prog.emit(t_op::DIV);
+			mul_term_rest();
+			return;
 		}
 
 		// mul_term_rest -> '%' pow_term mul_term_rest
 		else if(m_lookahead == '%')
 		{
 			next_lookahead();
-			t_real factor_val = std::fmod(arg, pow_term());
-			t_real term_rest_val = mul_term_rest(factor_val);
-
-			return term_rest_val;
+			pow_term();
+			m_prog.emit(t_op::MOD);
+			mul_term_rest();
+			return;
 		}
 
 		// mul_term_rest -> epsilon
 		else if(m_lookahead == '+' || m_lookahead == '-' || m_lookahead == ')'
 			|| m_lookahead == (int)Token::TOK_END || m_lookahead == ',')
 		{
-			return arg;
+			return;
 		}
 
-		std::cerr << "Invalid lookahead in " << __func__ << ": " << m_lookahead << "." << std::endl;
-		return 0.;
+		error_lookahead(__func__);
 	}
 
 
@@ -352,32 +963,30 @@ protected:
 	 * ^ terms
 	 * (precedence 3)
 	 */
-	t_real pow_term()
+	void pow_term()
 	{
 		// pow_term -> factor pow_term_rest
 		if(m_lookahead == '(' || m_lookahead == (int)Token::TOK_REAL || m_lookahead == (int)Token::TOK_IDENT)
 		{
-			t_real factor_val = factor();
-			t_real term_rest_val = pow_term_rest(factor_val);
-
-			return term_rest_val;
+			factor();
+			pow_term_rest();
+			return;
 		}
 
-		std::cerr << "Invalid lookahead in " << __func__ << ": " << m_lookahead << "." << std::endl;
-		return 0.;
+		error_lookahead(__func__);
 	}
 
 
-	t_real pow_term_rest(t_real arg)
+	void pow_term_rest()
 	{
 		// pow_term_rest -> '^' factor pow_term_rest
 		if(m_lookahead == '^')
 		{
 			next_lookahead();
-			t_real factor_val = std::pow(arg, factor());
-			t_real term_rest_val = pow_term_rest(factor_val);
-
-			return term_rest_val;
+			factor();
+			m_prog.emit(t_op::POW);
+			pow_term_rest();
+			return;
 		}
 
 		// pow_term_rest -> epsilon
@@ -385,11 +994,10 @@ protected:
 			|| m_lookahead == (int)Token::TOK_END || m_lookahead == ','
 			|| m_lookahead == '*' || m_lookahead == '/' || m_lookahead == '%')
 		{
-			return arg;
+			return;
 		}
 
-		std::cerr << "Invalid lookahead in " << __func__ << ": " << m_lookahead << "." << std::endl;
-		return 0.;
+		error_lookahead(__func__);
 	}
 
 
@@ -397,32 +1005,31 @@ protected:
 	 * () terms, real factor or identifier
 	 * (highest precedence, 4)
 	 */
-	t_real factor()
+	void factor()
 	{
 		// factor -> '(' plus_term ')'
 		if(m_lookahead == '(')
 		{
 			next_lookahead();
-			t_real expr_val = plus_term();
-			match(')');
+			plus_term();
+			if(!match(')'))
+				m_ok = false;
 			next_lookahead();
-
-			return expr_val;
+			return;
 		}
 
 		// factor -> TOK_REAL
 		else if(m_lookahead == (int)Token::TOK_REAL)
 		{
-			t_real val = m_lookahead_val;
+			m_prog.emit(t_op::PUSH, m_prog.add_const(m_lookahead_val));
 			next_lookahead();
-
-			return val;
+			return;
 		}
 
 		// factor -> TOK_IDENT
 		else if(m_lookahead == (int)Token::TOK_IDENT)
 		{
-			const std::string ident = m_lookahead_text;
+			const std::string ident{m_lookahead_text};
 			next_lookahead();
 
 			// function call
@@ -436,37 +1043,24 @@ protected:
 				if(m_lookahead == ')')
 				{
 					next_lookahead();
-
-					auto iter = m_mapFuncs0.find(ident);
-					if(iter == m_mapFuncs0.end())
-					{
-						std::cerr << "Unknown function \"" << ident << "\"." << std::endl;
-						return 0.;
-					}
-
-					return (*iter->second)();
+					emit_call(m_mapFuncs0, m_prog.m_funcs0, t_op::CALL0, ident);
+					return;
 				}
 
 				// function with arguments
 				else
 				{
 					// first argument
-					t_real expr_val1 = plus_term();
+					plus_term();
 
 					// one-argument-function
 					// factor -> TOK_IDENT '(' plus_term ')'
 					if(m_lookahead == ')')
 					{
 						next_lookahead();
-
-						auto iter = m_mapFuncs1.find(ident);
-						if(iter == m_mapFuncs1.end())
-						{
-							std::cerr << "Unknown function \"" << ident << "\"." << std::endl;
-							return 0.;
-						}
-
-						return (*iter->second)(expr_val1);
+						emit_call(m_mapFuncs1, m_prog.m_funcs1, t_op::CALL1, ident,
+							&m_mapFuncs1Block, &m_prog.m_funcs1_block);
+						return;
 					}
 
 					// two-argument-function
@@ -474,18 +1068,13 @@ protected:
 					else if(m_lookahead == ',')
 					{
 						next_lookahead();
-						t_real expr_val2 = plus_term();
-						match(')');
+						plus_term();
+						if(!match(')'))
+							m_ok = false;
 						next_lookahead();
-
-						auto iter = m_mapFuncs2.find(ident);
-						if(iter == m_mapFuncs2.end())
-						{
-							std::cerr << "Unknown function \"" << ident << "\"." << std::endl;
-							return 0.;
-						}
-
-						return (*iter->second)(expr_val1, expr_val2);
+						emit_call(m_mapFuncs2, m_prog.m_funcs2, t_op::CALL2, ident,
+							&m_mapFuncs2Block, &m_prog.m_funcs2_block);
+						return;
 					}
 					else
 					{
@@ -498,37 +1087,98 @@ protected:
 			else if(m_lookahead == '=')
 			{
 				next_lookahead();
-				t_real assign_val = plus_term();
-				m_mapSymbols[ident] = assign_val;
-				return assign_val;
+				plus_term();
+
+				const std::uint32_t slot = bind_var(ident);
+				m_prog.m_assigned[slot] = true;
+				m_prog.emit(t_op::STORE, slot);
+				return;
 			}
 
 			// variable lookup
 			else
 			{
-				auto iter = m_mapSymbols.find(ident);
-				if(iter == m_mapSymbols.end())
-				{
-					std::cerr << "Unknown identifier \"" << ident << "\"." << std::endl;
-					return 0.;
-				}
-
-				return iter->second;
+				const std::uint32_t slot = bind_var(ident);
+				if(!m_prog.m_assigned[slot])
+					m_prog.m_inputs[slot] = true;
+				m_prog.emit(t_op::LOAD, slot);
+				return;
 			}
 		}
 
-		std::cerr << "Invalid lookahead in " << __func__ << ": " << m_lookahead << "." << std::endl;
-		return 0.;
+		error_lookahead(__func__);
+	}
+	// ----------------------------------------------------------------------------
+
+
+
+	// ----------------------------------------------------------------------------
+	// Code generation helpers
+	// ----------------------------------------------------------------------------
+	void error_lookahead(const char* func)
+	{
+		std::cerr << "Invalid lookahead in " << func << ": " << m_lookahead << "." << std::endl;
+		m_ok = false;
+	}
+
+
+	/**
+	 * resolves a variable to its slot, binding known symbols to their current value
+	 */
+	std::uint32_t bind_var(const std::string& ident)
+	{
+		auto [slot, is_new] = m_prog.add_var(ident);
+		if(is_new)
+		{
+			if(auto iter = m_mapSymbols.find(ident); iter != m_mapSymbols.end())
+				m_prog.m_defaults[slot] = iter->second;
+		}
+		return slot;
+	}
+
+
+	/**
+	 * looks up the function and adds it to the program's function tables
+	 */
+	template<class t_func, class t_func_block = std::nullptr_t>
+	void emit_call(const std::unordered_map<std::string, t_func>& funcs,
+		std::vector<t_func>& prog_funcs, t_op op, const std::string& ident,
+		const std::unordered_map<std::string, t_func_block>* funcs_block = nullptr,
+		std::vector<t_func_block>* prog_funcs_block = nullptr)
+	{
+		auto iter = funcs.find(ident);
+		if(iter == funcs.end())
+		{
+			std::cerr << "Unknown function \"" << ident << "\"." << std::endl;
+			m_ok = false;
+			return;
+		}
+
+		prog_funcs.push_back(iter->second);
+
+		if(prog_funcs_block)
+		{
+			auto iter_block = funcs_block->find(ident);
+			prog_funcs_block->push_back(iter_block == funcs_block->end() ? nullptr : iter_block->second);
+		}
+
+		m_prog.emit(op, std::uint32_t(prog_funcs.size() - 1));
 	}
 	// ----------------------------------------------------------------------------
 
 
 private:
-	std::shared_ptr<std::istream> m_istr{};
+	// program being compiled
+	t_program m_prog{};
+	bool m_ok{true};
+
+	// lexer input and position
+	std::string_view m_input{};
+	std::size_t m_inputpos{0};
 
 	int m_lookahead = (int)Token::TOK_INVALID;
 	t_real m_lookahead_val{};
-	std::string m_lookahead_text{};
+	std::string_view m_lookahead_text{};
 
 
 	// ----------------------------------------------------------------------------
@@ -546,9 +1196,11 @@ private:
 	{
 		{ "rand", []() -> t_real
 			{
-				static std::mt19937 s_rng{std::random_device{}()};
-				return std::uniform_real_distribution<t_real>(
-					t_real(0), t_real(1))(s_rng);
+				static thread_local std::mt19937 s_rng{std::random_device{}()};
+				using t_dist = std::conditional_t<std::is_floating_point_v<t_real>,
+					std::uniform_real_distribution<t_real>,
+					std::uniform_int_distribution<t_real>>;
+				return t_dist(t_real(0), t_real(1))(s_rng);
 			} },
 	};
 
@@ -580,7 +1232,7 @@ private:
 
 		{ "rand", [](t_real min, t_real max) -> t_real
 			{
-				static std::mt19937 s_rng{std::random_device{}()};
+				static thread_local std::mt19937 s_rng{std::random_device{}()};
 				if constexpr(std::is_floating_point_v<t_real>)
 					return std::uniform_real_distribution<t_real>(
 						min, max)(s_rng);
@@ -590,6 +1242,23 @@ private:
 				return t_real{};
 			} },
 	};
+
+
+	// vectorised versions of the one-arg functions operating on blocks
+	std::unordered_map<std::string, void(*)(t_real*)> m_mapFuncs1Block =
+	{
+		{ "sin", &expr_block<t_real>::sin },
+		{ "cos", &expr_block<t_real>::cos },
+		{ "sqrt", &expr_block<t_real>::sqrt },
+		{ "exp", &expr_block<t_real>::exp },
+	};
+
+
+	// vectorised versions of the two-args functions operating on blocks
+	std::unordered_map<std::string, void(*)(t_real*, const t_real*)> m_mapFuncs2Block =
+	{
+		{ "pow", &expr_block<t_real>::pow },
+	};
 	// ----------------------------------------------------------------------------
 };
 
@@ -62,13 +62,11 @@ ExprParser::ExprParser() :
 
 		{ "rand", [](t_val min, t_val max) -> t_val
 			{
-				if constexpr(std::is_floating_point_v<t_val>)
-					return std::uniform_real_distribution<t_val>(
-						min, max)(g_rng);
-				else if constexpr(std::is_integral_v<t_val>)
-					return std::uniform_int_distribution<t_val>(
-						min, max)(g_rng);
-				return t_val{};
+				// the discarded branch of an if constexpr is only skipped in templates
+				using t_dist = std::conditional_t<std::is_floating_point_v<t_val>,
+					std::uniform_real_distribution<t_val>,
+					std::uniform_int_distribution<t_val>>;
+				return t_dist(min, max)(g_rng);
 			} },
 	}
 { }
@@ -10,6 +10,7 @@
  *	- https://de.wikipedia.org/wiki/LL(k)-Grammatik
  *
  * gcc -Wall -Wextra -o expr_parser expr_parser.c string.c -lm
+ * gcc -Wall -Wextra -DEXPR_TEST -o expr_parser_tst expr_parser.c string.c -lm
  */
 
 //#include <string.h>
@@ -25,6 +26,10 @@
 // definitions
 // ----------------------------------------------------------------------------
 #define MAX_IDENT 256
+#define MAX_CODE  1024
+#define MAX_CONSTS 256
+#define MAX_VARS  64
+#define MAX_STACK 256
 
 
 //#define USE_INTEGER
@@ -45,18 +50,64 @@ enum Token
 };
 
 
+/**
+ * opcodes of the compiled postfix programs
+ */
+enum Op
+{
+	OP_PUSH,	// push constant
+	OP_LOAD,	// push slot value
+	OP_STORE,	// assign top of stack to slot, leaving it on the stack
+
+	OP_NEG, OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_MOD, OP_POW,
+	OP_SIN, OP_COS, OP_TAN, OP_ATAN2,
+};
+
+
+struct Instr
+{
+	unsigned char op;
+	unsigned int arg;
+};
+
+
+/**
+ * compiled expression with the variables resolved to slot indices
+ */
+struct Program
+{
+	struct Instr code[MAX_CODE];
+	int num_code;
+
+	t_value consts[MAX_CONSTS];
+	int num_consts;
+
+	// variable names and values bound at compile time
+	char vars[MAX_VARS][MAX_IDENT];
+	t_value defaults[MAX_VARS];
+	int num_vars;
+
+	// variables read before they are assigned
+	char inputs[MAX_VARS];
+	char assigned[MAX_VARS];
+
+	int stack, max_stack;
+	int ok;
+};
+
+
 static int g_lookahead = TOK_INVALID;
 static t_value g_lookahead_val = 0;
 static char g_lookahead_text[MAX_IDENT];
 
 
-static t_value plus_term();
-static t_value plus_term_rest(t_value arg);
-static t_value mul_term();
-static t_value mul_term_rest(t_value arg);
-static t_value pow_term();
-static t_value pow_term_rest(t_value arg);
-static t_value factor();
+static void plus_term();
+static void plus_term_rest();
+static void mul_term();
+static void mul_term_rest();
+static void pow_term();
+static void pow_term_rest();
+static void factor();
 // ----------------------------------------------------------------------------
 
 
@@ -441,6 +492,96 @@ int match(int expected)
 
 
 
+// ----------------------------------------------------------------------------
+// code generation
+// ----------------------------------------------------------------------------
+static struct Program* g_prog = 0;
+
+
+static void emit(int op, unsigned int arg)
+{
+	switch(op)
+	{
+		case OP_PUSH: case OP_LOAD:
+			++g_prog->stack;
+			break;
+		case OP_ADD: case OP_SUB: case OP_MUL: case OP_DIV:
+		case OP_MOD: case OP_POW: case OP_ATAN2:
+			--g_prog->stack;
+			break;
+		default:
+			break;
+	}
+
+	if(g_prog->stack > g_prog->max_stack)
+		g_prog->max_stack = g_prog->stack;
+
+	if(g_prog->num_code >= MAX_CODE || g_prog->max_stack > MAX_STACK)
+	{
+		fprintf(stderr, "Expression too long.\n");
+		g_prog->ok = 0;
+		return;
+	}
+
+	g_prog->code[g_prog->num_code].op = (unsigned char)op;
+	g_prog->code[g_prog->num_code].arg = arg;
+	++g_prog->num_code;
+}
+
+
+static void emit_const(t_value val)
+{
+	if(g_prog->num_consts >= MAX_CONSTS)
+	{
+		fprintf(stderr, "Too many constants.\n");
+		g_prog->ok = 0;
+		return;
+	}
+
+	g_prog->consts[g_prog->num_consts] = val;
+	emit(OP_PUSH, g_prog->num_consts++);
+}
+
+
+/**
+ * resolves a variable to its slot, binding known symbols to their current value
+ */
+static int bind_var(const char* ident)
+{
+	for(int slot=0; slot<g_prog->num_vars; ++slot)
+	{
+		if(my_strncmp(g_prog->vars[slot], ident, MAX_IDENT) == 0)
+			return slot;
+	}
+
+	if(g_prog->num_vars >= MAX_VARS)
+	{
+		fprintf(stderr, "Too many variables.\n");
+		g_prog->ok = 0;
+		return 0;
+	}
+
+	int slot = g_prog->num_vars++;
+	my_strncpy(g_prog->vars[slot], ident, MAX_IDENT);
+
+	const struct Symbol* sym = find_symbol(ident);
+	g_prog->defaults[slot] = sym ? sym->value : 0;
+	g_prog->inputs[slot] = 0;
+	g_prog->assigned[slot] = 0;
+
+	return slot;
+}
+
+
+static void error_lookahead(const char* func)
+{
+	fprintf(stderr, "Invalid lookahead in %s: %d.\n", func, g_lookahead);
+	g_prog->ok = 0;
+}
+// ----------------------------------------------------------------------------
+
+
+
 // ----------------------------------------------------------------------------
 // productions
 // ----------------------------------------------------------------------------
@@ -448,70 +589,69 @@ int match(int expected)
  * +,- terms
  * (lowest precedence, 1)
  */
-static t_value plus_term()
+static void plus_term()
 {
 	// plus_term -> mul_term plus_term_rest
 	if(g_lookahead == '(' || g_lookahead == TOK_VALUE || g_lookahead == TOK_IDENT)
 	{
-		t_value term_val = mul_term();
-		t_value expr_rest_val = plus_term_rest(term_val);
-
-		return expr_rest_val;
+		mul_term();
+		plus_term_rest();
+		return;
 	}
 	else if(g_lookahead == '+')	// unary +
 	{
 		next_lookahead();
-		t_value term_val = mul_term();
-		t_value expr_rest_val = plus_term_rest(term_val);
-
-		return expr_rest_val;
+		mul_term();
+		plus_term_rest();
+		return;
 	}
 	else if(g_lookahead == '-')	// unary -
 	{
 		next_lookahead();
-		t_value term_val = -mul_term();
-		t_value expr_rest_val = plus_term_rest(term_val);
-
-		return expr_rest_val;
+		mul_term();
+		emit(OP_NEG, 0);
+		plus_term_rest();
+		return;
 	}
 
 	if(g_lookahead == 0 || g_lookahead == EOF)
-		return 0;
+	{
+		g_prog->ok = 0;
+		return;
+	}
 
-	fprintf(stderr, "Invalid lookahead in %s: %d.\n", __func__, g_lookahead);
-	return 0.;
+	error_lookahead(__func__);
 }
 
 
-static t_value plus_term_rest(t_value arg)
+static void plus_term_rest()
 {
 	// plus_term_rest -> '+' mul_term plus_term_rest
 	if(g_lookahead == '+')
 	{
 		next_lookahead();
-		t_value term_val = arg + mul_term();
-		t_value expr_rest_val = plus_term_rest(term_val);
-
-		return expr_rest_val;
+		mul_term();
+		emit(OP_ADD, 0);
+		plus_term_rest();
+		return;
 	}
 
 	// plus_term_rest -> '-' mul_term plus_term_rest
 	else if(g_lookahead == '-')
 	{
 		next_lookahead();
-		t_value term_val = arg - mul_term();
-		t_value expr_rest_val = plus_term_rest(term_val);
-
-		return expr_rest_val;
+		mul_term();
+		emit(OP_SUB, 0);
+		plus_term_rest();
+		return;
 	}
 	// plus_term_rest -> epsilon
 	else if(g_lookahead == ')' || g_lookahead == TOK_END || g_lookahead == ',')
 	{
-		return arg;
+		return;
 	}
 
-	fprintf(stderr, "Invalid lookahead in %s: %d.\n", __func__, g_lookahead);
-	return 0.;
+	error_lookahead(__func__);
 }
 
 
@@ -519,63 +659,60 @@ static t_value plus_term_rest(t_value arg)
  * *,/,% terms
  * (precedence 2)
  */
-static t_value mul_term()
+static void mul_term()
 {
 	// mul_term -> pow_term mul_term_rest
 	if(g_lookahead == '(' || g_lookahead == TOK_VALUE || g_lookahead == TOK_IDENT)
 	{
-		t_value factor_val = pow_term();
-		t_value term_rest_val = mul_term_rest(factor_val);
-
-		return term_rest_val;
+		pow_term();
+		mul_term_rest();
+		return;
 	}
 
-	fprintf(stderr, "Invalid lookahead in %s: %d.\n", __func__, g_lookahead);
-	return 0.;
+	error_lookahead(__func__);
 }
 
 
-static t_value mul_term_rest(t_value arg)
+static void mul_term_rest()
 {
 	// mul_term_rest -> '*' pow_term mul_term_rest
 	if(g_lookahead == '*')
 	{
 		next_lookahead();
-		t_value factor_val = arg * pow_term();
-		t_value term_rest_val = mul_term_rest(factor_val);
-
-		return term_rest_val;
+		pow_term();
+		emit(OP_MUL, 0);
+		mul_term_rest();
+		return;
 	}
 
 	// mul_term_rest -> '/' pow_term mul_term_rest
 	else if(g_lookahead == '/')
 	{
 		next_lookahead();
-		t_value factor_val = arg / pow_term();
-		t_value term_rest_val = mul_term_rest(factor_val);
-
-		return term_rest_val;
+		pow_term();
+		emit(OP_DIV, 0);
+		mul_term_rest();
+		return;
 	}
 
 	// mul_term_rest -> '%' pow_term mul_term_rest
 	else if(g_lookahead == '%')
 	{
 		next_lookahead();
-		t_value factor_val = fmod(arg, pow_term());
-		t_value term_rest_val = mul_term_rest(factor_val);
-
-		return term_rest_val;
+		pow_term();
+		emit(OP_MOD, 0);
+		mul_term_rest();
+		return;
 	}
 
 	// mul_term_rest -> epsilon
 	else if(g_lookahead == '+' || g_lookahead == '-' || g_lookahead == ')'
 		|| g_lookahead == TOK_END || g_lookahead == ',')
 	{
-		return arg;
+		return;
 	}
 
-	fprintf(stderr, "Invalid lookahead in %s: %d.\n", __func__, g_lookahead);
-	return 0.;
+	error_lookahead(__func__);
 }
 
 
@@ -583,32 +720,30 @@ static t_value mul_term_rest(t_value arg)
  * ^ terms
  * (precedence 3)
  */
-static t_value pow_term()
+static void pow_term()
 {
 	// pow_term -> factor pow_term_rest
 	if(g_lookahead == '(' || g_lookahead == TOK_VALUE || g_lookahead == TOK_IDENT)
 	{
-		t_value factor_val = factor();
-		t_value term_rest_val = pow_term_rest(factor_val);
-
-		return term_rest_val;
+		factor();
+		pow_term_rest();
+		return;
 	}
 
-	fprintf(stderr, "Invalid lookahead in %s: %d.\n", __func__, g_lookahead);
-	return 0.;
+	error_lookahead(__func__);
 }
 
 
-static t_value pow_term_rest(t_value arg)
+static void pow_term_rest()
 {
 	// pow_term_rest -> '^' factor pow_term_rest
 	if(g_lookahead == '^')
 	{
 		next_lookahead();
-		t_value factor_val = pow(arg, factor());
-		t_value term_rest_val = pow_term_rest(factor_val);
-
-		return term_rest_val;
+		factor();
+		emit(OP_POW, 0);
+		pow_term_rest();
+		return;
 	}
 
 	// pow_term_rest -> epsilon
@@ -616,11 +751,10 @@ static t_value pow_term_rest(t_value arg)
 		|| g_lookahead == TOK_END || g_lookahead == ','
 		|| g_lookahead == '*' || g_lookahead == '/' || g_lookahead == '%')
 	{
-		return arg;
+		return;
 	}
 
-	fprintf(stderr, "Invalid lookahead in %s: %d.\n", __func__, g_lookahead);
-	return 0.;
+	error_lookahead(__func__);
 }
 
 
@@ -628,26 +762,25 @@ static t_value pow_term_rest(t_value arg)
  * () terms, real factor or identifier
  * (highest precedence, 4)
  */
-static t_value factor()
+static void factor()
 {
 	// factor -> '(' plus_term ')'
 	if(g_lookahead == '(')
 	{
 		next_lookahead();
-		t_value expr_val = plus_term();
-		match(')');
+		plus_term();
+		if(!match(')'))
+			g_prog->ok = 0;
 		next_lookahead();
-
-		return expr_val;
+		return;
 	}
 
 	// factor -> TOK_VALUE
 	else if(g_lookahead == TOK_VALUE)
 	{
-		t_value val = g_lookahead_val;
+		emit_const(g_lookahead_val);
 		next_lookahead();
-
-		return val;
+		return;
 	}
 
 	// factor -> TOK_IDENT
@@ -671,21 +804,16 @@ static t_value factor()
 				next_lookahead();
 
 				// TODO
-				//auto iter = m_mapFuncs0.find(ident);
-				//if(iter == m_mapFuncs0.end())
-				{
-					fprintf(stderr, "Unknown function: \"%s\".\n", ident);
-					return 0.;
-				}
-
-				//return (*iter->second)();
+				fprintf(stderr, "Unknown function: \"%s\".\n", ident);
+				g_prog->ok = 0;
+				return;
 			}
 
 			// function with arguments
 			else
 			{
 				// first argument
-				t_value expr_val1 = plus_term();
+				plus_term();
 
 				// one-argument-function
 				// factor -> TOK_IDENT '(' plus_term ')'
@@ -695,21 +823,22 @@ static t_value factor()
 
 					if(my_strncmp(ident, "sin", MAX_IDENT)==0)
 					{
-						return sin(expr_val1);
+						emit(OP_SIN, 0);
 					}
 					else if(my_strncmp(ident, "cos", MAX_IDENT)==0)
 					{
-						return cos(expr_val1);
+						emit(OP_COS, 0);
 					}
 					else if(my_strncmp(ident, "tan", MAX_IDENT)==0)
 					{
-						return tan(expr_val1);
+						emit(OP_TAN, 0);
 					}
 					else
 					{
 						fprintf(stderr, "Unknown function: \"%s\".\n", ident);
-						return 0.;
+						g_prog->ok = 0;
 					}
+					return;
 				}
 
 				// two-argument-function
@@ -717,19 +846,21 @@ static t_value factor()
 				else if(g_lookahead == ',')
 				{
 					next_lookahead();
-					t_value expr_val2 = plus_term();
-					match(')');
+					plus_term();
+					if(!match(')'))
+						g_prog->ok = 0;
 					next_lookahead();
 
 					if(my_strncmp(ident, "atan2", MAX_IDENT)==0)
 					{
-						return atan2(expr_val1, expr_val2);
+						emit(OP_ATAN2, 0);
 					}
 					else
 					{
 						fprintf(stderr, "Unknown function: \"%s\".\n", ident);
-						return 0.;
+						g_prog->ok = 0;
 					}
+					return;
 				}
 				else
 				{
@@ -742,45 +873,196 @@ static t_value factor()
 		else if(g_lookahead == '=')
 		{
 			next_lookahead();
-			t_value assign_val = plus_term();
-			assign_or_insert_symbol(ident, assign_val);
-			return assign_val;
+			plus_term();
+
+			int slot = bind_var(ident);
+			g_prog->assigned[slot] = 1;
+			emit(OP_STORE, slot);
+			return;
 		}
 
 		// variable lookup
 		else
 		{
-			const struct Symbol* sym = find_symbol(ident);
-			if(!sym)
-			{
-				fprintf(stderr, "Unknown identifier \"%s\".\n", ident);
-				return 0.;
-			}
-
-			return sym->value;
+			int slot = bind_var(ident);
+			if(!g_prog->assigned[slot])
+				g_prog->inputs[slot] = 1;
+			emit(OP_LOAD, slot);
+			return;
 		}
 	}
 
-	fprintf(stderr, "Invalid lookahead in %s: %d.\n", __func__, g_lookahead);
-	return 0.;
+	error_lookahead(__func__);
 }
+// ------------------------------------------------------------------------
 
 
 
-t_value parse(const char* str)
+// ------------------------------------------------------------------------
+// compiled programs
+// ------------------------------------------------------------------------
+/**
+ * translates the expression into a postfix program
+ * @return 0 on syntax errors
+ */
+int compile(const char* str, struct Program* prog)
 {
+	prog->num_code = 0;
+	prog->num_consts = 0;
+	prog->num_vars = 0;
+	prog->stack = 0;
+	prog->max_stack = 0;
+	prog->ok = 1;
+
+	g_prog = prog;
 	set_input(str);
 	next_lookahead();
-	return plus_term();
+	plus_term();
+	g_prog = 0;
+
+	return prog->ok;
+}
+
+
+/**
+ * evaluates the program with the given variable values
+ * @param slots variable values, assigned variables are written back
+ */
+t_value eval(const struct Program* prog, t_value* slots)
+{
+	t_value stack[MAX_STACK];
+	t_value *sp = stack;
+
+	for(int pc=0; pc<prog->num_code; ++pc)
+	{
+		const struct Instr* instr = &prog->code[pc];
+
+		switch(instr->op)
+		{
+			case OP_PUSH: *sp++ = prog->consts[instr->arg]; break;
+			case OP_LOAD: *sp++ = slots[instr->arg]; break;
+			case OP_STORE: slots[instr->arg] = sp[-1]; break;
+
+			case OP_NEG: sp[-1] = -sp[-1]; break;
+			case OP_ADD: --sp; sp[-1] = sp[-1] + sp[0]; break;
+			case OP_SUB: --sp; sp[-1] = sp[-1] - sp[0]; break;
+			case OP_MUL: --sp; sp[-1] = sp[-1] * sp[0]; break;
+			case OP_DIV: --sp; sp[-1] = sp[-1] / sp[0]; break;
+			case OP_MOD: --sp; sp[-1] = fmod(sp[-1], sp[0]); break;
+			case OP_POW: --sp; sp[-1] = pow(sp[-1], sp[0]); break;
+
+			case OP_SIN: sp[-1] = sin(sp[-1]); break;
+			case OP_COS: sp[-1] = cos(sp[-1]); break;
+			case OP_TAN: sp[-1] = tan(sp[-1]); break;
+			case OP_ATAN2: --sp; sp[-1] = atan2(sp[-1], sp[0]); break;
+		}
+	}
+
+	return sp[-1];
+}
+
+
+/**
+ * evaluates the program for each row of the input columns
+ * @param columns input column for each slot, or 0 to use the slot's default value
+ * @param num_columns number of columns, has to match the program's variable count
+ * @return 0 if the number of columns does not match
+ */
+int eval_columns(const struct Program* prog, const t_value* const* columns,
+	int num_columns, int num_rows, t_value* results)
+{
+	if(num_columns != prog->num_vars)
+	{
+		fprintf(stderr, "Expected %d input columns, but got %d.\n",
+			prog->num_vars, num_columns);
+		return 0;
+	}
+
+	t_value slots[MAX_VARS];
+
+	for(int row=0; row<num_rows; ++row)
+	{
+		for(int slot=0; slot<prog->num_vars; ++slot)
+			slots[slot] = columns[slot] ? columns[slot][row] : prog->defaults[slot];
+
+		results[row] = eval(prog, slots);
+	}
+
+	return 1;
+}
+
+
+/**
+ * compiles and evaluates the expression with the variables from the symbol table
+ */
+t_value parse(const char* str)
+{
+	static struct Program prog;
+	if(!compile(str, &prog))
+		return 0;
+
+	t_value slots[MAX_VARS];
+	for(int slot=0; slot<prog.num_vars; ++slot)
+	{
+		slots[slot] = prog.defaults[slot];
+
+		if(prog.inputs[slot] && !find_symbol(prog.vars[slot]))
+			fprintf(stderr, "Unknown identifier \"%s\".\n", prog.vars[slot]);
+	}
+
+	t_value val = eval(&prog, slots);
+
+	for(int slot=0; slot<prog.num_vars; ++slot)
+	{
+		if(prog.assigned[slot])
+			assign_or_insert_symbol(prog.vars[slot], slots[slot]);
+	}
+
+	return val;
 }
 // ------------------------------------------------------------------------
 
 
 
+#ifdef EXPR_TEST
+/**
+ * checks the column-wise evaluation against the expected values
+ */
+static int test_eval_columns()
+{
+	struct Program prog;
+	if(!compile("x*y + z", &prog) || prog.num_vars != 3)
+		return 0;
+
+	const t_value x[] = { 1, 2, 3, 4 };
+	const t_value y[] = { 5, 6, 7, 8 };
+	const t_value* columns[] = { x, y, 0 };
+	t_value results[4];
+
+	int ok = eval_columns(&prog, columns, 3, 4, results);
+	for(int row=0; row<4; ++row)
+		ok = ok && results[row] == x[row]*y[row];
+
+	// too few or too many columns
+	ok = ok && !eval_columns(&prog, columns, 2, 4, results);
+	ok = ok && !eval_columns(&prog, columns, 4, 4, results);
+
+	return ok;
+}
+#endif
+
+
 int main()
 {
 	init_symbols();
 
+#ifdef EXPR_TEST
+	int ok = test_eval_columns();
+	printf("eval_columns: ok = %d\n", ok);
+	deinit_symbols();
+	return ok ? 0 : -1;
+#endif
+
 	while(1)
 	{
 		char expr[256];
@@ -4,194 +4,64 @@
  * @author Tobias Weber
  * @date 23-jun-19
  * @license: see 'LICENSE.EUPL' file
+ *
+ * g++ -std=c++20 -O2 -o distvec distvec.cpp -lpthread
  */
 
 #include <vector>
-#include <tuple>
-#include <unordered_map>
-#include <limits>
 #include <string>
 #include <iostream>
 #include <iomanip>
-#include <thread>
 
-#include <boost/signals2/signal.hpp>
-namespace sig = boost::signals2;
+#include "../../libs/graph_distvec.h"
 
 
 using t_real = double;
 
 
-class Node
+int main()
 {
-private:
-	const std::string& m_name;
-
-	std::unordered_map<std::string, t_real> m_neighbours;
-	std::unordered_map<std::string, t_real> m_route;
-
-	using t_sigAnnounceRoute = sig::signal<void(const std::string&, const std::string&, t_real)>;
-	t_sigAnnounceRoute m_sigAnnounceRoute;
-
-
-public:
-	Node(const std::string& name) : m_name(name)
-	{
-		// route to self
-		m_neighbours[m_name] = 0.;
-		m_route[m_name + "->" + m_name] = 0.;
-	}
-
-
-	void SetNeighbour(const std::string& name, t_real dist)
-	{
-		m_neighbours[name] = dist;
-		m_route[m_name + "->" + name] = dist;
-	}
-
-
-	void AnnounceNeighbourDistances()
-	{
-		for(const auto& pair : m_neighbours)
-		{
-			m_sigAnnounceRoute(m_name, pair.first, pair.second);
-		}
-	}
-
-
-	/**
-	 * find minimal distance to target node
-	 */
-	t_real GetMinDistTo(const std::string& node)
-	{
-		t_real dist = std::numeric_limits<t_real>::max();
-
-		for(const auto& pair : m_route)
-		{
-			std::size_t iPos = pair.first.find("->")+2;
-			std::string nodeTo = pair.first.substr(iPos);
-			if(nodeTo == node)
-				dist = std::min(dist, pair.second);
-		}
-
-		return dist;
-	}
-
-
-	void ReceiveRoute(const std::string& nameVia, const std::string& nameTo, t_real dist)
-	{
-		// check if the sending node is a known neighbour and get the distance to it
-		t_real distToSendingNode = 0.;
-
-		if(auto iter = m_neighbours.find(nameVia); iter != m_neighbours.end())
-		{
-			distToSendingNode = iter->second;
-		}
-		else
-		{
-			// ignore message from non-neighbour node
-			return;
-		}
-
-
-		std::string strRouteName = nameVia + "->" + nameTo;
-
-		// does this route already exist?
-		if(auto iter = m_route.find(strRouteName); iter != m_route.end())
-		{
-			// more efficient route found?
-			if(distToSendingNode + dist < iter->second)
-			{
-				bool bNewMinDist = distToSendingNode + dist < GetMinDistTo(nameTo);
-
-				// update distance
-				iter->second = distToSendingNode + dist;
-
-				std::cout << "Updated route for node " << m_name << ": "
-					<< strRouteName << ", distance: " << distToSendingNode + dist
-					<< std::endl;
-
-				// announce updated route
-				if(bNewMinDist)
-					m_sigAnnounceRoute(m_name, nameTo, distToSendingNode + dist);
-			}
-		}
-		// new route
-		else
-		{
-			bool bNewMinDist = distToSendingNode + dist < GetMinDistTo(nameTo);
-
-			m_route[strRouteName] = distToSendingNode + dist;
-
-			std::cout << "New route for node " << m_name << ": "
-				<< strRouteName << ", distance: " << distToSendingNode + dist
-				<< std::endl;
+	// example graph
+	// vertices
+	const std::vector<std::string> names{ "a", "b", "c" };
+	distvec_sim<t_real> sim(names.size());
 
-			// announce new route
-			if(bNewMinDist)
-				m_sigAnnounceRoute(m_name, nameTo, distToSendingNode + dist);
-		}
-	}
+	// edges
+	sim.SetBidirLink(0, 1, 1.);
+	sim.SetBidirLink(1, 2, 2.);
 
 
-	template<class t_slot>
-	void ConnectToRouteAnnouncer(const t_slot& slot)
+	// exchange the distance vectors until the routing tables don't change anymore
+	// (the simulation counts the updates and messages over all rounds)
+	std::size_t last_updates = 0;
+	while(sim.Round())
 	{
-		m_sigAnnounceRoute.connect(slot);
+		std::cout << "Round " << sim.GetNumRounds() << ": "
+			<< sim.GetNumUpdates() - last_updates << " route updates, "
+			<< sim.GetNumMessages() << " messages in total." << std::endl;
+		last_updates = sim.GetNumUpdates();
 	}
 
 
-	friend std::ostream& operator<<(std::ostream& ostr, const Node& node)
+	// print final routing tables
+	std::cout << "\n";
+	for(std::size_t node=0; node<names.size(); ++node)
 	{
-		ostr << "Routing table for node " << node.m_name << "\n";
-
-		for(const auto& pair : node.m_route)
-			ostr << pair.first << ": " << pair.second << "\n";
-
-		return ostr;
-	}
-};
+		std::cout << "Routing table for node " << names[node] << "\n";
 
-
-int main()
-{
-	// example graph
-	// vertices
-	Node a("a");
-	Node b("b");
-	Node c("c");
-
-	// edges
-	a.SetNeighbour("b", 1.);
-	b.SetNeighbour("a", 1.);
-	b.SetNeighbour("c", 2.);
-	c.SetNeighbour("b", 2.);
-
-
-	// connect the signals of every node to every other node
-	for(Node* node1 : {&a, &b, &c})
-	{
-		for(Node* node2 : {&a, &b, &c})
+		for(std::size_t dest=0; dest<names.size(); ++dest)
 		{
-			if(node1 == node2)
+			std::optional<t_real> dist = sim.GetDist(node, dest);
+			std::optional<std::size_t> hop = sim.GetNextHop(node, dest);
+			if(!dist || !hop)
 				continue;
 
-			node1->ConnectToRouteAnnouncer(
-				[node2](const std::string& nameVia, const std::string& nameTo, t_real dist)
-				{ node2->ReceiveRoute(nameVia, nameTo, dist); });
+			std::cout << names[node] << "->" << names[dest] << " via " << names[*hop]
+				<< ": " << *dist << "\n";
 		}
-	}
-
-
-	// begin annoucing initial distances
-	for(Node* node : {&a, &b, &c})
-		node->AnnounceNeighbourDistances();
 
-
-	// print final routing tables
-	std::cout << "\n";
-	for(Node* node : {&a, &b, &c})
-		std::cout << *node << std::endl;
+		std::cout << std::endl;
+	}
 
 
 	return 0;
@@ -4,7 +4,7 @@
  * @date 18-mar-18
  * @license: see 'LICENSE.EUPL' file
  *
- * g++ -o structurefactor structurefactor.cpp -std=c++17 -fconcepts
+ * g++ -o structurefactor structurefactor.cpp -std=c++20 -lpthread
  */
 
 #include <boost/algorithm/string.hpp>
@@ -15,14 +15,15 @@
 
 #include "../libs/math_algos.h"
 #include "../libs/math_conts.h"
+#include "../libs/math_structfact.h"
 using namespace m;
 using namespace m_ops;
 
 using t_real = double;
 using t_cplx = std::complex<t_real>;
-using t_vec = std::vector<t_real>;
+using t_vec = vec<t_real, std::vector>;
 using t_mat = mat<t_real, std::vector>;
-using t_vec_cplx = std::vector<t_cplx>;
+using t_vec_cplx = vec<t_cplx, std::vector>;
 using t_mat_cplx = mat<t_cplx, std::vector>;
 
 std::string g_ws = " \t";
@@ -95,15 +96,27 @@ void calc(std::istream& istr)
 
 	std::cout << Rs.size() << " atom(s) defined.\n";
 
-	for(t_real h=0; h<2; ++h)
-		for(t_real k=0; k<2; ++k)
-			for(t_real l=0; l<2; ++l)
+	// calculate all structure factors at once on the hkl grid
+	const t_vec Q0 = create<t_vec>({0, 0, 0});
+	const t_vec dh = create<t_vec>({1, 0, 0});
+	const t_vec dk = create<t_vec>({0, 1, 0});
+	const t_vec dl = create<t_vec>({0, 0, 1});
+
+	std::vector<t_cplx> Fs;
+	if(bNucl)
+		Fs = structure_factors_grid<t_vec>(make_sf_atoms<t_vec, t_cplx>(bs, Rs), Q0, dh, dk, dl, 2, 2, 2);
+	else
+		Fs = structure_factors_grid<t_vec>(make_sf_atoms<t_vec, t_vec_cplx>(Ms, Rs), Q0, dh, dk, dl, 2, 2, 2);
+
+	for(std::size_t h=0; h<2; ++h)
+		for(std::size_t k=0; k<2; ++k)
+			for(std::size_t l=0; l<2; ++l)
 			{
-				auto Q = create<t_vec>({h,k,l});
+				const std::size_t idx = (h*2 + k)*2 + l;
 
 				if(bNucl)
 				{
-					auto Fn = structure_factor<t_vec, t_cplx>(bs, Rs, Q);
+					auto Fn = Fs[idx];
 					std::cout << "Fn(" << h << k << l << ") = "
 						<< Fn << ", "
 						<< "In(" << h << k << l << ") = "
@@ -111,9 +124,9 @@ void calc(std::istream& istr)
 				}
 				else
 				{
-					auto Fm = structure_factor<t_vec, t_vec_cplx>(Ms, Rs, Q);
+					const t_cplx* Fm = Fs.data() + idx*3;
 					std::cout << "Fm(" << h << k << l << ") = "
-						<< Fm[0] << ", " <<  Fm[1] << ", " << "Fm[2]" << ")\n";
+						<< Fm[0] << ", " <<  Fm[1] << ", " << Fm[2] << ")\n";
 				}
 			}
 }